@@ -0,0 +1,264 @@
+#pragma once
+
+/**
+ * @file CDS_Allocator.hpp
+ * @brief Memory resources and the allocator adapter used by CDS containers.
+ *
+ * CDS_Arena is a monotonic bump allocator: allocation is a pointer increment
+ * and Reset hands the whole arena back in O(1), which suits memory whose
+ * lifetime ends at a known point such as the end of a request. CDS_Pool
+ * keeps per-size-class free lists carved from large slabs, so repeated
+ * allocations of similar sizes neither hit the global heap nor fragment it.
+ *
+ * Neither resource is thread-safe, use one per thread or per request.
+ * CDS_Allocator adapts a resource to the standard allocator interface, so it
+ * can be passed to CDS_List as well as to standard containers.
+ */
+
+#include <cstddef>
+#include <new>
+
+/**
+ * @brief Monotonic bump allocator over a chain of blocks.
+ *
+ * Memory is only reclaimed by Reset, except that freeing the most recent
+ * allocation rolls the bump pointer back, so a container growing at the top
+ * of the arena reuses its old buffer.
+ */
+class CDS_Arena {
+public:
+  /**
+   * @brief Constructs an empty arena.
+   *
+   * @param blockSize Size in bytes of the first block, later blocks double.
+   */
+  explicit CDS_Arena(std::size_t blockSize = 64 * 1024);
+
+  CDS_Arena(const CDS_Arena &) = delete;
+  CDS_Arena &operator=(const CDS_Arena &) = delete;
+
+  /**
+   * @brief Destructor.
+   *
+   * Returns all blocks to the global heap.
+   */
+  ~CDS_Arena();
+
+  /**
+   * @brief Allocates memory from the arena.
+   *
+   * @param bytes Number of bytes.
+   * @param alignment Alignment in bytes, a power of two.
+   * @return Pointer to the memory.
+   */
+  void *Allocate(std::size_t bytes,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * @brief Frees memory, which only has an effect on the latest allocation.
+   *
+   * @param pointer Pointer returned by Allocate.
+   * @param bytes Number of bytes passed to Allocate.
+   * @param alignment Alignment passed to Allocate.
+   */
+  void Deallocate(void *pointer, std::size_t bytes,
+                  std::size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * @brief Frees everything allocated from the arena in O(1).
+   *
+   * The blocks are kept and reused by later allocations. Objects living in
+   * the arena are not destroyed, destroy any containers using it first.
+   */
+  void Reset();
+
+  /**
+   * @brief Gets the number of bytes handed out since the last Reset,
+   * including alignment padding.
+   *
+   * @return The bytes in use.
+   */
+  std::size_t GetUsed() const;
+
+  /**
+   * @brief Gets the total size of the blocks owned by the arena.
+   *
+   * @return The capacity in bytes.
+   */
+  std::size_t GetCapacity() const;
+
+private:
+  /**
+   * @brief Header at the start of every block.
+   */
+  struct _Block {
+    _Block *Next;     ///< Next block in the chain, null for the last one.
+    std::size_t Size; ///< Usable bytes after the header.
+  };
+
+  _Block *_First = nullptr;   ///< First block of the chain
+  _Block *_Current = nullptr; ///< Block the bump pointer is in
+  char *_Cursor = nullptr;    ///< Next free byte in the current block
+  char *_End = nullptr;       ///< End of the current block
+  std::size_t _BlockSize;     ///< Size of the next block to allocate
+  std::size_t _Used = 0;      ///< Bytes in full blocks before _Current
+
+  /**
+   * @brief Moves the bump pointer to the start of a block.
+   *
+   * @param block The block.
+   */
+  void _Enter(_Block *block);
+
+  /**
+   * @brief Moves to a block with room for an allocation, reusing the blocks
+   * after the current one before allocating a new one.
+   *
+   * @param bytes Number of bytes.
+   * @param alignment Alignment in bytes.
+   */
+  void _Advance(std::size_t bytes, std::size_t alignment);
+};
+
+/**
+ * @brief Allocator with free lists for power-of-two size classes.
+ *
+ * Requests up to _LARGEST bytes are rounded up to a size class and served
+ * from that class's free list, which is refilled a slab at a time. Larger
+ * requests go to the global heap. Freed chunks go back to their list and
+ * slabs are only returned on destruction.
+ */
+class CDS_Pool {
+public:
+  /**
+   * @brief Constructs an empty pool.
+   *
+   * @param slabSize Size in bytes of the slabs carved into chunks.
+   */
+  explicit CDS_Pool(std::size_t slabSize = 64 * 1024);
+
+  CDS_Pool(const CDS_Pool &) = delete;
+  CDS_Pool &operator=(const CDS_Pool &) = delete;
+
+  /**
+   * @brief Destructor.
+   *
+   * Returns all slabs to the global heap.
+   */
+  ~CDS_Pool();
+
+  /**
+   * @brief Allocates memory from the pool.
+   *
+   * @param bytes Number of bytes.
+   * @param alignment Alignment in bytes, a power of two.
+   * @return Pointer to the memory.
+   */
+  void *Allocate(std::size_t bytes,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * @brief Returns memory to the pool.
+   *
+   * @param pointer Pointer returned by Allocate.
+   * @param bytes Number of bytes passed to Allocate.
+   * @param alignment Alignment passed to Allocate.
+   */
+  void Deallocate(void *pointer, std::size_t bytes,
+                  std::size_t alignment = alignof(std::max_align_t));
+
+private:
+  static constexpr std::size_t _SMALLEST = 16; ///< Smallest size class
+  static constexpr std::size_t _CLASSES = 9;   ///< 16 bytes up to 4 KiB
+  static constexpr std::size_t _LARGEST = _SMALLEST << (_CLASSES - 1);
+
+  /**
+   * @brief A free chunk, linked through its first bytes.
+   */
+  struct _Chunk {
+    _Chunk *Next; ///< Next free chunk of the same class.
+  };
+
+  _Chunk *_Free[_CLASSES] = {}; ///< Free list of every size class
+  void *_Slabs = nullptr;       ///< Slabs, linked through their first bytes
+  std::size_t _SlabSize;        ///< Size of every slab
+
+  /**
+   * @brief Gets the size class of a request.
+   *
+   * @param bytes Number of bytes.
+   * @param alignment Alignment in bytes.
+   * @return Index of the class, _CLASSES if the request is too large.
+   */
+  static std::size_t _Class(std::size_t bytes, std::size_t alignment);
+
+  /**
+   * @brief Carves a new slab into chunks of one size class.
+   *
+   * @param index Index of the class.
+   */
+  void _Refill(std::size_t index);
+};
+
+/**
+ * @brief Standard allocator that draws from a CDS memory resource.
+ *
+ * Copies and rebound copies share the resource, which must outlive every
+ * container using it. Two allocators compare equal when they share it.
+ *
+ * @tparam T Type of the allocated objects.
+ * @tparam Resource CDS_Arena, CDS_Pool or another type with the same
+ * Allocate and Deallocate members.
+ */
+template <class T, class Resource> class CDS_Allocator {
+public:
+  using value_type = T;
+
+  /**
+   * @brief Constructs an allocator drawing from a resource.
+   *
+   * @param resource The resource.
+   */
+  CDS_Allocator(Resource &resource) noexcept;
+
+  /**
+   * @brief Rebinding constructor, shares the resource of the other
+   * allocator.
+   */
+  template <class U>
+  CDS_Allocator(const CDS_Allocator<U, Resource> &other) noexcept;
+
+  /**
+   * @brief Allocates memory for objects, without constructing them.
+   *
+   * @param count Number of objects.
+   * @return Pointer to the memory.
+   */
+  T *allocate(std::size_t count);
+
+  /**
+   * @brief Frees memory from allocate.
+   *
+   * @param pointer Pointer returned by allocate.
+   * @param count Number of objects passed to allocate.
+   */
+  void deallocate(T *pointer, std::size_t count) noexcept;
+
+  /**
+   * @brief Gets the resource the allocator draws from.
+   *
+   * @return The resource.
+   */
+  Resource &GetResource() const;
+
+  template <class U>
+  bool operator==(const CDS_Allocator<U, Resource> &other) const;
+
+private:
+  Resource *_Resource; ///< The shared resource
+};
+
+template <class T> using CDS_ArenaAllocator = CDS_Allocator<T, CDS_Arena>;
+template <class T> using CDS_PoolAllocator = CDS_Allocator<T, CDS_Pool>;
+
+#include "CDS_Allocator.ipp"
@@ -1,5 +1,11 @@
 #pragma once
+#include "CDS_Iterator.hpp"
+#include "CDS_Simd.hpp"
+#include <functional>
+#include <initializer_list>
 #include <iostream>
+#include <span>
+#include <type_traits>
 
 /**
  * @file CDS_Arr.h
@@ -15,15 +21,44 @@
  * element access, swapping elements, filling the array with values,
  * and outputting the array to an output stream.
  *
+ * Everything except the stream output is constexpr, so lookup tables can be
+ * built at compile time with Generate, Transform and Sort and stored in a
+ * static constexpr variable, which puts them in read-only data instead of
+ * computing them at startup.
+ *
  * @tparam T The type of elements stored in the array.
  * @tparam N The size of the array.
  */
 template <class T, int N> class CDS_Arr {
 public:
+  using value_type = T;
+  using iterator = CDS_Iterator<T>;
+  using const_iterator = CDS_Iterator<const T>;
+
+  /**
+   * @brief Constructs a CDS_Arr object with value-initialized elements.
+   */
+  constexpr CDS_Arr();
+
   /**
-   * @brief Constructs a CDS_Arr object.
+   * @brief Constructs a CDS_Arr object from a list of elements.
+   *
+   * Elements past the end of the list are value-initialized.
+   *
+   * @param elems The elements, at most N of them.
    */
-  CDS_Arr();
+  constexpr CDS_Arr(std::initializer_list<T> elems);
+
+  /**
+   * @brief Constructs a CDS_Arr object whose elements are computed from
+   * their index.
+   *
+   * @tparam Generator Type of the generator.
+   * @param generator Called with every index from 0 to N - 1.
+   * @return An array holding generator(i) at index i.
+   */
+  template <class Generator>
+  static constexpr CDS_Arr<T, N> Generate(Generator generator);
 
   /**
    * @brief Gets the size of the array.
@@ -37,14 +72,14 @@ public:
    *
    * @return A pointer to the array data.
    */
-  T *GetData();
+  constexpr T *GetData();
 
   /**
    * @brief Gets a constant pointer to the array data.
    *
    * @return A constant pointer to the array data.
    */
-  const T *GetData() const;
+  constexpr const T *GetData() const;
 
   /**
    * @brief Swaps two elements in the array.
@@ -52,13 +87,137 @@ public:
    * @param lhs The index of the first element to swap.
    * @param rhs The index of the second element to swap.
    */
-  void Swap(const size_t &lhs, const size_t &rhs);
+  constexpr void Swap(const size_t &lhs, const size_t &rhs);
 
   /**
    * @brief Fills the array with values of type T.
+   *
+   * Vectorized for arithmetic T when not evaluated at compile time.
+   *
    * @param elem The value of type T.
    */
-  void Fill(const T &elem);
+  constexpr void Fill(const T &elem);
+
+  /**
+   * @brief Sorts the array.
+   *
+   * @tparam Compare Type of the comparison.
+   * @param compare Strict weak ordering of the elements.
+   */
+  template <class Compare = std::less<>>
+  constexpr void Sort(Compare compare = Compare());
+
+  /**
+   * @brief Finds the first element equal to a value.
+   *
+   * @param elem The value to look for.
+   * @return The index of the element, N if there is none.
+   */
+  constexpr size_t Find(const T &elem) const;
+
+  /**
+   * @brief Binary searches a sorted array for the first element not
+   * ordered before a value.
+   *
+   * @tparam Compare Type of the comparison.
+   * @param elem The value to look for.
+   * @param compare The ordering the array is sorted by.
+   * @return The index of the element, N if every element is ordered before
+   * the value.
+   */
+  template <class Compare = std::less<>>
+  constexpr size_t LowerBound(const T &elem,
+                              Compare compare = Compare()) const;
+
+  /**
+   * @brief Applies a function to every element.
+   *
+   * @tparam Function Type of the function.
+   * @param function Called with every element in order.
+   * @return An array of the results, of the function's result type.
+   */
+  template <class Function>
+  constexpr CDS_Arr<std::invoke_result_t<Function &, const T &>, N>
+  Transform(Function function) const;
+
+  // Numeric bulk operations, for arithmetic T. Arrays of float and double
+  // run the kernels of CDS_Simd.hpp at runtime, and scalar loops in
+  // constant expressions.
+
+  /**
+   * @brief Adds another range element-wise to the array.
+   *
+   * @param other Elements to add, N of them.
+   */
+  constexpr void Add(std::span<const T> other)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Subtracts another range element-wise from the array.
+   *
+   * @param other Elements to subtract, N of them.
+   */
+  constexpr void Sub(std::span<const T> other)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Multiplies the array element-wise by another range.
+   *
+   * @param other Factors, N of them.
+   */
+  constexpr void Mul(std::span<const T> other)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Adds the element-wise product of two ranges to the array.
+   *
+   * @param lhs First factors, N of them.
+   * @param rhs Second factors, N of them.
+   */
+  constexpr void Fma(std::span<const T> lhs, std::span<const T> rhs)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Overwrites the array with a scaled copy of a range.
+   *
+   * @param source Elements to copy, N of them, may be the array itself.
+   * @param alpha Factor every element is multiplied by.
+   */
+  constexpr void AssignScaled(std::span<const T> source, const T &alpha)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Computes the dot product with another range.
+   *
+   * @param other The other range, N elements long.
+   * @return The sum of the element-wise products.
+   */
+  constexpr T Dot(std::span<const T> other) const
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Computes the sum of the elements.
+   *
+   * @return The sum.
+   */
+  constexpr T Sum() const
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Finds the smallest element.
+   *
+   * @return The smallest element.
+   */
+  constexpr T Min() const
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Finds the largest element.
+   *
+   * @return The largest element.
+   */
+  constexpr T Max() const
+    requires std::is_arithmetic_v<T>;
 
   /**
    * @brief Accesses an element in the array.
@@ -66,7 +225,7 @@ public:
    * @param index The index of the element to access.
    * @return A reference to the element at the specified index.
    */
-  T &operator[](const size_t index);
+  constexpr T &operator[](const size_t index);
 
   /**
    * @brief Accesses a constant element in the array.
@@ -74,7 +233,7 @@ public:
    * @param index The index of the element to access.
    * @return A constant reference to the element at the specified index.
    */
-  const T &operator[](const size_t index) const;
+  constexpr const T &operator[](const size_t index) const;
 
   /**
    * @brief Overloads the stream insertion operator to output the array.
@@ -89,9 +248,29 @@ public:
   friend std::ostream &operator<<(std::ostream &stream,
                                   const CDS_Arr<U, M> &array);
 
+  /**
+   * @brief Gets an iterator to the first element.
+   *
+   * The iterators are contiguous, so the array is a
+   * std::ranges::contiguous_range and converts to a std::span.
+   *
+   * @return An iterator to the first element.
+   */
+  constexpr iterator begin();
+  constexpr const_iterator begin() const;
+  constexpr const_iterator cbegin() const;
+
+  /**
+   * @brief Gets an iterator past the last element.
+   *
+   * @return An iterator past the last element.
+   */
+  constexpr iterator end();
+  constexpr const_iterator end() const;
+  constexpr const_iterator cend() const;
+
 private:
-  T _Arr[N];    /**< The fixed-size array. */
-  size_t _Size; /**< The size of the array. */
+  T _Arr[N]; /**< The fixed-size array. */
 };
 
 #include "CDS_Arr.ipp"
@@ -0,0 +1,329 @@
+#pragma once
+
+/**
+ * @file CDS_ConcurrentHashMap.hpp
+ * @brief Hash map split into independently locked shards.
+ *
+ * The top bits of a key's hash pick one of many shards, each an
+ * open-addressing table with the control bytes and group probing of
+ * CDS_HashMap and its own writer lock, so writers on different shards never
+ * wait for each other. Every shard also has a sequence counter, odd while a
+ * writer is inside it. When keys and values are trivially copyable, readers
+ * take no lock at all: they copy the value out, then retry if the sequence
+ * moved in the meantime (a seqlock). Readers of other types lock the shard.
+ */
+
+#include "CDS_HashMap.hpp"
+#include "CDS_Result.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+/**
+ * @brief Hash map safe for concurrent use from many threads.
+ *
+ * Every member may be called from any thread at any time, except the
+ * destructor. Get and Contains are lock-free for trivially copyable keys
+ * and values: they only wait while a writer is inside the same shard.
+ * Values are handed out as copies, since an entry may be changed or
+ * removed by another thread right after the lookup; use Update to modify a
+ * value in place.
+ *
+ * Tables are replaced when a shard grows. With lock-free readers the
+ * replaced tables are kept until the map is destroyed, because a reader may
+ * still be probing them; being half the size of their successor each, they
+ * add at most the size of the current tables.
+ *
+ * @tparam K Type of the keys.
+ * @tparam V Type of the values.
+ * @tparam Hash Hash function of the keys.
+ * @tparam Eq Equality of the keys.
+ */
+template <class K, class V, class Hash = std::hash<K>,
+          class Eq = std::equal_to<K>>
+class CDS_ConcurrentHashMap {
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using hasher = Hash;
+  using key_equal = Eq;
+
+  /**
+   * @brief Whether Get and Contains run without taking a lock.
+   */
+  static constexpr bool LockFreeReads =
+      std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>;
+
+  /**
+   * @brief Constructs an empty map, shard tables are allocated on the first
+   * insertion into them.
+   *
+   * @param shards Number of shards, rounded up to a power of two. A few
+   * times the number of writing threads keeps them from colliding.
+   * @param maxLoadFactor Fraction of the slots of a shard that may be in
+   * use, between 0 and 1.
+   * @param hash The hash function.
+   * @param equal The key equality.
+   */
+  explicit CDS_ConcurrentHashMap(std::size_t shards = 64,
+                                 float maxLoadFactor = 0.875f,
+                                 const Hash &hash = Hash(),
+                                 const Eq &equal = Eq());
+
+  CDS_ConcurrentHashMap(const CDS_ConcurrentHashMap &) = delete;
+  CDS_ConcurrentHashMap &operator=(const CDS_ConcurrentHashMap &) = delete;
+
+  /**
+   * @brief Destructor.
+   *
+   * Destroys the entries and frees every table.
+   */
+  ~CDS_ConcurrentHashMap();
+
+  // Getters
+
+  /**
+   * @brief Get the number of entries.
+   *
+   * @return The number of entries, which other threads may be changing.
+   */
+  std::size_t GetSize() const;
+
+  /**
+   * @brief Get the number of shards.
+   *
+   * @return The number of shards.
+   */
+  std::size_t GetShardCount() const;
+
+  /**
+   * @brief Get a copy of the value of a key.
+   *
+   * @param key The key to look up.
+   * @return The value, or an error if the key does not exist.
+   */
+  CDS_Result<V> Get(const K &key) const;
+
+  /**
+   * @brief Check whether a key exists.
+   *
+   * @param key The key to look up.
+   * @return true if the map holds the key.
+   */
+  bool Contains(const K &key) const;
+
+  // Modifiers
+
+  /**
+   * @brief Insert a new entry.
+   *
+   * @param key The key.
+   * @param value The value.
+   * @return A copy of the stored value, or an error if the key already
+   * exists, in which case the map is not changed.
+   */
+  CDS_Result<V> Insert(const K &key, V value);
+
+  /**
+   * @brief Insert an entry or overwrite the value of an existing key.
+   *
+   * @param key The key.
+   * @param value The value.
+   */
+  void Set(const K &key, V value);
+
+  /**
+   * @brief Modify the value of a key in place, atomically with respect to
+   * every other member.
+   *
+   * @tparam Function Type of the function.
+   * @param key The key.
+   * @param function Called with a reference to the value, under the lock of
+   * the shard, so it must not call back into the map.
+   * @return true if the key exists and the function was called.
+   */
+  template <class Function> bool Update(const K &key, Function function);
+
+  /**
+   * @brief Remove an entry.
+   *
+   * @param key The key to remove.
+   * @return The value the key had, or an error if the key does not exist.
+   */
+  CDS_Result<V> Delete(const K &key);
+
+  /**
+   * @brief Remove every entry, keeping the tables.
+   */
+  void Clear();
+
+  /**
+   * @brief Call a function on every entry, one locked shard at a time.
+   *
+   * Entries inserted or removed by other threads during the call may or may
+   * not be visited.
+   *
+   * @tparam Function Type of the function.
+   * @param function Called with the key and a reference to the value, must
+   * not call back into the map.
+   */
+  template <class Function> void ForEach(Function function);
+
+private:
+  /**
+   * @brief An entry of a table.
+   */
+  struct _Slot {
+    K Key;   ///< The key.
+    V Value; ///< The value.
+  };
+
+  /**
+   * @brief The slots of a shard. Capacity and pointers never change after
+   * the table is published, only the contents of the arrays.
+   */
+  struct _Table {
+    std::size_t Capacity; ///< Number of slots, a power of two
+    std::int8_t *Control; ///< Control bytes, then _GROUP clones
+    _Slot *Slots;         ///< Entries, constructed in full slots
+    _Table *Replaced;     ///< Table this one replaced, still readable
+  };
+
+  /**
+   * @brief One independently locked part of the map, alone on its cache
+   * lines.
+   */
+  struct alignas(64) _Shard {
+    std::atomic<std::uint64_t> Sequence{0}; ///< Odd while being written
+    std::atomic<_Table *> Table{nullptr};   ///< Current table
+    std::atomic<std::size_t> Size{0};       ///< Number of entries
+    std::size_t Deleted = 0;                ///< Number of deleted slots
+    std::mutex Mutex;                       ///< Serializes the writers
+  };
+
+  /**
+   * @brief Holds the lock of a shard and keeps its sequence odd.
+   */
+  class _Write {
+  public:
+    explicit _Write(_Shard &shard);
+    ~_Write();
+
+  private:
+    _Shard &_Target;                   ///< The shard being written
+    std::lock_guard<std::mutex> _Lock; ///< Its writer lock
+  };
+
+  std::unique_ptr<_Shard[]> _Shards;  ///< The shards
+  std::size_t _ShardBits;             ///< log2 of the number of shards
+  float _MaxLoadFactor;               ///< Fraction of slots that may be used
+  [[no_unique_address]] Hash _Hasher; ///< The hash function
+  [[no_unique_address]] Eq _Equal;    ///< The key equality
+
+  /**
+   * @brief Get the shard of a hash.
+   *
+   * @param hash The mixed hash of a key.
+   * @return The shard, picked by the top bits of the hash.
+   */
+  _Shard &ShardOf(std::size_t hash) const;
+
+  /**
+   * @brief Run a read of a shard. Lock-free reads are retried until no
+   * writer was inside the shard during the read, other reads hold the lock
+   * of the shard.
+   *
+   * @tparam Reader Type of the read.
+   * @param shard The shard.
+   * @param reader Called with the current table, may be called several
+   * times and then sees torn entries, which it must only copy.
+   * @return The result of the last call of the reader.
+   */
+  template <class Reader> auto Read(_Shard &shard, Reader reader) const;
+
+  /**
+   * @brief Find the slot holding a key.
+   *
+   * The probe visits every group at most once, so it also ends on a table
+   * a writer is changing.
+   *
+   * @param table The table, may be null.
+   * @param key The key.
+   * @param hash The mixed hash of the key.
+   * @return Pointer to the slot, null if the key does not exist.
+   */
+  _Slot *Lookup(const _Table *table, const K &key, std::size_t hash) const;
+
+  /**
+   * @brief Store an entry whose key does not exist yet, growing the table
+   * first if needed. The shard must be held by a _Write.
+   *
+   * @param shard The shard.
+   * @param hash The mixed hash of the key.
+   * @param key The key.
+   * @param value The value.
+   * @return A reference to the stored value.
+   */
+  V &Place(_Shard &shard, std::size_t hash, const K &key, V &&value);
+
+  /**
+   * @brief Move the entries of a shard into a new table, or reinsert them
+   * into the current one to drop its deleted slots. The shard must be held
+   * by a _Write.
+   *
+   * @param shard The shard.
+   * @param capacity Number of slots of the new table, the current capacity
+   * to rehash in place.
+   */
+  void Rehash(_Shard &shard, std::size_t capacity);
+
+  /**
+   * @brief Get the smallest table that holds a number of used slots.
+   *
+   * @param count Number of used slots.
+   * @return The number of slots.
+   */
+  std::size_t CapacityFor(std::size_t count) const;
+
+  /**
+   * @brief Allocate an empty table.
+   *
+   * @param capacity Number of slots, a power of two of at least _GROUP.
+   * @return The table.
+   */
+  static _Table *Allocate(std::size_t capacity);
+
+  /**
+   * @brief Set the control byte of a slot and its clone.
+   *
+   * @param table The table.
+   * @param index Index of the slot.
+   * @param control The new control byte.
+   */
+  static void SetControl(_Table *table, std::size_t index,
+                         std::int8_t control);
+
+  /**
+   * @brief Find the first free slot on the probe sequence of a hash.
+   *
+   * @param table The table.
+   * @param hash The mixed hash.
+   * @return Index of the slot.
+   */
+  static std::size_t Probe(const _Table *table, std::size_t hash);
+
+  /**
+   * @brief Destroy the entries of a table and free it.
+   *
+   * @param table The table.
+   * @param destroy Whether the table still holds constructed entries.
+   */
+  static void Free(_Table *table, bool destroy);
+};
+
+#include "CDS_ConcurrentHashMap.ipp"
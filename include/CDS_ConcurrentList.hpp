@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file CDS_ConcurrentList.hpp
+ * @brief Append-only list that many threads can append to at once.
+ *
+ * CDS_ConcurrentList stores its elements in segments whose sizes double, so
+ * growing never moves an element: a thread claims a slot with one atomic
+ * fetch-add, installs the segment holding it if it is still missing, and
+ * constructs its element there. No lock is taken and references to elements
+ * stay valid while other threads append. Freeze moves everything into a
+ * contiguous CDS_List once the producers are done.
+ */
+
+#include "CDS_List.hpp"
+#include "CDS_SegmentedList.hpp"
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Append-only list safe for concurrent Append and Emplace.
+ *
+ * Appends from any number of threads may run at the same time, as may
+ * reads of elements whose append happened before the read (the appending
+ * thread itself, or any thread synchronized with it, e.g. by joining it).
+ * GetSize counts claimed slots, which may include elements still being
+ * constructed by another thread.
+ *
+ * Freeze and the destructor require that no append is in flight. An
+ * element constructor that throws terminates the program, as a claimed slot
+ * cannot be handed back.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <class T> class CDS_ConcurrentList {
+public:
+  using value_type = T;
+
+  /**
+   * @brief Constructs an empty list, segments are allocated on demand.
+   */
+  CDS_ConcurrentList() = default;
+
+  CDS_ConcurrentList(const CDS_ConcurrentList &) = delete;
+  CDS_ConcurrentList &operator=(const CDS_ConcurrentList &) = delete;
+
+  /**
+   * @brief Destructor.
+   *
+   * Destroys the elements and frees the segments.
+   */
+  ~CDS_ConcurrentList();
+
+  /**
+   * @brief Gets the number of claimed slots.
+   *
+   * @return The number of elements appended or being appended.
+   */
+  std::size_t GetSize() const;
+
+  /**
+   * @brief Appends an element, safe to call from many threads.
+   *
+   * @param elem The element to append.
+   * @return A reference to the appended element, valid until Freeze.
+   */
+  const T &Append(const T &elem) noexcept;
+
+  /**
+   * @brief Appends a temporary element, safe to call from many threads.
+   *
+   * @param elem The temporary element to append.
+   * @return A reference to the appended element, valid until Freeze.
+   */
+  const T &Append(T &&elem) noexcept;
+
+  /**
+   * @brief Constructs and appends an element in place, safe to call from
+   * many threads.
+   *
+   * @tparam Args The types of the constructor arguments.
+   * @param args The constructor arguments.
+   * @return A reference to the new element, valid until Freeze.
+   */
+  template <class... Args> T &Emplace(Args &&...args) noexcept;
+
+  /**
+   * @brief Moves all elements into a contiguous list and empties this one.
+   *
+   * @return The elements, in slot order.
+   */
+  CDS_List<T> Freeze();
+
+  /**
+   * @brief Accesses an element by its index.
+   *
+   * @param index The index of the element, its append must have completed.
+   * @return A reference to the element.
+   */
+  T &operator[](const std::size_t index);
+  const T &operator[](const std::size_t index) const;
+
+private:
+  std::atomic<std::size_t> _Size{0};             ///< Claimed slots
+  std::atomic<T *> _Segments[_Segment::_COUNT]{}; ///< Element arrays
+
+  /**
+   * @brief Claims the next slot, installing its segment if needed.
+   *
+   * @return Pointer to the uninitialized slot.
+   */
+  T *Claim();
+
+  /**
+   * @brief Destroys all elements and frees the segments.
+   */
+  void Release();
+};
+
+#include "CDS_ConcurrentList.ipp"
@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file CDS_Eigen.hpp
+ * @brief Dense eigenvalue solvers used by CDS_Matrix.
+ *
+ * Symmetric matrices are reduced to tridiagonal form by Householder
+ * reflections, blocked so that half of the work is a rank-2k update on the
+ * parallel GEMM (LAPACK sytrd/latrd), and the tridiagonal problem is solved
+ * by the implicit QL algorithm. General matrices are reduced to upper
+ * Hessenberg form and solved by the Francis double-shift QR algorithm,
+ * followed by back substitution for the eigenvectors (EISPACK hqr2).
+ *
+ * Like the other factorizations, the solvers work on column-major buffers of
+ * real elements. Both iterations are capped at 30 sweeps per eigenvalue and
+ * report a failure instead of running on when a matrix does not converge.
+ */
+
+#include "CDS_Factor.hpp"
+#include "CDS_Result.hpp"
+#include <complex>
+#include <vector>
+
+namespace _Factor {
+
+/**
+ * @brief Eigenvalues and, optionally, eigenvectors of a square matrix.
+ *
+ * @tparam T Real type of the elements.
+ */
+template <class T> struct Spectrum {
+  std::vector<std::complex<T>> Values;  ///< Eigenvalues.
+  std::vector<std::complex<T>> Vectors; ///< Unit eigenvectors, column-major
+                                        ///< n x n, empty if not computed.
+};
+
+/**
+ * @brief Solves a symmetric eigenproblem.
+ *
+ * Only the lower triangle of the matrix is read. Eigenvalues are returned in
+ * ascending order, eigenvectors are orthonormal.
+ *
+ * @tparam T Real type of the elements.
+ * @param data Column-major n x n buffer, destroyed.
+ * @param n Order of the matrix.
+ * @param vectors Whether to compute the eigenvectors.
+ * @return The spectrum, or a failure if the matrix has non-finite elements
+ * or the iteration did not converge.
+ */
+template <class T>
+CDS_Result<Spectrum<T>> SymmetricEigen(std::vector<T> data, int n,
+                                       bool vectors);
+
+/**
+ * @brief Solves a general real eigenproblem.
+ *
+ * Complex eigenvalues come in conjugate pairs, the one with positive
+ * imaginary part first.
+ *
+ * @tparam T Real type of the elements.
+ * @param data Column-major n x n buffer, destroyed.
+ * @param n Order of the matrix.
+ * @param vectors Whether to compute the eigenvectors.
+ * @return The spectrum, or a failure if the matrix has non-finite elements
+ * or the iteration did not converge.
+ */
+template <class T>
+CDS_Result<Spectrum<T>> GeneralEigen(std::vector<T> data, int n,
+                                     bool vectors);
+
+} // namespace _Factor
+
+#include "CDS_Eigen.ipp"
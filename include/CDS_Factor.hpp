@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * @file CDS_Factor.hpp
+ * @brief Dense factorization engine used by CDS_Matrix.
+ *
+ * The engine works on column-major buffers and provides a blocked LU
+ * factorization with partial pivoting, a blocked Householder QR in compact WY
+ * form and a column-pivoted QR for rank decisions. The blocked routines do
+ * their O(n^3) work in trailing updates that run on the parallel GEMM from
+ * CDS_Gemm.hpp, only the narrow panels are factored column by column.
+ *
+ * The panel width can be tuned at compile time by defining CDS_FACTOR_NB
+ * before including this header.
+ */
+
+#include "CDS_Gemm.hpp"
+#include <complex>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#ifndef CDS_FACTOR_NB
+#define CDS_FACTOR_NB 64 ///< Columns per panel of the blocked factorizations.
+#endif
+
+namespace _Factor {
+
+/**
+ * @brief Element type the factorizations of a CDS_Matrix<T> are computed in.
+ *
+ * Integer matrices are factored in double precision.
+ */
+template <class T>
+using Scalar = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+/**
+ * @brief Real type underlying a real or complex element type.
+ */
+template <class T> struct _RealOf {
+  using type = T;
+};
+template <class T> struct _RealOf<std::complex<T>> {
+  using type = T;
+};
+template <class T> using Real = typename _RealOf<T>::type;
+
+/**
+ * @brief LU factorization P * A = L * U of a square matrix.
+ *
+ * L (unit diagonal, not stored) and U share one column-major buffer.
+ *
+ * @tparam T Type of the elements.
+ */
+template <class T> struct LU {
+  std::vector<T> Data;     ///< L below and U on and above the diagonal.
+  int Size = 0;            ///< Order of the matrix.
+  std::vector<int> Pivots; ///< Row i was swapped with row Pivots[i].
+  bool OddSwaps = false;   ///< Whether the permutation is odd.
+  bool Singular = false;   ///< Whether U has a negligible diagonal element.
+};
+
+/**
+ * @brief Householder QR factorization A = Q * R.
+ *
+ * R is stored on and above the diagonal, the Householder vectors (with an
+ * implicit unit leading element) below it, as in LAPACK's geqrf.
+ *
+ * @tparam T Type of the elements.
+ */
+template <class T> struct QR {
+  std::vector<T> Data; ///< R and the Householder vectors, column-major.
+  int Rows = 0;        ///< Number of rows of A.
+  int Cols = 0;        ///< Number of columns of A.
+  std::vector<T> Tau;  ///< Scale factors of the reflectors.
+};
+
+template <class T> struct Spectrum; // CDS_Eigen.hpp
+
+/**
+ * @brief Factorizations of one matrix, computed on demand and shared by all
+ * copies of the matrix until one of them is modified.
+ *
+ * @tparam T Type of the elements.
+ */
+template <class T> struct Cache {
+  std::mutex Mutex;                  ///< Guards lazy construction.
+  std::shared_ptr<const LU<T>> Lu;   ///< LU factorization, if computed.
+  std::shared_ptr<const QR<T>> Qr;   ///< QR factorization, if computed.
+  int Rank = -1;                     ///< Numerical rank, -1 if unknown.
+  /// Eigenvalues and possibly eigenvectors, if computed (CDS_Eigen.hpp).
+  std::shared_ptr<const Spectrum<Real<T>>> Eigen;
+};
+
+/**
+ * @brief Factors a square column-major matrix in place.
+ *
+ * @tparam T Type of the elements.
+ * @param data Column-major n x n buffer, overwritten by L and U.
+ * @param n Order of the matrix.
+ * @return The factorization, taking ownership of data.
+ */
+template <class T> LU<T> LuFactor(std::vector<T> data, int n);
+
+/**
+ * @brief Computes the determinant from an LU factorization.
+ *
+ * @tparam T Type of the elements.
+ * @param lu The factorization.
+ * @return det(A).
+ */
+template <class T> T LuDeterminant(const LU<T> &lu);
+
+/**
+ * @brief Computes the inverse from an LU factorization.
+ *
+ * @tparam T Type of the elements.
+ * @param lu The factorization, which must not be singular.
+ * @return Column-major n x n buffer holding A^-1.
+ */
+template <class T> std::vector<T> LuInverse(const LU<T> &lu);
+
+/**
+ * @brief Factors a column-major matrix by blocked Householder QR.
+ *
+ * @tparam T Type of the elements.
+ * @param data Column-major rows x cols buffer, overwritten by R and the
+ * reflectors.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @return The factorization, taking ownership of data.
+ */
+template <class T> QR<T> QrFactor(std::vector<T> data, int rows, int cols);
+
+/**
+ * @brief Forms the full orthogonal (unitary) factor Q of a QR factorization.
+ *
+ * @tparam T Type of the elements.
+ * @param qr The factorization.
+ * @return Column-major rows x rows buffer holding Q.
+ */
+template <class T> std::vector<T> QrFormQ(const QR<T> &qr);
+
+/**
+ * @brief Extracts the upper trapezoidal factor R of a QR factorization.
+ *
+ * @tparam T Type of the elements.
+ * @param qr The factorization.
+ * @return Column-major rows x cols buffer holding R.
+ */
+template <class T> std::vector<T> QrFormR(const QR<T> &qr);
+
+/**
+ * @brief Computes the numerical rank by QR with column pivoting.
+ *
+ * Diagonal elements of R below max(rows, cols) * epsilon * |R(0, 0)| are
+ * treated as zero.
+ *
+ * @tparam T Type of the elements.
+ * @param data Column-major rows x cols buffer, destroyed.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @return The rank.
+ */
+template <class T> int PivotedRank(std::vector<T> data, int rows, int cols);
+
+} // namespace _Factor
+
+#include "CDS_Factor.ipp"
@@ -0,0 +1,108 @@
+#pragma once
+
+/**
+ * @file CDS_File.hpp
+ * @brief Memory mapping of files, shared by the CDS on-disk formats.
+ *
+ * Read-only mappings back the formats that are written once and read in
+ * place, writable ones the formats that are changed in place.
+ */
+
+#include "CDS_Result.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace _File {
+
+/**
+ * @brief A read-only mapping of a whole file, unmapped on destruction.
+ */
+struct Mapping {
+  const void *Address = nullptr; ///< Start of the mapping.
+  std::size_t Length = 0;        ///< Length of the file in bytes.
+
+  Mapping() = default;
+  Mapping(const Mapping &) = delete;
+  Mapping &operator=(const Mapping &) = delete;
+  ~Mapping();
+};
+
+/**
+ * @brief Maps a file read-only and shared.
+ *
+ * @param path Path of the file.
+ * @return The mapping, or the reason it failed, which includes an empty
+ * file.
+ */
+CDS_Result<std::shared_ptr<const Mapping>> MapFile(const std::string &path);
+
+/**
+ * @brief A writable mapping of a whole file that stays open, so it can be
+ * grown and synced. The file is locked exclusively while it is open.
+ * Unmapped, unlocked and closed on destruction, and removed if it was
+ * created and never published.
+ */
+struct SharedMapping {
+  int Descriptor = -1;     ///< The open file.
+  void *Address = nullptr; ///< Start of the mapping, null while empty.
+  std::size_t Length = 0;  ///< Length of the file in bytes.
+  std::string Temporary;   ///< Path of a new file until it is published.
+
+  SharedMapping() = default;
+  SharedMapping(const SharedMapping &) = delete;
+  SharedMapping &operator=(const SharedMapping &) = delete;
+  ~SharedMapping();
+};
+
+/**
+ * @brief Opens a file for reading and writing and maps it shared.
+ *
+ * The file is locked with flock, so a second OpenShared of it, from any
+ * process, fails until the mapping is destroyed. If the file does not
+ * exist, an empty one is created under a temporary name next to it instead,
+ * and Temporary is set. Fill it, then call Publish to give it its name, so
+ * a crash never leaves a half-built file at the path.
+ *
+ * @param path Path of the file.
+ * @return The mapping, or the reason it failed.
+ */
+CDS_Result<std::unique_ptr<SharedMapping>>
+OpenShared(const std::string &path);
+
+/**
+ * @brief Gives a file created by OpenShared its name, once its contents are
+ * durable, and syncs the directory.
+ *
+ * Fails without replacing it if a file of that name appeared meanwhile.
+ *
+ * @param mapping The mapping of the new file.
+ * @param path The path passed to OpenShared.
+ * @return The path, or the reason it failed.
+ */
+CDS_Result<std::string> Publish(SharedMapping &mapping,
+                                const std::string &path);
+
+/**
+ * @brief Changes the length of a mapped file and maps it again, which may
+ * move it.
+ *
+ * @param mapping The mapping.
+ * @param length New length in bytes.
+ * @return The new length, or the reason it failed.
+ */
+CDS_Result<std::size_t> Resize(SharedMapping &mapping, std::size_t length);
+
+/**
+ * @brief Writes the changed pages of a range of a mapping to the disk and
+ * waits for them.
+ *
+ * @param mapping The mapping.
+ * @param offset Start of the range, rounded down to a page.
+ * @param length Length of the range in bytes.
+ * @return The number of bytes synced, or the reason it failed.
+ */
+CDS_Result<std::size_t> Sync(const SharedMapping &mapping, std::size_t offset,
+                             std::size_t length);
+
+} // namespace _File
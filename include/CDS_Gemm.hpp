@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * @file CDS_Gemm.hpp
+ * @brief General matrix multiply engine used by CDS_Matrix.
+ *
+ * The engine follows the classic Goto/BLIS structure: B is packed into
+ * KC x NC panels that stay in L3, A is packed into MC x KC blocks that stay
+ * in L2, and a register-tiled MR x NR micro-kernel streams through both. For
+ * float and double the micro-kernel is compiled for AVX-512, AVX2 with FMA
+ * and SSE2, and the level CDS_Simd selects at runtime picks the version, so
+ * a generic x86-64 build still runs the AVX kernels. Every other element
+ * type uses plain scalar code.
+ *
+ * The cache block sizes can be tuned at compile time by defining
+ * CDS_GEMM_MC, CDS_GEMM_KC and CDS_GEMM_NC before including this header.
+ */
+
+#include "CDS_MatrixView.hpp"
+#include "CDS_ThreadPool.hpp"
+
+#ifndef CDS_GEMM_MC
+#define CDS_GEMM_MC 144 ///< Rows of A packed per L2 block.
+#endif
+
+#ifndef CDS_GEMM_KC
+#define CDS_GEMM_KC 256 ///< Depth of the packed A and B panels.
+#endif
+
+#ifndef CDS_GEMM_NC
+#define CDS_GEMM_NC 4096 ///< Columns of B packed per L3 block.
+#endif
+
+#ifndef CDS_GEMM_SMALL
+#define CDS_GEMM_SMALL 32768 ///< m * n * k below which packing is skipped.
+#endif
+
+namespace _Gemm {
+
+/**
+ * @brief Computes C = alpha * A * B + beta * C.
+ *
+ * A is m x k, B is k x n and C is m x n. The operands may be any views,
+ * including transposed views and views with excluded rows or columns. When
+ * beta is zero, C is never read.
+ *
+ * @tparam T Type of the elements.
+ * @param alpha Scale factor of the product.
+ * @param a View of the left operand.
+ * @param b View of the right operand.
+ * @param beta Scale factor of the existing contents of C.
+ * @param c View of the output.
+ */
+template <class T>
+void Gemm(T alpha, CDS_MatrixView<const T> a, CDS_MatrixView<const T> b,
+          T beta, CDS_MatrixView<T> c);
+
+/**
+ * @brief Computes C = alpha * A * B + beta * C on the library thread pool.
+ *
+ * C is split into a grid of tiles whose rows are a multiple of the L2 block
+ * and whose columns are a multiple of the micro-tile width. Every tile runs
+ * the serial engine on its slice of A and B. Products below the serial
+ * cutoff of the pool run on the calling thread.
+ *
+ * @tparam T Type of the elements.
+ * @param alpha Scale factor of the product.
+ * @param a View of the left operand.
+ * @param b View of the right operand.
+ * @param beta Scale factor of the existing contents of C.
+ * @param c View of the output.
+ */
+template <class T>
+void ParallelGemm(T alpha, CDS_MatrixView<const T> a,
+                  CDS_MatrixView<const T> b, T beta, CDS_MatrixView<T> c);
+
+/**
+ * @brief Micro-kernel multiplying one packed A panel by one packed B panel.
+ */
+template <class T>
+using _Kernel = void (*)(int kc, const T *a, const T *b, T *tile);
+
+/**
+ * @brief Sizes the product can be split at without cutting a block.
+ */
+struct _Grain {
+  int Rows; ///< Rows of A packed per L2 block
+  int Cols; ///< Columns of the micro-tile
+};
+
+/**
+ * @brief Gets the sizes the product of T can be split at.
+ *
+ * @tparam T Type of the elements.
+ * @return The grain of the micro-kernel in use.
+ */
+template <class T> _Grain _GetGrain();
+
+template <> _Grain _GetGrain<float>();
+template <> _Grain _GetGrain<double>();
+
+/**
+ * @brief Runs the packed engine with the micro-kernel of the instruction set
+ * CDS_Simd selected. Defined in CDS_Gemm.cpp.
+ */
+void _Dispatch(float alpha, const CDS_MatrixView<const float> &a,
+               const CDS_MatrixView<const float> &b, float beta,
+               const CDS_MatrixView<float> &c);
+void _Dispatch(double alpha, const CDS_MatrixView<const double> &a,
+               const CDS_MatrixView<const double> &b, double beta,
+               const CDS_MatrixView<double> &c);
+
+} // namespace _Gemm
+
+#include "CDS_Gemm.ipp"
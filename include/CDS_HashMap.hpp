@@ -0,0 +1,478 @@
+#pragma once
+
+/**
+ * @file CDS_HashMap.hpp
+ * @brief Open-addressing hash map with a separate array of control bytes.
+ *
+ * Every slot has one control byte telling whether it is empty, deleted, or
+ * full, and for full slots 7 bits of the key's hash. Probing reads the
+ * compact control array and only compares a key when those bits match, so
+ * a lookup touches the slots themselves about once.
+ *
+ * The control bytes are scanned a group at a time, Swiss-table style: one
+ * compare of a group against the hash bits gives every candidate slot in
+ * it. Groups are 32 bytes with AVX2, 16 with SSE2 and 8 bytes of portable
+ * word arithmetic otherwise, chosen when the map is compiled.
+ */
+
+#include "CDS_Result.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace _Hash {
+
+/**
+ * @brief Control byte of a slot that was never used, ends a probe.
+ */
+constexpr std::int8_t _EMPTY = -128;
+
+/**
+ * @brief Control byte of a slot whose entry was deleted, a probe goes on
+ * past it.
+ */
+constexpr std::int8_t _DELETED = -2;
+
+/**
+ * @brief Number of control bytes scanned at once.
+ */
+#if defined(__AVX2__)
+constexpr std::size_t _GROUP = 32;
+#elif defined(__SSE2__)
+constexpr std::size_t _GROUP = 16;
+#else
+constexpr std::size_t _GROUP = 8;
+#endif
+
+/**
+ * @brief Number of slots of the first table, a group loaded at any slot
+ * then stays within the table and its cloned bytes.
+ */
+constexpr std::size_t _MIN_CAPACITY = _GROUP;
+
+/**
+ * @brief Spreads the bits of a hash, so hashes that only differ in their
+ * high bits, or identity hashes of integers, still land in different slots.
+ *
+ * @param hash The hash from the hash function.
+ * @return The mixed hash.
+ */
+constexpr std::size_t _Mix(std::size_t hash);
+
+/**
+ * @brief Gets the slot a probe starts at.
+ *
+ * @param hash The mixed hash.
+ * @return The hash without the bits kept in the control byte.
+ */
+constexpr std::size_t _H1(std::size_t hash);
+
+/**
+ * @brief Gets the bits of the hash kept in the control byte of a full slot.
+ *
+ * @param hash The mixed hash.
+ * @return The low 7 bits of the hash.
+ */
+constexpr std::int8_t _H2(std::size_t hash);
+
+/**
+ * @brief Whether a hash function and a key equality accept other types
+ * than the key type.
+ */
+template <class Hash, class Eq>
+concept _Transparent = requires {
+  typename Hash::is_transparent;
+  typename Eq::is_transparent;
+};
+
+/**
+ * @brief Set of slots of a group.
+ *
+ * SIMD groups use one bit per slot, the portable group the top bit of the
+ * slot's byte.
+ */
+struct _Mask {
+  std::uint64_t Bits; ///< The set bits.
+
+  /**
+   * @brief Checks whether any slot is in the set.
+   */
+  explicit operator bool() const;
+
+  /**
+   * @brief Gets the first slot of the set, which must not be empty.
+   *
+   * @return The offset of the slot in the group.
+   */
+  std::size_t Lowest() const;
+
+  /**
+   * @brief Removes the first slot from the set.
+   */
+  void Next();
+
+  /**
+   * @brief Counts the slots at the start of the group before the first one
+   * in the set.
+   *
+   * @return The count, _GROUP for an empty set.
+   */
+  std::size_t TrailingZeros() const;
+
+  /**
+   * @brief Counts the slots at the end of the group after the last one in
+   * the set.
+   *
+   * @return The count, _GROUP for an empty set.
+   */
+  std::size_t LeadingZeros() const;
+};
+
+/**
+ * @brief _GROUP consecutive control bytes, loaded at once.
+ */
+struct _Group {
+#if defined(__AVX2__)
+  __m256i Control; ///< The control bytes.
+#elif defined(__SSE2__)
+  __m128i Control; ///< The control bytes.
+#else
+  std::uint64_t Control; ///< The control bytes, little-endian.
+#endif
+
+  /**
+   * @brief Loads a group, the pointer needs no alignment.
+   *
+   * @param control Pointer to the first control byte.
+   */
+  explicit _Group(const std::int8_t *control);
+
+  /**
+   * @brief Finds the full slots whose hash bits equal a tag.
+   *
+   * The portable group may report a slot right after a match whose tag
+   * differs by one, the key comparison weeds it out.
+   *
+   * @param tag The hash bits from _H2.
+   * @return The slots.
+   */
+  _Mask Match(std::int8_t tag) const;
+
+  /**
+   * @brief Finds the empty slots.
+   *
+   * @return The slots.
+   */
+  _Mask MatchEmpty() const;
+
+  /**
+   * @brief Finds the empty and the deleted slots.
+   *
+   * @return The slots.
+   */
+  _Mask MatchFree() const;
+};
+
+} // namespace _Hash
+
+/**
+ * @brief Hash map with open addressing.
+ *
+ * Groups of slots are probed quadratically. The table has a power-of-two
+ * number of slots and doubles once the entries and the deleted slots would
+ * exceed the maximum load factor. Entries move when the table grows, so
+ * pointers from Find or Insert stay valid only until the next insertion.
+ *
+ * When Hash and Eq both define is_transparent, Get, Find, Contains and
+ * Delete also take any key type they accept, e.g. a std::string_view for
+ * std::string keys, without converting it to K first.
+ *
+ * @tparam K Type of the keys.
+ * @tparam V Type of the values.
+ * @tparam Hash Hash function of the keys.
+ * @tparam Eq Equality of the keys.
+ */
+template <class K, class V, class Hash = std::hash<K>,
+          class Eq = std::equal_to<K>>
+class CDS_HashMap {
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using hasher = Hash;
+  using key_equal = Eq;
+
+  /**
+   * @brief Constructs an empty map, nothing is allocated until the first
+   * insertion.
+   *
+   * @param maxLoadFactor Fraction of the slots that may be in use, between
+   * 0 and 1.
+   * @param hash The hash function.
+   * @param equal The key equality.
+   */
+  explicit CDS_HashMap(float maxLoadFactor = 0.875f,
+                       const Hash &hash = Hash(), const Eq &equal = Eq());
+
+  /**
+   * @brief Copy constructor.
+   */
+  CDS_HashMap(const CDS_HashMap &other);
+
+  /**
+   * @brief Move constructor, steals the table of the other map.
+   */
+  CDS_HashMap(CDS_HashMap &&other) noexcept;
+
+  /**
+   * @brief Copy and move assignment.
+   */
+  CDS_HashMap &operator=(CDS_HashMap other) noexcept;
+
+  /**
+   * @brief Destructor.
+   *
+   * Destroys the entries and frees the table.
+   */
+  ~CDS_HashMap();
+
+  // Getters
+
+  /**
+   * @brief Get the number of entries.
+   *
+   * @return The number of entries in the map.
+   */
+  std::size_t GetSize() const;
+
+  /**
+   * @brief Get the number of slots of the table.
+   *
+   * @return The capacity of the table.
+   */
+  std::size_t GetCapacity() const;
+
+  /**
+   * @brief Get the maximum load factor.
+   *
+   * @return The fraction of the slots that may be in use.
+   */
+  float GetMaxLoadFactor() const;
+
+  /**
+   * @brief Get a copy of the value of a key.
+   *
+   * @param key The key to look up.
+   * @return The value, or an error if the key does not exist.
+   */
+  CDS_Result<V> Get(const K &key) const;
+  template <class Q>
+    requires _Hash::_Transparent<Hash, Eq>
+  CDS_Result<V> Get(const Q &key) const;
+
+  /**
+   * @brief Find the value of a key without copying it.
+   *
+   * @param key The key to look up.
+   * @return Pointer to the value, null if the key does not exist.
+   */
+  V *Find(const K &key);
+  const V *Find(const K &key) const;
+  template <class Q>
+    requires _Hash::_Transparent<Hash, Eq>
+  V *Find(const Q &key);
+  template <class Q>
+    requires _Hash::_Transparent<Hash, Eq>
+  const V *Find(const Q &key) const;
+
+  /**
+   * @brief Check whether a key exists.
+   *
+   * @param key The key to look up.
+   * @return true if the map holds the key.
+   */
+  bool Contains(const K &key) const;
+  template <class Q>
+    requires _Hash::_Transparent<Hash, Eq>
+  bool Contains(const Q &key) const;
+
+  // Modifiers
+
+  /**
+   * @brief Insert a new entry.
+   *
+   * @param key The key.
+   * @param value The value.
+   * @return Pointer to the stored value, or an error if the key already
+   * exists, in which case the map is not changed.
+   */
+  CDS_Result<V *> Insert(const K &key, V value);
+
+  /**
+   * @brief Insert an entry or overwrite the value of an existing key.
+   *
+   * @param key The key.
+   * @param value The value.
+   * @return A reference to the stored value.
+   */
+  V &Set(const K &key, V value);
+
+  /**
+   * @brief Remove an entry.
+   *
+   * @param key The key to remove.
+   * @return The value the key had, or an error if the key does not exist.
+   */
+  CDS_Result<V> Delete(const K &key);
+  template <class Q>
+    requires _Hash::_Transparent<Hash, Eq>
+  CDS_Result<V> Delete(const Q &key);
+
+  /**
+   * @brief Remove every entry, keeping the table.
+   */
+  void Clear();
+
+  /**
+   * @brief Grow the table so that it holds a number of entries without
+   * growing again.
+   *
+   * @param count Number of entries.
+   */
+  void Reserve(std::size_t count);
+
+  /**
+   * @brief Set the maximum load factor, growing the table if it is now
+   * above it.
+   *
+   * @param maxLoadFactor Fraction of the slots that may be in use, between
+   * 0 and 1.
+   */
+  void SetMaxLoadFactor(float maxLoadFactor);
+
+  /**
+   * @brief Call a function on every entry, in table order.
+   *
+   * @tparam Function Type of the function.
+   * @param function Called with the key and a reference to the value.
+   */
+  template <class Function> void ForEach(Function function);
+  template <class Function> void ForEach(Function function) const;
+
+  /**
+   * @brief Swap the contents of two maps.
+   *
+   * @param other The other map.
+   */
+  void Swap(CDS_HashMap &other) noexcept;
+
+  // Operator Overloads
+
+  /**
+   * @brief Access the value of a key, inserting a value-initialized one if
+   * the key does not exist.
+   *
+   * @param key The key.
+   * @return A reference to the value.
+   */
+  V &operator[](const K &key);
+
+private:
+  /**
+   * @brief An entry of the table.
+   */
+  struct _Slot {
+    K Key;   ///< The key.
+    V Value; ///< The value.
+  };
+
+  std::int8_t *_Control = nullptr; ///< Control bytes, then _GROUP clones
+  _Slot *_Slots = nullptr;         ///< Entries, constructed in full slots
+  std::size_t _Capacity = 0;       ///< Number of slots, a power of two
+  std::size_t _Size = 0;           ///< Number of full slots
+  std::size_t _Deleted = 0;        ///< Number of deleted slots
+  float _MaxLoadFactor;            ///< Fraction of slots that may be used
+  [[no_unique_address]] Hash _Hasher; ///< The hash function
+  [[no_unique_address]] Eq _Equal;    ///< The key equality
+
+  /**
+   * @brief Find the slot holding a key.
+   *
+   * @tparam Q Type of the key, K or a type Eq compares with K.
+   * @param key The key.
+   * @param hash The mixed hash of the key.
+   * @return Index of the slot, _Capacity if the key does not exist.
+   */
+  template <class Q>
+  std::size_t Lookup(const Q &key, std::size_t hash) const;
+
+  /**
+   * @brief Remove the entry of a full slot.
+   *
+   * @param index Index of the slot.
+   * @return The value of the entry.
+   */
+  CDS_Result<V> Remove(std::size_t index);
+
+  /**
+   * @brief Store an entry whose key does not exist yet, growing the table
+   * first if needed.
+   *
+   * @param hash The mixed hash of the key.
+   * @param key The key.
+   * @param value The value.
+   * @return A reference to the stored value.
+   */
+  V &Place(std::size_t hash, const K &key, V &&value);
+
+  /**
+   * @brief Allocate an empty table.
+   *
+   * @param capacity Number of slots, a power of two of at least _GROUP.
+   */
+  void Allocate(std::size_t capacity);
+
+  /**
+   * @brief Set the control byte of a slot and its clone.
+   *
+   * @param index Index of the slot.
+   * @param control The new control byte.
+   */
+  void SetControl(std::size_t index, std::int8_t control);
+
+  /**
+   * @brief Find the first free slot on the probe sequence of a hash.
+   *
+   * @param hash The mixed hash.
+   * @return Index of the slot.
+   */
+  std::size_t Probe(std::size_t hash) const;
+
+  /**
+   * @brief Move every entry into a new table, dropping deleted slots.
+   *
+   * @param capacity Number of slots of the new table, a power of two.
+   */
+  void Rehash(std::size_t capacity);
+
+  /**
+   * @brief Get the smallest table that holds a number of used slots.
+   *
+   * @param count Number of used slots.
+   * @return The number of slots.
+   */
+  std::size_t CapacityFor(std::size_t count) const;
+
+  /**
+   * @brief Destroy the entries and free the table.
+   */
+  void Release();
+};
+
+#include "CDS_HashMap.ipp"
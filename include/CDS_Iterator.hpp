@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * @file CDS_Iterator.hpp
+ * @brief Contiguous iterator shared by the CDS containers.
+ *
+ * CDS_List and CDS_Arr keep their elements in one array, so both hand out
+ * CDS_Iterator. It models std::contiguous_iterator, which lets standard
+ * algorithms and std::ranges treat the containers as plain memory, and lets
+ * std::span view them directly.
+ */
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * @brief Random access iterator over a contiguous array.
+ *
+ * @tparam T Type of the elements, const-qualified for const iterators.
+ */
+template <class T> class CDS_Iterator {
+public:
+  using iterator_concept = std::contiguous_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::remove_cv_t<T>;
+  using element_type = T;
+  using pointer = T *;
+  using reference = T &;
+
+  /**
+   * @brief Constructs a null iterator.
+   */
+  constexpr CDS_Iterator() = default;
+
+  /**
+   * @brief Constructs an iterator pointing at an element.
+   *
+   * @param inPointer Pointer to the element.
+   */
+  constexpr CDS_Iterator(pointer inPointer);
+
+  /**
+   * @brief Converts a mutable iterator to a const one.
+   *
+   * @param other The mutable iterator.
+   */
+  template <class U>
+    requires std::is_same_v<const U, T>
+  constexpr CDS_Iterator(const CDS_Iterator<U> &other);
+
+  constexpr reference operator*() const;
+  constexpr pointer operator->() const;
+  constexpr reference operator[](difference_type offset) const;
+
+  constexpr CDS_Iterator &operator++();
+  constexpr CDS_Iterator operator++(int);
+  constexpr CDS_Iterator &operator--();
+  constexpr CDS_Iterator operator--(int);
+
+  constexpr CDS_Iterator &operator+=(difference_type offset);
+  constexpr CDS_Iterator &operator-=(difference_type offset);
+  constexpr CDS_Iterator operator+(difference_type offset) const;
+  constexpr CDS_Iterator operator-(difference_type offset) const;
+  constexpr difference_type operator-(const CDS_Iterator &other) const;
+
+  constexpr bool operator==(const CDS_Iterator &other) const;
+  constexpr std::strong_ordering operator<=>(const CDS_Iterator &other) const;
+
+private:
+  pointer _pointer = nullptr;
+};
+
+/**
+ * @brief Advances an iterator, with the offset on the left.
+ */
+template <class T>
+constexpr CDS_Iterator<T>
+operator+(typename CDS_Iterator<T>::difference_type offset,
+          const CDS_Iterator<T> &iterator);
+
+#include "CDS_Iterator.ipp"
@@ -8,15 +8,85 @@
  */
 
 #pragma once
+#include "CDS_Iterator.hpp"
+#include "CDS_Simd.hpp"
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <span>
+#include <type_traits>
 namespace _Init {
 
 /**
  * @brief Namespace for initialization constants.
  */
-constexpr const size_t _INITIAL = 1; ///< Initial capacity for the list.
+constexpr const size_t _INITIAL = 4; ///< Capacity of the first allocation.
+
+/**
+ * @brief Uninitialized, suitably aligned storage for N elements.
+ *
+ * Elements are constructed into it on demand, unlike a CDS_Arr whose
+ * elements all exist from construction on.
+ */
+template <class T, std::size_t N> struct _Inline {
+  alignas(T) unsigned char Bytes[N * sizeof(T)];
+
+  T *GetData() { return reinterpret_cast<T *>(this->Bytes); }
+  const T *GetData() const { return reinterpret_cast<const T *>(this->Bytes); }
+};
+
+/**
+ * @brief Empty storage for lists without inline elements.
+ */
+template <class T> struct _Inline<T, 0> {
+  T *GetData() { return nullptr; }
+  const T *GetData() const { return nullptr; }
+};
 } // namespace _Init
 
+/**
+ * @brief Trait telling CDS_List that T can be moved to a new address by
+ * copying its bytes, without running its move constructor and destructor.
+ *
+ * True for trivially copyable types. Specialize it for types that own
+ * resources but hold no pointers into themselves, e.g. a struct holding a
+ * std::unique_ptr. It must not be specialized for types such as libstdc++'s
+ * std::string, which points into its own small buffer.
+ *
+ * @tparam T The type of the elements.
+ */
+template <class T>
+struct CDS_TriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+/**
+ * @brief Growth policy of CDS_List.
+ *
+ * A full list grows its capacity by the factor Numerator / Denominator, and
+ * to at least Minimum elements on the first allocation.
+ *
+ * @tparam Numerator Numerator of the growth factor.
+ * @tparam Denominator Denominator of the growth factor.
+ * @tparam Minimum Capacity of the first allocation.
+ */
+template <std::size_t Numerator = 2, std::size_t Denominator = 1,
+          std::size_t Minimum = _Init::_INITIAL>
+struct CDS_ListGrowth {
+  static_assert(Numerator > Denominator, "Growth factor must exceed 1");
+  static_assert(Minimum > 0, "Minimum capacity must be positive");
+
+  /**
+   * @brief Gets the capacity following a full one.
+   *
+   * @param capacity The current capacity.
+   * @return The new capacity.
+   */
+  static constexpr std::size_t Next(std::size_t capacity) {
+    std::size_t step = capacity / Denominator * (Numerator - Denominator);
+    return std::max(capacity + std::max<std::size_t>(step, 1), Minimum);
+  }
+};
+
 /**
  * @brief Templated dynamic list class.
  *
@@ -24,43 +94,78 @@ constexpr const size_t _INITIAL = 1; ///< Initial capacity for the list.
  * operations such as adding, removing, and accessing elements. It automatically
  * reallocates memory when the capacity is exceeded.
  *
+ * All memory comes from the allocator, which may be a std::allocator or a
+ * CDS_ArenaAllocator / CDS_PoolAllocator from CDS_Allocator.hpp.
+ *
+ * With Inline > 0 the first Inline elements live inside the list object
+ * itself, so constructing the list and filling it up to that size never
+ * allocates. The elements move to the allocator once the list outgrows the
+ * inline storage. Moving such a list moves its inline elements one by one.
+ *
+ * Elements that are CDS_TriviallyRelocatable move between arrays with one
+ * memcpy. With the default std::allocator their array is kept by malloc
+ * and grown with realloc, which extends it in place when possible and
+ * remaps large arrays instead of copying them.
+ *
  * @tparam T The type of elements stored in the list.
+ * @tparam Allocator The allocator the element array is obtained from.
+ * @tparam Inline Number of elements stored inline before spilling.
+ * @tparam Growth Growth policy, see CDS_ListGrowth.
  */
-template <class T> class CDS_List {
+template <class T, class Allocator = std::allocator<T>, std::size_t Inline = 0,
+          class Growth = CDS_ListGrowth<>>
+class CDS_List {
 public:
-  class iterator {
+  using allocator_type = Allocator;
 
-  public:
-    using iterator_category = std::forward_iterator_tag;
-    using difference_type = std::ptrdiff_t;
-    using value_type = T;
-    using pointer = T *;
-    using reference = T &;
+  using value_type = T;
+  using iterator = CDS_Iterator<T>;
+  using const_iterator = CDS_Iterator<const T>;
 
-    iterator(pointer inPointer);
+  // Constructors and Destructor
 
-    reference operator*() const;
-    pointer operator->();
-    iterator &operator++();
-    iterator operator++(int);
-    iterator &operator--();
-    iterator operator--(int);
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes an empty list, nothing is allocated until the first
+   * element exceeds the inline capacity.
+   */
+  CDS_List();
 
-    bool operator==(const iterator &other) const;
-    bool operator!=(const iterator &other) const;
+  /**
+   * @brief Constructs an empty list drawing memory from an allocator.
+   *
+   * @param allocator The allocator to use.
+   */
+  explicit CDS_List(const Allocator &allocator);
 
-  private:
-    pointer _pointer;
-  };
+  /**
+   * @brief Copy constructor.
+   */
+  CDS_List(const CDS_List &other);
 
-  // Constructors and Destructor
+  /**
+   * @brief Move constructor.
+   *
+   * Steals the array of the other list, or moves its elements when they are
+   * stored inline. The other list is left empty.
+   */
+  CDS_List(CDS_List &&other) noexcept(Inline == 0 ||
+                                      std::is_nothrow_move_constructible_v<T>);
 
   /**
-   * @brief Default constructor.
+   * @brief Copy assignment.
+   */
+  CDS_List &operator=(const CDS_List &other);
+
+  /**
+   * @brief Move assignment.
    *
-   * Initializes the list with a default capacity.
+   * Steals the array of the other list when it is on the heap and the
+   * allocators compare equal, otherwise moves the elements. The other list
+   * is left empty.
    */
-  CDS_List();
+  CDS_List &operator=(CDS_List &&other);
 
   /**
    * @brief Destructor.
@@ -71,6 +176,13 @@ public:
 
   // Getters
 
+  /**
+   * @brief Get the allocator the list draws memory from.
+   *
+   * @return A copy of the allocator.
+   */
+  Allocator GetAllocator() const;
+
   /**
    * @brief Get a pointer to the internal data array.
    *
@@ -108,8 +220,29 @@ public:
    */
   const size_t GetCapacity() const;
 
+  /**
+   * @brief Check if the elements are stored in the inline buffer.
+   *
+   * @return true if the list has not spilled to the allocator.
+   */
+  bool IsInline() const;
+
   // Modifiers
 
+  /**
+   * @brief Make room for a number of elements without further reallocation.
+   *
+   * @param capacity The minimum capacity.
+   */
+  void Reserve(const size_t capacity);
+
+  /**
+   * @brief Reduce the capacity to the size of the list.
+   *
+   * Moves the elements back into the inline buffer when they fit.
+   */
+  void ShrinkToFit();
+
   /**
    * @brief Remove and return the last element from the list.
    *
@@ -151,10 +284,90 @@ public:
   /**
    * @brief Fill the list with the specified element.
    *
+   * Vectorized for arithmetic T.
+   *
    * @param elem The element to fill the list with.
    */
   void Fill(const T &elem);
 
+  // Numeric bulk operations, for arithmetic T. Lists of float and double
+  // run the kernels of CDS_Simd.hpp, picked at runtime for the CPU.
+
+  /**
+   * @brief Add another range element-wise to the list.
+   *
+   * @param other Elements to add, as many as the list has.
+   */
+  void Add(std::span<const T> other)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Subtract another range element-wise from the list.
+   *
+   * @param other Elements to subtract, as many as the list has.
+   */
+  void Sub(std::span<const T> other)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Multiply the list element-wise by another range.
+   *
+   * @param other Factors, as many as the list has elements.
+   */
+  void Mul(std::span<const T> other)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Add the element-wise product of two ranges to the list.
+   *
+   * @param lhs First factors, as many as the list has elements.
+   * @param rhs Second factors, as many as the list has elements.
+   */
+  void Fma(std::span<const T> lhs, std::span<const T> rhs)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Replace the contents with a scaled copy of a range.
+   *
+   * @param source Elements to copy, may be the list itself.
+   * @param alpha Factor every element is multiplied by.
+   */
+  void AssignScaled(std::span<const T> source, const T &alpha)
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Compute the dot product with another range.
+   *
+   * @param other The other range, as long as the list.
+   * @return The sum of the element-wise products.
+   */
+  T Dot(std::span<const T> other) const
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Compute the sum of the elements.
+   *
+   * @return The sum, zero for an empty list.
+   */
+  T Sum() const
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Find the smallest element of a non-empty list.
+   *
+   * @return The smallest element.
+   */
+  T Min() const
+    requires std::is_arithmetic_v<T>;
+
+  /**
+   * @brief Find the largest element of a non-empty list.
+   *
+   * @return The largest element.
+   */
+  T Max() const
+    requires std::is_arithmetic_v<T>;
+
   /**
    * @brief Swap two elements in the list by their indices.
    *
@@ -163,6 +376,24 @@ public:
    */
   void Swap(const size_t &lhs, const size_t &rhs);
 
+  /**
+   * @brief Append a range of elements with at most one reallocation.
+   *
+   * The range must not point into the list itself.
+   *
+   * @tparam InputIt The iterator type of the range.
+   * @param first The first element to append.
+   * @param last The end of the range.
+   */
+  template <class InputIt> void AppendRange(InputIt first, InputIt last);
+
+  /**
+   * @brief Append a span of elements with at most one reallocation.
+   *
+   * @param elems The elements to append, not from the list itself.
+   */
+  void AppendRange(std::span<const T> elems);
+
   /**
    * @brief Insert an element at a specified index.
    *
@@ -171,6 +402,37 @@ public:
    */
   void Insert(const size_t index, const T &elem);
 
+  /**
+   * @brief Insert a temporary element at a specified index.
+   *
+   * @param index The index at which to insert the element.
+   * @param elem The temporary element to insert.
+   */
+  void Insert(const size_t index, T &&elem);
+
+  /**
+   * @brief Insert a range of elements at a specified index with at most one
+   * reallocation.
+   *
+   * The range must not point into the list itself.
+   *
+   * @tparam InputIt The iterator type of the range.
+   * @param index The index at which to insert the first element.
+   * @param first The first element to insert.
+   * @param last The end of the range.
+   */
+  template <class InputIt>
+  void InsertRange(const size_t index, InputIt first, InputIt last);
+
+  /**
+   * @brief Insert a span of elements at a specified index with at most one
+   * reallocation.
+   *
+   * @param index The index at which to insert the first element.
+   * @param elems The elements to insert, not from the list itself.
+   */
+  void InsertRange(const size_t index, std::span<const T> elems);
+
   /**
    * @brief Remove an element at a specified index.
    *
@@ -178,6 +440,24 @@ public:
    */
   void Remove(const size_t index);
 
+  /**
+   * @brief Remove a run of consecutive elements.
+   *
+   * @param index The index of the first element to remove.
+   * @param count The number of elements to remove.
+   */
+  void RemoveRange(const size_t index, const size_t count);
+
+  /**
+   * @brief Remove all elements matching a predicate in a single pass,
+   * keeping the order of the others.
+   *
+   * @tparam Predicate Callable taking a const T& and returning bool.
+   * @param pred The predicate.
+   * @return The number of removed elements.
+   */
+  template <class Predicate> size_t RemoveIf(Predicate pred);
+
   /**
    * @brief Clear the list, removing all elements.
    */
@@ -207,18 +487,51 @@ public:
    * Allows printing the list to an output stream.
    *
    * @tparam U The type of elements in the list.
+   * @tparam A The allocator of the list.
+   * @tparam M The inline capacity of the list.
+   * @tparam G The growth policy of the list.
    * @param stream The output stream.
    * @param array The list to print.
    * @return A reference to the output stream.
    */
-  template <class U>
+  template <class U, class A, std::size_t M, class G>
   friend std::ostream &operator<<(std::ostream &stream,
-                                  const CDS_List<U> &array);
+                                  const CDS_List<U, A, M, G> &array);
 
-  iterator end();
+  /**
+   * @brief Get an iterator to the first element.
+   *
+   * The iterators are contiguous, so the list is a
+   * std::ranges::contiguous_range and converts to a std::span.
+   *
+   * @return An iterator to the first element.
+   */
   iterator begin();
+  const_iterator begin() const;
+  const_iterator cbegin() const;
+
+  /**
+   * @brief Get an iterator past the last element.
+   *
+   * @return An iterator past the last element.
+   */
+  iterator end();
+  const_iterator end() const;
+  const_iterator cend() const;
 
 private:
+  using _Traits = std::allocator_traits<Allocator>;
+
+  /**
+   * @brief Whether the heap array is managed with malloc and realloc.
+   */
+  static constexpr bool _Realloc =
+      std::is_same_v<Allocator, std::allocator<T>> &&
+      CDS_TriviallyRelocatable<T>::value &&
+      alignof(T) <= alignof(std::max_align_t);
+
+  [[no_unique_address]] Allocator _Allocator; ///< Source of the array.
+  [[no_unique_address]] _Init::_Inline<T, Inline> _Buffer; ///< Inline array.
   size_t _Size;       ///< The current number of elements in the list.
   size_t _Capacity;   ///< The maximum number of elements the list can hold.
   T *_List = nullptr; ///< Pointer to the dynamically allocated array.
@@ -257,9 +570,79 @@ private:
   /**
    * @brief Reallocate the internal data array to a new capacity.
    *
-   * @param mem The new capacity.
+   * @param mem The new capacity, at least the size.
    */
   void Reallocate(size_t mem);
+
+  /**
+   * @brief Grow the array following the growth policy.
+   *
+   * @param needed The minimum capacity after growing.
+   */
+  void Grow(const size_t needed);
+
+  /**
+   * @brief Allocate an uninitialized heap array.
+   *
+   * @param count Number of elements.
+   * @return Pointer to the array.
+   */
+  T *Allocate(const size_t count);
+
+  /**
+   * @brief Move elements to uninitialized memory, ending their lifetime at
+   * the source.
+   *
+   * @param from The elements to move.
+   * @param count Number of elements.
+   * @param to The destination.
+   */
+  void Relocate(T *from, const size_t count, T *to);
+
+  /**
+   * @brief Move the elements from an index on back to leave uninitialized
+   * slots, reallocating at most once. The size is left unchanged.
+   *
+   * @param index The index of the first slot.
+   * @param count The number of slots.
+   * @return Pointer to the first slot.
+   */
+  T *OpenGap(const size_t index, const size_t count);
+
+  /**
+   * @brief Copy construct elements from a range into uninitialized memory.
+   *
+   * @tparam InputIt The iterator type of the range.
+   * @param first The first element to copy.
+   * @param count The number of elements.
+   * @param to The destination.
+   */
+  template <class InputIt>
+  void CopyRange(InputIt first, const size_t count, T *to);
+
+  /**
+   * @brief Check if a pointer points at an element of the list.
+   *
+   * @param pointer The pointer.
+   * @return true if it points into the list.
+   */
+  bool Contains(const T *pointer) const;
+
+  /**
+   * @brief Free the array if it is on the heap and point the list back at
+   * its inline buffer, without touching any elements.
+   */
+  void Release();
 };
 
+/**
+ * @brief CDS_List storing its first N elements inline.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam N Number of elements stored inline.
+ * @tparam Allocator The allocator used once the list outgrows N elements.
+ */
+template <class T, std::size_t N, class Allocator = std::allocator<T>>
+using CDS_SmallList = CDS_List<T, Allocator, N>;
+
 #include "CDS_List.ipp"
@@ -10,6 +10,18 @@
  * decomposition.
  */
 
+#include "CDS_Eigen.hpp"
+#include "CDS_Factor.hpp"
+#include "CDS_Gemm.hpp"
+#include "CDS_MatrixExpr.hpp"
+#include "CDS_MatrixView.hpp"
+#include "CDS_Result.hpp"
+#include "CDS_ThreadPool.hpp"
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
 #include <tuple>
 #include <vector>
 
@@ -17,10 +29,35 @@
  * @brief A matrix class template that supports matrix operations,
  * transformations, and decompositions.
  *
+ * Elements live in a single 64-byte aligned buffer, stored either row by row
+ * or column by column. Rows, columns, diagonals and sub-matrices are handed
+ * out as non-owning views into that buffer.
+ *
+ * Sums, differences and scalings are lazy expressions (see
+ * CDS_MatrixExpr.hpp) that are fused into a single loop on assignment.
+ *
+ * Products, element-wise expressions, transposition and matrix-vector
+ * products are split into tiles and run on the CDS_ThreadPool once they are
+ * above its serial cutoff.
+ *
+ * Determinant, Inverse, IsInvertible, Rank, Nullity and Decompose are backed
+ * by the factorizations of CDS_Factor.hpp. A factorization is computed on the
+ * first query that needs it and cached, so later queries on the unmodified
+ * matrix reuse it. Any non-const member function drops the cache; writing
+ * through a view that was obtained before a query does not, so such views
+ * should not be written to after querying.
+ *
  * @tparam T Type of the elements in the matrix (e.g., float, double, int).
  */
 template <typename T> class CDS_Matrix {
 public:
+  using value_type = T;
+
+  /**
+   * @brief Complex type eigenvalues and eigenvectors are returned in.
+   */
+  using Complex = std::complex<_Factor::Real<_Factor::Scalar<T>>>;
+
   /**
    * @brief Enum for specifying the order of matrix decompositions.
    *
@@ -32,20 +69,97 @@ public:
     RQ  ///< RQ decomposition
   };
 
+  /**
+   * @brief Enum for specifying the storage order of the elements.
+   */
+  enum class Layout {
+    RowMajor, ///< Elements of a row are adjacent in memory
+    ColMajor  ///< Elements of a column are adjacent in memory
+  };
+
+  /**
+   * @brief Alignment of the element buffer in bytes.
+   */
+  static constexpr std::size_t Alignment = 64;
+
   /**
    * @brief Constructs a matrix with a given list of elements.
    *
+   * The elements are taken in row-major order. A perfect square number of
+   * elements gives a square matrix, any other count gives a column vector.
+   *
    * @param elements A list of elements to initialize the matrix.
    */
   CDS_Matrix(std::initializer_list<T> elements);
 
   /**
-   * @brief Constructs a matrix with a given number of rows and columns.
+   * @brief Constructs a zero matrix with a given number of rows and columns.
    *
    * @param rows Number of rows.
    * @param cols Number of columns.
+   * @param layout Storage order of the elements.
+   */
+  CDS_Matrix(int rows, int cols, Layout layout = Layout::RowMajor);
+
+  /**
+   * @brief Constructs a matrix by copying the elements of a view.
+   *
+   * @tparam U Element type of the view, possibly const-qualified T.
+   * @param view The view to copy from.
+   * @param layout Storage order of the elements.
+   */
+  template <class U>
+  CDS_Matrix(const CDS_MatrixView<U> &view, Layout layout = Layout::RowMajor);
+
+  /**
+   * @brief Constructs a matrix by evaluating an element-wise expression.
+   *
+   * The storage order is taken from the left-most operand.
+   *
+   * @tparam E Type of the expression.
+   * @param expr The expression to evaluate.
+   */
+  template <_Expr::Expression E> CDS_Matrix(const E &expr);
+
+  /**
+   * @brief Copy constructor.
+   */
+  CDS_Matrix(const CDS_Matrix<T> &other);
+
+  /**
+   * @brief Move constructor, steals the buffer of the other matrix.
+   */
+  CDS_Matrix(CDS_Matrix<T> &&other) noexcept;
+
+  /**
+   * @brief Copy assignment, reuses the buffer when the size matches.
+   */
+  CDS_Matrix<T> &operator=(const CDS_Matrix<T> &other);
+
+  /**
+   * @brief Move assignment, steals the buffer of the other matrix.
+   */
+  CDS_Matrix<T> &operator=(CDS_Matrix<T> &&other) noexcept;
+
+  /**
+   * @brief Evaluates an element-wise expression into this matrix.
+   *
+   * The buffer is reused when the shape matches. Each element of the result
+   * only depends on the same element of the operands, so an expression that
+   * refers to this matrix itself (e.g. `A = A + B`) is computed in place.
+   *
+   * @tparam E Type of the expression.
+   * @param expr The expression to evaluate.
+   * @return A reference to this matrix.
+   */
+  template <_Expr::Expression E> CDS_Matrix<T> &operator=(const E &expr);
+
+  /**
+   * @brief Destructor.
+   *
+   * Frees the element buffer.
    */
-  CDS_Matrix(int rows, int cols);
+  ~CDS_Matrix();
 
   /**
    * @brief Creates an identity matrix of size rows x cols.
@@ -76,6 +190,9 @@ public:
   /**
    * @brief Sets the degree of rotation for the matrix.
    *
+   * Resets the matrix to the identity and writes a rotation by the given
+   * angle in the plane of the first two axes (about the z axis in 3D).
+   *
    * @param degree Degree of rotation.
    */
   void SetDegree(float degree);
@@ -83,35 +200,14 @@ public:
   /**
    * @brief Performs matrix multiplication with another matrix.
    *
+   * The product runs on the blocked GEMM engine from CDS_Gemm.hpp. The result
+   * has the storage order of this matrix.
+   *
    * @param other The other matrix to multiply with.
    * @return Resulting matrix after multiplication.
    */
   CDS_Matrix<T> operator*(const CDS_Matrix<T> &other) const;
 
-  /**
-   * @brief Performs matrix addition with another matrix.
-   *
-   * @param other The other matrix to add.
-   * @return Resulting matrix after addition.
-   */
-  CDS_Matrix<T> operator+(const CDS_Matrix<T> &other) const;
-
-  /**
-   * @brief Performs matrix subtraction with another matrix.
-   *
-   * @param other The other matrix to subtract.
-   * @return Resulting matrix after subtraction.
-   */
-  CDS_Matrix<T> operator-(const CDS_Matrix<T> &other) const;
-
-  /**
-   * @brief Scales the matrix by a scalar.
-   *
-   * @param scalar Scalar value to multiply the matrix by.
-   * @return Resulting matrix after scaling.
-   */
-  friend CDS_Matrix<T> operator*(float scalar, const CDS_Matrix<T> &matrix);
-
   /**
    * @brief Multiplies the matrix with a vector.
    *
@@ -123,11 +219,21 @@ public:
   /**
    * @brief Reshapes the matrix to a new dimension.
    *
+   * Elements keep their row-major order. If the number of elements changes,
+   * the tail is truncated or padded with zeros.
+   *
    * @param newRows New number of rows.
    * @param newCols New number of columns.
    */
   void Reshape(int newRows, int newCols);
 
+  /**
+   * @brief Changes the storage order, reordering the buffer if needed.
+   *
+   * @param layout The new storage order.
+   */
+  void SetLayout(Layout layout);
+
   /**
    * @brief Sets a specific column with new values.
    *
@@ -148,40 +254,84 @@ public:
    * @brief Excludes specific columns from the matrix.
    *
    * @param colIndices Indices of the columns to exclude.
-   * @return Resulting matrix after excluding columns.
+   * @return View of the matrix without the excluded columns.
    */
-  CDS_Matrix<T> ExcludeColumns(std::initializer_list<int> colIndices);
+  CDS_MatrixView<T> ExcludeColumns(std::initializer_list<int> colIndices);
+  CDS_MatrixView<const T>
+  ExcludeColumns(std::initializer_list<int> colIndices) const;
 
   /**
    * @brief Excludes specific rows from the matrix.
    *
    * @param rowIndices Indices of the rows to exclude.
-   * @return Resulting matrix after excluding rows.
+   * @return View of the matrix without the excluded rows.
    */
-  CDS_Matrix<T> ExcludeRows(std::initializer_list<int> rowIndices);
+  CDS_MatrixView<T> ExcludeRows(std::initializer_list<int> rowIndices);
+  CDS_MatrixView<const T>
+  ExcludeRows(std::initializer_list<int> rowIndices) const;
 
   /**
    * @brief Gets the diagonal of the matrix.
    *
-   * @return A vector containing the diagonal elements.
+   * @return A strided view of the diagonal elements.
    */
-  std::vector<T> GetDiagonal() const;
+  CDS_VectorView<T> GetDiagonal();
+  CDS_VectorView<const T> GetDiagonal() const;
 
   /**
    * @brief Gets a specific column from the matrix.
    *
    * @param colIndex Index of the column to retrieve.
-   * @return A vector containing the elements of the column.
+   * @return A strided view of the elements of the column.
    */
-  std::vector<T> GetColumn(int colIndex) const;
+  CDS_VectorView<T> GetColumn(int colIndex);
+  CDS_VectorView<const T> GetColumn(int colIndex) const;
 
   /**
    * @brief Gets a specific row from the matrix.
    *
    * @param rowIndex Index of the row to retrieve.
-   * @return A vector containing the elements of the row.
+   * @return A strided view of the elements of the row.
+   */
+  CDS_VectorView<T> GetRow(int rowIndex);
+  CDS_VectorView<const T> GetRow(int rowIndex) const;
+
+  /**
+   * @brief Gets a view of the whole matrix.
+   *
+   * @return A strided view of all elements.
    */
-  std::vector<T> GetRow(int rowIndex) const;
+  CDS_MatrixView<T> View();
+  CDS_MatrixView<const T> View() const;
+
+  /**
+   * @brief Gets a pointer to the element buffer.
+   *
+   * @return A pointer to the first element in storage order.
+   */
+  T *GetData();
+  const T *GetData() const;
+
+  /**
+   * @brief Gets the storage order of the matrix.
+   *
+   * @return The layout of the element buffer.
+   */
+  Layout GetLayout() const;
+
+  /**
+   * @brief Gets the distance in elements between two consecutive rows.
+   *
+   * @return The row stride.
+   */
+  std::ptrdiff_t GetRowStride() const;
+
+  /**
+   * @brief Gets the distance in elements between two consecutive columns.
+   *
+   * @return The column stride.
+   */
+  std::ptrdiff_t GetColumnStride() const;
 
   /**
    * @brief Gets the shape of the matrix (rows, cols).
@@ -209,11 +359,15 @@ public:
 
   /**
    * @brief Computes the transpose of the matrix.
+   *
+   * The storage order of the matrix is kept.
    */
   void Transpose();
 
   /**
    * @brief Computes the inverse of the matrix.
+   *
+   * Uses the cached LU factorization. The matrix must be invertible.
    */
   void Inverse();
 
@@ -235,6 +389,9 @@ public:
   /**
    * @brief Computes the determinant of the matrix.
    *
+   * Uses the cached LU factorization. Integer matrices are factored in double
+   * precision and the result is rounded.
+   *
    * @return The determinant of the matrix.
    */
   T Determinant() const;
@@ -249,6 +406,8 @@ public:
   /**
    * @brief Computes the rank of the matrix.
    *
+   * The numerical rank is found by QR with column pivoting and is cached.
+   *
    * @return The rank of the matrix.
    */
   int Rank() const;
@@ -260,11 +419,23 @@ public:
    */
   int Nullity() const;
 
-  // Friend function for row access using subscript operator
-  std::vector<T> &operator[](CDS_Matrix<T> &matrix, int rowIndex);
+  /**
+   * @brief Accesses a row using the subscript operator.
+   *
+   * @param rowIndex Index of the row.
+   * @return A strided view of the row.
+   */
+  CDS_VectorView<T> operator[](int rowIndex);
+  CDS_VectorView<const T> operator[](int rowIndex) const;
 
-  // Friend function for element access using subscript operator
-  T &operator[](CDS_Matrix<T> &matrix, std::pair<int, int> indices);
+  /**
+   * @brief Accesses an element using the subscript operator.
+   *
+   * @param indices Row and column index of the element.
+   * @return A reference to the element.
+   */
+  T &operator[](std::pair<int, int> indices);
+  const T &operator[](std::pair<int, int> indices) const;
 
   // Declaration of is-Member functions
 
@@ -292,6 +463,9 @@ public:
   /**
    * @brief Checks if the matrix is invertible.
    *
+   * A matrix is treated as singular when a pivot of its cached LU
+   * factorization is negligible relative to its largest element.
+   *
    * @return true if the matrix is invertible, false otherwise.
    */
   bool IsInvertible() const;
@@ -343,27 +517,156 @@ public:
   /**
    * @brief Decomposes the matrix into a QR or RQ decomposition.
    *
+   * For an m x n matrix, QR returns Q (m x m, orthogonal or unitary) and R
+   * (m x n, upper trapezoidal). RQ returns R (m x n, zero below the diagonal
+   * that ends in the bottom-right corner) and Q (n x n). The QR factorization
+   * is cached.
+   *
    * @param order Decomposition order (QR or RQ).
-   * @return A pair of matrices representing the decomposition.
+   * @return The factors in the order of the decomposition, (Q, R) or (R, Q).
    */
-  std::pair<CDS_Matrix<T>, CDS_Matrix<T>> Decompose(Order order);
+  std::pair<CDS_Matrix<T>, CDS_Matrix<T>> Decompose(Order order) const;
 
   /**
    * @brief Computes the eigenvectors of the matrix.
    *
-   * @return A tuple containing the eigenvectors.
+   * Symmetric matrices (see IsSymmetric) take the tridiagonal QL path and
+   * get real orthonormal eigenvectors. Other matrices take the Hessenberg QR
+   * path and get unit eigenvectors. The eigen decomposition is cached, the
+   * eigenvalues come for free afterwards.
+   *
+   * @return Matrix whose column j is the eigenvector of Eigenvals()[j], or a
+   * failure if the matrix has non-finite elements or the iteration did not
+   * converge.
    */
-  std::tuple<std::vector<T>> Eigenvecs() const;
+  CDS_Result<CDS_Matrix<Complex>> Eigenvecs() const;
 
   /**
    * @brief Computes the eigenvalues of the matrix.
    *
-   * @return A tuple containing the eigenvalues.
+   * Eigenvalues of a symmetric matrix are real and sorted in ascending
+   * order. Complex eigenvalues of a general matrix come in conjugate pairs,
+   * the one with positive imaginary part first. Only real matrices are
+   * supported.
+   *
+   * @return Vector of the eigenvalues, or a failure if the matrix has
+   * non-finite elements or the iteration did not converge.
    */
-  std::tuple<T> Eigenvals() const;
+  CDS_Result<std::vector<Complex>> Eigenvals() const;
 
 private:
-  std::vector<std::vector<T>>
-      data;       ///< Matrix data stored as a vector of vectors
-  int rows, cols; ///< Number of rows and columns in the matrix
+  using _Scalar = _Factor::Scalar<T>;
+  using _Cache = _Factor::Cache<_Scalar>;
+
+  T *_Data = nullptr; ///< Aligned buffer holding all elements
+  int _Rows, _Cols;   ///< Number of rows and columns in the matrix
+  Layout _Layout;     ///< Storage order of the elements
+  mutable std::atomic<std::shared_ptr<_Cache>> _Factors; ///< Cached factors
+  mutable std::atomic<bool> _HasFactors{false}; ///< _Factors may be set
+
+  /**
+   * @brief Allocates an aligned buffer of value-initialized elements.
+   *
+   * @param count Number of elements.
+   * @return Pointer to the new buffer.
+   */
+  static T *_Allocate(std::size_t count);
+
+  /**
+   * @brief Destroys the elements of a buffer and frees it.
+   *
+   * @param data Pointer to the buffer.
+   * @param count Number of elements.
+   */
+  static void _Release(T *data, std::size_t count);
+
+  /**
+   * @brief Gets the number of elements in the matrix.
+   *
+   * @return rows * cols.
+   */
+  std::size_t _Count() const;
+
+  /**
+   * @brief Maps a row and column index to a buffer offset.
+   *
+   * @param row Row index.
+   * @param col Column index.
+   * @return Offset of the element in the buffer.
+   */
+  std::size_t _Index(int row, int col) const;
+
+  /**
+   * @brief Evaluates an expression of the same shape into the buffer.
+   *
+   * @tparam E Type of the expression.
+   * @param expr The expression to evaluate.
+   */
+  template <class E> void _Assign(const E &expr);
+
+  /**
+   * @brief Gets the factorization cache, creating it if needed.
+   *
+   * @return The cache shared by this matrix and its unmodified copies.
+   */
+  std::shared_ptr<_Cache> _GetCache() const;
+
+  /**
+   * @brief Replaces the factorization cache.
+   *
+   * @param factors The new cache, may be empty.
+   */
+  void _SetFactors(std::shared_ptr<_Cache> factors);
+
+  /**
+   * @brief Drops the cached factorizations before the matrix is modified.
+   *
+   * Element access calls it for every element, so it only touches the
+   * cache when one may exist.
+   */
+  void _Invalidate();
+
+  /**
+   * @brief Gets the LU factorization, computing it on first use.
+   *
+   * @return The cached factorization.
+   */
+  std::shared_ptr<const _Factor::LU<_Scalar>> _GetLU() const;
+
+  /**
+   * @brief Gets the QR factorization, computing it on first use.
+   *
+   * @return The cached factorization.
+   */
+  std::shared_ptr<const _Factor::QR<_Scalar>> _GetQR() const;
+
+  /**
+   * @brief Gets the eigen decomposition, computing it on first use.
+   *
+   * @param vectors Whether the eigenvectors are needed.
+   * @return The cached decomposition, or the failure of the solver.
+   */
+  CDS_Result<std::shared_ptr<const _Factor::Spectrum<_Factor::Real<_Scalar>>>>
+  _GetSpectrum(bool vectors) const;
+
+  /**
+   * @brief Copies the elements into a column-major buffer for factoring.
+   *
+   * @return The elements, converted to the factorization type.
+   */
+  std::vector<_Scalar> _ColumnMajor() const;
+
+  /**
+   * @brief Builds a matrix from a column-major factorization result.
+   *
+   * @param data Column-major elements.
+   * @param rows Number of rows.
+   * @param cols Number of columns.
+   * @param layout Storage order of the new matrix.
+   * @return The new matrix.
+   */
+  static CDS_Matrix<T> _FromColumnMajor(const std::vector<_Scalar> &data,
+                                        int rows, int cols, Layout layout);
 };
+
+#include "CDS_Matrix.ipp"
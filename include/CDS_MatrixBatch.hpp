@@ -0,0 +1,288 @@
+#pragma once
+
+/**
+ * @file CDS_MatrixBatch.hpp
+ * @brief Header file for the CDS_MatrixBatch class template.
+ *
+ * CDS_MatrixBatch holds many independent matrices of the same small shape
+ * and runs products, transposes, inverses and determinants on all of them in
+ * one call. Storage is structure-of-arrays: element (i, j) of every matrix
+ * sits in one contiguous plane, so the kernels loop over the batch in the
+ * innermost dimension and vectorize across matrices instead of within one.
+ */
+
+#include "CDS_Factor.hpp"
+#include "CDS_Matrix.hpp"
+#include "CDS_MatrixView.hpp"
+#include "CDS_ThreadPool.hpp"
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+namespace _Batch {
+
+/**
+ * @brief Number of matrices the kernels process together, their scratch
+ * planes stay in L1 for shapes up to about 8x8.
+ */
+constexpr int _LANES = 32;
+
+/**
+ * @brief Number of matrices per parallel task.
+ */
+constexpr int _TASK = 1024;
+
+/**
+ * @brief Runs Gauss-Jordan elimination with partial pivoting on a group of
+ * matrices at once.
+ *
+ * The scratch holds n rows of width columns per matrix, as planes of _LANES
+ * elements: element (i, j) of matrix b is work[(i * width + j) * _LANES + b].
+ * Each matrix picks its own pivots. Rows are reduced to the identity in the
+ * first n columns when eliminating above the diagonal too, otherwise only
+ * below it.
+ *
+ * @tparam S Type the elimination is computed in.
+ * @param work The scratch planes, modified.
+ * @param n Number of rows.
+ * @param width Number of columns, at least n.
+ * @param full Whether to also eliminate above the diagonal.
+ * @param det Receives the determinant of the leading n x n block of each
+ * of the _LANES matrices.
+ */
+template <class S>
+void _Eliminate(S *work, int n, int width, bool full, S *det);
+
+} // namespace _Batch
+
+/**
+ * @brief A batch of independent matrices of the same shape.
+ *
+ * Element (i, j) of all matrices is stored contiguously in a 64-byte aligned
+ * plane, planes follow each other row by row. A single matrix of the batch
+ * is handed out as a strided CDS_MatrixView, a single element position
+ * across the batch as a contiguous CDS_VectorView.
+ *
+ * Batched operations split the batch into tasks of _Batch::_TASK matrices
+ * that run on the CDS_ThreadPool once they are above its serial cutoff; set
+ * the pool to one thread to keep them on the calling thread.
+ *
+ * @tparam T Type of the elements (e.g., float, double, int).
+ */
+template <typename T> class CDS_MatrixBatch {
+public:
+  using value_type = T;
+
+  /**
+   * @brief Alignment of every element plane in bytes.
+   */
+  static constexpr std::size_t Alignment = 64;
+
+  /**
+   * @brief Constructs a batch of zero matrices.
+   *
+   * @param count Number of matrices.
+   * @param rows Number of rows of each matrix.
+   * @param cols Number of columns of each matrix.
+   */
+  CDS_MatrixBatch(int count, int rows, int cols);
+
+  /**
+   * @brief Constructs a batch from a list of matrices of the same shape.
+   *
+   * @param matrices The matrices to copy.
+   */
+  explicit CDS_MatrixBatch(const std::vector<CDS_Matrix<T>> &matrices);
+
+  /**
+   * @brief Copy constructor.
+   */
+  CDS_MatrixBatch(const CDS_MatrixBatch<T> &other);
+
+  /**
+   * @brief Move constructor, steals the buffer of the other batch.
+   */
+  CDS_MatrixBatch(CDS_MatrixBatch<T> &&other) noexcept;
+
+  /**
+   * @brief Copy assignment.
+   */
+  CDS_MatrixBatch<T> &operator=(const CDS_MatrixBatch<T> &other);
+
+  /**
+   * @brief Move assignment, steals the buffer of the other batch.
+   */
+  CDS_MatrixBatch<T> &operator=(CDS_MatrixBatch<T> &&other) noexcept;
+
+  /**
+   * @brief Destructor.
+   *
+   * Frees the element buffer.
+   */
+  ~CDS_MatrixBatch();
+
+  /**
+   * @brief Gets the number of matrices in the batch.
+   *
+   * @return The number of matrices.
+   */
+  int GetCount() const;
+
+  /**
+   * @brief Gets the shape of each matrix (rows, cols).
+   *
+   * @return A tuple containing the number of rows and columns.
+   */
+  std::tuple<int, int> GetShape() const;
+
+  /**
+   * @brief Gets the distance in elements between two element planes.
+   *
+   * @return The plane stride, the count rounded up to the alignment.
+   */
+  std::ptrdiff_t GetStride() const;
+
+  /**
+   * @brief Gets a pointer to the element buffer.
+   *
+   * @return A pointer to the plane of element (0, 0).
+   */
+  T *GetData();
+  const T *GetData() const;
+
+  /**
+   * @brief Accesses one matrix of the batch.
+   *
+   * @param index Index of the matrix.
+   * @return A strided view of the matrix.
+   */
+  CDS_MatrixView<T> operator[](int index);
+  CDS_MatrixView<const T> operator[](int index) const;
+
+  /**
+   * @brief Accesses one element position across the whole batch.
+   *
+   * @param row Row index of the element.
+   * @param col Column index of the element.
+   * @return A contiguous view of element (row, col) of every matrix.
+   */
+  CDS_VectorView<T> GetElement(int row, int col);
+  CDS_VectorView<const T> GetElement(int row, int col) const;
+
+  /**
+   * @brief Copies one matrix of the batch out.
+   *
+   * @param index Index of the matrix.
+   * @return The matrix.
+   */
+  CDS_Matrix<T> Get(int index) const;
+
+  /**
+   * @brief Overwrites one matrix of the batch.
+   *
+   * @param index Index of the matrix.
+   * @param matrix The new elements, of the shape of the batch.
+   */
+  void Set(int index, const CDS_Matrix<T> &matrix);
+
+  /**
+   * @brief Multiplies every matrix with the matrix of the same index in
+   * another batch.
+   *
+   * @param other The batch of right-hand operands.
+   * @return Batch of the products.
+   */
+  CDS_MatrixBatch<T> operator*(const CDS_MatrixBatch<T> &other) const;
+
+  /**
+   * @brief Transposes every matrix of the batch.
+   */
+  void Transpose();
+
+  /**
+   * @brief Inverts every matrix of the batch.
+   *
+   * Each matrix is inverted by Gauss-Jordan elimination with its own partial
+   * pivoting. Integer matrices are inverted in double precision. Singular
+   * matrices are left with non-finite elements, check Determinant first if
+   * the batch may contain them.
+   */
+  void Inverse();
+
+  /**
+   * @brief Computes the determinant of every matrix of the batch.
+   *
+   * Integer matrices are eliminated in double precision and the results are
+   * rounded.
+   *
+   * @return The determinants, in batch order.
+   */
+  std::vector<T> Determinant() const;
+
+  /**
+   * @brief Checks if the matrices are square (rows == cols).
+   *
+   * @return true if the matrices are square, false otherwise.
+   */
+  bool IsSquare() const;
+
+  /**
+   * @brief Checks if the batch can be multiplied by another batch.
+   *
+   * @param other The other batch to check multiplication compatibility.
+   * @return true if the counts match and the shapes can be multiplied.
+   */
+  bool IsMultipliable(const CDS_MatrixBatch<T> &other) const;
+
+private:
+  using _Scalar = _Factor::Scalar<T>;
+
+  T *_Data = nullptr;  ///< Aligned buffer holding all element planes
+  int _Count;          ///< Number of matrices
+  int _Rows, _Cols;    ///< Shape of every matrix
+  std::size_t _Stride; ///< Elements per plane, _Count rounded up
+
+  /**
+   * @brief Allocates an aligned buffer of value-initialized elements.
+   *
+   * @param count Number of elements.
+   * @return Pointer to the new buffer.
+   */
+  static T *_Allocate(std::size_t count);
+
+  /**
+   * @brief Destroys the elements of a buffer and frees it.
+   *
+   * @param data Pointer to the buffer.
+   * @param count Number of elements.
+   */
+  static void _Release(T *data, std::size_t count);
+
+  /**
+   * @brief Gets the number of elements in the buffer.
+   *
+   * @return rows * cols * stride.
+   */
+  std::size_t _Size() const;
+
+  /**
+   * @brief Gets the plane of an element position.
+   *
+   * @param row Row index.
+   * @param col Column index.
+   * @return Pointer to element (row, col) of matrix 0.
+   */
+  T *_Plane(int row, int col) const;
+
+  /**
+   * @brief Runs body(begin, end) over the batch in tasks of _Batch::_TASK
+   * matrices.
+   *
+   * @tparam F Type of the task body.
+   * @param work Total amount of work, compared against the serial cutoff.
+   * @param body The task body.
+   */
+  template <class F> void _ForTasks(std::size_t work, F &&body) const;
+};
+
+#include "CDS_MatrixBatch.ipp"
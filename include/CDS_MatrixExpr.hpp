@@ -0,0 +1,228 @@
+#pragma once
+
+/**
+ * @file CDS_MatrixExpr.hpp
+ * @brief Lazy element-wise expressions over CDS_Matrix.
+ *
+ * Sums, differences and scalings of matrices do not compute anything when
+ * they are written. They build a small tree of expression nodes instead,
+ * and the whole tree is evaluated in a single pass over memory when it is
+ * assigned to a CDS_Matrix. An expression such as `A + B - 4 * C` therefore
+ * allocates at most the result and never any intermediate.
+ *
+ * Named matrices are held by reference, temporaries (for instance the
+ * result of a matrix product) are moved into the expression, so storing an
+ * expression in an `auto` variable is safe as long as the named operands
+ * outlive it.
+ */
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+template <typename T> class CDS_Matrix;
+
+namespace _Expr {
+
+/**
+ * @brief Tag base of all expression nodes.
+ */
+struct _Node {};
+
+/**
+ * @brief Checks if a type is a CDS_Matrix.
+ */
+template <class X> struct _IsMatrix : std::false_type {};
+template <class T> struct _IsMatrix<CDS_Matrix<T>> : std::true_type {};
+
+/**
+ * @brief A type that can take part in an element-wise expression.
+ */
+template <class X>
+concept Operand = std::is_base_of_v<_Node, std::remove_cvref_t<X>> ||
+                  _IsMatrix<std::remove_cvref_t<X>>::value;
+
+/**
+ * @brief An expression node, anything that is an operand but not a matrix.
+ */
+template <class X>
+concept Expression = std::is_base_of_v<_Node, std::remove_cvref_t<X>>;
+
+/**
+ * @brief Leaf referring to a named matrix.
+ *
+ * @tparam T Type of the elements.
+ */
+template <class T> class _MatrixRef : public _Node {
+public:
+  using value_type = T;
+
+  explicit _MatrixRef(const CDS_Matrix<T> &matrix);
+
+  int Rows() const;
+  int Cols() const;
+  typename CDS_Matrix<T>::Layout GetLayout() const;
+  T At(int row, int col) const;
+  T Linear(std::size_t index) const;
+  bool IsUniform(typename CDS_Matrix<T>::Layout layout) const;
+  bool Aliases(const T *data) const;
+
+private:
+  const CDS_Matrix<T> *_Matrix; ///< The referenced matrix.
+};
+
+/**
+ * @brief Leaf owning a temporary matrix that was moved into the expression.
+ *
+ * @tparam T Type of the elements.
+ */
+template <class T> class _MatrixOwn : public _Node {
+public:
+  using value_type = T;
+
+  explicit _MatrixOwn(CDS_Matrix<T> &&matrix);
+
+  int Rows() const;
+  int Cols() const;
+  typename CDS_Matrix<T>::Layout GetLayout() const;
+  T At(int row, int col) const;
+  T Linear(std::size_t index) const;
+  bool IsUniform(typename CDS_Matrix<T>::Layout layout) const;
+  bool Aliases(const T *data) const;
+
+private:
+  CDS_Matrix<T> _Matrix; ///< The owned matrix.
+};
+
+/**
+ * @brief Node applying a binary operation element by element.
+ *
+ * @tparam L Type of the left operand node.
+ * @tparam R Type of the right operand node.
+ * @tparam Op Type of the element operation.
+ */
+template <class L, class R, class Op> class _Binary : public _Node {
+public:
+  using value_type = typename L::value_type;
+
+  _Binary(L lhs, R rhs);
+
+  int Rows() const;
+  int Cols() const;
+  typename CDS_Matrix<value_type>::Layout GetLayout() const;
+  value_type At(int row, int col) const;
+  value_type Linear(std::size_t index) const;
+  bool IsUniform(typename CDS_Matrix<value_type>::Layout layout) const;
+  bool Aliases(const value_type *data) const;
+
+private:
+  L _Lhs; ///< Left operand.
+  R _Rhs; ///< Right operand.
+};
+
+/**
+ * @brief Node multiplying every element by a scalar.
+ *
+ * @tparam E Type of the operand node.
+ */
+template <class E> class _Scaled : public _Node {
+public:
+  using value_type = typename E::value_type;
+
+  _Scaled(value_type scalar, E expr);
+
+  int Rows() const;
+  int Cols() const;
+  typename CDS_Matrix<value_type>::Layout GetLayout() const;
+  value_type At(int row, int col) const;
+  value_type Linear(std::size_t index) const;
+  bool IsUniform(typename CDS_Matrix<value_type>::Layout layout) const;
+  bool Aliases(const value_type *data) const;
+
+private:
+  value_type _Scalar; ///< The scale factor.
+  E _Expr;            ///< The operand.
+};
+
+/**
+ * @brief Element operation of a sum.
+ */
+struct _Plus {
+  template <class T> T operator()(const T &lhs, const T &rhs) const {
+    return lhs + rhs;
+  }
+};
+
+/**
+ * @brief Element operation of a difference.
+ */
+struct _Minus {
+  template <class T> T operator()(const T &lhs, const T &rhs) const {
+    return lhs - rhs;
+  }
+};
+
+/**
+ * @brief Node type an operand is stored as inside an expression.
+ *
+ * Named matrices become references, temporary matrices are moved in and
+ * nodes are stored by value.
+ */
+template <class X> struct _Stored {
+  using type = std::remove_cvref_t<X>;
+};
+template <class T> struct _Stored<CDS_Matrix<T> &> {
+  using type = _MatrixRef<T>;
+};
+template <class T> struct _Stored<const CDS_Matrix<T> &> {
+  using type = _MatrixRef<T>;
+};
+template <class T> struct _Stored<CDS_Matrix<T>> {
+  using type = _MatrixOwn<T>;
+};
+template <class T> struct _Stored<CDS_Matrix<T> &&> {
+  using type = _MatrixOwn<T>;
+};
+
+/**
+ * @brief Wraps an operand into the node type it is stored as.
+ *
+ * @param operand A matrix or an expression node.
+ * @return The stored node.
+ */
+template <class X> typename _Stored<X>::type _Store(X &&operand);
+
+} // namespace _Expr
+
+/**
+ * @brief Performs element-wise addition of two matrices or expressions.
+ *
+ * @param lhs The left operand.
+ * @param rhs The right operand, same shape as lhs.
+ * @return A lazy expression, evaluated when assigned to a CDS_Matrix.
+ */
+template <_Expr::Operand L, _Expr::Operand R>
+auto operator+(L &&lhs, R &&rhs);
+
+/**
+ * @brief Performs element-wise subtraction of two matrices or expressions.
+ *
+ * @param lhs The left operand.
+ * @param rhs The right operand, same shape as lhs.
+ * @return A lazy expression, evaluated when assigned to a CDS_Matrix.
+ */
+template <_Expr::Operand L, _Expr::Operand R>
+auto operator-(L &&lhs, R &&rhs);
+
+/**
+ * @brief Scales a matrix or expression by a scalar.
+ *
+ * @param scalar Scalar value to multiply the operand by.
+ * @param operand The matrix or expression to scale.
+ * @return A lazy expression, evaluated when assigned to a CDS_Matrix.
+ */
+template <_Expr::Operand E>
+auto operator*(typename _Expr::_Stored<E>::type::value_type scalar,
+               E &&operand);
+
+#include "CDS_MatrixExpr.ipp"
@@ -0,0 +1,259 @@
+#pragma once
+
+/**
+ * @file CDS_MatrixFile.hpp
+ * @brief Binary on-disk format for CDS_Matrix.
+ *
+ * A matrix file is a 64-byte header followed by the elements in storage
+ * order, starting at an offset that is a multiple of CDS_Matrix::Alignment:
+ *
+ *   offset  size  field
+ *        0     8  magic "CDSMATX\0"
+ *        8     4  format version
+ *       12     4  element type (_File::DType)
+ *       16     4  element size in bytes
+ *       20     4  layout (0 row-major, 1 column-major)
+ *       24     4  alignment of the element data
+ *       28     4  byte order mark 0x01020304, as written by the host
+ *       32     8  number of rows
+ *       40     8  number of columns
+ *       48     8  offset of the element data
+ *       56     8  reserved, zero
+ *
+ * CDS_MatrixWriter streams a file out block by block. CDS_MappedMatrix maps a
+ * file read-only and hands the elements out as a view straight into the
+ * page cache, without parsing or copying them, so processes mapping the same
+ * file share its pages.
+ */
+
+#include "CDS_File.hpp"
+#include "CDS_Matrix.hpp"
+#include "CDS_MatrixView.hpp"
+#include "CDS_Result.hpp"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace _File {
+
+/**
+ * @brief Element type tag stored in the header.
+ */
+enum class DType : std::uint32_t {
+  Other = 0, ///< Any other trivially copyable type, matched by size only
+  Int8,
+  UInt8,
+  Int16,
+  UInt16,
+  Int32,
+  UInt32,
+  Int64,
+  UInt64,
+  Float32,
+  Float64,
+  Complex64,  ///< std::complex<float>
+  Complex128, ///< std::complex<double>
+};
+
+/**
+ * @brief Gets the type tag of an element type.
+ *
+ * @tparam T Type of the elements.
+ * @return The tag, DType::Other for types without one.
+ */
+template <class T> constexpr DType DTypeOf();
+
+/**
+ * @brief The file header, see the table in the file comment.
+ */
+struct Header {
+  char Magic[8];
+  std::uint32_t Version;
+  std::uint32_t Type;
+  std::uint32_t ElementSize;
+  std::uint32_t Layout;
+  std::uint32_t Alignment;
+  std::uint32_t ByteOrder;
+  std::uint64_t Rows;
+  std::uint64_t Cols;
+  std::uint64_t DataOffset;
+  std::uint64_t Reserved;
+};
+static_assert(sizeof(Header) == 64, "Header must be exactly 64 bytes");
+
+constexpr char MAGIC[8] = {'C', 'D', 'S', 'M', 'A', 'T', 'X', '\0'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t ORDER_MARK = 0x01020304;
+
+/**
+ * @brief Checks that a mapped file holds a matrix of the expected type.
+ *
+ * @param mapping The mapped file.
+ * @param type Expected type tag.
+ * @param elementSize Expected element size in bytes.
+ * @return The header, or the reason the file does not match.
+ */
+CDS_Result<Header> ReadHeader(const Mapping &mapping, DType type,
+                              std::size_t elementSize);
+
+/**
+ * @brief Builds the header of a matrix file.
+ *
+ * @param type Type tag of the elements.
+ * @param elementSize Size of an element in bytes.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param colMajor Whether the elements are stored column by column.
+ * @return The header.
+ */
+Header MakeHeader(DType type, std::size_t elementSize, int rows, int cols,
+                  bool colMajor);
+
+} // namespace _File
+
+/**
+ * @brief A matrix file mapped into memory.
+ *
+ * The elements are read in place from the mapping. Copies share the mapping,
+ * which is released with the last copy, so views taken from View() must not
+ * outlive every copy. Construct a CDS_Matrix from View() to get a modifiable
+ * copy.
+ *
+ * @tparam T Type of the elements, must be trivially copyable.
+ */
+template <typename T> class CDS_MappedMatrix {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Mapped elements must be trivially copyable");
+
+public:
+  using value_type = T;
+  using Layout = typename CDS_Matrix<T>::Layout;
+
+  /**
+   * @brief Maps a matrix file.
+   *
+   * Fails if the file cannot be mapped, is not a matrix file, was written on
+   * a host with a different byte order, holds another element type, or is
+   * shorter than its header says.
+   *
+   * @param path Path of the file.
+   * @return The mapped matrix, or the reason it could not be mapped.
+   */
+  static CDS_Result<CDS_MappedMatrix<T>> Open(const std::string &path);
+
+  /**
+   * @brief Gets a read-only view of the whole matrix.
+   *
+   * @return A strided view of all elements.
+   */
+  CDS_MatrixView<const T> View() const;
+
+  /**
+   * @brief Gets a pointer to the mapped elements.
+   *
+   * @return A pointer to the first element in storage order.
+   */
+  const T *GetData() const;
+
+  /**
+   * @brief Gets the storage order of the elements in the file.
+   *
+   * @return The layout of the elements.
+   */
+  Layout GetLayout() const;
+
+  /**
+   * @brief Gets the shape of the matrix (rows, cols).
+   *
+   * @return A tuple containing the number of rows and columns.
+   */
+  std::tuple<int, int> GetShape() const;
+
+private:
+  std::shared_ptr<const _File::Mapping> _Mapping; ///< The mapped file
+  const T *_Data;                                 ///< First element
+  int _Rows, _Cols;                               ///< Shape of the matrix
+  Layout _Layout;                                 ///< Storage order
+
+  CDS_MappedMatrix(std::shared_ptr<const _File::Mapping> mapping,
+                   const _File::Header &header);
+};
+
+/**
+ * @brief Streams a matrix file to disk.
+ *
+ * The header is written up front from the declared shape, so the elements
+ * can be produced in blocks without ever holding the whole matrix in
+ * memory. Elements are appended in the declared storage order.
+ *
+ * @tparam T Type of the elements, must be trivially copyable.
+ */
+template <typename T> class CDS_MatrixWriter {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Written elements must be trivially copyable");
+
+public:
+  using Layout = typename CDS_Matrix<T>::Layout;
+
+  /**
+   * @brief Creates the file and writes its header.
+   *
+   * @param path Path of the file, overwritten if it exists.
+   * @param rows Number of rows.
+   * @param cols Number of columns.
+   * @param layout Storage order the elements will be appended in.
+   */
+  CDS_MatrixWriter(const std::string &path, int rows, int cols,
+                   Layout layout = Layout::RowMajor);
+
+  CDS_MatrixWriter(const CDS_MatrixWriter &) = delete;
+  CDS_MatrixWriter &operator=(const CDS_MatrixWriter &) = delete;
+
+  /**
+   * @brief Destructor.
+   *
+   * Closes the file if Close was not called.
+   */
+  ~CDS_MatrixWriter();
+
+  /**
+   * @brief Appends elements in storage order.
+   *
+   * @param elements Pointer to the elements.
+   * @param count Number of elements.
+   * @return The number of elements written so far, or the reason it failed.
+   */
+  CDS_Result<std::size_t> Write(const T *elements, std::size_t count);
+
+  /**
+   * @brief Finishes the file.
+   *
+   * Fails if fewer elements than rows * cols were written.
+   *
+   * @return The number of elements written, or the reason it failed.
+   */
+  CDS_Result<std::size_t> Close();
+
+  /**
+   * @brief Writes a whole matrix to a file in its storage order.
+   *
+   * @param path Path of the file, overwritten if it exists.
+   * @param matrix The matrix to write.
+   * @return The number of elements written, or the reason it failed.
+   */
+  static CDS_Result<std::size_t> Save(const std::string &path,
+                                      const CDS_Matrix<T> &matrix);
+
+private:
+  std::FILE *_Stream = nullptr; ///< The open file, null once closed
+  std::size_t _Written = 0;     ///< Elements written so far
+  std::size_t _Count;           ///< Elements declared by the header
+  std::string _Error;           ///< First error, empty if none
+};
+
+#include "CDS_MatrixFile.ipp"
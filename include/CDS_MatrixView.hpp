@@ -0,0 +1,280 @@
+#pragma once
+
+/**
+ * @file CDS_MatrixView.hpp
+ * @brief Non-owning strided views over CDS_Matrix storage.
+ *
+ * This file contains the CDS_VectorView and CDS_MatrixView class templates.
+ * A view never owns or copies elements, it only describes how to reach them
+ * inside a buffer owned by someone else (usually a CDS_Matrix). Rows, columns
+ * and diagonals are plain strided views. Views with excluded rows or columns
+ * additionally carry a shared table of element offsets.
+ */
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A non-owning one-dimensional view with a constant stride or an
+ * explicit offset table.
+ *
+ * @tparam T Type of the viewed elements, may be const-qualified.
+ */
+template <class T> class CDS_VectorView {
+public:
+  using value_type = std::remove_const_t<T>;
+  using Offsets = std::shared_ptr<const std::vector<std::ptrdiff_t>>;
+
+  /**
+   * @brief Constructs a strided view.
+   *
+   * @param data Pointer to the first element.
+   * @param size Number of elements in the view.
+   * @param stride Distance in elements between two consecutive entries.
+   */
+  CDS_VectorView(T *data, int size, std::ptrdiff_t stride);
+
+  /**
+   * @brief Constructs a view addressed through an offset table.
+   *
+   * @param data Base pointer the offsets are relative to.
+   * @param offsets Element offsets of every entry of the view.
+   */
+  CDS_VectorView(T *data, Offsets offsets);
+
+  /**
+   * @brief Converts a mutable view into a read-only one.
+   */
+  operator CDS_VectorView<const T>() const;
+
+  /**
+   * @brief Gets the number of elements in the view.
+   *
+   * @return The number of elements.
+   */
+  int GetSize() const;
+
+  /**
+   * @brief Gets the stride of the view.
+   *
+   * @return The stride in elements, meaningless if the view is not strided.
+   */
+  std::ptrdiff_t GetStride() const;
+
+  /**
+   * @brief Gets the base pointer of the view.
+   *
+   * @return Pointer to the element the view is addressed from.
+   */
+  T *GetData() const;
+
+  /**
+   * @brief Checks if the view is addressed by a constant stride.
+   *
+   * @return true if no offset table is involved, false otherwise.
+   */
+  bool IsStrided() const;
+
+  /**
+   * @brief Accesses an element of the view.
+   *
+   * @param index Index of the element.
+   * @return A reference to the element.
+   */
+  T &operator[](int index) const;
+
+  /**
+   * @brief Copies the viewed elements into a new vector.
+   *
+   * @return A vector holding a copy of the elements.
+   */
+  std::vector<value_type> ToVector() const;
+
+  /**
+   * @brief Implicitly copies the viewed elements into a new vector.
+   */
+  operator std::vector<value_type>() const;
+
+private:
+  T *_Data;               ///< Base pointer of the view.
+  int _Size;              ///< Number of elements in the view.
+  std::ptrdiff_t _Stride; ///< Distance between consecutive elements.
+  Offsets _Offsets;       ///< Optional offset table, overrides the stride.
+};
+
+/**
+ * @brief A non-owning two-dimensional view over a matrix buffer.
+ *
+ * Element (i, j) lives at `data[RowOffset(i) + ColumnOffset(j)]`. Offsets are
+ * either computed from a row/column stride or looked up in a table when rows
+ * or columns were excluded from the view.
+ *
+ * @tparam T Type of the viewed elements, may be const-qualified.
+ */
+template <class T> class CDS_MatrixView {
+public:
+  using value_type = std::remove_const_t<T>;
+  using Offsets = std::shared_ptr<const std::vector<std::ptrdiff_t>>;
+
+  /**
+   * @brief Constructs a strided view.
+   *
+   * @param data Pointer to element (0, 0).
+   * @param rows Number of rows.
+   * @param cols Number of columns.
+   * @param rowStride Distance in elements between two consecutive rows.
+   * @param colStride Distance in elements between two consecutive columns.
+   */
+  CDS_MatrixView(T *data, int rows, int cols, std::ptrdiff_t rowStride,
+                 std::ptrdiff_t colStride);
+
+  /**
+   * @brief Converts a mutable view into a read-only one.
+   */
+  operator CDS_MatrixView<const T>() const;
+
+  /**
+   * @brief Gets the shape of the view (rows, cols).
+   *
+   * @return A tuple containing the number of rows and columns.
+   */
+  std::tuple<int, int> GetShape() const;
+
+  /**
+   * @brief Gets the base pointer of the view.
+   *
+   * @return Pointer to the element the view is addressed from.
+   */
+  T *GetData() const;
+
+  /**
+   * @brief Gets the distance between two consecutive rows.
+   *
+   * @return The row stride, meaningless if rows were excluded.
+   */
+  std::ptrdiff_t GetRowStride() const;
+
+  /**
+   * @brief Gets the distance between two consecutive columns.
+   *
+   * @return The column stride, meaningless if columns were excluded.
+   */
+  std::ptrdiff_t GetColumnStride() const;
+
+  /**
+   * @brief Checks if both dimensions are addressed by a constant stride.
+   *
+   * @return true if no offset table is involved, false otherwise.
+   */
+  bool IsStrided() const;
+
+  /**
+   * @brief Gets the offset of a row relative to the base pointer.
+   *
+   * @param rowIndex Index of the row.
+   * @return Offset in elements.
+   */
+  std::ptrdiff_t RowOffset(int rowIndex) const;
+
+  /**
+   * @brief Gets the offset of a column relative to the base pointer.
+   *
+   * @param colIndex Index of the column.
+   * @return Offset in elements.
+   */
+  std::ptrdiff_t ColumnOffset(int colIndex) const;
+
+  /**
+   * @brief Accesses an element of the view.
+   *
+   * @param indices Row and column index of the element.
+   * @return A reference to the element.
+   */
+  T &operator[](std::pair<int, int> indices) const;
+
+  /**
+   * @brief Gets a view of a single row.
+   *
+   * @param rowIndex Index of the row.
+   * @return A view of the row.
+   */
+  CDS_VectorView<T> GetRow(int rowIndex) const;
+
+  /**
+   * @brief Gets a view of a single column.
+   *
+   * @param colIndex Index of the column.
+   * @return A view of the column.
+   */
+  CDS_VectorView<T> GetColumn(int colIndex) const;
+
+  /**
+   * @brief Gets a view of the main diagonal.
+   *
+   * @return A view of the diagonal elements.
+   */
+  CDS_VectorView<T> GetDiagonal() const;
+
+  /**
+   * @brief Gets a view without the given columns.
+   *
+   * @param colIndices Indices of the columns to exclude.
+   * @return A view of the remaining columns.
+   */
+  CDS_MatrixView<T> ExcludeColumns(std::initializer_list<int> colIndices) const;
+
+  /**
+   * @brief Gets a view without the given rows.
+   *
+   * @param rowIndices Indices of the rows to exclude.
+   * @return A view of the remaining rows.
+   */
+  CDS_MatrixView<T> ExcludeRows(std::initializer_list<int> rowIndices) const;
+
+  /**
+   * @brief Gets a contiguous block of the view.
+   *
+   * @param row First row of the block.
+   * @param col First column of the block.
+   * @param rows Number of rows of the block.
+   * @param cols Number of columns of the block.
+   * @return A view of the block.
+   */
+  CDS_MatrixView<T> Block(int row, int col, int rows, int cols) const;
+
+  /**
+   * @brief Gets the transposed view, no elements are moved.
+   *
+   * @return A view with rows and columns swapped.
+   */
+  CDS_MatrixView<T> Transposed() const;
+
+private:
+  template <class U> friend class CDS_MatrixView;
+
+  T *_Data;                  ///< Pointer to element (0, 0).
+  int _Rows, _Cols;          ///< Shape of the view.
+  std::ptrdiff_t _RowStride; ///< Distance between consecutive rows.
+  std::ptrdiff_t _ColStride; ///< Distance between consecutive columns.
+  Offsets _RowOffsets;       ///< Optional row offset table.
+  Offsets _ColOffsets;       ///< Optional column offset table.
+
+  /**
+   * @brief Builds the offset table of the entries that are not excluded.
+   *
+   * @param count Number of entries in the current dimension.
+   * @param excluded Indices to drop.
+   * @param offsetOf Function returning the offset of an entry.
+   * @return The offset table of the remaining entries.
+   */
+  template <class F>
+  static Offsets _Exclude(int count, std::initializer_list<int> excluded,
+                          F offsetOf);
+};
+
+#include "CDS_MatrixView.ipp"
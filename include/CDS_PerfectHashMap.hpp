@@ -0,0 +1,303 @@
+#pragma once
+
+/**
+ * @file CDS_PerfectHashMap.hpp
+ * @brief Immutable map over a fixed key set, indexed by a minimal perfect
+ * hash.
+ *
+ * The keys are hashed into buckets of about _BUCKET_SIZE keys. Building the
+ * map picks, for each bucket from the largest down, a seed that sends every
+ * key of the bucket to a slot no other key took (hash and displace, CHD).
+ * There are exactly as many slots as keys, so a lookup hashes the key,
+ * reads the seed of its bucket and compares the one key in its slot: one
+ * probe, with no empty slots or tombstones to skip. The seeds take about one
+ * byte per key.
+ *
+ * The whole map is a single image that is also its file format:
+ *
+ *   offset  size  field
+ *        0     8  magic "CDSPHMP\0"
+ *        8     4  format version
+ *       12     4  byte order mark 0x01020304, as written by the host
+ *       16     4  key size in bytes, 0 for strings
+ *       20     4  value size in bytes
+ *       24     8  number of keys
+ *       32     8  number of buckets
+ *       40     8  seed of the key hash
+ *       48     8  length of the key bytes
+ *       56     8  reserved, zero
+ *
+ * followed, each at a multiple of _ALIGNMENT, by the bucket seeds (4 bytes
+ * each), the values in slot order, for strings the offsets of the keys
+ * into the key bytes (one more than the keys), and the key bytes. Saving
+ * writes the image out, opening a file maps it back and reads it in place.
+ */
+
+#include "CDS_File.hpp"
+#include "CDS_Result.hpp"
+#include "CDS_StringHash.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace _PerfectHash {
+
+/**
+ * @brief The image header, see the table in the file comment.
+ */
+struct _Header {
+  char Magic[8];
+  std::uint32_t Version;
+  std::uint32_t ByteOrder;
+  std::uint32_t KeySize;
+  std::uint32_t ValueSize;
+  std::uint64_t Count;
+  std::uint64_t Buckets;
+  std::uint64_t Seed;
+  std::uint64_t KeyBytes;
+  std::uint64_t Reserved;
+};
+static_assert(sizeof(_Header) == 64, "Header must be exactly 64 bytes");
+
+constexpr char _MAGIC[8] = {'C', 'D', 'S', 'P', 'H', 'M', 'P', '\0'};
+constexpr std::uint32_t _VERSION = 1;
+constexpr std::uint32_t _ORDER_MARK = 0x01020304;
+
+/**
+ * @brief Alignment of the sections of an image.
+ */
+constexpr std::size_t _ALIGNMENT = 64;
+
+/**
+ * @brief Average number of keys per bucket. Larger buckets need fewer
+ * seeds but longer searches while building.
+ */
+constexpr std::size_t _BUCKET_SIZE = 4;
+
+/**
+ * @brief Byte offsets of the sections of an image.
+ */
+struct _Sections {
+  std::size_t Seeds;   ///< Bucket seeds
+  std::size_t Values;  ///< Values in slot order
+  std::size_t Offsets; ///< Offsets of string keys, equal to Keys otherwise
+  std::size_t Keys;    ///< Key bytes
+  std::size_t End;     ///< Length of the image
+};
+
+/**
+ * @brief Map a hash evenly onto a range without dividing.
+ *
+ * @param hash The hash.
+ * @param range Size of the range.
+ * @return A number below range.
+ */
+std::uint64_t _Reduce(std::uint64_t hash, std::uint64_t range);
+
+/**
+ * @brief Get the slot of a key.
+ *
+ * @param hash Hash of the key.
+ * @param seed Seed of the bucket of the key.
+ * @param count Number of slots.
+ * @return Index of the slot.
+ */
+std::uint64_t _Slot(std::uint64_t hash, std::uint32_t seed,
+                    std::uint64_t count);
+
+/**
+ * @brief Lay out an image.
+ *
+ * @param header The header of the image.
+ * @return The offsets of its sections.
+ */
+_Sections _Locate(const _Header &header);
+
+/**
+ * @brief Check that an image holds a map of the expected types and fits
+ * its length.
+ *
+ * @param image Start of the image, aligned to _ALIGNMENT.
+ * @param length Length of the image in bytes.
+ * @param keySize Expected key size, 0 for strings.
+ * @param valueSize Expected value size.
+ * @return The header, or the reason the image does not match.
+ */
+CDS_Result<_Header> _Check(const void *image, std::size_t length,
+                           std::uint32_t keySize, std::uint32_t valueSize);
+
+/**
+ * @brief Find a seed for every bucket that gives each key a slot of its
+ * own.
+ *
+ * @param hashes Hashes of the keys, all different.
+ * @param seeds Seeds of the buckets, filled in.
+ * @param slots Slots of the keys, filled in.
+ * @return false if some bucket has no seed, the keys then need another
+ * hash seed.
+ */
+bool _Displace(std::span<const std::uint64_t> hashes,
+               std::span<std::uint32_t> seeds,
+               std::span<std::uint64_t> slots);
+
+} // namespace _PerfectHash
+
+/**
+ * @brief Read-only hash map built once from all its keys.
+ *
+ * Keys are either strings, K being std::string or std::string_view, looked
+ * up by std::string_view, or fixed-size types whose bytes identify them,
+ * such as integers or enums. Lookups are const and may run from any number
+ * of threads. Copies share the image, which is freed with the last copy.
+ *
+ * @tparam K Type of the keys.
+ * @tparam V Type of the values, must be trivially copyable.
+ */
+template <class K, class V> class CDS_PerfectHashMap {
+  /**
+   * @brief Whether the keys are strings of any length.
+   */
+  static constexpr bool _Strings =
+      std::is_convertible_v<const K &, std::string_view>;
+
+  static_assert(std::is_trivially_copyable_v<V>,
+                "Values must be trivially copyable");
+  static_assert(alignof(V) <= _PerfectHash::_ALIGNMENT,
+                "Values must not be over-aligned");
+  static_assert(_Strings || (std::is_trivially_copyable_v<K> &&
+                             std::has_unique_object_representations_v<K>),
+                "Keys must be strings or be identified by their bytes");
+
+public:
+  using key_type = K;
+  using mapped_type = V;
+
+  /**
+   * @brief Type a key is looked up by.
+   */
+  using key_view = std::conditional_t<_Strings, std::string_view, const K &>;
+
+  /**
+   * @brief Builds a map.
+   *
+   * Fails if a key occurs twice.
+   *
+   * @param keys The keys.
+   * @param values The values, one for each key.
+   * @param seed Seed of the key hash, the next seeds are tried if the keys
+   * collide under it.
+   * @return The map, or the reason it could not be built.
+   */
+  static CDS_Result<CDS_PerfectHashMap> Build(std::span<const K> keys,
+                                              std::span<const V> values,
+                                              std::uint64_t seed = 0);
+
+  /**
+   * @brief Maps a file written by Save.
+   *
+   * Fails if the file cannot be mapped, is not a perfect hash map, was
+   * written on a host with a different byte order, holds other key or
+   * value types, or is shorter than its header says.
+   *
+   * @param path Path of the file.
+   * @return The mapped map, or the reason it could not be mapped.
+   */
+  static CDS_Result<CDS_PerfectHashMap> Open(const std::string &path);
+
+  /**
+   * @brief Writes the map to a file.
+   *
+   * @param path Path of the file, overwritten if it exists.
+   * @return The number of bytes written, or the reason it failed.
+   */
+  CDS_Result<std::size_t> Save(const std::string &path) const;
+
+  // Getters
+
+  /**
+   * @brief Get the number of entries.
+   *
+   * @return The number of keys.
+   */
+  std::size_t GetSize() const;
+
+  /**
+   * @brief Get the size of the image.
+   *
+   * @return The bytes taken by the map, which a saved file also has.
+   */
+  std::size_t GetBytes() const;
+
+  /**
+   * @brief Get a copy of the value of a key.
+   *
+   * @param key The key to look up.
+   * @return The value, or an error if the key does not exist.
+   */
+  CDS_Result<V> Get(key_view key) const;
+
+  /**
+   * @brief Find the value of a key without copying it.
+   *
+   * @param key The key to look up.
+   * @return Pointer to the value, null if the key does not exist.
+   */
+  const V *Find(key_view key) const;
+
+  /**
+   * @brief Check whether a key exists.
+   *
+   * @param key The key to look up.
+   * @return true if the map holds the key.
+   */
+  bool Contains(key_view key) const;
+
+  /**
+   * @brief Call a function on every entry, in slot order.
+   *
+   * @tparam Function Type of the function.
+   * @param function Called with the key, as a key_view, and the value.
+   */
+  template <class Function> void ForEach(Function function) const;
+
+private:
+  std::shared_ptr<const void> _Storage; ///< Owns the image
+  const std::byte *_Image;              ///< Start of the image
+  _PerfectHash::_Header _Info;          ///< Header of the image
+  const std::uint32_t *_Seeds;          ///< Seed of each bucket
+  const V *_Values;                     ///< Value of each slot
+  const std::uint64_t *_Offsets;        ///< Start of each string key
+  const char *_Keys;                    ///< Bytes of the keys
+
+  /**
+   * @brief Constructs a map reading an image in place.
+   *
+   * @param storage Owner of the image.
+   * @param image The image, already checked.
+   */
+  CDS_PerfectHashMap(std::shared_ptr<const void> storage,
+                     const std::byte *image);
+
+  /**
+   * @brief Get the bytes of a key.
+   *
+   * @param key The key.
+   * @return A view of its bytes.
+   */
+  static std::string_view Bytes(key_view key);
+
+  /**
+   * @brief Get the bytes of the key in a slot.
+   *
+   * @param slot Index of the slot.
+   * @return A view of its bytes in the image.
+   */
+  std::string_view KeyAt(std::size_t slot) const;
+};
+
+#include "CDS_PerfectHashMap.ipp"
@@ -0,0 +1,480 @@
+#pragma once
+
+/**
+ * @file CDS_PersistentHashMap.hpp
+ * @brief Hash map living in a memory-mapped file, reopened without
+ * rebuilding.
+ *
+ * The file holds the table, laid out like that of CDS_HashMap but probed
+ * linearly so it does not depend on the group width of the build, and the
+ * bytes of string keys. Everything in it refers to everything else by file
+ * offset, so it works wherever the file is mapped, and opening it only
+ * reads a header.
+ *
+ * Flush makes the current contents durable. The table it commits is never
+ * written again: the first change after a Flush copies it, and changes go
+ * to the copy until the next Flush commits that. Key bytes are only ever
+ * appended past the committed end of the file. The file starts with two
+ * checksummed copies of the header, each in its own sector, and a Flush
+ * syncs the data before it overwrites the older copy. After a crash, Open
+ * picks the newest copy that is intact and finds the map exactly as the
+ * last Flush left it.
+ *
+ *   offset  size  field (of each header copy, at 0 and _COPY_STRIDE)
+ *        0     8  magic "CDSPMAP\0"
+ *        8     4  format version
+ *       12     4  byte order mark 0x01020304, as written by the host
+ *       16     4  key size in bytes, 0 for strings
+ *       20     4  value size in bytes
+ *       24     8  generation, one more for every Flush
+ *       32     8  number of slots of the table, 0 for none
+ *       40     8  number of entries
+ *       48     8  number of deleted slots
+ *       56     8  offset of the table
+ *       64     8  offset of a free table area, 0 for none
+ *       72     8  number of slots of the free table area
+ *       80     8  end of the used part of the file
+ *       88    32  reserved, zero
+ *      120     8  checksum of the bytes before it
+ *
+ * A table is _CLONES more control bytes than slots, padded to _ALIGNMENT,
+ * followed by the slots. A slot holds a fixed-size key, or the offset and
+ * length of a string key, and then the value.
+ */
+
+#include "CDS_File.hpp"
+#include "CDS_HashMap.hpp"
+#include "CDS_Result.hpp"
+#include "CDS_StringHash.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace _Persistent {
+
+/**
+ * @brief A copy of the file header, see the table in the file comment.
+ */
+struct _Header {
+  char Magic[8];
+  std::uint32_t Version;
+  std::uint32_t ByteOrder;
+  std::uint32_t KeySize;
+  std::uint32_t ValueSize;
+  std::uint64_t Generation;
+  std::uint64_t Capacity;
+  std::uint64_t Size;
+  std::uint64_t Deleted;
+  std::uint64_t Table;
+  std::uint64_t Spare;
+  std::uint64_t SpareCapacity;
+  std::uint64_t End;
+  std::uint64_t Reserved[4];
+  std::uint64_t Checksum;
+};
+static_assert(sizeof(_Header) == 128, "Header must be exactly 128 bytes");
+
+constexpr char _MAGIC[8] = {'C', 'D', 'S', 'P', 'M', 'A', 'P', '\0'};
+constexpr std::uint32_t _VERSION = 1;
+constexpr std::uint32_t _ORDER_MARK = 0x01020304;
+
+/**
+ * @brief Distance between the two header copies, more than a disk sector,
+ * so one torn write never hits both.
+ */
+constexpr std::size_t _COPY_STRIDE = 2048;
+
+/**
+ * @brief Offset of the first table or key, past the headers.
+ */
+constexpr std::size_t _DATA = 4096;
+
+/**
+ * @brief Alignment of tables in the file.
+ */
+constexpr std::size_t _ALIGNMENT = 64;
+
+/**
+ * @brief Number of control bytes cloned past the end of a table, the
+ * widest group of any build.
+ */
+constexpr std::size_t _CLONES = 32;
+
+/**
+ * @brief Number of slots of the first table.
+ */
+constexpr std::size_t _MIN_CAPACITY = 32;
+
+static_assert(_Hash::_GROUP <= _CLONES, "Groups must fit in the clones");
+
+/**
+ * @brief Reference to the bytes of a string key in the file.
+ */
+struct _Span {
+  std::uint64_t Offset; ///< Offset of the first byte in the file.
+  std::uint64_t Length; ///< Number of bytes.
+};
+
+/**
+ * @brief Get the number of control bytes of a table, padded so the slots
+ * start aligned.
+ *
+ * @param capacity Number of slots.
+ * @return The bytes before the first slot.
+ */
+std::size_t _ControlBytes(std::size_t capacity);
+
+/**
+ * @brief Read the newest intact header copy of a file.
+ *
+ * @param mapping The mapped file, at least _DATA bytes long.
+ * @param keySize Expected key size, 0 for strings.
+ * @param valueSize Expected value size.
+ * @param slotSize Size of a slot, to check that the tables fit the file.
+ * @return The header, or the reason no copy matches.
+ */
+CDS_Result<_Header> _Load(const _File::SharedMapping &mapping,
+                          std::uint32_t keySize, std::uint32_t valueSize,
+                          std::size_t slotSize);
+
+/**
+ * @brief Make a header durable: sync the data it describes, then write and
+ * sync the copy the previous generation did not use.
+ *
+ * @param mapping The mapped file.
+ * @param header The header, its checksum is filled in.
+ * @return The generation of the header, or the reason it failed.
+ */
+CDS_Result<std::uint64_t> _Commit(_File::SharedMapping &mapping,
+                                  _Header &header);
+
+} // namespace _Persistent
+
+/**
+ * @brief Hash map stored in a file, durable at every Flush.
+ *
+ * Keys are either strings, K being std::string or std::string_view, looked
+ * up by std::string_view, or fixed-size types whose bytes identify them.
+ * Keys and values are stored as bytes, so the file can only be read on a
+ * host with the same byte order and type layouts.
+ *
+ * Changes since the last Flush are lost when the process stops. The
+ * destructor flushes, ignoring errors; call Flush to see them. Members that
+ * change the map may have to grow the file and then fail with the reason.
+ * Values are handed out read-only, since the table they live in may be the
+ * committed one; use Set to change them. Pointers from Find stay valid
+ * until the next change, which may move the mapping.
+ *
+ * A new file is built under a temporary name next to its path and only
+ * takes that name once its first header is durable, so a crash while
+ * creating it leaves at most the temporary file behind. The file is locked
+ * with flock while a map has it open, and a second Open of it fails. The
+ * lock is advisory, it keeps out other maps but not other writers.
+ *
+ * The file keeps the tables the map outgrew and the bytes of deleted
+ * string keys. Open checks the header but trusts the table, so only open
+ * files written by this class.
+ *
+ * @tparam K Type of the keys.
+ * @tparam V Type of the values, must be trivially copyable.
+ */
+template <class K, class V> class CDS_PersistentHashMap {
+  /**
+   * @brief Whether the keys are strings of any length.
+   */
+  static constexpr bool _Strings =
+      std::is_convertible_v<const K &, std::string_view>;
+
+  static_assert(std::is_trivially_copyable_v<V>,
+                "Values must be trivially copyable");
+  static_assert(_Strings || (std::is_trivially_copyable_v<K> &&
+                             std::has_unique_object_representations_v<K>),
+                "Keys must be strings or be identified by their bytes");
+
+public:
+  using key_type = K;
+  using mapped_type = V;
+
+  /**
+   * @brief Type a key is looked up by.
+   */
+  using key_view = std::conditional_t<_Strings, std::string_view, const K &>;
+
+  /**
+   * @brief Opens the map in a file, creating an empty one if the file does
+   * not exist.
+   *
+   * Takes constant time. Fails if the file cannot be opened, is open in
+   * another map, is not a persistent hash map, holds other key or value
+   * types, or has no intact header.
+   *
+   * @param path Path of the file.
+   * @param maxLoadFactor Fraction of the slots that may be in use, between
+   * 0 and 1.
+   * @return The map, or the reason it could not be opened.
+   */
+  static CDS_Result<CDS_PersistentHashMap>
+  Open(const std::string &path, float maxLoadFactor = 0.875f);
+
+  CDS_PersistentHashMap(const CDS_PersistentHashMap &) = delete;
+  CDS_PersistentHashMap &operator=(const CDS_PersistentHashMap &) = delete;
+
+  /**
+   * @brief Move constructor, takes over the file of the other map.
+   */
+  CDS_PersistentHashMap(CDS_PersistentHashMap &&other) noexcept = default;
+
+  /**
+   * @brief Move assignment, flushes and closes the current file first.
+   */
+  CDS_PersistentHashMap &operator=(CDS_PersistentHashMap &&other) noexcept;
+
+  /**
+   * @brief Destructor.
+   *
+   * Flushes and closes the file.
+   */
+  ~CDS_PersistentHashMap();
+
+  // Getters
+
+  /**
+   * @brief Get the number of entries.
+   *
+   * @return The number of entries in the map.
+   */
+  std::size_t GetSize() const;
+
+  /**
+   * @brief Get the number of slots of the table.
+   *
+   * @return The capacity of the table.
+   */
+  std::size_t GetCapacity() const;
+
+  /**
+   * @brief Get the generation of the last Flush.
+   *
+   * @return The number of commits the file has seen.
+   */
+  std::uint64_t GetGeneration() const;
+
+  /**
+   * @brief Get a copy of the value of a key.
+   *
+   * @param key The key to look up.
+   * @return The value, or an error if the key does not exist.
+   */
+  CDS_Result<V> Get(key_view key) const;
+
+  /**
+   * @brief Find the value of a key without copying it.
+   *
+   * @param key The key to look up.
+   * @return Pointer to the value, null if the key does not exist.
+   */
+  const V *Find(key_view key) const;
+
+  /**
+   * @brief Check whether a key exists.
+   *
+   * @param key The key to look up.
+   * @return true if the map holds the key.
+   */
+  bool Contains(key_view key) const;
+
+  // Modifiers
+
+  /**
+   * @brief Insert a new entry.
+   *
+   * @param key The key.
+   * @param value The value.
+   * @return Pointer to the stored value, or an error if the key already
+   * exists or the file cannot grow, in which case the map is not changed.
+   */
+  CDS_Result<const V *> Insert(key_view key, const V &value);
+
+  /**
+   * @brief Insert an entry or overwrite the value of an existing key.
+   *
+   * @param key The key.
+   * @param value The value.
+   * @return Pointer to the stored value, or an error if the file cannot
+   * grow, in which case the map is not changed.
+   */
+  CDS_Result<const V *> Set(key_view key, const V &value);
+
+  /**
+   * @brief Remove an entry.
+   *
+   * @param key The key to remove.
+   * @return The value the key had, or an error if the key does not exist or
+   * the file cannot grow.
+   */
+  CDS_Result<V> Delete(key_view key);
+
+  /**
+   * @brief Remove every entry. The next insertion starts a new table.
+   */
+  void Clear();
+
+  /**
+   * @brief Grow the table so that it holds a number of entries without
+   * growing again.
+   *
+   * @param count Number of entries.
+   * @return The capacity of the table, or an error if the file cannot
+   * grow.
+   */
+  CDS_Result<std::size_t> Reserve(std::size_t count);
+
+  /**
+   * @brief Make every change so far durable.
+   *
+   * @return The new generation, or the reason it failed, in which case the
+   * file still holds the previous one.
+   */
+  CDS_Result<std::uint64_t> Flush();
+
+  /**
+   * @brief Call a function on every entry, in table order.
+   *
+   * @tparam Function Type of the function.
+   * @param function Called with the key, as a key_view, and the value.
+   */
+  template <class Function> void ForEach(Function function) const;
+
+private:
+  /**
+   * @brief An entry of the table, stored as bytes in the file.
+   */
+  struct _Slot {
+    std::conditional_t<_Strings, _Persistent::_Span, K> Key; ///< The key.
+    V Value;                                                 ///< The value.
+  };
+
+  static_assert(alignof(_Slot) <= _Persistent::_ALIGNMENT,
+                "Slots must not be over-aligned");
+
+  std::unique_ptr<_File::SharedMapping> _Mapping; ///< The open file
+  _Persistent::_Header _State; ///< The map, as the next Flush writes it
+  _Persistent::_Header _Last;  ///< The header of the last Flush
+  float _MaxLoadFactor;        ///< Fraction of slots that may be used
+
+  CDS_PersistentHashMap(std::unique_ptr<_File::SharedMapping> mapping,
+                        const _Persistent::_Header &header,
+                        float maxLoadFactor);
+
+  /**
+   * @brief Get the control bytes of the current table.
+   */
+  std::int8_t *Control() const;
+
+  /**
+   * @brief Get the slots of the current table.
+   */
+  _Slot *Slots() const;
+
+  /**
+   * @brief Get the bytes of a key.
+   *
+   * @param key The key.
+   * @return A view of its bytes.
+   */
+  static std::string_view Bytes(key_view key);
+
+  /**
+   * @brief Get the bytes of the key in a slot.
+   *
+   * @param slot The slot.
+   * @return A view of its bytes in the file or in the slot.
+   */
+  std::string_view KeyOf(const _Slot &slot) const;
+
+  /**
+   * @brief Find the slot holding a key.
+   *
+   * @param bytes The bytes of the key.
+   * @param hash The hash of the key.
+   * @return Index of the slot, the capacity if the key does not exist.
+   */
+  std::size_t Lookup(std::string_view bytes, std::uint64_t hash) const;
+
+  /**
+   * @brief Store an entry whose key does not exist yet, growing the table
+   * first if needed.
+   *
+   * @param bytes The bytes of the key.
+   * @param hash The hash of the key.
+   * @param value The value.
+   * @return Index of the slot, or the reason the file could not grow.
+   */
+  CDS_Result<std::size_t> Place(std::string_view bytes, std::uint64_t hash,
+                                const V &value);
+
+  /**
+   * @brief Make sure the current table is not the committed one, copying
+   * it if it is.
+   *
+   * @return The offset of the current table, or the reason the file could
+   * not grow.
+   */
+  CDS_Result<std::uint64_t> Detach();
+
+  /**
+   * @brief Move the entries into a new table.
+   *
+   * @param capacity Number of slots of the new table, a power of two.
+   * @return The offset of the new table, or the reason the file could not
+   * grow.
+   */
+  CDS_Result<std::uint64_t> Rehash(std::size_t capacity);
+
+  /**
+   * @brief Get a table area, the free one if it has the right size.
+   *
+   * @param capacity Number of slots.
+   * @return The offset of the area, or the reason the file could not grow.
+   */
+  CDS_Result<std::uint64_t> TableArea(std::size_t capacity);
+
+  /**
+   * @brief Take bytes from the end of the used part of the file, growing
+   * the file if needed, which may move the mapping.
+   *
+   * @param bytes Number of bytes.
+   * @param alignment Alignment of the offset.
+   * @return The offset of the bytes, or the reason the file could not grow.
+   */
+  CDS_Result<std::uint64_t> Allocate(std::size_t bytes, std::size_t alignment);
+
+  /**
+   * @brief Find the first free slot on the probe sequence of a hash.
+   *
+   * @param hash The hash.
+   * @return Index of the slot.
+   */
+  std::size_t Probe(std::uint64_t hash) const;
+
+  /**
+   * @brief Set the control byte of a slot and its clone.
+   *
+   * @param index Index of the slot.
+   * @param control The new control byte.
+   */
+  void SetControl(std::size_t index, std::int8_t control);
+
+  /**
+   * @brief Get the smallest table that holds a number of entries.
+   *
+   * @param count Number of entries.
+   * @return The number of slots.
+   */
+  std::size_t CapacityFor(std::size_t count) const;
+};
+
+#include "CDS_PersistentHashMap.ipp"
@@ -0,0 +1,32 @@
+#pragma once
+
+/**
+ * @file CDS_Result.hpp
+ * @brief Value-or-error return type used by CDS functions that can fail at
+ * runtime.
+ */
+
+#include <optional>
+#include <string>
+
+/**
+ * @brief Holds either a value or an error message.
+ *
+ * @tparam T Type of the value.
+ */
+template <class T> struct CDS_Result {
+  std::optional<T> Value;
+  std::optional<std::string> ErrorMessage;
+
+  static CDS_Result<T> Success(const T &value);
+
+  static CDS_Result<T> Failure(const std::optional<std::string> &errorMessage);
+
+  bool IsSucces();
+
+  bool IsError();
+
+  T &Unpack();
+};
+
+#include "CDS_Result.ipp"
@@ -0,0 +1,267 @@
+#pragma once
+
+/**
+ * @file CDS_SegmentedList.hpp
+ * @brief A list made of doubling segments whose elements never move.
+ *
+ * CDS_SegmentedList grows by allocating another segment twice the size of
+ * the last one instead of reallocating: no element is copied, references
+ * stay valid across appends, and memory never peaks at old plus new array.
+ * Indexing stays O(1), the segment of an index is the position of its top
+ * bit. The segment arithmetic is shared with CDS_ConcurrentList.
+ */
+
+#include "CDS_List.hpp"
+#include <cstddef>
+#include <iostream>
+#include <memory>
+
+namespace _Segment {
+
+/**
+ * @brief The first segment holds 1 << _FIRST_SHIFT elements, every later
+ * one twice as many as the one before.
+ */
+constexpr std::size_t _FIRST_SHIFT = 6;
+
+/**
+ * @brief Number of segments, enough for 2^53 elements.
+ */
+constexpr std::size_t _COUNT = 48;
+
+/**
+ * @brief Position of an element within the segments.
+ */
+struct _Position {
+  std::size_t Segment; ///< Index of the segment.
+  std::size_t Offset;  ///< Index of the element within the segment.
+};
+
+/**
+ * @brief Finds the segment and offset of an element.
+ *
+ * @param index Index of the element.
+ * @return The position of the element.
+ */
+constexpr _Position _Locate(std::size_t index);
+
+/**
+ * @brief Gets the number of elements a segment holds.
+ *
+ * @param segment Index of the segment.
+ * @return The capacity of the segment.
+ */
+constexpr std::size_t _Capacity(std::size_t segment);
+
+/**
+ * @brief Gets the index of the first element of a segment.
+ *
+ * @param segment Index of the segment.
+ * @return The number of elements in all earlier segments.
+ */
+constexpr std::size_t _First(std::size_t segment);
+
+} // namespace _Segment
+
+/**
+ * @brief Templated list with stable element addresses.
+ *
+ * Offers the Append / Emplace / Pop / operator[] interface of CDS_List.
+ * Element addresses stay valid until the element is popped or the list is
+ * cleared. Segments are kept once allocated, so popping and re-appending
+ * never allocates. Flatten copies the elements into a contiguous CDS_List.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam Allocator The allocator the segments are obtained from.
+ */
+template <class T, class Allocator = std::allocator<T>>
+class CDS_SegmentedList {
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+
+  /**
+   * @brief Default constructor, nothing is allocated until the first
+   * append.
+   */
+  CDS_SegmentedList();
+
+  /**
+   * @brief Constructs an empty list drawing memory from an allocator.
+   *
+   * @param allocator The allocator to use.
+   */
+  explicit CDS_SegmentedList(const Allocator &allocator);
+
+  /**
+   * @brief Copy constructor.
+   */
+  CDS_SegmentedList(const CDS_SegmentedList &other);
+
+  /**
+   * @brief Move constructor, steals the segments of the other list.
+   */
+  CDS_SegmentedList(CDS_SegmentedList &&other) noexcept;
+
+  /**
+   * @brief Copy and move assignment.
+   */
+  CDS_SegmentedList &operator=(CDS_SegmentedList other) noexcept;
+
+  /**
+   * @brief Destructor.
+   *
+   * Destroys the elements and frees the segments.
+   */
+  ~CDS_SegmentedList();
+
+  // Getters
+
+  /**
+   * @brief Get the allocator the list draws memory from.
+   *
+   * @return A copy of the allocator.
+   */
+  Allocator GetAllocator() const;
+
+  /**
+   * @brief Get the current size of the list.
+   *
+   * @return The number of elements in the list.
+   */
+  std::size_t GetSize() const;
+
+  /**
+   * @brief Get the number of elements the allocated segments can hold.
+   *
+   * @return The capacity of the list.
+   */
+  std::size_t GetCapacity() const;
+
+  /**
+   * @brief Get a reference to the element at the given index.
+   *
+   * @param index The index of the element to retrieve.
+   * @return A reference to the element.
+   */
+  T &GetElement(const std::size_t index) const;
+
+  // Modifiers
+
+  /**
+   * @brief Append an element to the end of the list.
+   *
+   * @param elem The element to append, may be an element of this list.
+   * @return A const reference to the appended element.
+   */
+  const T &Append(const T &elem);
+
+  /**
+   * @brief Append a temporary element to the end of the list.
+   *
+   * @param elem The temporary element to append.
+   * @return A const reference to the appended element.
+   */
+  const T &Append(T &&elem);
+
+  /**
+   * @brief Construct and append an element in place.
+   *
+   * @tparam Args The types of the constructor arguments.
+   * @param args The constructor arguments.
+   * @return A reference to the newly emplaced element.
+   */
+  template <class... Args> T &Emplace(Args &&...args);
+
+  /**
+   * @brief Remove and return the last element from the list.
+   *
+   * @return The last element in the list.
+   */
+  T Pop();
+
+  /**
+   * @brief Clear the list, keeping its segments.
+   */
+  void Clear();
+
+  /**
+   * @brief Copy the elements into a contiguous list.
+   *
+   * Trivially copyable elements are copied with one memcpy per segment.
+   *
+   * @return The contiguous list.
+   */
+  CDS_List<T, Allocator> Flatten() const &;
+
+  /**
+   * @brief Move the elements into a contiguous list, leaving this one
+   * empty.
+   *
+   * @return The contiguous list.
+   */
+  CDS_List<T, Allocator> Flatten() &&;
+
+  /**
+   * @brief Swap the contents of two lists.
+   *
+   * @param other The other list.
+   */
+  void Swap(CDS_SegmentedList &other) noexcept;
+
+  // Operator Overloads
+
+  /**
+   * @brief Access an element by its index.
+   *
+   * @param index The index of the element to access.
+   * @return A reference to the element.
+   */
+  T &operator[](const std::size_t index);
+
+  /**
+   * @brief Access an element by its index (const version).
+   *
+   * @param index The index of the element to access.
+   * @return A const reference to the element.
+   */
+  const T &operator[](const std::size_t index) const;
+
+  /**
+   * @brief Output stream operator overload.
+   *
+   * @tparam U The type of elements in the list.
+   * @tparam A The allocator of the list.
+   * @param stream The output stream.
+   * @param array The list to print.
+   * @return A reference to the output stream.
+   */
+  template <class U, class A>
+  friend std::ostream &operator<<(std::ostream &stream,
+                                  const CDS_SegmentedList<U, A> &array);
+
+private:
+  using _Traits = std::allocator_traits<Allocator>;
+
+  [[no_unique_address]] Allocator _Allocator; ///< Source of the segments.
+  std::size_t _Size = 0;                      ///< Number of elements.
+  T *_Segments[_Segment::_COUNT] = {};        ///< Element arrays.
+
+  /**
+   * @brief Get the uninitialized slot past the last element, allocating its
+   * segment if needed.
+   *
+   * @return Pointer to the slot.
+   */
+  T *Slot();
+
+  /**
+   * @brief Copy or move every element into a contiguous list.
+   *
+   * @tparam Move Whether to move the elements.
+   * @return The contiguous list.
+   */
+  template <bool Move> CDS_List<T, Allocator> Gather() const;
+};
+
+#include "CDS_SegmentedList.ipp"
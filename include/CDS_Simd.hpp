@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file CDS_Simd.hpp
+ * @brief Vectorized bulk kernels behind the numeric members of CDS_List and
+ * CDS_Arr.
+ *
+ * The float and double kernels are compiled several times, for AVX-512,
+ * AVX2 with FMA and SSE2, and the best version the CPU supports is picked
+ * at runtime on first use. A binary built for a generic x86-64 target thus
+ * still runs AVX-512 kernels on machines that have it. Every other
+ * arithmetic type, and every other architecture, uses the scalar templates,
+ * which the compiler is free to auto-vectorize. The micro-kernel of the
+ * float and double GEMM in CDS_Gemm follows the same level.
+ */
+
+#include <cstddef>
+
+namespace _Simd {
+
+/**
+ * @brief Instruction sets the kernels are compiled for.
+ */
+enum class _Level { Scalar, SSE2, AVX2, AVX512 };
+
+/**
+ * @brief Gets the instruction set the kernels run with.
+ *
+ * @return The active level.
+ */
+_Level _GetLevel();
+
+/**
+ * @brief Gets the best instruction set the CPU supports.
+ *
+ * @return The supported level.
+ */
+_Level _GetSupported();
+
+/**
+ * @brief Selects the instruction set the kernels run with, mainly to test
+ * the lower levels. Levels the CPU lacks are clamped to the supported one.
+ *
+ * @param level The requested level.
+ */
+void _SetLevel(_Level level);
+
+// Scalar kernels, used for every type without a dispatched overload and in
+// constant expressions.
+
+/**
+ * @brief Sets count elements to a value.
+ */
+template <class T> constexpr void _Fill(T *out, std::size_t count, T value);
+
+/**
+ * @brief Element-wise out = lhs + rhs, out may alias either operand.
+ */
+template <class T>
+constexpr void _Add(const T *lhs, const T *rhs, T *out, std::size_t count);
+
+/**
+ * @brief Element-wise out = lhs - rhs, out may alias either operand.
+ */
+template <class T>
+constexpr void _Sub(const T *lhs, const T *rhs, T *out, std::size_t count);
+
+/**
+ * @brief Element-wise out = lhs * rhs, out may alias either operand.
+ */
+template <class T>
+constexpr void _Mul(const T *lhs, const T *rhs, T *out, std::size_t count);
+
+/**
+ * @brief Element-wise out = lhs * rhs + addend, out may alias any operand.
+ */
+template <class T>
+constexpr void _Fma(const T *lhs, const T *rhs, const T *addend, T *out,
+                    std::size_t count);
+
+/**
+ * @brief Element-wise out = alpha * in, out may alias in.
+ */
+template <class T>
+constexpr void _Scale(const T *in, T alpha, T *out, std::size_t count);
+
+/**
+ * @brief Sum of lhs[i] * rhs[i].
+ */
+template <class T>
+constexpr T _Dot(const T *lhs, const T *rhs, std::size_t count);
+
+/**
+ * @brief Sum of the elements.
+ */
+template <class T> constexpr T _Sum(const T *in, std::size_t count);
+
+/**
+ * @brief Smallest element, count must be positive.
+ */
+template <class T> constexpr T _Min(const T *in, std::size_t count);
+
+/**
+ * @brief Largest element, count must be positive.
+ */
+template <class T> constexpr T _Max(const T *in, std::size_t count);
+
+// Dispatched kernels, defined in CDS_Simd.cpp. The reductions may sum in a
+// different order than the scalar kernels, so floating-point results can
+// differ in the last bits between levels.
+
+void _Fill(float *out, std::size_t count, float value);
+void _Add(const float *lhs, const float *rhs, float *out, std::size_t count);
+void _Sub(const float *lhs, const float *rhs, float *out, std::size_t count);
+void _Mul(const float *lhs, const float *rhs, float *out, std::size_t count);
+void _Fma(const float *lhs, const float *rhs, const float *addend, float *out,
+          std::size_t count);
+void _Scale(const float *in, float alpha, float *out, std::size_t count);
+float _Dot(const float *lhs, const float *rhs, std::size_t count);
+float _Sum(const float *in, std::size_t count);
+float _Min(const float *in, std::size_t count);
+float _Max(const float *in, std::size_t count);
+
+void _Fill(double *out, std::size_t count, double value);
+void _Add(const double *lhs, const double *rhs, double *out, std::size_t count);
+void _Sub(const double *lhs, const double *rhs, double *out, std::size_t count);
+void _Mul(const double *lhs, const double *rhs, double *out, std::size_t count);
+void _Fma(const double *lhs, const double *rhs, const double *addend,
+          double *out, std::size_t count);
+void _Scale(const double *in, double alpha, double *out, std::size_t count);
+double _Dot(const double *lhs, const double *rhs, std::size_t count);
+double _Sum(const double *in, std::size_t count);
+double _Min(const double *in, std::size_t count);
+double _Max(const double *in, std::size_t count);
+
+} // namespace _Simd
+
+#include "CDS_Simd.ipp"
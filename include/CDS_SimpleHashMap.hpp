@@ -1,24 +1,15 @@
 #pragma once
+#include "CDS_Result.hpp"
 #include <array>
 #include <memory>
-#include <optional>
 #include <string>
+#include <string_view>
 
-template <class T> struct CDS_Result {
-  std::optional<T> Value;
-  std::optional<std::string> ErrorMessage;
-
-  static CDS_Result<T> Success(const T &value);
-
-  static CDS_Result<T> Failure(const std::optional<std::string> &errorMessage);
-
-  bool IsSucces();
-
-  bool IsError(); 
-
-  T &Unpack();
-};
-
+/**
+ * @brief Fixed 26-slot map keyed by the last letter of the key.
+ *
+ * Kept for existing callers, use CDS_HashMap for anything new.
+ */
 class CDS_SimpleHashMap {
   struct _State;
   std::shared_ptr<_State> p_State;
@@ -28,9 +19,9 @@ public:
   const std::array<std::string, 26> &Slots();
 
   CDS_SimpleHashMap();
-  CDS_Result<std::string> Get(std::string &key);
-  CDS_Result<std::string> Insert(std::string &key);
-  CDS_Result<std::string> Delete(std::string key);
+  CDS_Result<std::string> Get(std::string_view key);
+  CDS_Result<std::string> Insert(std::string_view key);
+  CDS_Result<std::string> Delete(std::string_view key);
 
 private:
   struct _State {
@@ -40,10 +31,8 @@ private:
   };
 
   std::array<std::string, 26> _Slots;
-  const byte _StartByte;
   const size_t _N;
+  const byte _StartByte;
 
-  CDS_Result<size_t> _HashFunction(std::string &key);
+  CDS_Result<size_t> _HashFunction(std::string_view key);
 };
-
-#include "CDS_SimpleHashMap.ipp"
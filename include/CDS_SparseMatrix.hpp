@@ -0,0 +1,312 @@
+#pragma once
+
+/**
+ * @file CDS_SparseMatrix.hpp
+ * @brief Header file for the CDS_SparseMatrix class template.
+ *
+ * CDS_SparseMatrix is the compressed counterpart of CDS_Matrix for large,
+ * mostly-zero matrices. It stores only the non-zero elements, row by row
+ * (CSR) or column by column (CSC), and multiplies against dense vectors and
+ * CDS_Matrix operands. Shape queries, Transpose and the Is* predicates match
+ * those of CDS_Matrix, so calling code can switch between the two types.
+ */
+
+#include "CDS_Matrix.hpp"
+#include "CDS_ThreadPool.hpp"
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+namespace _Sparse {
+
+/**
+ * @brief Number of stored elements per band of a parallel product, bands
+ * are cut so that every thread gets about the same number of non-zeros.
+ */
+constexpr std::size_t _BAND_NONZEROS = 16384;
+
+/**
+ * @brief Compressed rows (or columns) of a matrix.
+ *
+ * Major line k holds Indices and Values in [Offsets[k], Offsets[k + 1]),
+ * sorted by minor index, without duplicates or stored zeros. Indices are
+ * bounded by the dimensions and fit an int, offsets count non-zeros and
+ * do not.
+ *
+ * @tparam T Type of the elements.
+ */
+template <class T> struct _Compressed {
+  std::vector<std::size_t> Offsets; ///< Start of each major line, plus the end.
+  std::vector<int> Indices;         ///< Minor index of each stored element.
+  std::vector<T> Values;            ///< Value of each stored element.
+};
+
+/**
+ * @brief Switches the orientation of compressed storage by counting sort.
+ *
+ * The CSR arrays of a matrix are the CSC arrays of its transpose, so this
+ * both converts between formats and transposes in O(nnz + major + minor).
+ *
+ * @tparam T Type of the elements.
+ * @param in Compressed lines.
+ * @param minor Number of minor lines of the input.
+ * @return The same elements compressed along the other dimension.
+ */
+template <class T>
+_Compressed<T> _Swap(const _Compressed<T> &in, int minor);
+
+} // namespace _Sparse
+
+/**
+ * @brief A sparse matrix in compressed row (CSR) or compressed column (CSC)
+ * storage.
+ *
+ * Indices within a row (CSR) or column (CSC) are kept sorted and elements
+ * equal to zero are not stored, so two matrices with the same elements have
+ * the same storage. Elements are read-only through operator[], the storage is
+ * built from triplets or from a dense matrix.
+ *
+ * Sparse-times-dense products are split into bands of about equal non-zero
+ * count and run on the CDS_ThreadPool once they are above its serial cutoff.
+ *
+ * @tparam T Type of the elements in the matrix (e.g., float, double, int).
+ */
+template <typename T> class CDS_SparseMatrix {
+public:
+  using value_type = T;
+
+  /**
+   * @brief Enum for specifying the compression direction.
+   */
+  enum class Format {
+    CSR, ///< Compressed rows, fast row access and products
+    CSC  ///< Compressed columns, fast column access
+  };
+
+  /**
+   * @brief A single element given by position and value.
+   *
+   * Triplets may come in any order, values of repeated positions are summed.
+   */
+  struct Triplet {
+    int Row;  ///< Row index.
+    int Col;  ///< Column index.
+    T Value;  ///< Value of the element.
+  };
+
+  /**
+   * @brief Constructs a zero matrix with a given number of rows and columns.
+   *
+   * @param rows Number of rows.
+   * @param cols Number of columns.
+   * @param format Compression direction.
+   */
+  CDS_SparseMatrix(int rows, int cols, Format format = Format::CSR);
+
+  /**
+   * @brief Constructs a matrix from a list of triplets.
+   *
+   * @param rows Number of rows.
+   * @param cols Number of columns.
+   * @param triplets The elements, in any order.
+   * @param format Compression direction.
+   */
+  CDS_SparseMatrix(int rows, int cols, const std::vector<Triplet> &triplets,
+                   Format format = Format::CSR);
+
+  /**
+   * @brief Constructs a matrix from the non-zero elements of a dense matrix.
+   *
+   * @param dense The dense matrix.
+   * @param format Compression direction.
+   */
+  explicit CDS_SparseMatrix(const CDS_Matrix<T> &dense,
+                            Format format = Format::CSR);
+
+  /**
+   * @brief Converts the matrix to a dense matrix.
+   *
+   * @param layout Storage order of the dense matrix.
+   * @return The dense matrix.
+   */
+  CDS_Matrix<T>
+  ToDense(typename CDS_Matrix<T>::Layout layout =
+              CDS_Matrix<T>::Layout::RowMajor) const;
+
+  /**
+   * @brief Multiplies the matrix with a vector.
+   *
+   * @param vector The vector to multiply with.
+   * @return Resulting vector after multiplication.
+   */
+  std::vector<T> operator*(const std::vector<T> &vector) const;
+
+  /**
+   * @brief Multiplies the matrix with a dense matrix.
+   *
+   * A CSR matrix produces a row-major result, a CSC matrix a column-major
+   * one. The dense operand is reordered into the matching layout first if
+   * needed.
+   *
+   * @param other The dense matrix to multiply with.
+   * @return Resulting dense matrix after multiplication.
+   */
+  CDS_Matrix<T> operator*(const CDS_Matrix<T> &other) const;
+
+  /**
+   * @brief Changes the compression direction, converting in O(nnz).
+   *
+   * @param format The new compression direction.
+   */
+  void SetFormat(Format format);
+
+  /**
+   * @brief Gets the compression direction.
+   *
+   * @return The format of the storage.
+   */
+  Format GetFormat() const;
+
+  /**
+   * @brief Gets the shape of the matrix (rows, cols).
+   *
+   * @return A tuple containing the number of rows and columns.
+   */
+  std::tuple<int, int> GetShape() const;
+
+  /**
+   * @brief Gets the number of stored (non-zero) elements.
+   *
+   * @return The number of non-zeros.
+   */
+  std::size_t NonZeros() const;
+
+  /**
+   * @brief Gets the start of every row (CSR) or column (CSC) in the index
+   * and value arrays, followed by the number of non-zeros.
+   *
+   * @return The offsets array.
+   */
+  const std::vector<std::size_t> &GetOffsets() const;
+
+  /**
+   * @brief Gets the column (CSR) or row (CSC) index of every non-zero.
+   *
+   * @return The indices array.
+   */
+  const std::vector<int> &GetIndices() const;
+
+  /**
+   * @brief Gets the value of every non-zero.
+   *
+   * @return The values array.
+   */
+  const std::vector<T> &GetValues() const;
+
+  /**
+   * @brief Computes the transpose of the matrix.
+   *
+   * The format of the matrix is kept.
+   */
+  void Transpose();
+
+  /**
+   * @brief Reads an element.
+   *
+   * Finds the element by binary search within its row or column.
+   *
+   * @param indices Row and column index of the element.
+   * @return The element, zero if it is not stored.
+   */
+  T operator[](std::pair<int, int> indices) const;
+
+  // Declaration of is-Member functions
+
+  /**
+   * @brief Checks if the matrix is square (rows == cols).
+   *
+   * @return true if the matrix is square, false otherwise.
+   */
+  bool IsSquare() const;
+
+  /**
+   * @brief Checks if the matrix is symmetric (A == A^T).
+   *
+   * @return true if the matrix is symmetric, false otherwise.
+   */
+  bool IsSymmetric() const;
+
+  /**
+   * @brief Checks if the matrix is diagonal.
+   *
+   * @return true if the matrix is diagonal, false otherwise.
+   */
+  bool IsDiagonal() const;
+
+  /**
+   * @brief Checks if the matrix is upper triangular.
+   *
+   * @return true if the matrix is upper triangular, false otherwise.
+   */
+  bool IsUpperTriangular() const;
+
+  /**
+   * @brief Checks if the matrix is lower triangular.
+   *
+   * @return true if the matrix is lower triangular, false otherwise.
+   */
+  bool IsLowerTriangular() const;
+
+  /**
+   * @brief Checks if the current matrix is addable to another matrix.
+   *
+   * @param other The other matrix to compare dimensions.
+   * @return true if matrices can be added, false otherwise.
+   */
+  bool IsAddable(const CDS_SparseMatrix<T> &other) const;
+
+  /**
+   * @brief Checks if the current matrix can be multiplied by a dense matrix.
+   *
+   * @param other The other matrix to check multiplication compatibility.
+   * @return true if matrices can be multiplied, false otherwise.
+   */
+  bool IsMultipliable(const CDS_Matrix<T> &other) const;
+
+private:
+  int _Rows, _Cols;                 ///< Number of rows and columns
+  Format _Format;                   ///< Compression direction
+  _Sparse::_Compressed<T> _Storage; ///< The compressed elements
+
+  /**
+   * @brief Gets the number of major lines (rows for CSR, columns for CSC).
+   *
+   * @return The number of major lines.
+   */
+  int _Major() const;
+
+  /**
+   * @brief Gets the number of minor lines (columns for CSR, rows for CSC).
+   *
+   * @return The number of minor lines.
+   */
+  int _Minor() const;
+
+  /**
+   * @brief Splits the major lines into bands of about equal non-zero count.
+   *
+   * @return Boundaries of the bands, starting with 0 and ending with the
+   * number of major lines.
+   */
+  std::vector<int> _Bands() const;
+
+  /**
+   * @brief Checks that no element lies on a given side of the diagonal.
+   *
+   * @param below Whether to check below (true) or above (false) it.
+   * @return true if that side only holds zeros.
+   */
+  bool _IsZeroBeyondDiagonal(bool below) const;
+};
+
+#include "CDS_SparseMatrix.ipp"
@@ -0,0 +1,290 @@
+#pragma once
+
+/**
+ * @file CDS_StaticMatrix.hpp
+ * @brief Header file for the CDS_StaticMatrix class template.
+ *
+ * CDS_StaticMatrix is the fixed-size counterpart of CDS_Matrix for small
+ * linear algebra such as 2D/3D transforms. Its shape is part of the type, its
+ * elements live inline in a CDS_Arr, and every operation is constexpr.
+ */
+
+#include "CDS_Arr.hpp"
+#include "CDS_MatrixView.hpp"
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace _Static {
+
+/**
+ * @brief Largest trip count that is unrolled at compile time, longer loops
+ * are emitted as ordinary loops to keep code size in check.
+ */
+constexpr int _UNROLL = 64;
+
+/**
+ * @brief Calls body(i) for every i in [0, N).
+ *
+ * Up to _UNROLL iterations are expanded into straight-line code, each call
+ * receiving its index as a constant.
+ *
+ * @tparam N Number of iterations.
+ * @param body Callable taking the iteration index.
+ */
+template <int N, class F> constexpr void _For(F &&body);
+
+} // namespace _Static
+
+/**
+ * @brief A matrix whose shape is fixed at compile time.
+ *
+ * Elements are stored row by row in a CDS_Arr, so the matrix lives on the
+ * stack and copies are plain memberwise copies. Products, determinants and
+ * inverses of matrices up to 4x4 use closed forms with fully unrolled loops.
+ * Mismatched shapes do not compile, so there is no run-time counterpart to
+ * CDS_Matrix::IsAddable or CDS_Matrix::IsMultipliable.
+ *
+ * View() hands the elements out as a CDS_MatrixView, from which a dynamic
+ * CDS_Matrix can be constructed.
+ *
+ * @tparam T Type of the elements in the matrix (e.g., float, double, int).
+ * @tparam R Number of rows.
+ * @tparam C Number of columns.
+ */
+template <class T, int R, int C> class CDS_StaticMatrix {
+  static_assert(R > 0 && C > 0, "Matrix dimensions must be positive");
+
+public:
+  using value_type = T;
+
+  static constexpr int Rows = R; ///< Number of rows.
+  static constexpr int Cols = C; ///< Number of columns.
+
+  /**
+   * @brief Constructs a matrix with all elements set to zero.
+   */
+  constexpr CDS_StaticMatrix();
+
+  /**
+   * @brief Constructs a matrix from its elements in row-major order.
+   *
+   * @param elems Exactly R * C values.
+   */
+  template <class... U>
+    requires(sizeof...(U) == R * C && sizeof...(U) > 1 &&
+             (std::is_convertible_v<U, T> && ...))
+  constexpr CDS_StaticMatrix(U... elems);
+
+  /**
+   * @brief Constructs a matrix from an array in row-major order.
+   *
+   * @param elems The elements.
+   */
+  constexpr explicit CDS_StaticMatrix(const CDS_Arr<T, R * C> &elems);
+
+  /**
+   * @brief Creates an identity matrix.
+   *
+   * @return Identity matrix.
+   */
+  static constexpr CDS_StaticMatrix<T, R, C> Identity()
+    requires(R == C);
+
+  /**
+   * @brief Creates a null matrix.
+   *
+   * @return Matrix with all elements set to zero.
+   */
+  static constexpr CDS_StaticMatrix<T, R, C> Null();
+
+  /**
+   * @brief Creates a rotation matrix.
+   *
+   * The rotation is by the given angle in the plane of the first two axes
+   * (about the z axis in 3D), matching CDS_Matrix::SetDegree.
+   *
+   * @param degree Degree of rotation.
+   * @return Rotation matrix.
+   */
+  static CDS_StaticMatrix<T, R, C> Rotation(float degree)
+    requires(R == C && R >= 2);
+
+  /**
+   * @brief Performs matrix multiplication with another matrix.
+   *
+   * @tparam K Number of columns of the other matrix.
+   * @param other The matrix to multiply with.
+   * @return Resulting R x K matrix.
+   */
+  template <int K>
+  constexpr CDS_StaticMatrix<T, R, K>
+  operator*(const CDS_StaticMatrix<T, C, K> &other) const;
+
+  /**
+   * @brief Multiplies the matrix by a vector.
+   *
+   * @param vector Vector with C elements.
+   * @return Resulting vector with R elements.
+   */
+  constexpr CDS_Arr<T, R> operator*(const CDS_Arr<T, C> &vector) const;
+
+  /**
+   * @brief Performs element-wise addition with another matrix.
+   *
+   * @param other The matrix to add.
+   * @return Resulting matrix.
+   */
+  constexpr CDS_StaticMatrix<T, R, C>
+  operator+(const CDS_StaticMatrix<T, R, C> &other) const;
+
+  /**
+   * @brief Performs element-wise subtraction with another matrix.
+   *
+   * @param other The matrix to subtract.
+   * @return Resulting matrix.
+   */
+  constexpr CDS_StaticMatrix<T, R, C>
+  operator-(const CDS_StaticMatrix<T, R, C> &other) const;
+
+  /**
+   * @brief Compares two matrices element by element.
+   *
+   * @param other The matrix to compare with.
+   * @return True if all elements are equal, otherwise false.
+   */
+  constexpr bool operator==(const CDS_StaticMatrix<T, R, C> &other) const;
+
+  /**
+   * @brief Accesses an element.
+   *
+   * @param index A pair of (row, col).
+   * @return Reference to the element.
+   */
+  constexpr T &operator[](std::pair<int, int> index);
+
+  /**
+   * @brief Accesses an element (read-only).
+   *
+   * @param index A pair of (row, col).
+   * @return Const reference to the element.
+   */
+  constexpr const T &operator[](std::pair<int, int> index) const;
+
+  /**
+   * @brief Gets the shape of the matrix (rows, cols).
+   *
+   * @return A tuple containing the number of rows and columns.
+   */
+  constexpr std::tuple<int, int> GetShape() const;
+
+  /**
+   * @brief Gets a pointer to the elements in row-major order.
+   *
+   * @return Pointer to element (0, 0).
+   */
+  constexpr T *GetData();
+
+  /**
+   * @brief Gets a read-only pointer to the elements in row-major order.
+   *
+   * @return Pointer to element (0, 0).
+   */
+  constexpr const T *GetData() const;
+
+  /**
+   * @brief Gets a view of the whole matrix.
+   *
+   * @return A view sharing the elements of this matrix.
+   */
+  CDS_MatrixView<T> View();
+
+  /**
+   * @brief Gets a read-only view of the whole matrix.
+   *
+   * @return A view sharing the elements of this matrix.
+   */
+  CDS_MatrixView<const T> View() const;
+
+  /**
+   * @brief Returns the transpose of the matrix.
+   *
+   * @return Transposed C x R matrix.
+   */
+  constexpr CDS_StaticMatrix<T, C, R> Transposed() const;
+
+  /**
+   * @brief Transposes the matrix in place.
+   */
+  constexpr void Transpose()
+    requires(R == C);
+
+  /**
+   * @brief Returns the inverse of the matrix.
+   *
+   * The matrix must be invertible.
+   *
+   * @return Inverse matrix.
+   */
+  constexpr CDS_StaticMatrix<T, R, C> Inverted() const
+    requires(R == C);
+
+  /**
+   * @brief Inverts the matrix in place.
+   *
+   * The matrix must be invertible.
+   */
+  constexpr void Inverse()
+    requires(R == C);
+
+  /**
+   * @brief Calculates the determinant of the matrix.
+   *
+   * Closed forms are used up to 4x4. Larger matrices are reduced by Gaussian
+   * elimination with partial pivoting, or by fraction-free (Bareiss)
+   * elimination when T is an integer type, which keeps the result exact.
+   *
+   * @return Determinant of the matrix.
+   */
+  constexpr T Determinant() const
+    requires(R == C);
+
+  /**
+   * @brief Calculates the trace of the matrix.
+   *
+   * @return Sum of the diagonal elements.
+   */
+  constexpr T Trace() const
+    requires(R == C);
+
+private:
+  CDS_Arr<T, R * C> _Arr; ///< Elements in row-major order.
+
+  /**
+   * @brief Inverts a matrix larger than 4x4 by Gauss-Jordan elimination.
+   *
+   * @return Inverse matrix.
+   */
+  constexpr CDS_StaticMatrix<T, R, C> _GaussJordanInverse() const;
+};
+
+/**
+ * @brief Scales a matrix by a scalar.
+ *
+ * @param scalar Scalar value to multiply the matrix by.
+ * @param matrix The matrix to scale.
+ * @return Resulting matrix.
+ */
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C>
+operator*(const T &scalar, const CDS_StaticMatrix<T, R, C> &matrix);
+
+/**
+ * @brief Fixed-size square matrix aliases for geometry code.
+ */
+template <class T> using CDS_Matrix2 = CDS_StaticMatrix<T, 2, 2>;
+template <class T> using CDS_Matrix3 = CDS_StaticMatrix<T, 3, 3>;
+template <class T> using CDS_Matrix4 = CDS_StaticMatrix<T, 4, 4>;
+
+#include "CDS_StaticMatrix.ipp"
@@ -0,0 +1,54 @@
+#pragma once
+
+/**
+ * @file CDS_StringHash.hpp
+ * @brief Fast hash and equality for string keys, usable without a
+ * std::string.
+ *
+ * The hash is wyhash: a few 64x64->128 bit multiplications per 16 bytes of
+ * input, good enough for hash tables and not meant to resist attackers who
+ * choose the keys. Both function objects are transparent, so a
+ * CDS_HashMap<std::string, V, CDS_StringHash, CDS_StringEqual> looks keys up
+ * from a std::string_view, a const char * or a span of bytes as they are.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/**
+ * @brief Hash a range of bytes.
+ *
+ * The result depends on the byte order of the machine.
+ *
+ * @param data Pointer to the bytes.
+ * @param length Number of bytes.
+ * @param seed Seed, different seeds give independent hash functions.
+ * @return The hash.
+ */
+std::uint64_t CDS_HashBytes(const void *data, std::size_t length,
+                            std::uint64_t seed = 0);
+
+/**
+ * @brief Hash of string keys, equal for a string and its view or bytes.
+ */
+struct CDS_StringHash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view key) const;
+  std::size_t operator()(std::span<const std::byte> key) const;
+};
+
+/**
+ * @brief Equality of string keys, compares a stored key with a string or
+ * with raw bytes.
+ */
+struct CDS_StringEqual {
+  using is_transparent = void;
+
+  bool operator()(std::string_view key, std::string_view other) const;
+  bool operator()(std::string_view key, std::span<const std::byte> other) const;
+};
+
+#include "CDS_StringHash.ipp"
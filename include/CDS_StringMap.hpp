@@ -0,0 +1,203 @@
+#pragma once
+
+/**
+ * @file CDS_StringMap.hpp
+ * @brief Hash map from strings that owns copies of its keys in an arena.
+ *
+ * Keys are copied once, when they are first inserted, into a CDS_Arena the
+ * map owns, and the table stores string views into it. Lookups take a
+ * std::string_view, a const char * or a span of bytes, so finding a key
+ * read from a buffer allocates nothing, and neither does Set or operator[]
+ * on a key that exists already. New keys only bump the arena pointer, which
+ * goes to the heap once per block.
+ */
+
+#include "CDS_Allocator.hpp"
+#include "CDS_HashMap.hpp"
+#include "CDS_Result.hpp"
+#include "CDS_StringHash.hpp"
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+
+/**
+ * @brief Hash map from strings with interned keys.
+ *
+ * The bytes of a deleted key stay in the arena until Clear, so a map whose
+ * keys keep changing grows without bound; rebuild it or use a
+ * CDS_HashMap<std::string, V, CDS_StringHash, CDS_StringEqual> instead.
+ * Views of the keys passed to ForEach stay valid until Clear.
+ *
+ * @tparam V Type of the values.
+ */
+template <class V> class CDS_StringMap {
+public:
+  using key_type = std::string_view;
+  using mapped_type = V;
+
+  /**
+   * @brief Constructs an empty map, nothing is allocated until the first
+   * insertion.
+   *
+   * @param maxLoadFactor Fraction of the slots that may be in use, between
+   * 0 and 1.
+   */
+  explicit CDS_StringMap(float maxLoadFactor = 0.875f);
+
+  /**
+   * @brief Copy constructor, copies the keys into an arena of its own.
+   */
+  CDS_StringMap(const CDS_StringMap &other);
+
+  /**
+   * @brief Move constructor, steals the table and the arena of the other
+   * map.
+   */
+  CDS_StringMap(CDS_StringMap &&other) noexcept = default;
+
+  /**
+   * @brief Copy and move assignment.
+   */
+  CDS_StringMap &operator=(CDS_StringMap other) noexcept;
+
+  // Getters
+
+  /**
+   * @brief Get the number of entries.
+   *
+   * @return The number of entries in the map.
+   */
+  std::size_t GetSize() const;
+
+  /**
+   * @brief Get the number of slots of the table.
+   *
+   * @return The capacity of the table.
+   */
+  std::size_t GetCapacity() const;
+
+  /**
+   * @brief Get the number of bytes taken by keys, including those of
+   * deleted entries.
+   *
+   * @return The bytes used in the arena.
+   */
+  std::size_t GetKeyBytes() const;
+
+  /**
+   * @brief Get a copy of the value of a key.
+   *
+   * @param key The key to look up.
+   * @return The value, or an error if the key does not exist.
+   */
+  CDS_Result<V> Get(std::string_view key) const;
+  CDS_Result<V> Get(std::span<const std::byte> key) const;
+
+  /**
+   * @brief Find the value of a key without copying it.
+   *
+   * @param key The key to look up.
+   * @return Pointer to the value, null if the key does not exist.
+   */
+  V *Find(std::string_view key);
+  const V *Find(std::string_view key) const;
+  V *Find(std::span<const std::byte> key);
+  const V *Find(std::span<const std::byte> key) const;
+
+  /**
+   * @brief Check whether a key exists.
+   *
+   * @param key The key to look up.
+   * @return true if the map holds the key.
+   */
+  bool Contains(std::string_view key) const;
+  bool Contains(std::span<const std::byte> key) const;
+
+  // Modifiers
+
+  /**
+   * @brief Insert a new entry, copying the key into the arena.
+   *
+   * @param key The key.
+   * @param value The value.
+   * @return Pointer to the stored value, or an error if the key already
+   * exists, in which case the map is not changed.
+   */
+  CDS_Result<V *> Insert(std::string_view key, V value);
+
+  /**
+   * @brief Insert an entry or overwrite the value of an existing key.
+   *
+   * @param key The key, copied into the arena if it is new.
+   * @param value The value.
+   * @return A reference to the stored value.
+   */
+  V &Set(std::string_view key, V value);
+
+  /**
+   * @brief Remove an entry. The bytes of the key stay in the arena.
+   *
+   * @param key The key to remove.
+   * @return The value the key had, or an error if the key does not exist.
+   */
+  CDS_Result<V> Delete(std::string_view key);
+  CDS_Result<V> Delete(std::span<const std::byte> key);
+
+  /**
+   * @brief Remove every entry and free the keys, keeping the table and the
+   * arena blocks.
+   */
+  void Clear();
+
+  /**
+   * @brief Grow the table so that it holds a number of entries without
+   * growing again.
+   *
+   * @param count Number of entries.
+   */
+  void Reserve(std::size_t count);
+
+  /**
+   * @brief Call a function on every entry, in table order.
+   *
+   * @tparam Function Type of the function.
+   * @param function Called with a view of the key and a reference to the
+   * value.
+   */
+  template <class Function> void ForEach(Function function);
+  template <class Function> void ForEach(Function function) const;
+
+  /**
+   * @brief Swap the contents of two maps.
+   *
+   * @param other The other map.
+   */
+  void Swap(CDS_StringMap &other) noexcept;
+
+  // Operator Overloads
+
+  /**
+   * @brief Access the value of a key, inserting a value-initialized one if
+   * the key does not exist.
+   *
+   * @param key The key.
+   * @return A reference to the value.
+   */
+  V &operator[](std::string_view key);
+
+private:
+  CDS_HashMap<std::string_view, V, CDS_StringHash, CDS_StringEqual>
+      _Map;                         ///< Views of the keys to the values
+  std::unique_ptr<CDS_Arena> _Keys; ///< Bytes of the keys, made on demand
+
+  /**
+   * @brief Copy a key into the arena.
+   *
+   * @param key The key.
+   * @return A view of the copy.
+   */
+  std::string_view Intern(std::string_view key);
+};
+
+#include "CDS_StringMap.ipp"
@@ -0,0 +1,212 @@
+#pragma once
+
+/**
+ * @file CDS_ThreadPool.hpp
+ * @brief Work-stealing thread pool used by the parallel CDS algorithms.
+ *
+ * The pool is owned by the library and created on first use. Every worker
+ * has its own task deque: it pops its own tasks from the back and steals
+ * from the front of the other deques when it runs dry. A thread waiting for
+ * a parallel loop helps executing tasks instead of blocking, so parallel
+ * loops may be nested.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Library-owned work-stealing thread pool.
+ *
+ * Work below the serial cutoff is always run on the calling thread, so
+ * small inputs never pay for waking up workers.
+ */
+class CDS_ThreadPool {
+public:
+  /**
+   * @brief Gets the pool shared by the whole library.
+   *
+   * @return A reference to the pool.
+   */
+  static CDS_ThreadPool &Instance();
+
+  CDS_ThreadPool(const CDS_ThreadPool &) = delete;
+  CDS_ThreadPool &operator=(const CDS_ThreadPool &) = delete;
+
+  /**
+   * @brief Destructor.
+   *
+   * Stops and joins all workers.
+   */
+  ~CDS_ThreadPool();
+
+  /**
+   * @brief Sets the number of threads taking part in parallel loops.
+   *
+   * The calling thread counts as one of them, so a count of 1 makes every
+   * loop serial. Must not be called while a parallel loop is running.
+   *
+   * @param count The new number of threads, 0 selects the hardware
+   * concurrency.
+   */
+  void SetThreadCount(std::size_t count);
+
+  /**
+   * @brief Gets the number of threads taking part in parallel loops.
+   *
+   * @return The number of threads including the calling thread.
+   */
+  std::size_t GetThreadCount() const;
+
+  /**
+   * @brief Sets the amount of work below which loops run serially.
+   *
+   * Work is counted in scalar operations, e.g. rows * cols for element-wise
+   * operations or m * n * k for a matrix product.
+   *
+   * @param work The new serial cutoff.
+   */
+  void SetSerialCutoff(std::size_t work);
+
+  /**
+   * @brief Gets the amount of work below which loops run serially.
+   *
+   * @return The serial cutoff.
+   */
+  std::size_t GetSerialCutoff() const;
+
+  /**
+   * @brief Checks if a loop of the given size would run serially.
+   *
+   * @param work Amount of work of the loop.
+   * @return true if the work is below the cutoff or only one thread is used.
+   */
+  bool IsSerial(std::size_t work) const;
+
+  /**
+   * @brief Runs body(index) for every index in [0, count) and waits.
+   *
+   * If the body throws, the iterations that have not started are skipped and
+   * the first exception is rethrown on the calling thread once the running
+   * ones have finished.
+   *
+   * @tparam F Type of the loop body.
+   * @param count Number of iterations.
+   * @param work Total amount of work, compared against the serial cutoff.
+   * @param body The loop body.
+   */
+  template <class F>
+  void ParallelFor(std::size_t count, std::size_t work, F &&body);
+
+  /**
+   * @brief Splits a rows x cols domain into tiles and runs them in parallel.
+   *
+   * The body is called as body(rowBegin, rowEnd, colBegin, colEnd) once per
+   * tile. Below the serial cutoff it is called once for the whole domain.
+   * Exceptions propagate as in ParallelFor.
+   *
+   * @tparam F Type of the tile body.
+   * @param rows Number of rows of the domain.
+   * @param cols Number of columns of the domain.
+   * @param tileRows Number of rows per tile.
+   * @param tileCols Number of columns per tile.
+   * @param work Total amount of work, compared against the serial cutoff.
+   * @param body The tile body.
+   */
+  template <class F>
+  void ParallelFor2D(int rows, int cols, int tileRows, int tileCols,
+                     std::size_t work, F &&body);
+
+private:
+  /**
+   * @brief State of one parallel loop, shared by its tasks.
+   *
+   * Lives on the stack of the dispatching thread, which waits until Pending
+   * drops to zero, so every task must decrement it, even one that throws.
+   */
+  struct _Loop {
+    std::atomic<std::size_t> Pending; ///< Unfinished tasks of the loop.
+    std::atomic<bool> Failed{false};  ///< Set by the first throwing task.
+    std::exception_ptr Error;         ///< Exception of that task.
+  };
+
+  /**
+   * @brief A single unit of work, one iteration of a parallel loop.
+   */
+  struct _Task {
+    void (*Run)(void *, std::size_t); ///< Type-erased loop body.
+    void *Context;                    ///< The loop body object.
+    std::size_t Index;                ///< Iteration index.
+    _Loop *Loop;                      ///< The loop the task belongs to.
+  };
+
+  /**
+   * @brief Task deque owned by one thread, stolen from by the others.
+   */
+  struct _Queue {
+    std::mutex Mutex;
+    std::deque<_Task> Tasks;
+  };
+
+  std::vector<std::unique_ptr<_Queue>> _Queues; ///< Queue 0 is for callers.
+  std::vector<std::thread> _Threads;            ///< Background workers.
+  std::mutex _SleepMutex;                       ///< Guards sleeping workers.
+  std::condition_variable _Wake;                ///< Wakes sleeping workers.
+  std::atomic<std::size_t> _Queued;             ///< Tasks in all queues.
+  std::atomic<std::size_t> _Next;               ///< Round-robin cursor.
+  bool _Stop;                                   ///< Tells workers to exit.
+  std::size_t _ThreadCount;                     ///< Threads incl. caller.
+  std::size_t _SerialCutoff;                    ///< Serial work threshold.
+
+  CDS_ThreadPool();
+
+  /**
+   * @brief Starts count - 1 background workers.
+   *
+   * @param count Number of threads including the caller.
+   */
+  void _Start(std::size_t count);
+
+  /**
+   * @brief Stops and joins all background workers.
+   */
+  void _Shutdown();
+
+  /**
+   * @brief Runs a type-erased loop on the pool and waits for it.
+   *
+   * Rethrows the first exception of the loop body after all tasks are done.
+   *
+   * @param count Number of iterations.
+   * @param run Function running one iteration.
+   * @param context Object passed to run.
+   */
+  void _Dispatch(std::size_t count, void (*run)(void *, std::size_t),
+                 void *context);
+
+  /**
+   * @brief Takes one task from the own queue or steals one and runs it.
+   *
+   * An exception of the task is stored in its loop instead of escaping, and
+   * the tasks of a loop that already failed are not run.
+   *
+   * @param self Index of the queue owned by the calling thread.
+   * @return true if a task was run, false if all queues were empty.
+   */
+  bool _TryRun(std::size_t self);
+
+  /**
+   * @brief Main loop of a background worker.
+   *
+   * @param self Index of the queue owned by the worker.
+   */
+  void _WorkerLoop(std::size_t self);
+};
+
+#include "CDS_ThreadPool.ipp"
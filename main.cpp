@@ -26,9 +26,9 @@ int main() {
   matrixC.SetColumn(1, std::vector<float>{0.1, 0.2, 0.3});
   matrixC.SetRow(1, std::vector<float>{0.1, 0.2, 0.3});
   CDS_Matrix<float> submatrix = matrixC.ExcludeColumns({2}).ExcludeRows({0, 2});
-  std::vector<float> diagonal = matrixC.GetDiagonal();
-  std::vector<float> column = matrixC.GetColumn(1);
-  std::vector<float> row = matrixC.GetRow(1);
+  CDS_VectorView<float> diagonal = matrixC.GetDiagonal();
+  CDS_VectorView<float> column = matrixC.GetColumn(1);
+  CDS_VectorView<float> row = matrixC.GetRow(1);
   std::tuple<int, int> shape = matrixC.GetShape();
 
   matrixA++;
@@ -62,12 +62,11 @@ int main() {
   std::pair<CDS_Matrix<float>, CDS_Matrix<float>> RQtuple =
       matrixA.Decompose(CDS_Matrix<float>::Order::RQ);
 
-  std::tuple<std::vector<float>> eigenVectors = matrixA.Eigenvecs();
-  std::tuple<float> eigenValues = matrixA.Eigenvals();
+  CDS_Matrix<std::complex<float>> eigenVectors = matrixA.Eigenvecs();
+  std::vector<std::complex<float>> eigenValues = matrixA.Eigenvals();
 }
 */
 
 int main() {
   CDS_SimpleHashMap map;
-  map.Print();
 }
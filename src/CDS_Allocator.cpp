@@ -0,0 +1,176 @@
+#include "CDS_Allocator.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace {
+
+/**
+ * @brief Bytes needed to move an address up to an alignment.
+ */
+std::size_t Padding(const void *pointer, std::size_t alignment) {
+  auto address = reinterpret_cast<std::uintptr_t>(pointer);
+  return static_cast<std::size_t>(-address & (alignment - 1));
+}
+
+/**
+ * @brief Doubling stops here, later blocks all have this size.
+ */
+constexpr std::size_t MAX_BLOCK = std::size_t(16) << 20;
+
+/**
+ * @brief Alignment of pool slabs, chunks are aligned to the smaller of this
+ * and their size.
+ */
+constexpr std::size_t SLAB_ALIGNMENT = 64;
+
+} // namespace
+
+// CDS_Arena
+CDS_Arena::CDS_Arena(std::size_t blockSize)
+    : _BlockSize(std::max<std::size_t>(blockSize, 256)) {}
+
+CDS_Arena::~CDS_Arena() {
+  for (_Block *block = this->_First; block;) {
+    _Block *next = block->Next;
+    ::operator delete(block);
+    block = next;
+  }
+}
+
+void *CDS_Arena::Allocate(std::size_t bytes, std::size_t alignment) {
+  std::size_t padding = Padding(this->_Cursor, alignment);
+  if (!this->_Cursor ||
+      padding + bytes > static_cast<std::size_t>(this->_End - this->_Cursor)) {
+    this->_Advance(bytes, alignment);
+    padding = Padding(this->_Cursor, alignment);
+  }
+  char *pointer = this->_Cursor + padding;
+  this->_Cursor = pointer + bytes;
+  return pointer;
+}
+
+void CDS_Arena::Deallocate(void *pointer, std::size_t bytes, std::size_t) {
+  if (static_cast<char *>(pointer) + bytes == this->_Cursor)
+    this->_Cursor = static_cast<char *>(pointer);
+}
+
+void CDS_Arena::Reset() {
+  this->_Used = 0;
+  if (this->_First)
+    this->_Enter(this->_First);
+}
+
+std::size_t CDS_Arena::GetUsed() const {
+  if (!this->_Current)
+    return 0;
+  return this->_Used +
+         (this->_Cursor - reinterpret_cast<char *>(this->_Current + 1));
+}
+
+std::size_t CDS_Arena::GetCapacity() const {
+  std::size_t capacity = 0;
+  for (_Block *block = this->_First; block; block = block->Next) {
+    capacity += block->Size;
+  }
+  return capacity;
+}
+
+void CDS_Arena::_Enter(_Block *block) {
+  this->_Current = block;
+  this->_Cursor = reinterpret_cast<char *>(block + 1);
+  this->_End = this->_Cursor + block->Size;
+}
+
+void CDS_Arena::_Advance(std::size_t bytes, std::size_t alignment) {
+  // Block headers keep the data max_align_t aligned, larger alignments may
+  // need up to alignment - 1 bytes of padding.
+  std::size_t needed = bytes + alignment - 1;
+  _Block *last = this->_Current;
+  _Block *next = this->_First;
+  if (this->_Current) {
+    this->_Used +=
+        this->_Cursor - reinterpret_cast<char *>(this->_Current + 1);
+    next = this->_Current->Next;
+  }
+  // Blocks kept from before a Reset are reused in order, one that is too
+  // small for this request is skipped until the next Reset.
+  while (next && next->Size < needed) {
+    last = next;
+    next = next->Next;
+  }
+  if (!next) {
+    std::size_t size = std::max(this->_BlockSize, needed);
+    next = static_cast<_Block *>(::operator new(sizeof(_Block) + size));
+    next->Size = size;
+    next->Next = nullptr;
+    if (last)
+      last->Next = next;
+    else
+      this->_First = next;
+    this->_BlockSize = std::min(this->_BlockSize * 2,
+                                std::max(this->_BlockSize, MAX_BLOCK));
+  }
+  this->_Enter(next);
+}
+
+// CDS_Pool
+CDS_Pool::CDS_Pool(std::size_t slabSize)
+    : _SlabSize(std::max(slabSize, SLAB_ALIGNMENT + _LARGEST)) {}
+
+CDS_Pool::~CDS_Pool() {
+  while (this->_Slabs) {
+    void *next = *static_cast<void **>(this->_Slabs);
+    ::operator delete(this->_Slabs, std::align_val_t(SLAB_ALIGNMENT));
+    this->_Slabs = next;
+  }
+}
+
+void *CDS_Pool::Allocate(std::size_t bytes, std::size_t alignment) {
+  std::size_t index = _Class(bytes, alignment);
+  if (index == _CLASSES)
+    return ::operator new(bytes, std::align_val_t(alignment));
+  if (!this->_Free[index])
+    this->_Refill(index);
+  _Chunk *chunk = this->_Free[index];
+  this->_Free[index] = chunk->Next;
+  return chunk;
+}
+
+void CDS_Pool::Deallocate(void *pointer, std::size_t bytes,
+                          std::size_t alignment) {
+  std::size_t index = _Class(bytes, alignment);
+  if (index == _CLASSES) {
+    ::operator delete(pointer, std::align_val_t(alignment));
+    return;
+  }
+  _Chunk *chunk = static_cast<_Chunk *>(pointer);
+  chunk->Next = this->_Free[index];
+  this->_Free[index] = chunk;
+}
+
+std::size_t CDS_Pool::_Class(std::size_t bytes, std::size_t alignment) {
+  std::size_t size = std::max({bytes, alignment, _SMALLEST});
+  if (size > _LARGEST || alignment > SLAB_ALIGNMENT)
+    return _CLASSES;
+  return std::bit_width(size - 1) - std::bit_width(_SMALLEST - 1);
+}
+
+void CDS_Pool::_Refill(std::size_t index) {
+  char *slab = static_cast<char *>(
+      ::operator new(this->_SlabSize, std::align_val_t(SLAB_ALIGNMENT)));
+  *reinterpret_cast<void **>(slab) = this->_Slabs;
+  this->_Slabs = slab;
+
+  // The first line holds the slab link, chunks follow back to front so the
+  // free list hands them out in address order.
+  std::size_t size = _SMALLEST << index;
+  std::size_t count = (this->_SlabSize - SLAB_ALIGNMENT) / size;
+  for (std::size_t i = count; i-- > 0;) {
+    _Chunk *chunk =
+        reinterpret_cast<_Chunk *>(slab + SLAB_ALIGNMENT + i * size);
+    chunk->Next = this->_Free[index];
+    this->_Free[index] = chunk;
+  }
+}
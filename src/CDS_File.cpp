@@ -0,0 +1,155 @@
+#include "CDS_File.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace _File {
+
+Mapping::~Mapping() {
+  if (this->Address)
+    munmap(const_cast<void *>(this->Address), this->Length);
+}
+
+CDS_Result<std::shared_ptr<const Mapping>> MapFile(const std::string &path) {
+  using Result = CDS_Result<std::shared_ptr<const Mapping>>;
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return Result::Failure("Cannot open " + path + ": " + std::strerror(errno));
+
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    std::string error = std::strerror(errno);
+    close(fd);
+    return Result::Failure("Cannot stat " + path + ": " + error);
+  }
+  if (status.st_size == 0) {
+    close(fd);
+    return Result::Failure(path + " is empty");
+  }
+
+  // The mapping keeps the file alive on its own, the descriptor can go.
+  std::size_t length = static_cast<std::size_t>(status.st_size);
+  void *address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+  std::string error = std::strerror(errno);
+  close(fd);
+  if (address == MAP_FAILED)
+    return Result::Failure("Cannot map " + path + ": " + error);
+
+  std::shared_ptr<Mapping> mapping = std::make_shared<Mapping>();
+  mapping->Address = address;
+  mapping->Length = length;
+  return Result::Success(std::move(mapping));
+}
+
+SharedMapping::~SharedMapping() {
+  if (this->Address)
+    munmap(this->Address, this->Length);
+  if (!this->Temporary.empty())
+    unlink(this->Temporary.c_str());
+  if (this->Descriptor >= 0)
+    close(this->Descriptor);
+}
+
+CDS_Result<std::unique_ptr<SharedMapping>>
+OpenShared(const std::string &path) {
+  using Result = CDS_Result<std::unique_ptr<SharedMapping>>;
+  std::unique_ptr<SharedMapping> mapping = std::make_unique<SharedMapping>();
+  mapping->Descriptor = open(path.c_str(), O_RDWR | O_CLOEXEC);
+  if (mapping->Descriptor < 0 && errno == ENOENT) {
+    // A new file is built under a unique name and linked into place later.
+    std::string temporary = path + ".XXXXXX";
+    mapping->Descriptor = mkostemp(temporary.data(), O_CLOEXEC);
+    if (mapping->Descriptor >= 0)
+      mapping->Temporary = temporary;
+  }
+  if (mapping->Descriptor < 0)
+    return Result::Failure("Cannot open " + path + ": " + std::strerror(errno));
+
+  // The lock goes with the descriptor, closing it unlocks the file.
+  if (flock(mapping->Descriptor, LOCK_EX | LOCK_NB) != 0) {
+    if (errno == EWOULDBLOCK)
+      return Result::Failure(path + " is open in another process");
+    return Result::Failure("Cannot lock " + path + ": " +
+                           std::strerror(errno));
+  }
+
+  struct stat status;
+  if (fstat(mapping->Descriptor, &status) != 0)
+    return Result::Failure("Cannot stat " + path + ": " +
+                           std::strerror(errno));
+  std::size_t length = static_cast<std::size_t>(status.st_size);
+  if (length) {
+    void *address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         mapping->Descriptor, 0);
+    if (address == MAP_FAILED)
+      return Result::Failure("Cannot map " + path + ": " +
+                             std::strerror(errno));
+    mapping->Address = address;
+    mapping->Length = length;
+  }
+  return Result{std::move(mapping), std::nullopt};
+}
+
+CDS_Result<std::string> Publish(SharedMapping &mapping,
+                                const std::string &path) {
+  // link, unlike rename, never replaces a file another process created.
+  if (fsync(mapping.Descriptor) != 0 ||
+      link(mapping.Temporary.c_str(), path.c_str()) != 0)
+    return CDS_Result<std::string>::Failure("Cannot create " + path + ": " +
+                                            std::strerror(errno));
+  unlink(mapping.Temporary.c_str());
+  mapping.Temporary.clear();
+
+  std::string directory = path.substr(0, path.find_last_of('/') + 1);
+  int fd = open(directory.empty() ? "." : directory.c_str(),
+                O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  bool synced = fd >= 0 && fsync(fd) == 0;
+  std::string error = std::strerror(errno);
+  if (fd >= 0)
+    close(fd);
+  if (!synced)
+    return CDS_Result<std::string>::Failure("Cannot sync the directory of " +
+                                            path + ": " + error);
+  return CDS_Result<std::string>::Success(path);
+}
+
+CDS_Result<std::size_t> Resize(SharedMapping &mapping, std::size_t length) {
+  if (ftruncate(mapping.Descriptor, static_cast<off_t>(length)) != 0)
+    return CDS_Result<std::size_t>::Failure(
+        std::string("Cannot resize the file: ") + std::strerror(errno));
+  if (mapping.Address)
+    munmap(mapping.Address, mapping.Length);
+  mapping.Address = nullptr;
+  mapping.Length = 0;
+  if (length) {
+    void *address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         mapping.Descriptor, 0);
+    if (address == MAP_FAILED)
+      return CDS_Result<std::size_t>::Failure(
+          std::string("Cannot map the file: ") + std::strerror(errno));
+    mapping.Address = address;
+    mapping.Length = length;
+  }
+  return CDS_Result<std::size_t>::Success(length);
+}
+
+CDS_Result<std::size_t> Sync(const SharedMapping &mapping, std::size_t offset,
+                             std::size_t length) {
+  std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  std::size_t start = offset / page * page;
+  length += offset - start;
+  if (!length)
+    return CDS_Result<std::size_t>::Success(0);
+  if (msync(static_cast<char *>(mapping.Address) + start, length, MS_SYNC) !=
+      0)
+    return CDS_Result<std::size_t>::Failure(
+        std::string("Cannot sync the file: ") + std::strerror(errno));
+  return CDS_Result<std::size_t>::Success(length);
+}
+
+} // namespace _File
@@ -0,0 +1,212 @@
+#include "CDS_Gemm.hpp"
+#include "CDS_Simd.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _CDS_GEMM_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using _Simd::_Level;
+
+#if defined(_CDS_GEMM_X86)
+// SSE2, part of every x86-64 CPU, without FMA.
+namespace _Sse2 {
+#define _CDS_TARGET __attribute__((target("sse2")))
+
+template <class T> struct _Vec;
+
+template <> struct _Vec<float> {
+  using Reg = __m128;
+  static constexpr int Width = 4;
+  static constexpr int MR = 4;
+  static constexpr int NR = 8;
+  _CDS_TARGET static Reg Zero() { return _mm_setzero_ps(); }
+  _CDS_TARGET static Reg Load(const float *p) { return _mm_load_ps(p); }
+  _CDS_TARGET static void Store(float *p, Reg r) { _mm_store_ps(p, r); }
+  _CDS_TARGET static Reg Broadcast(float x) { return _mm_set1_ps(x); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+  }
+};
+
+template <> struct _Vec<double> {
+  using Reg = __m128d;
+  static constexpr int Width = 2;
+  static constexpr int MR = 4;
+  static constexpr int NR = 4;
+  _CDS_TARGET static Reg Zero() { return _mm_setzero_pd(); }
+  _CDS_TARGET static Reg Load(const double *p) { return _mm_load_pd(p); }
+  _CDS_TARGET static void Store(double *p, Reg r) { _mm_store_pd(p, r); }
+  _CDS_TARGET static Reg Broadcast(double x) { return _mm_set1_pd(x); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+  }
+};
+
+#include "CDS_GemmKernel.inc"
+
+#undef _CDS_TARGET
+} // namespace _Sse2
+
+// AVX2 with FMA, Haswell and later.
+namespace _Avx2 {
+#define _CDS_TARGET __attribute__((target("avx2,fma")))
+
+template <class T> struct _Vec;
+
+template <> struct _Vec<float> {
+  using Reg = __m256;
+  static constexpr int Width = 8;
+  static constexpr int MR = 6;
+  static constexpr int NR = 16;
+  _CDS_TARGET static Reg Zero() { return _mm256_setzero_ps(); }
+  _CDS_TARGET static Reg Load(const float *p) { return _mm256_load_ps(p); }
+  _CDS_TARGET static void Store(float *p, Reg r) { _mm256_store_ps(p, r); }
+  _CDS_TARGET static Reg Broadcast(float x) { return _mm256_set1_ps(x); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+};
+
+template <> struct _Vec<double> {
+  using Reg = __m256d;
+  static constexpr int Width = 4;
+  static constexpr int MR = 6;
+  static constexpr int NR = 8;
+  _CDS_TARGET static Reg Zero() { return _mm256_setzero_pd(); }
+  _CDS_TARGET static Reg Load(const double *p) { return _mm256_load_pd(p); }
+  _CDS_TARGET static void Store(double *p, Reg r) { _mm256_store_pd(p, r); }
+  _CDS_TARGET static Reg Broadcast(double x) { return _mm256_set1_pd(x); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm256_fmadd_pd(a, b, c);
+  }
+};
+
+#include "CDS_GemmKernel.inc"
+
+#undef _CDS_TARGET
+} // namespace _Avx2
+
+// AVX-512 Foundation, Skylake-SP and later.
+namespace _Avx512 {
+#define _CDS_TARGET __attribute__((target("avx512f")))
+
+template <class T> struct _Vec;
+
+template <> struct _Vec<float> {
+  using Reg = __m512;
+  static constexpr int Width = 16;
+  static constexpr int MR = 12;
+  static constexpr int NR = 32;
+  _CDS_TARGET static Reg Zero() { return _mm512_setzero_ps(); }
+  _CDS_TARGET static Reg Load(const float *p) { return _mm512_load_ps(p); }
+  _CDS_TARGET static void Store(float *p, Reg r) { _mm512_store_ps(p, r); }
+  _CDS_TARGET static Reg Broadcast(float x) { return _mm512_set1_ps(x); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm512_fmadd_ps(a, b, c);
+  }
+};
+
+template <> struct _Vec<double> {
+  using Reg = __m512d;
+  static constexpr int Width = 8;
+  static constexpr int MR = 12;
+  static constexpr int NR = 16;
+  _CDS_TARGET static Reg Zero() { return _mm512_setzero_pd(); }
+  _CDS_TARGET static Reg Load(const double *p) { return _mm512_load_pd(p); }
+  _CDS_TARGET static void Store(double *p, Reg r) { _mm512_store_pd(p, r); }
+  _CDS_TARGET static Reg Broadcast(double x) { return _mm512_set1_pd(x); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm512_fmadd_pd(a, b, c);
+  }
+};
+
+#include "CDS_GemmKernel.inc"
+
+#undef _CDS_TARGET
+} // namespace _Avx512
+#endif
+
+/**
+ * @brief Gets the grain of the micro-kernel of one instruction set.
+ */
+template <class V> _Gemm::_Grain _GrainOf() {
+  return {_Gemm::_Blocking<V::MR, V::NR>::MC, V::NR};
+}
+
+/**
+ * @brief Runs the packed engine with the micro-kernel of one instruction set.
+ */
+template <class T, class V>
+void _Run(_Gemm::_Kernel<T> kernel, T alpha, const CDS_MatrixView<const T> &a,
+          const CDS_MatrixView<const T> &b, T beta,
+          const CDS_MatrixView<T> &c) {
+  _Gemm::_Blocked<T, V::MR, V::NR>(kernel, alpha, a, b, beta, c);
+}
+
+/**
+ * @brief Gets the grain of the active level.
+ */
+template <class T> _Gemm::_Grain _ActiveGrain() {
+  switch (_Simd::_GetLevel()) {
+#if defined(_CDS_GEMM_X86)
+  case _Level::AVX512:
+    return _GrainOf<_Avx512::_Vec<T>>();
+  case _Level::AVX2:
+    return _GrainOf<_Avx2::_Vec<T>>();
+  case _Level::SSE2:
+    return _GrainOf<_Sse2::_Vec<T>>();
+#endif
+  default:
+    return _GrainOf<_Gemm::_Vec<T>>();
+  }
+}
+
+/**
+ * @brief Runs the packed engine with the micro-kernel of the active level.
+ */
+template <class T>
+void _ActiveProduct(T alpha, const CDS_MatrixView<const T> &a,
+                    const CDS_MatrixView<const T> &b, T beta,
+                    const CDS_MatrixView<T> &c) {
+  switch (_Simd::_GetLevel()) {
+#if defined(_CDS_GEMM_X86)
+  case _Level::AVX512:
+    _Run<T, _Avx512::_Vec<T>>(&_Avx512::_MicroKernel<T>, alpha, a, b, beta,
+                              c);
+    return;
+  case _Level::AVX2:
+    _Run<T, _Avx2::_Vec<T>>(&_Avx2::_MicroKernel<T>, alpha, a, b, beta, c);
+    return;
+  case _Level::SSE2:
+    _Run<T, _Sse2::_Vec<T>>(&_Sse2::_MicroKernel<T>, alpha, a, b, beta, c);
+    return;
+#endif
+  default:
+    _Run<T, _Gemm::_Vec<T>>(&_Gemm::_MicroKernel<T>, alpha, a, b, beta, c);
+  }
+}
+
+} // namespace
+
+template <> _Gemm::_Grain _Gemm::_GetGrain<float>() {
+  return _ActiveGrain<float>();
+}
+
+template <> _Gemm::_Grain _Gemm::_GetGrain<double>() {
+  return _ActiveGrain<double>();
+}
+
+void _Gemm::_Dispatch(float alpha, const CDS_MatrixView<const float> &a,
+                      const CDS_MatrixView<const float> &b, float beta,
+                      const CDS_MatrixView<float> &c) {
+  _ActiveProduct(alpha, a, b, beta, c);
+}
+
+void _Gemm::_Dispatch(double alpha, const CDS_MatrixView<const double> &a,
+                      const CDS_MatrixView<const double> &b, double beta,
+                      const CDS_MatrixView<double> &c) {
+  _ActiveProduct(alpha, a, b, beta, c);
+}
@@ -0,0 +1,58 @@
+#include "CDS_MatrixFile.hpp"
+
+#include <cstring>
+
+namespace _File {
+
+CDS_Result<Header> ReadHeader(const Mapping &mapping, DType type,
+                              std::size_t elementSize) {
+  if (mapping.Length < sizeof(Header))
+    return CDS_Result<Header>::Failure(
+        "The file is too short to be a matrix file");
+  Header header;
+  std::memcpy(&header, mapping.Address, sizeof(Header));
+
+  if (std::memcmp(header.Magic, MAGIC, sizeof(MAGIC)) != 0)
+    return CDS_Result<Header>::Failure("Not a matrix file");
+  if (header.ByteOrder != ORDER_MARK)
+    return CDS_Result<Header>::Failure("The file has a foreign byte order");
+  if (header.Version != VERSION)
+    return CDS_Result<Header>::Failure("Unsupported matrix file version");
+  if (header.Type != static_cast<std::uint32_t>(type) ||
+      header.ElementSize != elementSize)
+    return CDS_Result<Header>::Failure("The file holds another element type");
+  if (header.Layout > 1)
+    return CDS_Result<Header>::Failure("Unknown layout");
+  if (header.Rows > INT32_MAX || header.Cols > INT32_MAX)
+    return CDS_Result<Header>::Failure("The matrix is too large");
+  if (header.Alignment == 0 || header.DataOffset % header.Alignment != 0 ||
+      header.DataOffset < sizeof(Header))
+    return CDS_Result<Header>::Failure("Invalid element data offset");
+
+  if (header.DataOffset > mapping.Length ||
+      header.Rows * header.Cols >
+          (mapping.Length - header.DataOffset) / elementSize)
+    return CDS_Result<Header>::Failure("The file is truncated");
+  return CDS_Result<Header>::Success(header);
+}
+
+Header MakeHeader(DType type, std::size_t elementSize, int rows, int cols,
+                  bool colMajor) {
+  Header header = {};
+  std::memcpy(header.Magic, MAGIC, sizeof(MAGIC));
+  header.Version = VERSION;
+  header.Type = static_cast<std::uint32_t>(type);
+  header.ElementSize = static_cast<std::uint32_t>(elementSize);
+  header.Layout = colMajor ? 1 : 0;
+  header.Alignment = CDS_Matrix<double>::Alignment;
+  header.ByteOrder = ORDER_MARK;
+  header.Rows = static_cast<std::uint64_t>(rows);
+  header.Cols = static_cast<std::uint64_t>(cols);
+  // Round the data up to the alignment, mappings start on a page boundary
+  // so the elements end up as aligned as those of a CDS_Matrix.
+  header.DataOffset = (sizeof(Header) + header.Alignment - 1) /
+                      header.Alignment * header.Alignment;
+  return header;
+}
+
+} // namespace _File
@@ -0,0 +1,148 @@
+#include "CDS_PerfectHashMap.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+/**
+ * @brief Round a byte offset up to the alignment of sections.
+ */
+std::size_t Align(std::size_t offset) {
+  return (offset + _PerfectHash::_ALIGNMENT - 1) / _PerfectHash::_ALIGNMENT *
+         _PerfectHash::_ALIGNMENT;
+}
+
+} // namespace
+
+namespace _PerfectHash {
+
+_Sections _Locate(const _Header &header) {
+  _Sections sections;
+  sections.Seeds = Align(sizeof(_Header));
+  sections.Values =
+      Align(sections.Seeds + header.Buckets * sizeof(std::uint32_t));
+  sections.Offsets = Align(sections.Values + header.Count * header.ValueSize);
+  sections.Keys = sections.Offsets;
+  if (header.KeySize == 0)
+    sections.Keys =
+        Align(sections.Offsets + (header.Count + 1) * sizeof(std::uint64_t));
+  sections.End = sections.Keys + header.KeyBytes;
+  return sections;
+}
+
+CDS_Result<_Header> _Check(const void *image, std::size_t length,
+                           std::uint32_t keySize, std::uint32_t valueSize) {
+  if (length < sizeof(_Header))
+    return CDS_Result<_Header>::Failure(
+        "The file is too short to be a perfect hash map");
+  _Header header;
+  std::memcpy(&header, image, sizeof(_Header));
+
+  if (std::memcmp(header.Magic, _MAGIC, sizeof(_MAGIC)) != 0)
+    return CDS_Result<_Header>::Failure("Not a perfect hash map file");
+  if (header.ByteOrder != _ORDER_MARK)
+    return CDS_Result<_Header>::Failure("The file has a foreign byte order");
+  if (header.Version != _VERSION)
+    return CDS_Result<_Header>::Failure(
+        "Unsupported perfect hash map version");
+  if (header.KeySize != keySize || header.ValueSize != valueSize)
+    return CDS_Result<_Header>::Failure(
+        "The file holds other key or value types");
+
+  // Bounding the counts by the length first keeps the layout arithmetic
+  // from overflowing.
+  if (header.Count > length / std::max<std::uint32_t>(valueSize, 1) ||
+      header.KeyBytes > length)
+    return CDS_Result<_Header>::Failure("The file is truncated");
+  if (header.Buckets != (header.Count + _BUCKET_SIZE - 1) / _BUCKET_SIZE)
+    return CDS_Result<_Header>::Failure("Invalid number of buckets");
+  if (_Locate(header).End > length)
+    return CDS_Result<_Header>::Failure("The file is truncated");
+  if (keySize != 0 && header.KeyBytes != header.Count * keySize)
+    return CDS_Result<_Header>::Failure("Invalid length of the key bytes");
+
+  // String keys are sliced by their offsets, which must stay in the image.
+  if (keySize == 0) {
+    _Sections sections = _Locate(header);
+    std::uint64_t previous = 0;
+    for (std::uint64_t i = 0; i <= header.Count; i++) {
+      std::uint64_t offset;
+      std::memcpy(&offset,
+                  static_cast<const char *>(image) + sections.Offsets +
+                      i * sizeof(std::uint64_t),
+                  sizeof(offset));
+      if (offset < previous || offset > header.KeyBytes ||
+          (i == header.Count && offset != header.KeyBytes))
+        return CDS_Result<_Header>::Failure("Invalid key offsets");
+      previous = offset;
+    }
+  }
+  return CDS_Result<_Header>::Success(header);
+}
+
+bool _Displace(std::span<const std::uint64_t> hashes,
+               std::span<std::uint32_t> seeds,
+               std::span<std::uint64_t> slots) {
+  std::size_t count = hashes.size();
+  std::size_t buckets = seeds.size();
+
+  // Group the keys by bucket, a counting sort.
+  std::vector<std::size_t> start(buckets + 1, 0);
+  std::vector<std::size_t> members(count);
+  for (std::size_t i = 0; i < count; i++) {
+    start[_Reduce(hashes[i], buckets) + 1]++;
+  }
+  for (std::size_t b = 0; b < buckets; b++) {
+    start[b + 1] += start[b];
+  }
+  std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+  for (std::size_t i = 0; i < count; i++) {
+    members[fill[_Reduce(hashes[i], buckets)]++] = i;
+  }
+
+  // Large buckets go first, while most slots are still free.
+  std::vector<std::size_t> order(buckets);
+  for (std::size_t b = 0; b < buckets; b++) {
+    order[b] = b;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t a, std::size_t b) {
+                     return start[a + 1] - start[a] > start[b + 1] - start[b];
+                   });
+
+  std::vector<bool> taken(count, false);
+  std::vector<std::uint64_t> candidates;
+  for (std::size_t bucket : order) {
+    std::size_t first = start[bucket], last = start[bucket + 1];
+    if (first == last) {
+      seeds[bucket] = 0;
+      continue;
+    }
+    for (std::uint64_t seed = 0;; seed++) {
+      if (seed > std::numeric_limits<std::uint32_t>::max())
+        return false;
+      candidates.clear();
+      for (std::size_t m = first; m < last; m++) {
+        std::uint64_t slot =
+            _Slot(hashes[members[m]], static_cast<std::uint32_t>(seed), count);
+        if (taken[slot] || std::find(candidates.begin(), candidates.end(),
+                                     slot) != candidates.end())
+          break;
+        candidates.push_back(slot);
+      }
+      if (candidates.size() != last - first)
+        continue;
+      for (std::size_t m = first; m < last; m++) {
+        taken[candidates[m - first]] = true;
+        slots[members[m]] = candidates[m - first];
+      }
+      seeds[bucket] = static_cast<std::uint32_t>(seed);
+      break;
+    }
+  }
+  return true;
+}
+
+} // namespace _PerfectHash
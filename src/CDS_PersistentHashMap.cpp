@@ -0,0 +1,104 @@
+#include "CDS_PersistentHashMap.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <optional>
+
+namespace {
+
+/**
+ * @brief Check that a table fits in the used part of the file.
+ */
+bool Fits(std::uint64_t table, std::uint64_t capacity, std::uint64_t end,
+          std::size_t slotSize) {
+  if (capacity == 0)
+    return table == 0;
+  if (capacity < _Persistent::_MIN_CAPACITY || (capacity & (capacity - 1)) ||
+      capacity > end / slotSize || table % _Persistent::_ALIGNMENT ||
+      table < _Persistent::_DATA || table > end)
+    return false;
+  return _Persistent::_ControlBytes(capacity) + capacity * slotSize <=
+         end - table;
+}
+
+/**
+ * @brief Check one header copy.
+ *
+ * @return The reason the copy is not usable, none if it is.
+ */
+std::optional<std::string> Check(const _Persistent::_Header &header,
+                                  std::size_t length, std::uint32_t keySize,
+                                  std::uint32_t valueSize,
+                                  std::size_t slotSize) {
+  using namespace _Persistent;
+  if (std::memcmp(header.Magic, _MAGIC, sizeof(_MAGIC)) != 0)
+    return "Not a persistent hash map file";
+  if (header.ByteOrder != _ORDER_MARK)
+    return "The file has a foreign byte order";
+  if (header.Version != _VERSION)
+    return "Unsupported persistent hash map version";
+  if (header.KeySize != keySize || header.ValueSize != valueSize)
+    return "The file holds other key or value types";
+  if (header.Checksum !=
+      CDS_HashBytes(&header, offsetof(_Header, Checksum)))
+    return "The header is corrupt";
+  if (header.End < _DATA || header.End > length)
+    return "The file is truncated";
+  if (!Fits(header.Table, header.Capacity, header.End, slotSize) ||
+      header.Size > header.Capacity ||
+      header.Deleted > header.Capacity - header.Size ||
+      !Fits(header.Spare, header.SpareCapacity, header.End, slotSize))
+    return "Invalid table of the persistent hash map";
+  return std::nullopt;
+}
+
+} // namespace
+
+namespace _Persistent {
+
+CDS_Result<_Header> _Load(const _File::SharedMapping &mapping,
+                          std::uint32_t keySize, std::uint32_t valueSize,
+                          std::size_t slotSize) {
+  // Either copy may be the one a crash tore, the newest intact one wins.
+  std::optional<_Header> newest;
+  std::optional<std::string> error;
+  for (std::size_t copy = 0; copy < 2; copy++) {
+    _Header header;
+    std::memcpy(&header,
+                static_cast<const char *>(mapping.Address) +
+                    copy * _COPY_STRIDE,
+                sizeof(header));
+    std::optional<std::string> problem =
+        Check(header, mapping.Length, keySize, valueSize, slotSize);
+    if (!problem) {
+      if (!newest || header.Generation > newest->Generation)
+        newest = header;
+    } else if (!error || std::memcmp(header.Magic, _MAGIC,
+                                     sizeof(_MAGIC)) == 0) {
+      error = problem;
+    }
+  }
+  if (!newest)
+    return CDS_Result<_Header>::Failure(error);
+  return CDS_Result<_Header>::Success(*newest);
+}
+
+CDS_Result<std::uint64_t> _Commit(_File::SharedMapping &mapping,
+                                  _Header &header) {
+  // The data must be on the disk before a header that points to it.
+  CDS_Result<std::size_t> synced =
+      _File::Sync(mapping, _DATA, header.End - _DATA);
+  if (synced.IsError())
+    return CDS_Result<std::uint64_t>::Failure(synced.ErrorMessage);
+
+  header.Checksum = CDS_HashBytes(&header, offsetof(_Header, Checksum));
+  std::size_t copy = header.Generation % 2 * _COPY_STRIDE;
+  std::memcpy(static_cast<char *>(mapping.Address) + copy, &header,
+              sizeof(header));
+  synced = _File::Sync(mapping, copy, sizeof(header));
+  if (synced.IsError())
+    return CDS_Result<std::uint64_t>::Failure(synced.ErrorMessage);
+  return CDS_Result<std::uint64_t>::Success(header.Generation);
+}
+
+} // namespace _Persistent
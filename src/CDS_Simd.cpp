@@ -0,0 +1,348 @@
+#include "CDS_Simd.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _CDS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using _Simd::_Level;
+
+/**
+ * @brief Operations of the shared map and reduction kernels.
+ */
+enum class _Op { Add, Sub, Mul, Dot, Sum, Min, Max };
+
+#if defined(_CDS_SIMD_X86)
+// SSE2, part of every x86-64 CPU, without FMA.
+namespace _Sse2 {
+#define _CDS_TARGET __attribute__((target("sse2")))
+
+template <class T> struct _Vec;
+
+template <> struct _Vec<float> {
+  using Reg = __m128;
+  static constexpr int Width = 4;
+  _CDS_TARGET static Reg Zero() { return _mm_setzero_ps(); }
+  _CDS_TARGET static Reg Load(const float *p) { return _mm_loadu_ps(p); }
+  _CDS_TARGET static void Store(float *p, Reg r) { _mm_storeu_ps(p, r); }
+  _CDS_TARGET static Reg Broadcast(float x) { return _mm_set1_ps(x); }
+  _CDS_TARGET static Reg Add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+  _CDS_TARGET static Reg Sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+  _CDS_TARGET static Reg Mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+  _CDS_TARGET static Reg Min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+  _CDS_TARGET static Reg Max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+  }
+};
+
+template <> struct _Vec<double> {
+  using Reg = __m128d;
+  static constexpr int Width = 2;
+  _CDS_TARGET static Reg Zero() { return _mm_setzero_pd(); }
+  _CDS_TARGET static Reg Load(const double *p) { return _mm_loadu_pd(p); }
+  _CDS_TARGET static void Store(double *p, Reg r) { _mm_storeu_pd(p, r); }
+  _CDS_TARGET static Reg Broadcast(double x) { return _mm_set1_pd(x); }
+  _CDS_TARGET static Reg Add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+  _CDS_TARGET static Reg Sub(Reg a, Reg b) { return _mm_sub_pd(a, b); }
+  _CDS_TARGET static Reg Mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+  _CDS_TARGET static Reg Min(Reg a, Reg b) { return _mm_min_pd(a, b); }
+  _CDS_TARGET static Reg Max(Reg a, Reg b) { return _mm_max_pd(a, b); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+  }
+};
+
+#include "CDS_SimdKernels.inc"
+
+#undef _CDS_TARGET
+} // namespace _Sse2
+
+// AVX2 with FMA, Haswell and later.
+namespace _Avx2 {
+#define _CDS_TARGET __attribute__((target("avx2,fma")))
+
+template <class T> struct _Vec;
+
+template <> struct _Vec<float> {
+  using Reg = __m256;
+  static constexpr int Width = 8;
+  _CDS_TARGET static Reg Zero() { return _mm256_setzero_ps(); }
+  _CDS_TARGET static Reg Load(const float *p) { return _mm256_loadu_ps(p); }
+  _CDS_TARGET static void Store(float *p, Reg r) { _mm256_storeu_ps(p, r); }
+  _CDS_TARGET static Reg Broadcast(float x) { return _mm256_set1_ps(x); }
+  _CDS_TARGET static Reg Add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+  _CDS_TARGET static Reg Sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+  _CDS_TARGET static Reg Mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+  _CDS_TARGET static Reg Min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+  _CDS_TARGET static Reg Max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+};
+
+template <> struct _Vec<double> {
+  using Reg = __m256d;
+  static constexpr int Width = 4;
+  _CDS_TARGET static Reg Zero() { return _mm256_setzero_pd(); }
+  _CDS_TARGET static Reg Load(const double *p) { return _mm256_loadu_pd(p); }
+  _CDS_TARGET static void Store(double *p, Reg r) { _mm256_storeu_pd(p, r); }
+  _CDS_TARGET static Reg Broadcast(double x) { return _mm256_set1_pd(x); }
+  _CDS_TARGET static Reg Add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+  _CDS_TARGET static Reg Sub(Reg a, Reg b) { return _mm256_sub_pd(a, b); }
+  _CDS_TARGET static Reg Mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+  _CDS_TARGET static Reg Min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+  _CDS_TARGET static Reg Max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm256_fmadd_pd(a, b, c);
+  }
+};
+
+#include "CDS_SimdKernels.inc"
+
+#undef _CDS_TARGET
+} // namespace _Avx2
+
+// AVX-512 Foundation, Skylake-SP and later. GCC's AVX-512 min and max pass
+// an undefined register as the source of their unused mask lanes, which
+// -Wmaybe-uninitialized reports wherever they are inlined.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+namespace _Avx512 {
+#define _CDS_TARGET __attribute__((target("avx512f")))
+
+template <class T> struct _Vec;
+
+template <> struct _Vec<float> {
+  using Reg = __m512;
+  static constexpr int Width = 16;
+  _CDS_TARGET static Reg Zero() { return _mm512_setzero_ps(); }
+  _CDS_TARGET static Reg Load(const float *p) { return _mm512_loadu_ps(p); }
+  _CDS_TARGET static void Store(float *p, Reg r) { _mm512_storeu_ps(p, r); }
+  _CDS_TARGET static Reg Broadcast(float x) { return _mm512_set1_ps(x); }
+  _CDS_TARGET static Reg Add(Reg a, Reg b) { return _mm512_add_ps(a, b); }
+  _CDS_TARGET static Reg Sub(Reg a, Reg b) { return _mm512_sub_ps(a, b); }
+  _CDS_TARGET static Reg Mul(Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+  _CDS_TARGET static Reg Min(Reg a, Reg b) { return _mm512_min_ps(a, b); }
+  _CDS_TARGET static Reg Max(Reg a, Reg b) { return _mm512_max_ps(a, b); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm512_fmadd_ps(a, b, c);
+  }
+};
+
+template <> struct _Vec<double> {
+  using Reg = __m512d;
+  static constexpr int Width = 8;
+  _CDS_TARGET static Reg Zero() { return _mm512_setzero_pd(); }
+  _CDS_TARGET static Reg Load(const double *p) { return _mm512_loadu_pd(p); }
+  _CDS_TARGET static void Store(double *p, Reg r) { _mm512_storeu_pd(p, r); }
+  _CDS_TARGET static Reg Broadcast(double x) { return _mm512_set1_pd(x); }
+  _CDS_TARGET static Reg Add(Reg a, Reg b) { return _mm512_add_pd(a, b); }
+  _CDS_TARGET static Reg Sub(Reg a, Reg b) { return _mm512_sub_pd(a, b); }
+  _CDS_TARGET static Reg Mul(Reg a, Reg b) { return _mm512_mul_pd(a, b); }
+  _CDS_TARGET static Reg Min(Reg a, Reg b) { return _mm512_min_pd(a, b); }
+  _CDS_TARGET static Reg Max(Reg a, Reg b) { return _mm512_max_pd(a, b); }
+  _CDS_TARGET static Reg Fma(Reg a, Reg b, Reg c) {
+    return _mm512_fmadd_pd(a, b, c);
+  }
+};
+
+#include "CDS_SimdKernels.inc"
+
+#undef _CDS_TARGET
+} // namespace _Avx512
+#pragma GCC diagnostic pop
+
+#endif
+
+/**
+ * @brief The kernels of one instruction set for one element type.
+ */
+template <class T> struct _Table {
+  void (*Fill)(T *, std::size_t, T);
+  void (*Add)(const T *, const T *, T *, std::size_t);
+  void (*Sub)(const T *, const T *, T *, std::size_t);
+  void (*Mul)(const T *, const T *, T *, std::size_t);
+  void (*Fma)(const T *, const T *, const T *, T *, std::size_t);
+  void (*Scale)(const T *, T, T *, std::size_t);
+  T (*Dot)(const T *, const T *, std::size_t);
+  T (*Sum)(const T *, std::size_t);
+  T (*Min)(const T *, std::size_t);
+  T (*Max)(const T *, std::size_t);
+};
+
+template <class T>
+constexpr _Table<T> _SCALAR = {
+    &_Simd::_Fill<T>, &_Simd::_Add<T>,   &_Simd::_Sub<T>, &_Simd::_Mul<T>,
+    &_Simd::_Fma<T>,  &_Simd::_Scale<T>, &_Simd::_Dot<T>, &_Simd::_Sum<T>,
+    &_Simd::_Min<T>,  &_Simd::_Max<T>};
+
+#if defined(_CDS_SIMD_X86)
+#define _CDS_TABLE(ns)                                                         \
+  {&ns::_Fill<T>,                                                              \
+   &ns::_Map<_Op::Add, T>,                                                     \
+   &ns::_Map<_Op::Sub, T>,                                                     \
+   &ns::_Map<_Op::Mul, T>,                                                     \
+   &ns::_Fma<T>,                                                               \
+   &ns::_Scale<T>,                                                             \
+   &ns::_Reduce<_Op::Dot, T>,                                                  \
+   &ns::_Reduce<_Op::Sum, T>,                                                  \
+   &ns::_Reduce<_Op::Min, T>,                                                  \
+   &ns::_Reduce<_Op::Max, T>}
+
+template <class T> constexpr _Table<T> _SSE2 = _CDS_TABLE(_Sse2);
+template <class T> constexpr _Table<T> _AVX2 = _CDS_TABLE(_Avx2);
+template <class T> constexpr _Table<T> _AVX512 = _CDS_TABLE(_Avx512);
+
+#undef _CDS_TABLE
+#endif
+
+/**
+ * @brief Level the kernels currently run with.
+ */
+std::atomic<_Level> &_Active() {
+  static std::atomic<_Level> level(_Simd::_GetSupported());
+  return level;
+}
+
+/**
+ * @brief Gets the kernels of the active level.
+ */
+template <class T> const _Table<T> &_Kernels() {
+  switch (_Active().load(std::memory_order_relaxed)) {
+#if defined(_CDS_SIMD_X86)
+  case _Level::AVX512:
+    return _AVX512<T>;
+  case _Level::AVX2:
+    return _AVX2<T>;
+  case _Level::SSE2:
+    return _SSE2<T>;
+#endif
+  default:
+    return _SCALAR<T>;
+  }
+}
+
+} // namespace
+
+// Levels
+_Level _Simd::_GetSupported() {
+#if defined(_CDS_SIMD_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return _Level::AVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return _Level::AVX2;
+  if (__builtin_cpu_supports("sse2"))
+    return _Level::SSE2;
+#endif
+  return _Level::Scalar;
+}
+
+_Level _Simd::_GetLevel() { return _Active().load(std::memory_order_relaxed); }
+
+void _Simd::_SetLevel(_Level level) {
+  _Active().store(std::min(level, _GetSupported()), std::memory_order_relaxed);
+}
+
+// float
+void _Simd::_Fill(float *out, std::size_t count, float value) {
+  _Kernels<float>().Fill(out, count, value);
+}
+
+void _Simd::_Add(const float *lhs, const float *rhs, float *out,
+                 std::size_t count) {
+  _Kernels<float>().Add(lhs, rhs, out, count);
+}
+
+void _Simd::_Sub(const float *lhs, const float *rhs, float *out,
+                 std::size_t count) {
+  _Kernels<float>().Sub(lhs, rhs, out, count);
+}
+
+void _Simd::_Mul(const float *lhs, const float *rhs, float *out,
+                 std::size_t count) {
+  _Kernels<float>().Mul(lhs, rhs, out, count);
+}
+
+void _Simd::_Fma(const float *lhs, const float *rhs, const float *addend,
+                 float *out, std::size_t count) {
+  _Kernels<float>().Fma(lhs, rhs, addend, out, count);
+}
+
+void _Simd::_Scale(const float *in, float alpha, float *out,
+                   std::size_t count) {
+  _Kernels<float>().Scale(in, alpha, out, count);
+}
+
+float _Simd::_Dot(const float *lhs, const float *rhs, std::size_t count) {
+  return _Kernels<float>().Dot(lhs, rhs, count);
+}
+
+float _Simd::_Sum(const float *in, std::size_t count) {
+  return _Kernels<float>().Sum(in, count);
+}
+
+float _Simd::_Min(const float *in, std::size_t count) {
+  assertm(count > 0, "Minimum of no elements");
+  return _Kernels<float>().Min(in, count);
+}
+
+float _Simd::_Max(const float *in, std::size_t count) {
+  assertm(count > 0, "Maximum of no elements");
+  return _Kernels<float>().Max(in, count);
+}
+
+// double
+void _Simd::_Fill(double *out, std::size_t count, double value) {
+  _Kernels<double>().Fill(out, count, value);
+}
+
+void _Simd::_Add(const double *lhs, const double *rhs, double *out,
+                 std::size_t count) {
+  _Kernels<double>().Add(lhs, rhs, out, count);
+}
+
+void _Simd::_Sub(const double *lhs, const double *rhs, double *out,
+                 std::size_t count) {
+  _Kernels<double>().Sub(lhs, rhs, out, count);
+}
+
+void _Simd::_Mul(const double *lhs, const double *rhs, double *out,
+                 std::size_t count) {
+  _Kernels<double>().Mul(lhs, rhs, out, count);
+}
+
+void _Simd::_Fma(const double *lhs, const double *rhs, const double *addend,
+                 double *out, std::size_t count) {
+  _Kernels<double>().Fma(lhs, rhs, addend, out, count);
+}
+
+void _Simd::_Scale(const double *in, double alpha, double *out,
+                   std::size_t count) {
+  _Kernels<double>().Scale(in, alpha, out, count);
+}
+
+double _Simd::_Dot(const double *lhs, const double *rhs, std::size_t count) {
+  return _Kernels<double>().Dot(lhs, rhs, count);
+}
+
+double _Simd::_Sum(const double *in, std::size_t count) {
+  return _Kernels<double>().Sum(in, count);
+}
+
+double _Simd::_Min(const double *in, std::size_t count) {
+  assertm(count > 0, "Minimum of no elements");
+  return _Kernels<double>().Min(in, count);
+}
+
+double _Simd::_Max(const double *in, std::size_t count) {
+  assertm(count > 0, "Maximum of no elements");
+  return _Kernels<double>().Max(in, count);
+}
@@ -1,8 +1,8 @@
-#pragma once
 #include "CDS_SimpleHashMap.hpp"
 
-CDS_SimpleHashMap::CDS_SimpleHashMap() : _N(26), _StartByte('a') {
-  for (int i = 0; i < this->_N; i++) {
+CDS_SimpleHashMap::CDS_SimpleHashMap()
+    : p_State(std::make_shared<_State>()), _N(26), _StartByte('a') {
+  for (size_t i = 0; i < this->_N; i++) {
     this->_Slots[i] = this->p_State->NeverUsed;
   }
 }
@@ -11,13 +11,13 @@ const std::array<std::string, 26> &CDS_SimpleHashMap::Slots() {
   return this->_Slots;
 }
 
-CDS_Result<std::string> CDS_SimpleHashMap::Get(std::string &key) {
+CDS_Result<std::string> CDS_SimpleHashMap::Get(std::string_view key) {
   CDS_Result<size_t> index = this->_HashFunction(key);
   if (index.IsError())
     return CDS_Result<std::string>::Failure(index.ErrorMessage);
 
   size_t indexUnpacked = index.Unpack();
-  for (int i = 0; i < this->_N; i++) {
+  for (size_t i = 0; i < this->_N; i++) {
     if (this->_Slots[indexUnpacked] == this->p_State->Tombstone ||
         this->_Slots[indexUnpacked] == this->p_State->Occupied) {
       indexUnpacked = (indexUnpacked + 1) % this->_N;
@@ -30,15 +30,15 @@ CDS_Result<std::string> CDS_SimpleHashMap::Get(std::string &key) {
   return CDS_Result<std::string>::Failure("The key does not exist");
 }
 
-CDS_Result<std::string> CDS_SimpleHashMap::Insert(std::string &key) {
+CDS_Result<std::string> CDS_SimpleHashMap::Insert(std::string_view key) {
   return CDS_Result<std::string>::Failure("Not Implemented");
 }
 
-CDS_Result<std::string> CDS_SimpleHashMap::Delete(std::string key) {
+CDS_Result<std::string> CDS_SimpleHashMap::Delete(std::string_view key) {
   return CDS_Result<std::string>::Failure("Not Implemented");
 }
 
-CDS_Result<size_t> CDS_SimpleHashMap::_HashFunction(std::string &key) {
+CDS_Result<size_t> CDS_SimpleHashMap::_HashFunction(std::string_view key) {
   /*
    * In: Key as a string
    * Out: Index where to put value or error
@@ -0,0 +1,176 @@
+#include "CDS_ThreadPool.hpp"
+
+namespace {
+
+// Index of the queue owned by the current thread, 0 for threads that are not
+// pool workers.
+thread_local std::size_t tl_QueueIndex = 0;
+
+constexpr std::size_t _DEFAULT_SERIAL_CUTOFF = std::size_t(1) << 16;
+
+std::size_t _HardwareThreads() {
+  std::size_t count = std::thread::hardware_concurrency();
+  return count == 0 ? 1 : count;
+}
+
+} // namespace
+
+CDS_ThreadPool &CDS_ThreadPool::Instance() {
+  static CDS_ThreadPool pool;
+  return pool;
+}
+
+CDS_ThreadPool::CDS_ThreadPool()
+    : _Queued(0), _Next(0), _Stop(false), _ThreadCount(1),
+      _SerialCutoff(_DEFAULT_SERIAL_CUTOFF) {
+  this->_Start(_HardwareThreads());
+}
+
+CDS_ThreadPool::~CDS_ThreadPool() { this->_Shutdown(); }
+
+// Configuration
+void CDS_ThreadPool::SetThreadCount(std::size_t count) {
+  if (count == 0)
+    count = _HardwareThreads();
+  if (count == this->_ThreadCount)
+    return;
+  this->_Shutdown();
+  this->_Start(count);
+}
+
+std::size_t CDS_ThreadPool::GetThreadCount() const {
+  return this->_ThreadCount;
+}
+
+void CDS_ThreadPool::SetSerialCutoff(std::size_t work) {
+  this->_SerialCutoff = work;
+}
+
+std::size_t CDS_ThreadPool::GetSerialCutoff() const {
+  return this->_SerialCutoff;
+}
+
+bool CDS_ThreadPool::IsSerial(std::size_t work) const {
+  return this->_ThreadCount <= 1 || work < this->_SerialCutoff;
+}
+
+// Workers
+void CDS_ThreadPool::_Start(std::size_t count) {
+  this->_Stop = false;
+  this->_ThreadCount = count;
+  this->_Queues.clear();
+  for (std::size_t i = 0; i < count; i++) {
+    this->_Queues.push_back(std::make_unique<_Queue>());
+  }
+  for (std::size_t i = 1; i < count; i++) {
+    this->_Threads.emplace_back([this, i] { this->_WorkerLoop(i); });
+  }
+}
+
+void CDS_ThreadPool::_Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(this->_SleepMutex);
+    this->_Stop = true;
+  }
+  this->_Wake.notify_all();
+  for (std::thread &thread : this->_Threads) {
+    thread.join();
+  }
+  this->_Threads.clear();
+}
+
+void CDS_ThreadPool::_WorkerLoop(std::size_t self) {
+  tl_QueueIndex = self;
+  while (true) {
+    if (this->_TryRun(self))
+      continue;
+    std::unique_lock<std::mutex> lock(this->_SleepMutex);
+    this->_Wake.wait(lock,
+                     [this] { return this->_Stop || this->_Queued > 0; });
+    if (this->_Stop)
+      return;
+  }
+}
+
+bool CDS_ThreadPool::_TryRun(std::size_t self) {
+  _Task task;
+  bool found = false;
+
+  // Own queue first, newest task, it is the most likely to be cache hot.
+  {
+    _Queue &queue = *this->_Queues[self];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (!queue.Tasks.empty()) {
+      task = queue.Tasks.back();
+      queue.Tasks.pop_back();
+      found = true;
+    }
+  }
+
+  // Then steal the oldest task of another queue.
+  for (std::size_t i = 1; !found && i < this->_Queues.size(); i++) {
+    _Queue &queue = *this->_Queues[(self + i) % this->_Queues.size()];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (!queue.Tasks.empty()) {
+      task = queue.Tasks.front();
+      queue.Tasks.pop_front();
+      found = true;
+    }
+  }
+
+  if (!found)
+    return false;
+  this->_Queued.fetch_sub(1, std::memory_order_relaxed);
+  _Loop &loop = *task.Loop;
+  if (!loop.Failed.load(std::memory_order_relaxed)) {
+    try {
+      task.Run(task.Context, task.Index);
+    } catch (...) {
+      if (!loop.Failed.exchange(true, std::memory_order_relaxed))
+        loop.Error = std::current_exception();
+    }
+  }
+  // Publishes the error, the dispatching thread reads it after seeing zero.
+  loop.Pending.fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+// Dispatch
+void CDS_ThreadPool::_Dispatch(std::size_t count,
+                               void (*run)(void *, std::size_t),
+                               void *context) {
+  _Loop loop;
+  loop.Pending.store(count, std::memory_order_relaxed);
+  std::size_t queues = this->_Queues.size();
+  {
+    std::lock_guard<std::mutex> lock(this->_SleepMutex);
+    this->_Queued.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  // Deal the iterations out to all queues, each queue gets a contiguous
+  // range so neighbouring tiles tend to run on the same thread.
+  std::size_t first = this->_Next.fetch_add(1, std::memory_order_relaxed);
+  for (std::size_t q = 0; q < queues; q++) {
+    std::size_t begin = count * q / queues;
+    std::size_t end = count * (q + 1) / queues;
+    if (begin == end)
+      continue;
+    _Queue &queue = *this->_Queues[(first + q) % queues];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    // Pushed in reverse so the owner, popping from the back, walks the
+    // range forwards while thieves take its far end.
+    for (std::size_t i = end; i-- > begin;) {
+      queue.Tasks.push_back(_Task{run, context, i, &loop});
+    }
+  }
+  this->_Wake.notify_all();
+
+  // Help instead of blocking, this also keeps nested loops deadlock free.
+  std::size_t self = tl_QueueIndex;
+  while (loop.Pending.load(std::memory_order_acquire) != 0) {
+    if (!this->_TryRun(self))
+      std::this_thread::yield();
+  }
+  if (loop.Error)
+    std::rethrow_exception(loop.Error);
+}
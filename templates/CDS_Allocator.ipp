@@ -0,0 +1,42 @@
+#pragma once
+#include "CDS_Allocator.hpp"
+#include <cassert>
+#include <limits>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+template <class T, class Resource>
+CDS_Allocator<T, Resource>::CDS_Allocator(Resource &resource) noexcept
+    : _Resource(&resource) {}
+
+template <class T, class Resource>
+template <class U>
+CDS_Allocator<T, Resource>::CDS_Allocator(
+    const CDS_Allocator<U, Resource> &other) noexcept
+    : _Resource(&other.GetResource()) {}
+
+template <class T, class Resource>
+T *CDS_Allocator<T, Resource>::allocate(std::size_t count) {
+  if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+    throw std::bad_array_new_length();
+  return static_cast<T *>(
+      this->_Resource->Allocate(count * sizeof(T), alignof(T)));
+}
+
+template <class T, class Resource>
+void CDS_Allocator<T, Resource>::deallocate(T *pointer,
+                                            std::size_t count) noexcept {
+  this->_Resource->Deallocate(pointer, count * sizeof(T), alignof(T));
+}
+
+template <class T, class Resource>
+Resource &CDS_Allocator<T, Resource>::GetResource() const {
+  return *this->_Resource;
+}
+
+template <class T, class Resource>
+template <class U>
+bool CDS_Allocator<T, Resource>::operator==(
+    const CDS_Allocator<U, Resource> &other) const {
+  return this->_Resource == &other.GetResource();
+}
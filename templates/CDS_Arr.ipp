@@ -1,8 +1,30 @@
 #pragma once
 #include "CDS_Arr.hpp"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
 
 // Constructor
-template <class T, int N> CDS_Arr<T, N>::CDS_Arr() : _Size(N) {}
+template <class T, int N>
+constexpr CDS_Arr<T, N>::CDS_Arr() : _Arr{} {}
+
+template <class T, int N>
+constexpr CDS_Arr<T, N>::CDS_Arr(std::initializer_list<T> elems) : _Arr{} {
+  assertm(elems.size() <= size_t(N), "Too many elements");
+  std::copy(elems.begin(), elems.end(), this->_Arr);
+}
+
+template <class T, int N>
+template <class Generator>
+constexpr CDS_Arr<T, N> CDS_Arr<T, N>::Generate(Generator generator) {
+  CDS_Arr<T, N> array;
+  for (size_t i = 0; i < size_t(N); i++) {
+    array._Arr[i] = generator(i);
+  }
+  return array;
+}
 
 // Getters
 template <class T, int N>
@@ -10,34 +32,170 @@ constexpr const size_t CDS_Arr<T, N>::GetSize() const {
   return N;
 }
 
-template <class T, int N> T *CDS_Arr<T, N>::GetData() { return this->_Arr; }
+template <class T, int N> constexpr T *CDS_Arr<T, N>::GetData() {
+  return this->_Arr;
+}
 
-template <class T, int N> const T *CDS_Arr<T, N>::GetData() const {
+template <class T, int N> constexpr const T *CDS_Arr<T, N>::GetData() const {
   return this->_Arr;
 }
 
 // Swap
 template <class T, int N>
-void CDS_Arr<T, N>::Swap(const size_t &lhs, const size_t &rhs) {
-  size_t temp = this->_Arr[lhs];
-  this->_Arr[lhs] = this->_Arr[rhs];
-  this->_Arr[rhs] = temp;
+constexpr void CDS_Arr<T, N>::Swap(const size_t &lhs, const size_t &rhs) {
+  std::swap(this->_Arr[lhs], this->_Arr[rhs]);
 }
 
 // Fill
-template <class T, int N> void CDS_Arr<T, N>::Fill(const T &elem) {
-  for (int i = 0; i < _Size; i++) {
+template <class T, int N> constexpr void CDS_Arr<T, N>::Fill(const T &elem) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    if (!std::is_constant_evaluated()) {
+      _Simd::_Fill(this->_Arr, N, elem);
+      return;
+    }
+  }
+  for (size_t i = 0; i < size_t(N); i++) {
     this->_Arr[i] = elem;
   }
 }
 
+// Algorithms
+template <class T, int N>
+template <class Compare>
+constexpr void CDS_Arr<T, N>::Sort(Compare compare) {
+  std::sort(this->_Arr, this->_Arr + N, compare);
+}
+
+template <class T, int N>
+constexpr size_t CDS_Arr<T, N>::Find(const T &elem) const {
+  return std::find(this->_Arr, this->_Arr + N, elem) - this->_Arr;
+}
+
+template <class T, int N>
+template <class Compare>
+constexpr size_t CDS_Arr<T, N>::LowerBound(const T &elem,
+                                           Compare compare) const {
+  return std::lower_bound(this->_Arr, this->_Arr + N, elem, compare) -
+         this->_Arr;
+}
+
+template <class T, int N>
+template <class Function>
+constexpr CDS_Arr<std::invoke_result_t<Function &, const T &>, N>
+CDS_Arr<T, N>::Transform(Function function) const {
+  CDS_Arr<std::invoke_result_t<Function &, const T &>, N> result;
+  for (size_t i = 0; i < size_t(N); i++) {
+    result[i] = function(this->_Arr[i]);
+  }
+  return result;
+}
+
+// Numeric Operations
+//
+// Constant expressions take the scalar templates explicitly, the overloads
+// dispatched at runtime are not constexpr.
+template <class T, int N>
+constexpr void CDS_Arr<T, N>::Add(std::span<const T> other)
+  requires std::is_arithmetic_v<T>
+{
+  assertm(other.size() == size_t(N), "Sizes do not match");
+  if (std::is_constant_evaluated())
+    _Simd::_Add<T>(this->_Arr, other.data(), this->_Arr, N);
+  else
+    _Simd::_Add(this->_Arr, other.data(), this->_Arr, N);
+}
+
+template <class T, int N>
+constexpr void CDS_Arr<T, N>::Sub(std::span<const T> other)
+  requires std::is_arithmetic_v<T>
+{
+  assertm(other.size() == size_t(N), "Sizes do not match");
+  if (std::is_constant_evaluated())
+    _Simd::_Sub<T>(this->_Arr, other.data(), this->_Arr, N);
+  else
+    _Simd::_Sub(this->_Arr, other.data(), this->_Arr, N);
+}
+
+template <class T, int N>
+constexpr void CDS_Arr<T, N>::Mul(std::span<const T> other)
+  requires std::is_arithmetic_v<T>
+{
+  assertm(other.size() == size_t(N), "Sizes do not match");
+  if (std::is_constant_evaluated())
+    _Simd::_Mul<T>(this->_Arr, other.data(), this->_Arr, N);
+  else
+    _Simd::_Mul(this->_Arr, other.data(), this->_Arr, N);
+}
+
+template <class T, int N>
+constexpr void CDS_Arr<T, N>::Fma(std::span<const T> lhs,
+                                   std::span<const T> rhs)
+  requires std::is_arithmetic_v<T>
+{
+  assertm(lhs.size() == N && rhs.size() == size_t(N), "Sizes do not match");
+  if (std::is_constant_evaluated())
+    _Simd::_Fma<T>(lhs.data(), rhs.data(), this->_Arr, this->_Arr, N);
+  else
+    _Simd::_Fma(lhs.data(), rhs.data(), this->_Arr, this->_Arr, N);
+}
+
+template <class T, int N>
+constexpr void CDS_Arr<T, N>::AssignScaled(std::span<const T> source,
+                                            const T &alpha)
+  requires std::is_arithmetic_v<T>
+{
+  assertm(source.size() == size_t(N), "Sizes do not match");
+  if (std::is_constant_evaluated())
+    _Simd::_Scale<T>(source.data(), alpha, this->_Arr, N);
+  else
+    _Simd::_Scale(source.data(), alpha, this->_Arr, N);
+}
+
+template <class T, int N>
+constexpr T CDS_Arr<T, N>::Dot(std::span<const T> other) const
+  requires std::is_arithmetic_v<T>
+{
+  assertm(other.size() == size_t(N), "Sizes do not match");
+  if (std::is_constant_evaluated())
+    return _Simd::_Dot<T>(this->_Arr, other.data(), N);
+  return _Simd::_Dot(this->_Arr, other.data(), N);
+}
+
+template <class T, int N>
+constexpr T CDS_Arr<T, N>::Sum() const
+  requires std::is_arithmetic_v<T>
+{
+  if (std::is_constant_evaluated())
+    return _Simd::_Sum<T>(this->_Arr, N);
+  return _Simd::_Sum(this->_Arr, N);
+}
+
+template <class T, int N>
+constexpr T CDS_Arr<T, N>::Min() const
+  requires std::is_arithmetic_v<T>
+{
+  if (std::is_constant_evaluated())
+    return _Simd::_Min<T>(this->_Arr, N);
+  return _Simd::_Min(this->_Arr, N);
+}
+
+template <class T, int N>
+constexpr T CDS_Arr<T, N>::Max() const
+  requires std::is_arithmetic_v<T>
+{
+  if (std::is_constant_evaluated())
+    return _Simd::_Max<T>(this->_Arr, N);
+  return _Simd::_Max(this->_Arr, N);
+}
+
 // Operator Overloads
-template <class T, int N> T &CDS_Arr<T, N>::operator[](const size_t index) {
+template <class T, int N>
+constexpr T &CDS_Arr<T, N>::operator[](const size_t index) {
   return this->_Arr[index];
 }
 
 template <class T, int N>
-const T &CDS_Arr<T, N>::operator[](const size_t index) const {
+constexpr const T &CDS_Arr<T, N>::operator[](const size_t index) const {
   return this->_Arr[index];
 }
 
@@ -53,3 +211,34 @@ std::ostream &operator<<(std::ostream &stream, const CDS_Arr<U, M> &array) {
   stream << "]";
   return stream;
 }
+
+// Iterators
+template <class T, int N>
+constexpr typename CDS_Arr<T, N>::iterator CDS_Arr<T, N>::begin() {
+  return iterator(this->_Arr);
+}
+
+template <class T, int N>
+constexpr typename CDS_Arr<T, N>::const_iterator CDS_Arr<T, N>::begin() const {
+  return const_iterator(this->_Arr);
+}
+
+template <class T, int N>
+constexpr typename CDS_Arr<T, N>::const_iterator CDS_Arr<T, N>::cbegin() const {
+  return const_iterator(this->_Arr);
+}
+
+template <class T, int N>
+constexpr typename CDS_Arr<T, N>::iterator CDS_Arr<T, N>::end() {
+  return iterator(this->_Arr + N);
+}
+
+template <class T, int N>
+constexpr typename CDS_Arr<T, N>::const_iterator CDS_Arr<T, N>::end() const {
+  return const_iterator(this->_Arr + N);
+}
+
+template <class T, int N>
+constexpr typename CDS_Arr<T, N>::const_iterator CDS_Arr<T, N>::cend() const {
+  return const_iterator(this->_Arr + N);
+}
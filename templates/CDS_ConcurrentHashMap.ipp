@@ -0,0 +1,382 @@
+#pragma once
+#include "CDS_ConcurrentHashMap.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+// Writer sections
+template <class K, class V, class Hash, class Eq>
+CDS_ConcurrentHashMap<K, V, Hash, Eq>::_Write::_Write(_Shard &shard)
+    : _Target(shard), _Lock(shard.Mutex) {
+  // The fence keeps the stores of the writer from becoming visible before
+  // the odd sequence.
+  std::uint64_t sequence =
+      this->_Target.Sequence.load(std::memory_order_relaxed);
+  this->_Target.Sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+template <class K, class V, class Hash, class Eq>
+CDS_ConcurrentHashMap<K, V, Hash, Eq>::_Write::~_Write() {
+  std::uint64_t sequence =
+      this->_Target.Sequence.load(std::memory_order_relaxed);
+  this->_Target.Sequence.store(sequence + 1, std::memory_order_release);
+}
+
+// Constructor
+template <class K, class V, class Hash, class Eq>
+CDS_ConcurrentHashMap<K, V, Hash, Eq>::CDS_ConcurrentHashMap(
+    std::size_t shards, float maxLoadFactor, const Hash &hash,
+    const Eq &equal)
+    : _ShardBits(std::bit_width(shards - 1)), _MaxLoadFactor(maxLoadFactor),
+      _Hasher(hash), _Equal(equal) {
+  assertm(shards > 0, "There must be at least one shard");
+  assertm(maxLoadFactor > 0 && maxLoadFactor < 1,
+          "The load factor must be between 0 and 1");
+  this->_Shards = std::make_unique<_Shard[]>(this->GetShardCount());
+}
+
+// Destructor
+template <class K, class V, class Hash, class Eq>
+CDS_ConcurrentHashMap<K, V, Hash, Eq>::~CDS_ConcurrentHashMap() {
+  for (std::size_t i = 0; i < this->GetShardCount(); i++) {
+    _Table *table = this->_Shards[i].Table.load(std::memory_order_relaxed);
+    for (bool current = true; table; current = false) {
+      _Table *replaced = table->Replaced;
+      Free(table, current);
+      table = replaced;
+    }
+  }
+}
+
+// Getters
+template <class K, class V, class Hash, class Eq>
+std::size_t CDS_ConcurrentHashMap<K, V, Hash, Eq>::GetSize() const {
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < this->GetShardCount(); i++) {
+    size += this->_Shards[i].Size.load(std::memory_order_relaxed);
+  }
+  return size;
+}
+
+template <class K, class V, class Hash, class Eq>
+std::size_t CDS_ConcurrentHashMap<K, V, Hash, Eq>::GetShardCount() const {
+  return std::size_t(1) << this->_ShardBits;
+}
+
+template <class K, class V, class Hash, class Eq>
+CDS_Result<V> CDS_ConcurrentHashMap<K, V, Hash, Eq>::Get(const K &key) const {
+  std::size_t hash = _Hash::_Mix(this->_Hasher(key));
+  std::optional<V> value =
+      this->Read(this->ShardOf(hash), [&](const _Table *table) {
+        std::optional<V> copy;
+        if (const _Slot *slot = this->Lookup(table, key, hash))
+          copy.emplace(slot->Value);
+        return copy;
+      });
+  if (!value)
+    return CDS_Result<V>::Failure("The key does not exist");
+  return CDS_Result<V>{std::move(value), std::nullopt};
+}
+
+template <class K, class V, class Hash, class Eq>
+bool CDS_ConcurrentHashMap<K, V, Hash, Eq>::Contains(const K &key) const {
+  std::size_t hash = _Hash::_Mix(this->_Hasher(key));
+  return this->Read(this->ShardOf(hash), [&](const _Table *table) {
+    return this->Lookup(table, key, hash) != nullptr;
+  });
+}
+
+// Modifiers
+template <class K, class V, class Hash, class Eq>
+CDS_Result<V> CDS_ConcurrentHashMap<K, V, Hash, Eq>::Insert(const K &key,
+                                                           V value) {
+  std::size_t hash = _Hash::_Mix(this->_Hasher(key));
+  _Shard &shard = this->ShardOf(hash);
+  _Write write(shard);
+  if (this->Lookup(shard.Table.load(std::memory_order_relaxed), key, hash))
+    return CDS_Result<V>::Failure("The key already exists");
+  return CDS_Result<V>::Success(
+      this->Place(shard, hash, key, std::move(value)));
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_ConcurrentHashMap<K, V, Hash, Eq>::Set(const K &key, V value) {
+  std::size_t hash = _Hash::_Mix(this->_Hasher(key));
+  _Shard &shard = this->ShardOf(hash);
+  _Write write(shard);
+  _Slot *slot =
+      this->Lookup(shard.Table.load(std::memory_order_relaxed), key, hash);
+  if (slot)
+    slot->Value = std::move(value);
+  else
+    this->Place(shard, hash, key, std::move(value));
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Function>
+bool CDS_ConcurrentHashMap<K, V, Hash, Eq>::Update(const K &key,
+                                                   Function function) {
+  std::size_t hash = _Hash::_Mix(this->_Hasher(key));
+  _Shard &shard = this->ShardOf(hash);
+  _Write write(shard);
+  _Slot *slot =
+      this->Lookup(shard.Table.load(std::memory_order_relaxed), key, hash);
+  if (!slot)
+    return false;
+  function(slot->Value);
+  return true;
+}
+
+template <class K, class V, class Hash, class Eq>
+CDS_Result<V> CDS_ConcurrentHashMap<K, V, Hash, Eq>::Delete(const K &key) {
+  std::size_t hash = _Hash::_Mix(this->_Hasher(key));
+  _Shard &shard = this->ShardOf(hash);
+  _Write write(shard);
+  _Table *table = shard.Table.load(std::memory_order_relaxed);
+  _Slot *slot = this->Lookup(table, key, hash);
+  if (!slot)
+    return CDS_Result<V>::Failure("The key does not exist");
+  CDS_Result<V> removed = CDS_Result<V>{std::move(slot->Value), std::nullopt};
+  std::destroy_at(slot);
+  shard.Size.fetch_sub(1, std::memory_order_relaxed);
+
+  // Same as CDS_HashMap::Delete, a slot inside a run of full slots shorter
+  // than a group can become empty again.
+  std::size_t index = slot - table->Slots;
+  std::size_t mask = table->Capacity - 1;
+  _Hash::_Mask after = _Hash::_Group(table->Control + index).MatchEmpty();
+  _Hash::_Mask before =
+      _Hash::_Group(table->Control + ((index - _Hash::_GROUP) & mask))
+          .MatchEmpty();
+  if (after && before &&
+      after.TrailingZeros() + before.LeadingZeros() < _Hash::_GROUP) {
+    SetControl(table, index, _Hash::_EMPTY);
+  } else {
+    SetControl(table, index, _Hash::_DELETED);
+    shard.Deleted++;
+  }
+  return removed;
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_ConcurrentHashMap<K, V, Hash, Eq>::Clear() {
+  for (std::size_t i = 0; i < this->GetShardCount(); i++) {
+    _Shard &shard = this->_Shards[i];
+    _Write write(shard);
+    _Table *table = shard.Table.load(std::memory_order_relaxed);
+    if (!table)
+      continue;
+    for (std::size_t j = 0; j < table->Capacity; j++) {
+      if (table->Control[j] >= 0)
+        std::destroy_at(&table->Slots[j]);
+    }
+    std::fill_n(table->Control, table->Capacity + _Hash::_GROUP,
+                _Hash::_EMPTY);
+    shard.Size.store(0, std::memory_order_relaxed);
+    shard.Deleted = 0;
+  }
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Function>
+void CDS_ConcurrentHashMap<K, V, Hash, Eq>::ForEach(Function function) {
+  for (std::size_t i = 0; i < this->GetShardCount(); i++) {
+    _Write write(this->_Shards[i]);
+    _Table *table = this->_Shards[i].Table.load(std::memory_order_relaxed);
+    for (std::size_t j = 0; table && j < table->Capacity; j++) {
+      if (table->Control[j] >= 0)
+        function(const_cast<const K &>(table->Slots[j].Key),
+                 table->Slots[j].Value);
+    }
+  }
+}
+
+// Private
+template <class K, class V, class Hash, class Eq>
+typename CDS_ConcurrentHashMap<K, V, Hash, Eq>::_Shard &
+CDS_ConcurrentHashMap<K, V, Hash, Eq>::ShardOf(std::size_t hash) const {
+  // Tables index with the low bits above the control byte's, shards take
+  // the top bits so the two stay independent.
+  std::size_t top = std::rotl(hash, static_cast<int>(this->_ShardBits));
+  return this->_Shards[top & (this->GetShardCount() - 1)];
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Reader>
+auto CDS_ConcurrentHashMap<K, V, Hash, Eq>::Read(_Shard &shard,
+                                                 Reader reader) const {
+  if constexpr (LockFreeReads) {
+    for (;;) {
+      std::uint64_t sequence = shard.Sequence.load(std::memory_order_acquire);
+      if (sequence & 1) {
+        std::this_thread::yield();
+        continue;
+      }
+      auto result = reader(shard.Table.load(std::memory_order_acquire));
+      // Orders the reads of the entries before the second sequence load.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (shard.Sequence.load(std::memory_order_relaxed) == sequence)
+        return result;
+    }
+  } else {
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    return reader(shard.Table.load(std::memory_order_relaxed));
+  }
+}
+
+template <class K, class V, class Hash, class Eq>
+typename CDS_ConcurrentHashMap<K, V, Hash, Eq>::_Slot *
+CDS_ConcurrentHashMap<K, V, Hash, Eq>::Lookup(const _Table *table,
+                                              const K &key,
+                                              std::size_t hash) const {
+  if (!table)
+    return nullptr;
+  std::size_t mask = table->Capacity - 1;
+  std::size_t groups = table->Capacity / _Hash::_GROUP;
+  std::int8_t tag = _Hash::_H2(hash);
+  std::size_t position = _Hash::_H1(hash) & mask;
+  for (std::size_t probe = 1; probe <= groups; probe++) {
+    _Hash::_Group group(table->Control + position);
+    for (_Hash::_Mask match = group.Match(tag); match; match.Next()) {
+      std::size_t index = (position + match.Lowest()) & mask;
+      if (this->_Equal(table->Slots[index].Key, key))
+        return &table->Slots[index];
+    }
+    if (group.MatchEmpty())
+      return nullptr;
+    position = (position + probe * _Hash::_GROUP) & mask;
+  }
+  return nullptr;
+}
+
+template <class K, class V, class Hash, class Eq>
+V &CDS_ConcurrentHashMap<K, V, Hash, Eq>::Place(_Shard &shard,
+                                                std::size_t hash,
+                                                const K &key, V &&value) {
+  _Table *table = shard.Table.load(std::memory_order_relaxed);
+  std::size_t capacity = table ? table->Capacity : 0;
+  std::size_t size = shard.Size.load(std::memory_order_relaxed);
+  std::size_t budget = std::size_t(capacity * this->_MaxLoadFactor);
+  if (size + shard.Deleted + 1 > budget) {
+    // As in CDS_HashMap, rehash in place once half the budget is deleted
+    // slots, otherwise double.
+    if (capacity && (size + 1) * 2 <= budget)
+      this->Rehash(shard, capacity);
+    else
+      this->Rehash(shard, this->CapacityFor(size + 1));
+    table = shard.Table.load(std::memory_order_relaxed);
+  }
+  std::size_t index = Probe(table, hash);
+  ::new (&table->Slots[index]) _Slot{key, std::move(value)};
+  if (table->Control[index] == _Hash::_DELETED)
+    shard.Deleted--;
+  SetControl(table, index, _Hash::_H2(hash));
+  shard.Size.store(size + 1, std::memory_order_relaxed);
+  return table->Slots[index].Value;
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_ConcurrentHashMap<K, V, Hash, Eq>::Rehash(_Shard &shard,
+                                                   std::size_t capacity) {
+  _Table *old = shard.Table.load(std::memory_order_relaxed);
+  if (old && old->Capacity == capacity) {
+    // Readers retry while the sequence is odd, so the entries can be
+    // shuffled within the table they may be probing.
+    std::vector<_Slot> entries;
+    entries.reserve(shard.Size.load(std::memory_order_relaxed));
+    for (std::size_t i = 0; i < capacity; i++) {
+      if (old->Control[i] < 0)
+        continue;
+      entries.push_back(std::move(old->Slots[i]));
+      std::destroy_at(&old->Slots[i]);
+    }
+    std::fill_n(old->Control, capacity + _Hash::_GROUP, _Hash::_EMPTY);
+    for (_Slot &entry : entries) {
+      std::size_t hash = _Hash::_Mix(this->_Hasher(entry.Key));
+      std::size_t index = Probe(old, hash);
+      ::new (&old->Slots[index]) _Slot(std::move(entry));
+      SetControl(old, index, _Hash::_H2(hash));
+    }
+    shard.Deleted = 0;
+    return;
+  }
+
+  _Table *table = Allocate(capacity);
+  for (std::size_t i = 0; old && i < old->Capacity; i++) {
+    if (old->Control[i] < 0)
+      continue;
+    std::size_t hash = _Hash::_Mix(this->_Hasher(old->Slots[i].Key));
+    std::size_t index = Probe(table, hash);
+    ::new (&table->Slots[index]) _Slot(std::move(old->Slots[i]));
+    SetControl(table, index, _Hash::_H2(hash));
+    std::destroy_at(&old->Slots[i]);
+  }
+  if constexpr (LockFreeReads) {
+    table->Replaced = old;
+  } else if (old) {
+    Free(old, false);
+  }
+  shard.Table.store(table, std::memory_order_release);
+  shard.Deleted = 0;
+}
+
+template <class K, class V, class Hash, class Eq>
+std::size_t
+CDS_ConcurrentHashMap<K, V, Hash, Eq>::CapacityFor(std::size_t count) const {
+  std::size_t capacity = _Hash::_MIN_CAPACITY;
+  while (count > std::size_t(capacity * this->_MaxLoadFactor)) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+template <class K, class V, class Hash, class Eq>
+typename CDS_ConcurrentHashMap<K, V, Hash, Eq>::_Table *
+CDS_ConcurrentHashMap<K, V, Hash, Eq>::Allocate(std::size_t capacity) {
+  _Table *table = new _Table{capacity, nullptr, nullptr, nullptr};
+  table->Control = new std::int8_t[capacity + _Hash::_GROUP];
+  table->Slots = std::allocator<_Slot>().allocate(capacity);
+  std::fill_n(table->Control, capacity + _Hash::_GROUP, _Hash::_EMPTY);
+  return table;
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_ConcurrentHashMap<K, V, Hash, Eq>::SetControl(_Table *table,
+                                                       std::size_t index,
+                                                       std::int8_t control) {
+  table->Control[index] = control;
+  if (index < _Hash::_GROUP)
+    table->Control[table->Capacity + index] = control;
+}
+
+template <class K, class V, class Hash, class Eq>
+std::size_t CDS_ConcurrentHashMap<K, V, Hash, Eq>::Probe(const _Table *table,
+                                                         std::size_t hash) {
+  std::size_t mask = table->Capacity - 1;
+  std::size_t position = _Hash::_H1(hash) & mask;
+  for (std::size_t step = _Hash::_GROUP;; step += _Hash::_GROUP) {
+    _Hash::_Mask free = _Hash::_Group(table->Control + position).MatchFree();
+    if (free)
+      return (position + free.Lowest()) & mask;
+    position = (position + step) & mask;
+  }
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_ConcurrentHashMap<K, V, Hash, Eq>::Free(_Table *table,
+                                                 bool destroy) {
+  for (std::size_t i = 0; destroy && i < table->Capacity; i++) {
+    if (table->Control[i] >= 0)
+      std::destroy_at(&table->Slots[i]);
+  }
+  delete[] table->Control;
+  std::allocator<_Slot>().deallocate(table->Slots, table->Capacity);
+  delete table;
+}
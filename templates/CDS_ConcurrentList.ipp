@@ -0,0 +1,117 @@
+#pragma once
+#include "CDS_ConcurrentList.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+// Destructor
+template <class T> CDS_ConcurrentList<T>::~CDS_ConcurrentList() {
+  this->Release();
+}
+
+// Getters
+template <class T> std::size_t CDS_ConcurrentList<T>::GetSize() const {
+  return this->_Size.load(std::memory_order_acquire);
+}
+
+// Append
+template <class T>
+const T &CDS_ConcurrentList<T>::Append(const T &elem) noexcept {
+  return *::new (this->Claim()) T(elem);
+}
+
+template <class T>
+const T &CDS_ConcurrentList<T>::Append(T &&elem) noexcept {
+  return *::new (this->Claim()) T(std::move(elem));
+}
+
+// Emplace
+template <class T>
+template <class... Args>
+T &CDS_ConcurrentList<T>::Emplace(Args &&...args) noexcept {
+  return *::new (this->Claim()) T(std::forward<Args>(args)...);
+}
+
+// Freeze
+template <class T> CDS_List<T> CDS_ConcurrentList<T>::Freeze() {
+  std::size_t size = this->_Size.load(std::memory_order_acquire);
+  CDS_List<T> list;
+  list.Reserve(size);
+  for (std::size_t segment = 0, done = 0; done < size; segment++) {
+    T *data = this->_Segments[segment].load(std::memory_order_acquire);
+    std::size_t count =
+        std::min(_Segment::_Capacity(segment), size - done);
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      list.AppendRange(std::span<const T>(data, count));
+    } else {
+      list.AppendRange(std::make_move_iterator(data),
+                       std::make_move_iterator(data + count));
+    }
+    done += count;
+  }
+  this->Release();
+  return list;
+}
+
+// Operator Overloads
+template <class T>
+T &CDS_ConcurrentList<T>::operator[](const std::size_t index) {
+  assertm(index < this->GetSize(), "Index out of bounds");
+  _Segment::_Position position = _Segment::_Locate(index);
+  return this->_Segments[position.Segment].load(
+      std::memory_order_acquire)[position.Offset];
+}
+
+template <class T>
+const T &CDS_ConcurrentList<T>::operator[](const std::size_t index) const {
+  assertm(index < this->GetSize(), "Index out of bounds");
+  _Segment::_Position position = _Segment::_Locate(index);
+  return this->_Segments[position.Segment].load(
+      std::memory_order_acquire)[position.Offset];
+}
+
+// Private
+template <class T> T *CDS_ConcurrentList<T>::Claim() {
+  std::size_t index = this->_Size.fetch_add(1, std::memory_order_acq_rel);
+  _Segment::_Position position = _Segment::_Locate(index);
+  assertm(position.Segment < _Segment::_COUNT, "List is full");
+  std::atomic<T *> &slot = this->_Segments[position.Segment];
+  T *data = slot.load(std::memory_order_acquire);
+  if (!data) {
+    // Every thread landing in a missing segment races to install one, the
+    // losers free theirs and use the winner's.
+    std::size_t bytes = _Segment::_Capacity(position.Segment) * sizeof(T);
+    T *fresh = static_cast<T *>(
+        ::operator new(bytes, std::align_val_t(alignof(T))));
+    if (slot.compare_exchange_strong(data, fresh, std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+      data = fresh;
+    } else {
+      ::operator delete(fresh, std::align_val_t(alignof(T)));
+    }
+  }
+  return data + position.Offset;
+}
+
+template <class T> void CDS_ConcurrentList<T>::Release() {
+  std::size_t size = this->_Size.load(std::memory_order_acquire);
+  for (std::size_t segment = 0; segment < _Segment::_COUNT; segment++) {
+    T *data = this->_Segments[segment].exchange(nullptr);
+    if (!data)
+      continue;
+    std::size_t first = _Segment::_First(segment);
+    std::size_t count = first < size
+                            ? std::min(_Segment::_Capacity(segment),
+                                       size - first)
+                            : 0;
+    std::destroy_n(data, count);
+    ::operator delete(data, std::align_val_t(alignof(T)));
+  }
+  this->_Size.store(0, std::memory_order_release);
+}
@@ -0,0 +1,794 @@
+#pragma once
+#include "CDS_Eigen.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+namespace _Factor {
+
+// y = A * x for a symmetric n x n matrix of which only the lower triangle is
+// read. Column bands of equal area run in parallel into private buffers.
+template <class T>
+void _SymmetricProduct(int n, const T *a, int lda, const T *x, T *y) {
+  CDS_ThreadPool &pool = CDS_ThreadPool::Instance();
+  std::size_t work = std::size_t(n) * n / 2;
+  std::size_t bands = pool.IsSerial(work) ? 1 : pool.GetThreadCount();
+  std::vector<T> partial((bands - 1) * std::size_t(n), T(0));
+  std::fill(y, y + n, T(0));
+
+  pool.ParallelFor(bands, work, [&](std::size_t band) {
+    // Band boundaries split the triangle into pieces of equal area.
+    auto boundary = [&](std::size_t k) {
+      return static_cast<int>(
+          n * (1.0 - std::sqrt(1.0 - double(k) / double(bands))));
+    };
+    int begin = band == 0 ? 0 : boundary(band);
+    int end = band + 1 == bands ? n : boundary(band + 1);
+    T *out = band == 0 ? y : partial.data() + (band - 1) * std::size_t(n);
+    for (int j = begin; j < end; j++) {
+      const T *col = a + std::size_t(j) * lda;
+      T xj = x[j];
+      T sum = T(0);
+      for (int i = j + 1; i < n; i++) {
+        out[i] += col[i] * xj;
+        sum += col[i] * x[i];
+      }
+      out[j] += col[j] * xj + sum;
+    }
+  });
+  for (std::size_t band = 1; band < bands; band++) {
+    const T *in = partial.data() + (band - 1) * std::size_t(n);
+    for (int i = 0; i < n; i++) {
+      y[i] += in[i];
+    }
+  }
+}
+
+// Reduces the first nb columns of the symmetric m x m block at a to
+// tridiagonal form and returns in w the matrix W such that the trailing
+// block is updated by A22 -= V * W^T + W * V^T (LAPACK latrd, lower).
+template <class T>
+void _TridiagonalPanel(T *a, int lda, int m, int nb, T *e, T *tau, T *w,
+                       int ldw) {
+  auto A = [&](int i, int j) -> T & { return a[i + std::size_t(j) * lda]; };
+  auto W = [&](int i, int j) -> T & { return w[i + std::size_t(j) * ldw]; };
+
+  for (int j = 0; j < nb; j++) {
+    // Bring column j up to date with the reflectors of this panel.
+    for (int k = 0; k < j; k++) {
+      T wjk = W(j, k);
+      T ajk = A(j, k);
+      for (int r = j; r < m; r++) {
+        A(r, j) -= A(r, k) * wjk + W(r, k) * ajk;
+      }
+    }
+    if (j == m - 1)
+      continue;
+
+    int len = m - j - 1;
+    T *v = &A(j + 1, j);
+    tau[j] = _Reflector(len, v);
+    e[j] = v[0];
+    v[0] = T(1);
+
+    // W(j+1:m, j) = tau * (A22 - V W^T - W V^T) * v, with the corrections
+    // for the earlier columns of the panel applied explicitly.
+    T *x = &W(j + 1, j);
+    T *t = &W(0, j);
+    _SymmetricProduct(len, &A(j + 1, j + 1), lda, v, x);
+    for (int k = 0; k < j; k++) {
+      T sum = T(0);
+      for (int r = 0; r < len; r++) {
+        sum += W(j + 1 + r, k) * v[r];
+      }
+      t[k] = sum;
+    }
+    for (int k = 0; k < j; k++) {
+      for (int r = 0; r < len; r++) {
+        x[r] -= A(j + 1 + r, k) * t[k];
+      }
+    }
+    for (int k = 0; k < j; k++) {
+      T sum = T(0);
+      for (int r = 0; r < len; r++) {
+        sum += A(j + 1 + r, k) * v[r];
+      }
+      t[k] = sum;
+    }
+    for (int k = 0; k < j; k++) {
+      for (int r = 0; r < len; r++) {
+        x[r] -= W(j + 1 + r, k) * t[k];
+      }
+    }
+    T dot = T(0);
+    for (int r = 0; r < len; r++) {
+      x[r] *= tau[j];
+      dot += x[r] * v[r];
+    }
+    T alpha = T(-0.5) * tau[j] * dot;
+    for (int r = 0; r < len; r++) {
+      x[r] += alpha * v[r];
+    }
+  }
+}
+
+// Reduces the symmetric n x n matrix at a (lower triangle) to tridiagonal
+// form Q^T * A * Q = T. The reflectors are left below the subdiagonal.
+template <class T>
+void _Tridiagonalize(T *a, int n, std::vector<T> &d, std::vector<T> &e,
+                     std::vector<T> &tau) {
+  const int nb = CDS_FACTOR_NB;
+  const std::size_t lda = n;
+  d.assign(n, T(0));
+  e.assign(std::max(n - 1, 0), T(0));
+  tau.assign(std::max(n - 1, 0), T(0));
+
+  int i = 0;
+  std::vector<T> w(std::size_t(n) * nb);
+  for (; n - i > 2 * nb; i += nb) {
+    int m = n - i;
+    T *block = a + i + i * lda;
+    _TridiagonalPanel(block, n, m, nb, e.data() + i, tau.data() + i, w.data(),
+                      m);
+
+    // Lower triangle of A22 -= V * W^T + W * V^T, one column tile at a time.
+    const T *v = block + nb;
+    const T *wt = w.data() + nb;
+    int rest = m - nb;
+    for (int c0 = 0; c0 < rest; c0 += nb) {
+      int cols = std::min(nb, rest - c0);
+      CDS_MatrixView<T> c =
+          _View(block + nb + c0 + (nb + c0) * lda, n, rest - c0, cols);
+      _Update<T>(T(-1), _View(v + c0, n, rest - c0, nb),
+                 CDS_MatrixView<const T>(wt + c0, nb, cols, m, 1), T(1), c);
+      _Update<T>(T(-1), _View(wt + c0, m, rest - c0, nb),
+                 CDS_MatrixView<const T>(v + c0, nb, cols, lda, 1), T(1), c);
+    }
+    for (int j = i; j < i + nb; j++) {
+      a[j + 1 + j * lda] = e[j];
+      d[j] = a[j + j * lda];
+    }
+  }
+
+  // Unblocked remainder (LAPACK sytd2, lower).
+  std::vector<T> x(n);
+  for (; i < n - 1; i++) {
+    int len = n - i - 1;
+    T *v = a + i + 1 + i * lda;
+    T taui = _Reflector(len, v);
+    e[i] = v[0];
+    if (taui != T(0)) {
+      v[0] = T(1);
+      T *trailing = a + (i + 1) + (i + 1) * lda;
+      _SymmetricProduct(len, trailing, n, v, x.data());
+      T dot = T(0);
+      for (int r = 0; r < len; r++) {
+        x[r] *= taui;
+        dot += x[r] * v[r];
+      }
+      T alpha = T(-0.5) * taui * dot;
+      for (int r = 0; r < len; r++) {
+        x[r] += alpha * v[r];
+      }
+      for (int c = 0; c < len; c++) {
+        T *col = trailing + c * lda;
+        for (int r = c; r < len; r++) {
+          col[r] -= v[r] * x[c] + x[r] * v[c];
+        }
+      }
+      v[0] = e[i];
+    }
+    d[i] = a[i + i * lda];
+    tau[i] = taui;
+  }
+  if (n > 0)
+    d[n - 1] = a[(n - 1) + (n - 1) * lda];
+}
+
+// Reduces the general n x n matrix at a to upper Hessenberg form
+// Q^T * A * Q = H. The reflectors are left below the subdiagonal.
+template <class T> void _Hessenberg(T *a, int n, std::vector<T> &tau) {
+  const std::size_t lda = n;
+  tau.assign(std::max(n - 1, 0), T(0));
+  std::vector<T> w(n);
+  for (int k = 0; k < n - 1; k++) {
+    int len = n - k - 1;
+    T *v = a + k + 1 + k * lda;
+    T t = _Reflector(len, v);
+    tau[k] = t;
+    if (t == T(0))
+      continue;
+    T beta = v[0];
+    v[0] = T(1);
+
+    // H * A from the left on the trailing columns.
+    _ApplyReflector(len, v, t, v + lda, n, len);
+
+    // A * H from the right on all rows.
+    T *cols = a + (k + 1) * lda;
+    std::fill(w.begin(), w.end(), T(0));
+    for (int c = 0; c < len; c++) {
+      const T *col = cols + c * lda;
+      for (int r = 0; r < n; r++) {
+        w[r] += col[r] * v[c];
+      }
+    }
+    for (int c = 0; c < len; c++) {
+      T *col = cols + c * lda;
+      T scale = t * v[c];
+      for (int r = 0; r < n; r++) {
+        col[r] -= w[r] * scale;
+      }
+    }
+    v[0] = beta;
+  }
+}
+
+// Forms Q = H(0) ... H(n - 2) from reflectors stored below the subdiagonal,
+// reflector k acting on rows k + 1 to n - 1.
+template <class T>
+std::vector<T> _SubdiagonalQ(const T *a, int n, const std::vector<T> &tau) {
+  std::vector<T> q(std::size_t(n) * n, T(0));
+  if (n == 0)
+    return q;
+  q[0] = T(1);
+  if (n == 1)
+    return q;
+
+  // The reflectors are those of a QR factorization of A(1:n, 0:n-1).
+  QR<T> qr;
+  qr.Rows = qr.Cols = n - 1;
+  qr.Tau = tau;
+  qr.Data.resize(std::size_t(n - 1) * (n - 1));
+  for (int j = 0; j < n - 1; j++) {
+    std::copy(a + 1 + std::size_t(j) * n, a + std::size_t(j + 1) * n,
+              qr.Data.begin() + std::size_t(j) * (n - 1));
+  }
+  std::vector<T> inner = QrFormQ(qr);
+  for (int j = 0; j < n - 1; j++) {
+    std::copy(inner.begin() + std::size_t(j) * (n - 1),
+              inner.begin() + std::size_t(j + 1) * (n - 1),
+              q.begin() + 1 + std::size_t(j + 1) * n);
+  }
+  return q;
+}
+
+// Implicit QL on the symmetric tridiagonal matrix with diagonal d and
+// subdiagonal e (length n, e[n - 1] unused). The rotations are applied to the
+// columns of z if it is not null. Eigenvalues end up in d. Returns false if
+// the iteration did not converge within 30 sweeps per eigenvalue.
+template <class T> bool _TridiagonalQL(int n, T *d, T *e, T *z) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  const std::size_t ldz = n;
+  if (n == 0)
+    return true;
+  e[n - 1] = T(0);
+
+  int budget = 30 * n;
+  T shift = T(0);
+  T norm = T(0);
+  for (int l = 0; l < n; l++) {
+    norm = std::max(norm, std::abs(d[l]) + std::abs(e[l]));
+    int m = l;
+    while (m < n - 1 && std::abs(e[m]) > eps * norm) {
+      m++;
+    }
+    if (m > l) {
+      do {
+        if (budget-- == 0)
+          return false;
+        // Wilkinson-like shift from the leading 2 x 2 block.
+        T g = d[l];
+        T p = (d[l + 1] - g) / (T(2) * e[l]);
+        T r = std::hypot(p, T(1));
+        if (p < T(0))
+          r = -r;
+        d[l] = e[l] / (p + r);
+        d[l + 1] = e[l] * (p + r);
+        T next = d[l + 1];
+        T h = g - d[l];
+        for (int i = l + 2; i < n; i++) {
+          d[i] -= h;
+        }
+        shift += h;
+
+        // Chase the bulge from the bottom with plane rotations.
+        p = d[m];
+        T c = T(1), c2 = T(1), c3 = T(1);
+        T el1 = e[l + 1];
+        T s = T(0), s2 = T(0);
+        for (int i = m - 1; i >= l; i--) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * e[i];
+          h = c * p;
+          r = std::hypot(p, e[i]);
+          e[i + 1] = s * r;
+          s = e[i] / r;
+          c = p / r;
+          p = c * d[i] - s * g;
+          d[i + 1] = h + s * (c * g + s * d[i]);
+          if (z != nullptr) {
+            T *left = z + i * ldz;
+            T *right = left + ldz;
+            for (int k = 0; k < n; k++) {
+              T value = right[k];
+              right[k] = s * left[k] + c * value;
+              left[k] = c * left[k] - s * value;
+            }
+          }
+        }
+        p = -s * s2 * c3 * el1 * e[l] / next;
+        e[l] = s * p;
+        d[l] = c * p;
+      } while (std::abs(e[l]) > eps * norm);
+    }
+    d[l] += shift;
+    e[l] = T(0);
+  }
+  return true;
+}
+
+// Francis double-shift QR on the upper Hessenberg matrix h, accumulating the
+// transformations into z and back substituting for the eigenvectors when z
+// is not null (EISPACK hqr2). On return z holds the real eigenvectors, a
+// complex pair (wr + i wi, wi > 0) as two columns with its real and
+// imaginary parts. Returns false if the iteration did not converge within 30
+// sweeps per eigenvalue, as LAPACK hseqr allows.
+template <class T>
+bool _HessenbergQR(int nn, T *hdata, std::vector<T> &wr, std::vector<T> &wi,
+                   T *z) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  const std::size_t ld = nn;
+  auto H = [&](int i, int j) -> T & { return hdata[i + j * ld]; };
+  auto V = [&](int i, int j) -> T & { return z[i + j * ld]; };
+  auto divide = [](T ar, T ai, T br, T bi) {
+    return std::complex<T>(ar, ai) / std::complex<T>(br, bi);
+  };
+  wr.assign(nn, T(0));
+  wi.assign(nn, T(0));
+
+  T norm = T(0);
+  for (int i = 0; i < nn; i++) {
+    for (int j = std::max(i - 1, 0); j < nn; j++) {
+      norm += std::abs(H(i, j));
+    }
+  }
+
+  int n = nn - 1;
+  int iter = 0;
+  int budget = 30 * std::max(nn, 10);
+  T exshift = T(0);
+  T p = T(0), q = T(0), r = T(0), s = T(0), zz = T(0);
+  T x = T(0), y = T(0), w = T(0), t = T(0);
+  while (n >= 0) {
+    // Look for a single small subdiagonal element.
+    int l = n;
+    while (l > 0) {
+      s = std::abs(H(l - 1, l - 1)) + std::abs(H(l, l));
+      if (s == T(0))
+        s = norm;
+      if (std::abs(H(l, l - 1)) < eps * s)
+        break;
+      l--;
+    }
+
+    if (l == n) {
+      // One root found.
+      H(n, n) += exshift;
+      wr[n] = H(n, n);
+      wi[n] = T(0);
+      n--;
+      iter = 0;
+    } else if (l == n - 1) {
+      // Two roots found.
+      w = H(n, n - 1) * H(n - 1, n);
+      p = (H(n - 1, n - 1) - H(n, n)) / T(2);
+      q = p * p + w;
+      zz = std::sqrt(std::abs(q));
+      H(n, n) += exshift;
+      H(n - 1, n - 1) += exshift;
+      x = H(n, n);
+
+      if (q >= T(0)) {
+        // Real pair, split off with a rotation.
+        zz = p >= T(0) ? p + zz : p - zz;
+        wr[n - 1] = x + zz;
+        wr[n] = zz != T(0) ? x - w / zz : wr[n - 1];
+        wi[n - 1] = wi[n] = T(0);
+        x = H(n, n - 1);
+        s = std::abs(x) + std::abs(zz);
+        p = x / s;
+        q = zz / s;
+        r = std::sqrt(p * p + q * q);
+        p /= r;
+        q /= r;
+        for (int j = n - 1; j < nn; j++) {
+          zz = H(n - 1, j);
+          H(n - 1, j) = q * zz + p * H(n, j);
+          H(n, j) = q * H(n, j) - p * zz;
+        }
+        for (int i = 0; i <= n; i++) {
+          zz = H(i, n - 1);
+          H(i, n - 1) = q * zz + p * H(i, n);
+          H(i, n) = q * H(i, n) - p * zz;
+        }
+        if (z != nullptr) {
+          for (int i = 0; i < nn; i++) {
+            zz = V(i, n - 1);
+            V(i, n - 1) = q * zz + p * V(i, n);
+            V(i, n) = q * V(i, n) - p * zz;
+          }
+        }
+      } else {
+        // Complex pair.
+        wr[n - 1] = wr[n] = x + p;
+        wi[n - 1] = zz;
+        wi[n] = -zz;
+      }
+      n -= 2;
+      iter = 0;
+    } else {
+      // Form the shift.
+      x = H(n, n);
+      y = T(0);
+      w = T(0);
+      if (l < n) {
+        y = H(n - 1, n - 1);
+        w = H(n, n - 1) * H(n - 1, n);
+      }
+
+      // Exceptional shifts after 10 and 30 iterations without convergence.
+      if (iter == 10) {
+        exshift += x;
+        for (int i = 0; i <= n; i++) {
+          H(i, i) -= x;
+        }
+        s = std::abs(H(n, n - 1)) + std::abs(H(n - 1, n - 2));
+        x = y = T(0.75) * s;
+        w = T(-0.4375) * s * s;
+      }
+      if (iter == 30) {
+        s = (y - x) / T(2);
+        s = s * s + w;
+        if (s > T(0)) {
+          s = std::sqrt(s);
+          if (y < x)
+            s = -s;
+          s = x - w / ((y - x) / T(2) + s);
+          for (int i = 0; i <= n; i++) {
+            H(i, i) -= s;
+          }
+          exshift += s;
+          x = y = w = T(0.964);
+        }
+      }
+      iter++;
+      if (budget-- == 0)
+        return false;
+
+      // Look for two consecutive small subdiagonal elements.
+      int m = n - 2;
+      while (m >= l) {
+        zz = H(m, m);
+        r = x - zz;
+        s = y - zz;
+        p = (r * s - w) / H(m + 1, m) + H(m, m + 1);
+        q = H(m + 1, m + 1) - zz - r - s;
+        r = H(m + 2, m + 1);
+        s = std::abs(p) + std::abs(q) + std::abs(r);
+        p /= s;
+        q /= s;
+        r /= s;
+        if (m == l)
+          break;
+        if (std::abs(H(m, m - 1)) * (std::abs(q) + std::abs(r)) <
+            eps * (std::abs(p) * (std::abs(H(m - 1, m - 1)) + std::abs(zz) +
+                                  std::abs(H(m + 1, m + 1)))))
+          break;
+        m--;
+      }
+      for (int i = m + 2; i <= n; i++) {
+        H(i, i - 2) = T(0);
+        if (i > m + 2)
+          H(i, i - 3) = T(0);
+      }
+
+      // Double QR step on rows l..n and columns m..n.
+      for (int k = m; k <= n - 1; k++) {
+        bool notlast = k != n - 1;
+        if (k != m) {
+          p = H(k, k - 1);
+          q = H(k + 1, k - 1);
+          r = notlast ? H(k + 2, k - 1) : T(0);
+          x = std::abs(p) + std::abs(q) + std::abs(r);
+          if (x == T(0))
+            continue;
+          p /= x;
+          q /= x;
+          r /= x;
+        }
+        s = std::sqrt(p * p + q * q + r * r);
+        if (p < T(0))
+          s = -s;
+        if (s == T(0))
+          continue;
+        if (k != m)
+          H(k, k - 1) = -s * x;
+        else if (l != m)
+          H(k, k - 1) = -H(k, k - 1);
+        p += s;
+        x = p / s;
+        y = q / s;
+        zz = r / s;
+        q /= p;
+        r /= p;
+
+        for (int j = k; j < nn; j++) {
+          p = H(k, j) + q * H(k + 1, j);
+          if (notlast) {
+            p += r * H(k + 2, j);
+            H(k + 2, j) -= p * zz;
+          }
+          H(k, j) -= p * x;
+          H(k + 1, j) -= p * y;
+        }
+        for (int i = 0; i <= std::min(n, k + 3); i++) {
+          p = x * H(i, k) + y * H(i, k + 1);
+          if (notlast) {
+            p += zz * H(i, k + 2);
+            H(i, k + 2) -= p * r;
+          }
+          H(i, k) -= p;
+          H(i, k + 1) -= p * q;
+        }
+        if (z != nullptr) {
+          for (int i = 0; i < nn; i++) {
+            p = x * V(i, k) + y * V(i, k + 1);
+            if (notlast) {
+              p += zz * V(i, k + 2);
+              V(i, k + 2) -= p * r;
+            }
+            V(i, k) -= p;
+            V(i, k + 1) -= p * q;
+          }
+        }
+      }
+    }
+  }
+
+  if (z == nullptr || norm == T(0))
+    return true;
+
+  // Back substitute for the eigenvectors of the quasi-triangular form.
+  for (n = nn - 1; n >= 0; n--) {
+    p = wr[n];
+    q = wi[n];
+
+    if (q == T(0)) {
+      // Real vector.
+      int l = n;
+      H(n, n) = T(1);
+      for (int i = n - 1; i >= 0; i--) {
+        w = H(i, i) - p;
+        r = T(0);
+        for (int j = l; j <= n; j++) {
+          r += H(i, j) * H(j, n);
+        }
+        if (wi[i] < T(0)) {
+          zz = w;
+          s = r;
+          continue;
+        }
+        l = i;
+        if (wi[i] == T(0)) {
+          H(i, n) = w != T(0) ? -r / w : -r / (eps * norm);
+        } else {
+          x = H(i, i + 1);
+          y = H(i + 1, i);
+          q = (wr[i] - p) * (wr[i] - p) + wi[i] * wi[i];
+          t = (x * s - zz * r) / q;
+          H(i, n) = t;
+          H(i + 1, n) =
+              std::abs(x) > std::abs(zz) ? (-r - w * t) / x : (-s - y * t) / zz;
+        }
+        // Overflow control.
+        t = std::abs(H(i, n));
+        if ((eps * t) * t > T(1)) {
+          for (int j = i; j <= n; j++) {
+            H(j, n) /= t;
+          }
+        }
+      }
+    } else if (q < T(0)) {
+      // Complex vector, the last component is taken imaginary.
+      int l = n - 1;
+      if (std::abs(H(n, n - 1)) > std::abs(H(n - 1, n))) {
+        H(n - 1, n - 1) = q / H(n, n - 1);
+        H(n - 1, n) = -(H(n, n) - p) / H(n, n - 1);
+      } else {
+        std::complex<T> c = divide(T(0), -H(n - 1, n), H(n - 1, n - 1) - p, q);
+        H(n - 1, n - 1) = c.real();
+        H(n - 1, n) = c.imag();
+      }
+      H(n, n - 1) = T(0);
+      H(n, n) = T(1);
+      for (int i = n - 2; i >= 0; i--) {
+        T ra = T(0), sa = T(0);
+        for (int j = l; j <= n; j++) {
+          ra += H(i, j) * H(j, n - 1);
+          sa += H(i, j) * H(j, n);
+        }
+        w = H(i, i) - p;
+        if (wi[i] < T(0)) {
+          zz = w;
+          r = ra;
+          s = sa;
+          continue;
+        }
+        l = i;
+        if (wi[i] == T(0)) {
+          std::complex<T> c = divide(-ra, -sa, w, q);
+          H(i, n - 1) = c.real();
+          H(i, n) = c.imag();
+        } else {
+          x = H(i, i + 1);
+          y = H(i + 1, i);
+          T vr = (wr[i] - p) * (wr[i] - p) + wi[i] * wi[i] - q * q;
+          T vi = (wr[i] - p) * T(2) * q;
+          if (vr == T(0) && vi == T(0)) {
+            vr = eps * norm *
+                 (std::abs(w) + std::abs(q) + std::abs(x) + std::abs(y) +
+                  std::abs(zz));
+          }
+          std::complex<T> c = divide(x * r - zz * ra + q * sa,
+                                     x * s - zz * sa - q * ra, vr, vi);
+          H(i, n - 1) = c.real();
+          H(i, n) = c.imag();
+          if (std::abs(x) > std::abs(zz) + std::abs(q)) {
+            H(i + 1, n - 1) = (-ra - w * H(i, n - 1) + q * H(i, n)) / x;
+            H(i + 1, n) = (-sa - w * H(i, n) - q * H(i, n - 1)) / x;
+          } else {
+            c = divide(-r - y * H(i, n - 1), -s - y * H(i, n), zz, q);
+            H(i + 1, n - 1) = c.real();
+            H(i + 1, n) = c.imag();
+          }
+        }
+        // Overflow control.
+        t = std::max(std::abs(H(i, n - 1)), std::abs(H(i, n)));
+        if ((eps * t) * t > T(1)) {
+          for (int j = i; j <= n; j++) {
+            H(j, n - 1) /= t;
+            H(j, n) /= t;
+          }
+        }
+      }
+    }
+  }
+
+  // Eigenvectors of A = Z * (upper triangle of H).
+  std::vector<T> upper(std::size_t(nn) * nn, T(0));
+  for (int j = 0; j < nn; j++) {
+    std::copy(hdata + j * ld, hdata + j * ld + j + 1, upper.begin() + j * ld);
+  }
+  std::vector<T> product(std::size_t(nn) * nn);
+  _Update<T>(T(1), _View<const T>(z, nn, nn, nn),
+             _View<const T>(upper.data(), nn, nn, nn), T(0),
+             _View(product.data(), nn, nn, nn));
+  std::copy(product.begin(), product.end(), z);
+  return true;
+}
+
+// Solvers
+//
+// Infinite and NaN elements are rejected up front, the iterations could
+// never deflate them.
+template <class T> bool _Finite(const std::vector<T> &data) {
+  return std::all_of(data.begin(), data.end(),
+                     [](T x) { return std::isfinite(x); });
+}
+
+template <class T>
+CDS_Result<Spectrum<T>> SymmetricEigen(std::vector<T> data, int n,
+                                       bool vectors) {
+  if (!_Finite(data))
+    return CDS_Result<Spectrum<T>>::Failure(
+        "The matrix has non-finite elements");
+  Spectrum<T> out;
+  std::vector<T> d, e, tau;
+  _Tridiagonalize(data.data(), n, d, e, tau);
+  e.resize(n);
+
+  std::vector<T> z;
+  if (vectors)
+    z = _SubdiagonalQ(data.data(), n, tau);
+  if (!_TridiagonalQL(n, d.data(), e.data(), vectors ? z.data() : nullptr))
+    return CDS_Result<Spectrum<T>>::Failure(
+        "The eigenvalue iteration did not converge");
+
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](int lhs, int rhs) { return d[lhs] < d[rhs]; });
+  out.Values.resize(n);
+  for (int i = 0; i < n; i++) {
+    out.Values[i] = d[order[i]];
+  }
+  if (vectors) {
+    out.Vectors.resize(std::size_t(n) * n);
+    for (int j = 0; j < n; j++) {
+      const T *col = z.data() + std::size_t(order[j]) * n;
+      std::copy(col, col + n, out.Vectors.begin() + std::size_t(j) * n);
+    }
+  }
+  return CDS_Result<Spectrum<T>>::Success(out);
+}
+
+template <class T>
+CDS_Result<Spectrum<T>> GeneralEigen(std::vector<T> data, int n,
+                                     bool vectors) {
+  if (!_Finite(data))
+    return CDS_Result<Spectrum<T>>::Failure(
+        "The matrix has non-finite elements");
+  Spectrum<T> out;
+  std::vector<T> tau, wr, wi, z;
+  _Hessenberg(data.data(), n, tau);
+  if (vectors)
+    z = _SubdiagonalQ(data.data(), n, tau);
+  for (int j = 0; j < n; j++) {
+    for (int i = j + 2; i < n; i++) {
+      data[i + std::size_t(j) * n] = T(0);
+    }
+  }
+  if (!_HessenbergQR(n, data.data(), wr, wi, vectors ? z.data() : nullptr))
+    return CDS_Result<Spectrum<T>>::Failure(
+        "The eigenvalue iteration did not converge");
+
+  out.Values.resize(n);
+  for (int i = 0; i < n; i++) {
+    out.Values[i] = std::complex<T>(wr[i], wi[i]);
+  }
+  if (!vectors)
+    return CDS_Result<Spectrum<T>>::Success(out);
+
+  out.Vectors.resize(std::size_t(n) * n);
+  for (int j = 0; j < n; j++) {
+    std::complex<T> *col = out.Vectors.data() + std::size_t(j) * n;
+    const T *re = z.data() + std::size_t(j) * n;
+    if (wi[j] == T(0)) {
+      std::copy(re, re + n, col);
+    } else {
+      // Columns j and j + 1 hold the real and imaginary parts of the vector
+      // of the eigenvalue with positive imaginary part.
+      const T *im = re + n;
+      for (int i = 0; i < n; i++) {
+        col[i] = std::complex<T>(re[i], im[i]);
+      }
+    }
+    T norm = T(0);
+    for (int i = 0; i < n; i++) {
+      norm += std::norm(col[i]);
+    }
+    norm = std::sqrt(norm);
+    if (norm != T(0)) {
+      for (int i = 0; i < n; i++) {
+        col[i] /= norm;
+      }
+    }
+    if (wi[j] != T(0)) {
+      for (int i = 0; i < n; i++) {
+        col[i + n] = std::conj(col[i]);
+      }
+      j++;
+    }
+  }
+  return CDS_Result<Spectrum<T>>::Success(out);
+}
+
+} // namespace _Factor
@@ -0,0 +1,470 @@
+#pragma once
+#include "CDS_Factor.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+namespace _Factor {
+
+// Scalar Helpers
+template <class T> T _Conj(const T &value) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return value;
+  } else {
+    return std::conj(value);
+  }
+}
+
+template <class T> Real<T> _Abs(const T &value) { return std::abs(value); }
+
+template <class T> Real<T> _Abs2(const T &value) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return value * value;
+  } else {
+    return std::norm(value);
+  }
+}
+
+// Column-major Views
+template <class T>
+CDS_MatrixView<T> _View(T *data, int ld, int rows, int cols) {
+  return CDS_MatrixView<T>(data, rows, cols, 1, ld);
+}
+
+// C = alpha * A * B + beta * C on the parallel GEMM, tolerating empty
+// operands at the edges of the blocked loops.
+template <class T>
+void _Update(T alpha, CDS_MatrixView<const T> a, CDS_MatrixView<const T> b,
+             T beta, CDS_MatrixView<T> c) {
+  auto [rows, cols] = c.GetShape();
+  if (rows == 0 || cols == 0)
+    return;
+  if (std::get<1>(a.GetShape()) == 0) {
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) {
+        c[{i, j}] = beta == T(0) ? T(0) : beta * c[{i, j}];
+      }
+    }
+    return;
+  }
+  _Gemm::ParallelGemm<T>(alpha, a, b, beta, c);
+}
+
+// Triangular Solves
+// Solves L * X = B in place, L is unit lower triangular n x n.
+template <class T>
+void _SolveLowerUnit(const T *a, int lda, int n, T *b, int ldb, int nrhs) {
+  const int nb = CDS_FACTOR_NB;
+  CDS_ThreadPool &pool = CDS_ThreadPool::Instance();
+  for (int k0 = 0; k0 < n; k0 += nb) {
+    int kb = std::min(nb, n - k0);
+    pool.ParallelFor(nrhs, std::size_t(nrhs) * kb * kb, [&](std::size_t c) {
+      T *x = b + c * ldb;
+      for (int j = k0; j < k0 + kb; j++) {
+        T xj = x[j];
+        if (xj == T(0))
+          continue;
+        const T *col = a + std::size_t(j) * lda;
+        for (int i = j + 1; i < k0 + kb; i++) {
+          x[i] -= col[i] * xj;
+        }
+      }
+    });
+    int rest = n - k0 - kb;
+    _Update<T>(T(-1), _View(a + k0 + kb + std::size_t(k0) * lda, lda, rest, kb),
+               _View<const T>(b + k0, ldb, kb, nrhs), T(1),
+               _View(b + k0 + kb, ldb, rest, nrhs));
+  }
+}
+
+// Solves U * X = B in place, U is upper triangular n x n.
+template <class T>
+void _SolveUpper(const T *a, int lda, int n, T *b, int ldb, int nrhs) {
+  const int nb = CDS_FACTOR_NB;
+  CDS_ThreadPool &pool = CDS_ThreadPool::Instance();
+  for (int k1 = n; k1 > 0; k1 -= nb) {
+    int k0 = std::max(0, k1 - nb);
+    int kb = k1 - k0;
+    pool.ParallelFor(nrhs, std::size_t(nrhs) * kb * kb, [&](std::size_t c) {
+      T *x = b + c * ldb;
+      for (int j = k1 - 1; j >= k0; j--) {
+        const T *col = a + std::size_t(j) * lda;
+        x[j] /= col[j];
+        T xj = x[j];
+        if (xj == T(0))
+          continue;
+        for (int i = k0; i < j; i++) {
+          x[i] -= col[i] * xj;
+        }
+      }
+    });
+    _Update<T>(T(-1), _View(a + std::size_t(k0) * lda, lda, k0, kb),
+               _View<const T>(b + k0, ldb, kb, nrhs), T(1),
+               _View(b, ldb, k0, nrhs));
+  }
+}
+
+// Householder Reflectors
+// Turns x (length n) into beta * e1 by H^H x, with H = I - tau v v^H and
+// v(0) = 1. beta is stored in x(0) and v(1:n) in x(1:n).
+template <class T> T _Reflector(int n, T *x) {
+  using R = Real<T>;
+  if (n <= 0)
+    return T(0);
+  R tail = R(0);
+  for (int i = 1; i < n; i++) {
+    tail += _Abs2(x[i]);
+  }
+  T alpha = x[0];
+  R imag = R(0);
+  if constexpr (!std::is_arithmetic_v<T>)
+    imag = std::imag(alpha);
+  if (tail == R(0) && imag == R(0))
+    return T(0);
+
+  R beta = std::sqrt(_Abs2(alpha) + tail);
+  if (std::real(alpha) >= R(0))
+    beta = -beta;
+  T tau = (T(beta) - alpha) / T(beta);
+  T scale = T(1) / (alpha - T(beta));
+  for (int i = 1; i < n; i++) {
+    x[i] *= scale;
+  }
+  x[0] = T(beta);
+  return tau;
+}
+
+// Applies I - tau v v^H from the left to the n x cols block C, v(0) = 1.
+template <class T>
+void _ApplyReflector(int n, const T *v, T tau, T *c, int ldc, int cols) {
+  if (tau == T(0))
+    return;
+  for (int j = 0; j < cols; j++) {
+    T *col = c + std::size_t(j) * ldc;
+    T w = col[0];
+    for (int i = 1; i < n; i++) {
+      w += _Conj(v[i]) * col[i];
+    }
+    w *= tau;
+    col[0] -= w;
+    for (int i = 1; i < n; i++) {
+      col[i] -= v[i] * w;
+    }
+  }
+}
+
+// Applies the block reflector H = H(0) ... H(kb - 1) = I - V T V^H, or its
+// adjoint, from the left to the n x cols block C. The reflectors are stored
+// below the diagonal of the n x kb block at v.
+template <class T>
+void _ApplyBlock(const T *v, int ldv, int n, int kb, const T *tau,
+                 bool adjoint, T *c, int ldc, int cols) {
+  if (n == 0 || kb == 0 || cols == 0)
+    return;
+
+  // Dense copies of V and V^H with the implicit unit diagonal made explicit.
+  std::vector<T> dense(std::size_t(n) * kb, T(0));
+  std::vector<T> adj(std::size_t(kb) * n, T(0));
+  for (int j = 0; j < kb; j++) {
+    dense[j + std::size_t(j) * n] = T(1);
+    for (int i = j + 1; i < n; i++) {
+      dense[i + std::size_t(j) * n] = v[i + std::size_t(j) * ldv];
+    }
+    for (int i = j; i < n; i++) {
+      adj[j + std::size_t(i) * kb] = _Conj(dense[i + std::size_t(j) * n]);
+    }
+  }
+
+  // Triangular factor T, column i is -tau(i) * T * V^H * v(i) (LAPACK larft).
+  std::vector<T> factor(std::size_t(kb) * kb, T(0));
+  for (int i = 0; i < kb; i++) {
+    T *col = factor.data() + std::size_t(i) * kb;
+    for (int r = 0; r < i; r++) {
+      T sum = T(0);
+      for (int l = i; l < n; l++) {
+        sum += adj[r + std::size_t(l) * kb] * dense[l + std::size_t(i) * n];
+      }
+      col[r] = -tau[i] * sum;
+    }
+    for (int r = 0; r < i; r++) {
+      T sum = T(0);
+      for (int l = r; l < i; l++) {
+        sum += factor[r + std::size_t(l) * kb] * col[l];
+      }
+      col[r] = sum;
+    }
+    col[i] = tau[i];
+  }
+  if (adjoint) {
+    std::vector<T> transposed(std::size_t(kb) * kb, T(0));
+    for (int i = 0; i < kb; i++) {
+      for (int j = i; j < kb; j++) {
+        transposed[j + std::size_t(i) * kb] =
+            _Conj(factor[i + std::size_t(j) * kb]);
+      }
+    }
+    factor.swap(transposed);
+  }
+
+  // C -= V * (op(T) * (V^H * C))
+  std::vector<T> work(std::size_t(kb) * cols);
+  std::vector<T> scaled(std::size_t(kb) * cols);
+  _Update<T>(T(1), _View<const T>(adj.data(), kb, kb, n),
+             _View<const T>(c, ldc, n, cols), T(0),
+             _View(work.data(), kb, kb, cols));
+  _Update<T>(T(1), _View<const T>(factor.data(), kb, kb, kb),
+             _View<const T>(work.data(), kb, kb, cols), T(0),
+             _View(scaled.data(), kb, kb, cols));
+  _Update<T>(T(-1), _View<const T>(dense.data(), n, n, kb),
+             _View<const T>(scaled.data(), kb, kb, cols), T(1),
+             _View(c, ldc, n, cols));
+}
+
+// LU
+template <class T> LU<T> LuFactor(std::vector<T> data, int n) {
+  using R = Real<T>;
+  const int nb = CDS_FACTOR_NB;
+  LU<T> lu;
+  lu.Size = n;
+  lu.Pivots.resize(n);
+  T *a = data.data();
+  const std::size_t lda = n;
+
+  R norm = R(0);
+  for (const T &value : data) {
+    norm = std::max(norm, _Abs(value));
+  }
+
+  for (int j0 = 0; j0 < n; j0 += nb) {
+    int jb = std::min(nb, n - j0);
+
+    // Panel, right-looking and unblocked.
+    for (int j = j0; j < j0 + jb; j++) {
+      T *col = a + j * lda;
+      int pivot = j;
+      R best = _Abs(col[j]);
+      for (int i = j + 1; i < n; i++) {
+        R value = _Abs(col[i]);
+        if (value > best) {
+          best = value;
+          pivot = i;
+        }
+      }
+      lu.Pivots[j] = pivot;
+      if (pivot != j) {
+        lu.OddSwaps = !lu.OddSwaps;
+        for (int c = j0; c < j0 + jb; c++) {
+          std::swap(a[j + c * lda], a[pivot + c * lda]);
+        }
+      }
+      if (col[j] == T(0))
+        continue;
+      T inverse = T(1) / col[j];
+      for (int i = j + 1; i < n; i++) {
+        col[i] *= inverse;
+      }
+      for (int c = j + 1; c < j0 + jb; c++) {
+        T *other = a + c * lda;
+        T factor = other[j];
+        if (factor == T(0))
+          continue;
+        for (int i = j + 1; i < n; i++) {
+          other[i] -= col[i] * factor;
+        }
+      }
+    }
+
+    // Row swaps of the panel, applied left and right of it.
+    for (int j = j0; j < j0 + jb; j++) {
+      int pivot = lu.Pivots[j];
+      if (pivot == j)
+        continue;
+      for (int c = 0; c < j0; c++) {
+        std::swap(a[j + c * lda], a[pivot + c * lda]);
+      }
+      for (int c = j0 + jb; c < n; c++) {
+        std::swap(a[j + c * lda], a[pivot + c * lda]);
+      }
+    }
+
+    // U12 = L11^-1 * A12, A22 -= L21 * U12
+    int rest = n - j0 - jb;
+    if (rest == 0)
+      continue;
+    T *a11 = a + j0 + j0 * lda;
+    T *a12 = a + j0 + (j0 + jb) * lda;
+    T *a21 = a + (j0 + jb) + j0 * lda;
+    T *a22 = a + (j0 + jb) + (j0 + jb) * lda;
+    _SolveLowerUnit<T>(a11, n, jb, a12, n, rest);
+    _Update<T>(T(-1), _View<const T>(a21, n, rest, jb),
+               _View<const T>(a12, n, jb, rest), T(1),
+               _View(a22, n, rest, rest));
+  }
+
+  R tolerance = R(n) * std::numeric_limits<R>::epsilon() * norm;
+  for (int i = 0; i < n; i++) {
+    if (_Abs(a[i + i * lda]) <= tolerance)
+      lu.Singular = true;
+  }
+  lu.Data = std::move(data);
+  return lu;
+}
+
+template <class T> T LuDeterminant(const LU<T> &lu) {
+  T det = lu.OddSwaps ? T(-1) : T(1);
+  for (int i = 0; i < lu.Size; i++) {
+    det *= lu.Data[i + std::size_t(i) * lu.Size];
+  }
+  return det;
+}
+
+template <class T> std::vector<T> LuInverse(const LU<T> &lu) {
+  const int n = lu.Size;
+  std::vector<T> out(std::size_t(n) * n, T(0));
+
+  // A^-1 = U^-1 * L^-1 * P, starting from the rows of I permuted by P.
+  std::vector<int> rows(n);
+  for (int i = 0; i < n; i++) {
+    rows[i] = i;
+  }
+  for (int i = 0; i < n; i++) {
+    std::swap(rows[i], rows[lu.Pivots[i]]);
+  }
+  for (int i = 0; i < n; i++) {
+    out[i + std::size_t(rows[i]) * n] = T(1);
+  }
+  _SolveLowerUnit<T>(lu.Data.data(), n, n, out.data(), n, n);
+  _SolveUpper<T>(lu.Data.data(), n, n, out.data(), n, n);
+  return out;
+}
+
+// QR
+template <class T> QR<T> QrFactor(std::vector<T> data, int rows, int cols) {
+  const int nb = CDS_FACTOR_NB;
+  const int k = std::min(rows, cols);
+  QR<T> qr;
+  qr.Rows = rows;
+  qr.Cols = cols;
+  qr.Tau.assign(k, T(0));
+  T *a = data.data();
+  const std::size_t lda = rows;
+
+  for (int j0 = 0; j0 < k; j0 += nb) {
+    int jb = std::min(nb, k - j0);
+
+    // Panel, one reflector per column.
+    for (int j = j0; j < j0 + jb; j++) {
+      T *col = a + j + j * lda;
+      qr.Tau[j] = _Reflector(rows - j, col);
+      _ApplyReflector(rows - j, col, _Conj(qr.Tau[j]), col + lda, rows,
+                      j0 + jb - j - 1);
+    }
+
+    // Trailing columns, Q^H applied as one block reflector.
+    _ApplyBlock(a + j0 + j0 * lda, rows, rows - j0, jb, qr.Tau.data() + j0,
+                true, a + j0 + (j0 + jb) * lda, rows, cols - j0 - jb);
+  }
+  qr.Data = std::move(data);
+  return qr;
+}
+
+template <class T> std::vector<T> QrFormQ(const QR<T> &qr) {
+  const int nb = CDS_FACTOR_NB;
+  const int m = qr.Rows;
+  const int k = static_cast<int>(qr.Tau.size());
+  std::vector<T> q(std::size_t(m) * m, T(0));
+  for (int i = 0; i < m; i++) {
+    q[i + std::size_t(i) * m] = T(1);
+  }
+
+  // Q = H(0) ... H(k - 1) * I, applied backwards so that each block only
+  // touches the trailing part of Q that is no longer the identity.
+  int last = k == 0 ? 0 : ((k - 1) / nb) * nb;
+  for (int j0 = last; j0 >= 0 && k > 0; j0 -= nb) {
+    int jb = std::min(nb, k - j0);
+    _ApplyBlock(qr.Data.data() + j0 + std::size_t(j0) * m, m, m - j0, jb,
+                qr.Tau.data() + j0, false, q.data() + j0 + std::size_t(j0) * m,
+                m, m - j0);
+  }
+  return q;
+}
+
+template <class T> std::vector<T> QrFormR(const QR<T> &qr) {
+  std::vector<T> r(std::size_t(qr.Rows) * qr.Cols, T(0));
+  for (int j = 0; j < qr.Cols; j++) {
+    for (int i = 0; i <= std::min(j, qr.Rows - 1); i++) {
+      r[i + std::size_t(j) * qr.Rows] = qr.Data[i + std::size_t(j) * qr.Rows];
+    }
+  }
+  return r;
+}
+
+// Rank
+template <class T> int PivotedRank(std::vector<T> data, int rows, int cols) {
+  using R = Real<T>;
+  const int k = std::min(rows, cols);
+  if (k == 0)
+    return 0;
+  T *a = data.data();
+  const std::size_t lda = rows;
+  const R threshold = std::sqrt(std::numeric_limits<R>::epsilon());
+
+  // Partial column norms and the norms they were last recomputed at.
+  std::vector<R> norms(cols), exact(cols);
+  for (int j = 0; j < cols; j++) {
+    R sum = R(0);
+    for (int i = 0; i < rows; i++) {
+      sum += _Abs2(a[i + j * lda]);
+    }
+    norms[j] = exact[j] = std::sqrt(sum);
+  }
+
+  std::vector<R> diagonal(k);
+  for (int i = 0; i < k; i++) {
+    int pivot = static_cast<int>(
+        std::max_element(norms.begin() + i, norms.end()) - norms.begin());
+    if (pivot != i) {
+      std::swap_ranges(a + i * lda, a + (i + 1) * lda, a + pivot * lda);
+      std::swap(norms[i], norms[pivot]);
+      std::swap(exact[i], exact[pivot]);
+    }
+
+    T *col = a + i + i * lda;
+    T tau = _Reflector(rows - i, col);
+    _ApplyReflector(rows - i, col, _Conj(tau), col + lda, rows, cols - i - 1);
+    diagonal[i] = _Abs(col[0]);
+
+    // Downdate the remaining norms, recomputing those that lost too many
+    // digits to cancellation (LAPACK geqp3).
+    for (int j = i + 1; j < cols; j++) {
+      if (norms[j] == R(0))
+        continue;
+      R ratio = _Abs(a[i + j * lda]) / norms[j];
+      R remain = std::max(R(0), R(1) - ratio * ratio);
+      R drift = remain * (norms[j] / exact[j]) * (norms[j] / exact[j]);
+      if (drift <= threshold) {
+        R sum = R(0);
+        for (int r = i + 1; r < rows; r++) {
+          sum += _Abs2(a[r + j * lda]);
+        }
+        norms[j] = exact[j] = std::sqrt(sum);
+      } else {
+        norms[j] *= std::sqrt(remain);
+      }
+    }
+  }
+
+  R tolerance =
+      R(std::max(rows, cols)) * std::numeric_limits<R>::epsilon() * diagonal[0];
+  int rank = 0;
+  while (rank < k && diagonal[rank] > tolerance) {
+    rank++;
+  }
+  return rank;
+}
+
+} // namespace _Factor
@@ -0,0 +1,262 @@
+#pragma once
+#include "CDS_Gemm.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace _Gemm {
+
+// Vector Registers
+//
+// _Vec<T> wraps one register of T together with the micro-tile shape that
+// fits the register file. This version is a single scalar and serves every
+// T that CDS_Gemm.cpp does not dispatch, and every CPU without a vector
+// instruction set.
+template <class T> struct _Vec {
+  using Reg = T;
+  static constexpr int Width = 1;
+  static constexpr int MR = 4;
+  static constexpr int NR = 4;
+  static Reg Zero() { return T(0); }
+  static Reg Load(const T *p) { return *p; }
+  static void Store(T *p, Reg r) { *p = r; }
+  static Reg Broadcast(T x) { return x; }
+  static Reg Fma(Reg a, Reg b, Reg c) { return a * b + c; }
+};
+
+// Block Sizes
+template <int MR, int NR> struct _Blocking {
+  static constexpr int MC = std::max(CDS_GEMM_MC / MR, 1) * MR;
+  static constexpr int KC = std::max(CDS_GEMM_KC, 1);
+  static constexpr int NC = std::max(CDS_GEMM_NC / NR, 1) * NR;
+};
+
+// Workspace
+//
+// Packing buffers are kept per thread and only grow, so repeated calls do
+// not go back to the allocator.
+template <class T> class _Workspace {
+public:
+  ~_Workspace() {
+    if (this->_Data)
+      ::operator delete(this->_Data, std::align_val_t(64));
+  }
+
+  T *Get(std::size_t count) {
+    if (count > this->_Capacity) {
+      if (this->_Data)
+        ::operator delete(this->_Data, std::align_val_t(64));
+      this->_Data = static_cast<T *>(
+          ::operator new(count * sizeof(T), std::align_val_t(64)));
+      this->_Capacity = count;
+    }
+    return this->_Data;
+  }
+
+private:
+  T *_Data = nullptr;
+  std::size_t _Capacity = 0;
+};
+
+// Packing
+//
+// A is packed into row panels of MR rows: panel r holds, for every p, the MR
+// values a(r*MR + i, p) next to each other. B is packed into column panels
+// of NR columns the same way. Rows and columns past the edge are zero, so
+// the micro-kernel never needs edge handling.
+template <class T, int MR>
+void _PackA(const CDS_MatrixView<const T> &a, int ic, int pc, int mc, int kc,
+            T *out) {
+  const T *base = a.GetData();
+  for (int ir = 0; ir < mc; ir += MR) {
+    int mr = std::min(MR, mc - ir);
+    std::ptrdiff_t rows[MR];
+    for (int i = 0; i < mr; i++) {
+      rows[i] = a.RowOffset(ic + ir + i);
+    }
+    for (int p = 0; p < kc; p++) {
+      std::ptrdiff_t col = a.ColumnOffset(pc + p);
+      for (int i = 0; i < mr; i++) {
+        out[i] = base[rows[i] + col];
+      }
+      for (int i = mr; i < MR; i++) {
+        out[i] = T(0);
+      }
+      out += MR;
+    }
+  }
+}
+
+template <class T, int NR>
+void _PackB(const CDS_MatrixView<const T> &b, int pc, int jc, int kc, int nc,
+            T *out) {
+  const T *base = b.GetData();
+  for (int jr = 0; jr < nc; jr += NR) {
+    int nr = std::min(NR, nc - jr);
+    std::ptrdiff_t cols[NR];
+    for (int j = 0; j < nr; j++) {
+      cols[j] = b.ColumnOffset(jc + jr + j);
+    }
+    for (int p = 0; p < kc; p++) {
+      const T *row = base + b.RowOffset(pc + p);
+      for (int j = 0; j < nr; j++) {
+        out[j] = row[cols[j]];
+      }
+      for (int j = nr; j < NR; j++) {
+        out[j] = T(0);
+      }
+      out += NR;
+    }
+  }
+}
+
+// Micro-kernel
+#define _CDS_TARGET
+#include "CDS_GemmKernel.inc"
+#undef _CDS_TARGET
+
+// Writes alpha * tile + beta * C for the top-left mr x nr part of the tile.
+template <class T, int NR>
+void _Update(const T *tile, int mr, int nr, T alpha, T beta,
+             const CDS_MatrixView<T> &c, int row, int col) {
+  std::ptrdiff_t cs = c.GetColumnStride();
+  bool contiguous = c.IsStrided() && cs == 1;
+  for (int i = 0; i < mr; i++) {
+    T *out = c.GetData() + c.RowOffset(row + i);
+    const T *in = tile + i * NR;
+    if (contiguous) {
+      out += col;
+      if (beta == T(0)) {
+        for (int j = 0; j < nr; j++)
+          out[j] = alpha * in[j];
+      } else {
+        for (int j = 0; j < nr; j++)
+          out[j] = alpha * in[j] + beta * out[j];
+      }
+      continue;
+    }
+    for (int j = 0; j < nr; j++) {
+      T &elem = out[c.ColumnOffset(col + j)];
+      elem = beta == T(0) ? alpha * in[j] : alpha * in[j] + beta * elem;
+    }
+  }
+}
+
+// Unpacked product for operands too small to amortize the packing.
+template <class T>
+void _GemmSmall(T alpha, const CDS_MatrixView<const T> &a,
+                const CDS_MatrixView<const T> &b, T beta,
+                const CDS_MatrixView<T> &c) {
+  auto [m, k] = a.GetShape();
+  int n = std::get<1>(b.GetShape());
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      T sum = T(0);
+      for (int p = 0; p < k; p++) {
+        sum += a[{i, p}] * b[{p, j}];
+      }
+      T &elem = c[{i, j}];
+      elem = beta == T(0) ? alpha * sum : alpha * sum + beta * elem;
+    }
+  }
+}
+
+template <class T, int MR, int NR>
+void _Blocked(_Kernel<T> kernel, T alpha, const CDS_MatrixView<const T> &a,
+              const CDS_MatrixView<const T> &b, T beta,
+              const CDS_MatrixView<T> &c) {
+  using B = _Blocking<MR, NR>;
+  auto [m, k] = a.GetShape();
+  int n = std::get<1>(b.GetShape());
+
+  thread_local _Workspace<T> packedA, packedB;
+  T *ap = packedA.Get(static_cast<std::size_t>(B::MC) * B::KC);
+  T *bp = packedB.Get(static_cast<std::size_t>(B::KC) * B::NC);
+  alignas(64) T tile[MR * NR];
+
+  for (int jc = 0; jc < n; jc += B::NC) {
+    int nc = std::min(B::NC, n - jc);
+    for (int pc = 0; pc < k; pc += B::KC) {
+      int kc = std::min(B::KC, k - pc);
+      T betaBlock = pc == 0 ? beta : T(1);
+      _PackB<T, NR>(b, pc, jc, kc, nc, bp);
+
+      for (int ic = 0; ic < m; ic += B::MC) {
+        int mc = std::min(B::MC, m - ic);
+        _PackA<T, MR>(a, ic, pc, mc, kc, ap);
+
+        for (int jr = 0; jr < nc; jr += NR) {
+          for (int ir = 0; ir < mc; ir += MR) {
+            kernel(kc, ap + static_cast<std::size_t>(ir) * kc,
+                   bp + static_cast<std::size_t>(jr) * kc, tile);
+            _Update<T, NR>(tile, std::min(MR, mc - ir), std::min(NR, nc - jr),
+                           alpha, betaBlock, c, ic + ir, jc + jr);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <class T> _Grain _GetGrain() {
+  return {_Blocking<_Vec<T>::MR, _Vec<T>::NR>::MC, _Vec<T>::NR};
+}
+
+template <class T>
+void Gemm(T alpha, CDS_MatrixView<const T> a, CDS_MatrixView<const T> b,
+          T beta, CDS_MatrixView<T> c) {
+  auto [m, k] = a.GetShape();
+  int n = std::get<1>(b.GetShape());
+  assertm(std::get<0>(b.GetShape()) == k, "Inner dimensions do not match");
+  assertm(c.GetShape() == std::make_tuple(m, n),
+          "Output shape does not match the product");
+
+  if (m == 0 || n == 0)
+    return;
+  if (static_cast<long long>(m) * n * k < CDS_GEMM_SMALL) {
+    _GemmSmall(alpha, a, b, beta, c);
+    return;
+  }
+
+  if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+    _Dispatch(alpha, a, b, beta, c);
+  } else {
+    _Blocked<T, _Vec<T>::MR, _Vec<T>::NR>(&_MicroKernel<T>, alpha, a, b, beta,
+                                          c);
+  }
+}
+
+template <class T>
+void ParallelGemm(T alpha, CDS_MatrixView<const T> a,
+                  CDS_MatrixView<const T> b, T beta, CDS_MatrixView<T> c) {
+  auto [m, k] = a.GetShape();
+  int n = std::get<1>(b.GetShape());
+  CDS_ThreadPool &pool = CDS_ThreadPool::Instance();
+  std::size_t work = static_cast<std::size_t>(m) * n * k;
+  if (pool.IsSerial(work)) {
+    Gemm<T>(alpha, a, b, beta, c);
+    return;
+  }
+
+  // Aim for a few tiles per thread so stealing can even out the load. Rows
+  // are split along L2 blocks first, the columns make up the rest.
+  _Grain grain = _GetGrain<T>();
+  int target = static_cast<int>(4 * pool.GetThreadCount());
+  int tilesDown = (m + grain.Rows - 1) / grain.Rows;
+  int tilesAcross = std::max(1, (target + tilesDown - 1) / tilesDown);
+  int tileCols = (n + tilesAcross - 1) / tilesAcross;
+  tileCols = std::max(grain.Cols,
+                      (tileCols + grain.Cols - 1) / grain.Cols * grain.Cols);
+
+  pool.ParallelFor2D(m, n, grain.Rows, tileCols, work,
+                     [&](int rowBegin, int rowEnd, int colBegin, int colEnd) {
+                       int rows = rowEnd - rowBegin;
+                       int cols = colEnd - colBegin;
+                       Gemm<T>(alpha, a.Block(rowBegin, 0, rows, k),
+                               b.Block(0, colBegin, k, cols), beta,
+                               c.Block(rowBegin, colBegin, rows, cols));
+                     });
+}
+
+} // namespace _Gemm
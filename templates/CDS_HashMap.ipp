@@ -0,0 +1,508 @@
+#pragma once
+#include "CDS_HashMap.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+// Hash arithmetic
+constexpr std::size_t _Hash::_Mix(std::size_t hash) {
+  // Finalizer of MurmurHash3, every input bit affects every output bit.
+  std::uint64_t mixed = hash;
+  mixed ^= mixed >> 33;
+  mixed *= 0xff51afd7ed558ccdULL;
+  mixed ^= mixed >> 33;
+  return static_cast<std::size_t>(mixed);
+}
+
+constexpr std::size_t _Hash::_H1(std::size_t hash) { return hash >> 7; }
+
+constexpr std::int8_t _Hash::_H2(std::size_t hash) {
+  return static_cast<std::int8_t>(hash & 0x7F);
+}
+
+// Group masks
+inline _Hash::_Mask::operator bool() const { return this->Bits != 0; }
+
+#if defined(__SSE2__)
+inline std::size_t _Hash::_Mask::Lowest() const {
+  return std::countr_zero(this->Bits);
+}
+
+inline std::size_t _Hash::_Mask::TrailingZeros() const {
+  return std::min<std::size_t>(std::countr_zero(this->Bits), _GROUP);
+}
+
+inline std::size_t _Hash::_Mask::LeadingZeros() const {
+  return std::countl_zero(this->Bits) - (64 - _GROUP);
+}
+#else
+inline std::size_t _Hash::_Mask::Lowest() const {
+  return std::countr_zero(this->Bits) >> 3;
+}
+
+inline std::size_t _Hash::_Mask::TrailingZeros() const {
+  return std::countr_zero(this->Bits) >> 3;
+}
+
+inline std::size_t _Hash::_Mask::LeadingZeros() const {
+  return std::countl_zero(this->Bits) >> 3;
+}
+#endif
+
+inline void _Hash::_Mask::Next() { this->Bits &= this->Bits - 1; }
+
+// Groups
+#if defined(__AVX2__)
+inline _Hash::_Group::_Group(const std::int8_t *control)
+    : Control(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(control))) {
+}
+
+inline _Hash::_Mask _Hash::_Group::Match(std::int8_t tag) const {
+  __m256i equal = _mm256_cmpeq_epi8(_mm256_set1_epi8(tag), this->Control);
+  return {static_cast<std::uint32_t>(_mm256_movemask_epi8(equal))};
+}
+
+inline _Hash::_Mask _Hash::_Group::MatchEmpty() const {
+  return this->Match(_EMPTY);
+}
+
+inline _Hash::_Mask _Hash::_Group::MatchFree() const {
+  // Empty and deleted are the only negative control bytes, so the sign bits
+  // are the mask.
+  return {static_cast<std::uint32_t>(_mm256_movemask_epi8(this->Control))};
+}
+#elif defined(__SSE2__)
+inline _Hash::_Group::_Group(const std::int8_t *control)
+    : Control(_mm_loadu_si128(reinterpret_cast<const __m128i *>(control))) {}
+
+inline _Hash::_Mask _Hash::_Group::Match(std::int8_t tag) const {
+  __m128i equal = _mm_cmpeq_epi8(_mm_set1_epi8(tag), this->Control);
+  return {static_cast<std::uint32_t>(_mm_movemask_epi8(equal))};
+}
+
+inline _Hash::_Mask _Hash::_Group::MatchEmpty() const {
+  return this->Match(_EMPTY);
+}
+
+inline _Hash::_Mask _Hash::_Group::MatchFree() const {
+  // Empty and deleted are the only negative control bytes, so the sign bits
+  // are the mask.
+  return {static_cast<std::uint32_t>(_mm_movemask_epi8(this->Control))};
+}
+#else
+namespace _Hash {
+constexpr std::uint64_t _LSBS = 0x0101010101010101ULL;
+constexpr std::uint64_t _MSBS = 0x8080808080808080ULL;
+} // namespace _Hash
+
+inline _Hash::_Group::_Group(const std::int8_t *control) {
+  std::memcpy(&this->Control, control, sizeof(this->Control));
+  if constexpr (std::endian::native == std::endian::big)
+    this->Control = __builtin_bswap64(this->Control);
+}
+
+inline _Hash::_Mask _Hash::_Group::Match(std::int8_t tag) const {
+  // Bytes equal to the tag become zero, the borrow of the subtraction then
+  // sets their top bit.
+  std::uint64_t x =
+      this->Control ^ (_LSBS * static_cast<std::uint8_t>(tag));
+  return {(x - _LSBS) & ~x & _MSBS};
+}
+
+inline _Hash::_Mask _Hash::_Group::MatchEmpty() const {
+  // Empty is the only control byte with bit 7 set and bit 1 clear.
+  return {this->Control & ~(this->Control << 6) & _MSBS};
+}
+
+inline _Hash::_Mask _Hash::_Group::MatchFree() const {
+  return {this->Control & _MSBS};
+}
+#endif
+
+// Constructors
+template <class K, class V, class Hash, class Eq>
+CDS_HashMap<K, V, Hash, Eq>::CDS_HashMap(float maxLoadFactor,
+                                         const Hash &hash, const Eq &equal)
+    : _MaxLoadFactor(maxLoadFactor), _Hasher(hash), _Equal(equal) {
+  assertm(maxLoadFactor > 0 && maxLoadFactor < 1,
+          "The load factor must be between 0 and 1");
+}
+
+template <class K, class V, class Hash, class Eq>
+CDS_HashMap<K, V, Hash, Eq>::CDS_HashMap(const CDS_HashMap &other)
+    : _MaxLoadFactor(other._MaxLoadFactor), _Hasher(other._Hasher),
+      _Equal(other._Equal) {
+  if (!other._Capacity)
+    return;
+  // Same capacity and hash, so every entry can keep its slot.
+  this->Allocate(other._Capacity);
+  for (std::size_t i = 0; i < this->_Capacity; i++) {
+    if (other._Control[i] >= 0) {
+      ::new (&this->_Slots[i]) _Slot(other._Slots[i]);
+      this->_Size++;
+    }
+    this->SetControl(i, other._Control[i]);
+  }
+  this->_Deleted = other._Deleted;
+}
+
+template <class K, class V, class Hash, class Eq>
+CDS_HashMap<K, V, Hash, Eq>::CDS_HashMap(CDS_HashMap &&other) noexcept
+    : _MaxLoadFactor(other._MaxLoadFactor), _Hasher(std::move(other._Hasher)),
+      _Equal(std::move(other._Equal)) {
+  std::swap(this->_Control, other._Control);
+  std::swap(this->_Slots, other._Slots);
+  std::swap(this->_Capacity, other._Capacity);
+  std::swap(this->_Size, other._Size);
+  std::swap(this->_Deleted, other._Deleted);
+}
+
+template <class K, class V, class Hash, class Eq>
+CDS_HashMap<K, V, Hash, Eq> &
+CDS_HashMap<K, V, Hash, Eq>::operator=(CDS_HashMap other) noexcept {
+  this->Swap(other);
+  return *this;
+}
+
+// Destructor
+template <class K, class V, class Hash, class Eq>
+CDS_HashMap<K, V, Hash, Eq>::~CDS_HashMap() {
+  this->Release();
+}
+
+// Getters
+template <class K, class V, class Hash, class Eq>
+std::size_t CDS_HashMap<K, V, Hash, Eq>::GetSize() const {
+  return this->_Size;
+}
+
+template <class K, class V, class Hash, class Eq>
+std::size_t CDS_HashMap<K, V, Hash, Eq>::GetCapacity() const {
+  return this->_Capacity;
+}
+
+template <class K, class V, class Hash, class Eq>
+float CDS_HashMap<K, V, Hash, Eq>::GetMaxLoadFactor() const {
+  return this->_MaxLoadFactor;
+}
+
+template <class K, class V, class Hash, class Eq>
+CDS_Result<V> CDS_HashMap<K, V, Hash, Eq>::Get(const K &key) const {
+  const V *value = this->Find(key);
+  if (!value)
+    return CDS_Result<V>::Failure("The key does not exist");
+  return CDS_Result<V>::Success(*value);
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+  requires _Hash::_Transparent<Hash, Eq>
+CDS_Result<V> CDS_HashMap<K, V, Hash, Eq>::Get(const Q &key) const {
+  const V *value = this->Find(key);
+  if (!value)
+    return CDS_Result<V>::Failure("The key does not exist");
+  return CDS_Result<V>::Success(*value);
+}
+
+template <class K, class V, class Hash, class Eq>
+V *CDS_HashMap<K, V, Hash, Eq>::Find(const K &key) {
+  std::size_t index = this->Lookup(key, _Hash::_Mix(this->_Hasher(key)));
+  if (index == this->_Capacity)
+    return nullptr;
+  return &this->_Slots[index].Value;
+}
+
+template <class K, class V, class Hash, class Eq>
+const V *CDS_HashMap<K, V, Hash, Eq>::Find(const K &key) const {
+  return const_cast<CDS_HashMap *>(this)->Find(key);
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+  requires _Hash::_Transparent<Hash, Eq>
+V *CDS_HashMap<K, V, Hash, Eq>::Find(const Q &key) {
+  std::size_t index = this->Lookup(key, _Hash::_Mix(this->_Hasher(key)));
+  if (index == this->_Capacity)
+    return nullptr;
+  return &this->_Slots[index].Value;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+  requires _Hash::_Transparent<Hash, Eq>
+const V *CDS_HashMap<K, V, Hash, Eq>::Find(const Q &key) const {
+  return const_cast<CDS_HashMap *>(this)->Find(key);
+}
+
+template <class K, class V, class Hash, class Eq>
+bool CDS_HashMap<K, V, Hash, Eq>::Contains(const K &key) const {
+  return this->Find(key) != nullptr;
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+  requires _Hash::_Transparent<Hash, Eq>
+bool CDS_HashMap<K, V, Hash, Eq>::Contains(const Q &key) const {
+  return this->Find(key) != nullptr;
+}
+
+// Modifiers
+template <class K, class V, class Hash, class Eq>
+CDS_Result<V *> CDS_HashMap<K, V, Hash, Eq>::Insert(const K &key, V value) {
+  std::size_t hash = _Hash::_Mix(this->_Hasher(key));
+  if (this->Lookup(key, hash) != this->_Capacity)
+    return CDS_Result<V *>::Failure("The key already exists");
+  return CDS_Result<V *>::Success(
+      &this->Place(hash, key, std::move(value)));
+}
+
+template <class K, class V, class Hash, class Eq>
+V &CDS_HashMap<K, V, Hash, Eq>::Set(const K &key, V value) {
+  std::size_t hash = _Hash::_Mix(this->_Hasher(key));
+  std::size_t index = this->Lookup(key, hash);
+  if (index == this->_Capacity)
+    return this->Place(hash, key, std::move(value));
+  this->_Slots[index].Value = std::move(value);
+  return this->_Slots[index].Value;
+}
+
+template <class K, class V, class Hash, class Eq>
+CDS_Result<V> CDS_HashMap<K, V, Hash, Eq>::Delete(const K &key) {
+  std::size_t index = this->Lookup(key, _Hash::_Mix(this->_Hasher(key)));
+  if (index == this->_Capacity)
+    return CDS_Result<V>::Failure("The key does not exist");
+  return this->Remove(index);
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+  requires _Hash::_Transparent<Hash, Eq>
+CDS_Result<V> CDS_HashMap<K, V, Hash, Eq>::Delete(const Q &key) {
+  std::size_t index = this->Lookup(key, _Hash::_Mix(this->_Hasher(key)));
+  if (index == this->_Capacity)
+    return CDS_Result<V>::Failure("The key does not exist");
+  return this->Remove(index);
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_HashMap<K, V, Hash, Eq>::Clear() {
+  for (std::size_t i = 0; i < this->_Capacity; i++) {
+    if (this->_Control[i] >= 0)
+      std::destroy_at(&this->_Slots[i]);
+  }
+  if (this->_Capacity)
+    std::fill_n(this->_Control, this->_Capacity + _Hash::_GROUP,
+                _Hash::_EMPTY);
+  this->_Size = 0;
+  this->_Deleted = 0;
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_HashMap<K, V, Hash, Eq>::Reserve(std::size_t count) {
+  std::size_t capacity = this->CapacityFor(count);
+  if (capacity > this->_Capacity)
+    this->Rehash(capacity);
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_HashMap<K, V, Hash, Eq>::SetMaxLoadFactor(float maxLoadFactor) {
+  assertm(maxLoadFactor > 0 && maxLoadFactor < 1,
+          "The load factor must be between 0 and 1");
+  this->_MaxLoadFactor = maxLoadFactor;
+  if (this->_Size + this->_Deleted >
+      std::size_t(this->_Capacity * this->_MaxLoadFactor))
+    this->Rehash(std::max(this->_Capacity, this->CapacityFor(this->_Size)));
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Function>
+void CDS_HashMap<K, V, Hash, Eq>::ForEach(Function function) {
+  for (std::size_t i = 0; i < this->_Capacity; i++) {
+    if (this->_Control[i] >= 0)
+      function(const_cast<const K &>(this->_Slots[i].Key),
+               this->_Slots[i].Value);
+  }
+}
+
+template <class K, class V, class Hash, class Eq>
+template <class Function>
+void CDS_HashMap<K, V, Hash, Eq>::ForEach(Function function) const {
+  for (std::size_t i = 0; i < this->_Capacity; i++) {
+    if (this->_Control[i] >= 0)
+      function(const_cast<const K &>(this->_Slots[i].Key),
+               const_cast<const V &>(this->_Slots[i].Value));
+  }
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_HashMap<K, V, Hash, Eq>::Swap(CDS_HashMap &other) noexcept {
+  std::swap(this->_Control, other._Control);
+  std::swap(this->_Slots, other._Slots);
+  std::swap(this->_Capacity, other._Capacity);
+  std::swap(this->_Size, other._Size);
+  std::swap(this->_Deleted, other._Deleted);
+  std::swap(this->_MaxLoadFactor, other._MaxLoadFactor);
+  std::swap(this->_Hasher, other._Hasher);
+  std::swap(this->_Equal, other._Equal);
+}
+
+// Operator Overloads
+template <class K, class V, class Hash, class Eq>
+V &CDS_HashMap<K, V, Hash, Eq>::operator[](const K &key) {
+  std::size_t hash = _Hash::_Mix(this->_Hasher(key));
+  std::size_t index = this->Lookup(key, hash);
+  if (index == this->_Capacity)
+    return this->Place(hash, key, V());
+  return this->_Slots[index].Value;
+}
+
+// Private
+template <class K, class V, class Hash, class Eq>
+template <class Q>
+std::size_t CDS_HashMap<K, V, Hash, Eq>::Lookup(const Q &key,
+                                                std::size_t hash) const {
+  if (!this->_Capacity)
+    return 0;
+  // Steps growing by a group visit every group of a power-of-two table, and
+  // the load factor keeps at least one slot empty, so the probe always ends.
+  std::size_t mask = this->_Capacity - 1;
+  std::int8_t tag = _Hash::_H2(hash);
+  std::size_t position = _Hash::_H1(hash) & mask;
+  for (std::size_t step = _Hash::_GROUP;; step += _Hash::_GROUP) {
+    _Hash::_Group group(this->_Control + position);
+    for (_Hash::_Mask match = group.Match(tag); match; match.Next()) {
+      std::size_t index = (position + match.Lowest()) & mask;
+      if (this->_Equal(this->_Slots[index].Key, key))
+        return index;
+    }
+    if (group.MatchEmpty())
+      return this->_Capacity;
+    position = (position + step) & mask;
+  }
+}
+
+template <class K, class V, class Hash, class Eq>
+CDS_Result<V> CDS_HashMap<K, V, Hash, Eq>::Remove(std::size_t index) {
+  CDS_Result<V> removed = CDS_Result<V>{std::move(this->_Slots[index].Value),
+                                        std::nullopt};
+  std::destroy_at(&this->_Slots[index]);
+  this->_Size--;
+
+  // A probe only goes past a slot when the whole group it scanned was
+  // full. If the empty slots around this one are less than a group apart,
+  // no group containing it ever was, and it can become empty again.
+  std::size_t mask = this->_Capacity - 1;
+  _Hash::_Mask after = _Hash::_Group(this->_Control + index).MatchEmpty();
+  _Hash::_Mask before =
+      _Hash::_Group(this->_Control + ((index - _Hash::_GROUP) & mask))
+          .MatchEmpty();
+  if (after && before &&
+      after.TrailingZeros() + before.LeadingZeros() < _Hash::_GROUP) {
+    this->SetControl(index, _Hash::_EMPTY);
+  } else {
+    this->SetControl(index, _Hash::_DELETED);
+    this->_Deleted++;
+  }
+  return removed;
+}
+
+template <class K, class V, class Hash, class Eq>
+V &CDS_HashMap<K, V, Hash, Eq>::Place(std::size_t hash, const K &key,
+                                      V &&value) {
+  std::size_t used = this->_Size + this->_Deleted + 1;
+  if (used > std::size_t(this->_Capacity * this->_MaxLoadFactor)) {
+    // Rehashing in place pays off once half the budget is deleted slots,
+    // otherwise the table doubles.
+    if (this->_Capacity && (this->_Size + 1) * 2 <=
+                               std::size_t(this->_Capacity *
+                                           this->_MaxLoadFactor))
+      this->Rehash(this->_Capacity);
+    else
+      this->Rehash(this->CapacityFor(this->_Size + 1));
+  }
+  std::size_t index = this->Probe(hash);
+  ::new (&this->_Slots[index]) _Slot{key, std::move(value)};
+  if (this->_Control[index] == _Hash::_DELETED)
+    this->_Deleted--;
+  this->SetControl(index, _Hash::_H2(hash));
+  this->_Size++;
+  return this->_Slots[index].Value;
+}
+
+template <class K, class V, class Hash, class Eq>
+std::size_t CDS_HashMap<K, V, Hash, Eq>::Probe(std::size_t hash) const {
+  std::size_t mask = this->_Capacity - 1;
+  std::size_t position = _Hash::_H1(hash) & mask;
+  for (std::size_t step = _Hash::_GROUP;; step += _Hash::_GROUP) {
+    _Hash::_Mask free = _Hash::_Group(this->_Control + position).MatchFree();
+    if (free)
+      return (position + free.Lowest()) & mask;
+    position = (position + step) & mask;
+  }
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_HashMap<K, V, Hash, Eq>::Allocate(std::size_t capacity) {
+  this->_Control = new std::int8_t[capacity + _Hash::_GROUP];
+  this->_Slots = std::allocator<_Slot>().allocate(capacity);
+  this->_Capacity = capacity;
+  std::fill_n(this->_Control, capacity + _Hash::_GROUP, _Hash::_EMPTY);
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_HashMap<K, V, Hash, Eq>::SetControl(std::size_t index,
+                                             std::int8_t control) {
+  // The first group is cloned past the end, so a group loaded at any slot
+  // reads the table circularly.
+  this->_Control[index] = control;
+  if (index < _Hash::_GROUP)
+    this->_Control[this->_Capacity + index] = control;
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_HashMap<K, V, Hash, Eq>::Rehash(std::size_t capacity) {
+  CDS_HashMap<K, V, Hash, Eq> table(this->_MaxLoadFactor, this->_Hasher,
+                                    this->_Equal);
+  table.Allocate(capacity);
+  for (std::size_t i = 0; i < this->_Capacity; i++) {
+    if (this->_Control[i] < 0)
+      continue;
+    _Slot &slot = this->_Slots[i];
+    std::size_t hash = _Hash::_Mix(this->_Hasher(slot.Key));
+    std::size_t index = table.Probe(hash);
+    ::new (&table._Slots[index]) _Slot(std::move(slot));
+    table.SetControl(index, _Hash::_H2(hash));
+    table._Size++;
+    std::destroy_at(&slot);
+    this->SetControl(i, _Hash::_DELETED);
+    this->_Size--;
+    this->_Deleted++;
+  }
+  this->Swap(table);
+}
+
+template <class K, class V, class Hash, class Eq>
+std::size_t CDS_HashMap<K, V, Hash, Eq>::CapacityFor(std::size_t count) const {
+  std::size_t capacity = _Hash::_MIN_CAPACITY;
+  while (count > std::size_t(capacity * this->_MaxLoadFactor)) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+template <class K, class V, class Hash, class Eq>
+void CDS_HashMap<K, V, Hash, Eq>::Release() {
+  if (!this->_Capacity)
+    return;
+  this->Clear();
+  delete[] this->_Control;
+  std::allocator<_Slot>().deallocate(this->_Slots, this->_Capacity);
+  this->_Control = nullptr;
+  this->_Slots = nullptr;
+  this->_Capacity = 0;
+}
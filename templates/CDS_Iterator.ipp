@@ -0,0 +1,108 @@
+#pragma once
+#include "CDS_Iterator.hpp"
+
+// Constructors
+template <class T>
+constexpr CDS_Iterator<T>::CDS_Iterator(pointer inPointer)
+    : _pointer(inPointer) {}
+
+template <class T>
+template <class U>
+  requires std::is_same_v<const U, T>
+constexpr CDS_Iterator<T>::CDS_Iterator(const CDS_Iterator<U> &other)
+    : _pointer(other.operator->()) {}
+
+// Access
+template <class T>
+constexpr typename CDS_Iterator<T>::reference
+CDS_Iterator<T>::operator*() const {
+  return *this->_pointer;
+}
+
+template <class T>
+constexpr typename CDS_Iterator<T>::pointer
+CDS_Iterator<T>::operator->() const {
+  return this->_pointer;
+}
+
+template <class T>
+constexpr typename CDS_Iterator<T>::reference
+CDS_Iterator<T>::operator[](difference_type offset) const {
+  return this->_pointer[offset];
+}
+
+// Movement
+template <class T> constexpr CDS_Iterator<T> &CDS_Iterator<T>::operator++() {
+  ++this->_pointer;
+  return *this;
+}
+
+template <class T>
+constexpr CDS_Iterator<T> CDS_Iterator<T>::operator++(int) {
+  CDS_Iterator temp = *this;
+  ++this->_pointer;
+  return temp;
+}
+
+template <class T> constexpr CDS_Iterator<T> &CDS_Iterator<T>::operator--() {
+  --this->_pointer;
+  return *this;
+}
+
+template <class T>
+constexpr CDS_Iterator<T> CDS_Iterator<T>::operator--(int) {
+  CDS_Iterator temp = *this;
+  --this->_pointer;
+  return temp;
+}
+
+template <class T>
+constexpr CDS_Iterator<T> &
+CDS_Iterator<T>::operator+=(difference_type offset) {
+  this->_pointer += offset;
+  return *this;
+}
+
+template <class T>
+constexpr CDS_Iterator<T> &
+CDS_Iterator<T>::operator-=(difference_type offset) {
+  this->_pointer -= offset;
+  return *this;
+}
+
+template <class T>
+constexpr CDS_Iterator<T>
+CDS_Iterator<T>::operator+(difference_type offset) const {
+  return CDS_Iterator(this->_pointer + offset);
+}
+
+template <class T>
+constexpr CDS_Iterator<T>
+CDS_Iterator<T>::operator-(difference_type offset) const {
+  return CDS_Iterator(this->_pointer - offset);
+}
+
+template <class T>
+constexpr typename CDS_Iterator<T>::difference_type
+CDS_Iterator<T>::operator-(const CDS_Iterator &other) const {
+  return this->_pointer - other._pointer;
+}
+
+template <class T>
+constexpr CDS_Iterator<T>
+operator+(typename CDS_Iterator<T>::difference_type offset,
+          const CDS_Iterator<T> &iterator) {
+  return iterator + offset;
+}
+
+// Comparison
+template <class T>
+constexpr bool CDS_Iterator<T>::operator==(const CDS_Iterator &other) const {
+  return this->_pointer == other._pointer;
+}
+
+template <class T>
+constexpr std::strong_ordering
+CDS_Iterator<T>::operator<=>(const CDS_Iterator &other) const {
+  return this->_pointer <=> other._pointer;
+}
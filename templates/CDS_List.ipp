@@ -1,168 +1,624 @@
 #pragma once
 #include "CDS_List.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
 #include <iostream>
 #include <utility>
 
 #define assertm(exp, msg) assert(((void)msg, exp))
 
 // Constructors
-template <class T>
-CDS_List<T>::CDS_List() : _Size(0), _Capacity(_Init::_INITIAL) {
-  this->Reallocate(_Init::_INITIAL);
+template <class T, class Allocator, std::size_t Inline, class Growth>
+CDS_List<T, Allocator, Inline, Growth>::CDS_List() : CDS_List(Allocator()) {}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+CDS_List<T, Allocator, Inline, Growth>::CDS_List(const Allocator &allocator)
+    : _Allocator(allocator), _Size(0), _Capacity(0) {
+  this->SetData(this->_Buffer.GetData());
+  this->SetCapacity(Inline);
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+CDS_List<T, Allocator, Inline, Growth>::CDS_List(const CDS_List &other)
+    : CDS_List(_Traits::select_on_container_copy_construction(
+          other._Allocator)) {
+  *this = other;
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+CDS_List<T, Allocator, Inline, Growth>::CDS_List(CDS_List &&other) noexcept(
+    Inline == 0 || std::is_nothrow_move_constructible_v<T>)
+    : _Allocator(std::move(other._Allocator)), _Size(0), _Capacity(Inline),
+      _List(this->_Buffer.GetData()) {
+  if (!other.IsInline()) {
+    // Heap arrays change owner, the other list falls back to its inline
+    // buffer, or to no array at all.
+    this->SetData(other._List);
+    this->SetCapacity(other._Capacity);
+    this->SetSize(other._Size);
+    other.SetData(other._Buffer.GetData());
+    other.SetCapacity(Inline);
+    other.SetSize(0);
+    return;
+  }
+  this->Relocate(other.GetData(), other.GetSize(), this->GetData());
+  this->SetSize(other.GetSize());
+  other.SetSize(0);
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+CDS_List<T, Allocator, Inline, Growth> &
+CDS_List<T, Allocator, Inline, Growth>::operator=(const CDS_List &other) {
+  if (this == &other)
+    return *this;
+  this->Clear();
+  this->Reserve(other.GetSize());
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (other.GetSize())
+      std::memcpy(static_cast<void *>(this->GetData()), other.GetData(),
+                  other.GetSize() * sizeof(T));
+  } else {
+    for (size_t i = 0; i < other.GetSize(); i++) {
+      _Traits::construct(this->_Allocator, this->GetData() + i,
+                         other.GetElement(i));
+    }
+  }
+  this->SetSize(other.GetSize());
+  return *this;
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+CDS_List<T, Allocator, Inline, Growth> &
+CDS_List<T, Allocator, Inline, Growth>::operator=(CDS_List &&other) {
+  if (this == &other)
+    return *this;
+  this->Clear();
+  if (!other.IsInline() && (_Traits::is_always_equal::value ||
+                            this->_Allocator == other._Allocator)) {
+    this->Release();
+    this->SetData(other._List);
+    this->SetCapacity(other._Capacity);
+    this->SetSize(other._Size);
+    other.SetData(other._Buffer.GetData());
+    other.SetCapacity(Inline);
+    other.SetSize(0);
+    return *this;
+  }
+  this->Reserve(other.GetSize());
+  this->Relocate(other.GetData(), other.GetSize(), this->GetData());
+  this->SetSize(other.GetSize());
+  other.SetSize(0);
+  return *this;
 }
 
 // Destructor
-template <class T> CDS_List<T>::~CDS_List() {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+CDS_List<T, Allocator, Inline, Growth>::~CDS_List() {
   this->Clear();
-  if (this->GetData())
-    ::operator delete(_List, this->GetCapacity() * sizeof(T));
+  this->Release();
 }
 
 // Getters
-template <class T> const size_t CDS_List<T>::GetSize() const {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+Allocator CDS_List<T, Allocator, Inline, Growth>::GetAllocator() const {
+  return this->_Allocator;
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+const size_t CDS_List<T, Allocator, Inline, Growth>::GetSize() const {
   return this->_Size;
 }
 
-template <class T> T *CDS_List<T>::GetData() { return this->_List; }
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T *CDS_List<T, Allocator, Inline, Growth>::GetData() { return this->_List; }
 
-template <class T> const T *CDS_List<T>::GetData() const { return this->_List; }
+template <class T, class Allocator, std::size_t Inline, class Growth>
+const T *CDS_List<T, Allocator, Inline, Growth>::GetData() const {
+  return this->_List;
+}
 
-template <class T> const size_t CDS_List<T>::GetCapacity() const {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+const size_t CDS_List<T, Allocator, Inline, Growth>::GetCapacity() const {
   return this->_Capacity;
 }
 
-template <class T> T &CDS_List<T>::GetElement(const size_t index) const {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+bool CDS_List<T, Allocator, Inline, Growth>::IsInline() const {
+  return this->_List == this->_Buffer.GetData();
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T &CDS_List<T, Allocator, Inline, Growth>::GetElement(
+    const size_t index) const {
   assertm(index < this->GetSize(), "Index out of bounds");
   return this->_List[index];
 }
 
 // Setters
-template <class T> void CDS_List<T>::SetCapacity(const size_t cap) {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::SetCapacity(const size_t cap) {
   this->_Capacity = cap;
 }
 
-template <class T> void CDS_List<T>::SetSize(const size_t size) {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::SetSize(const size_t size) {
   this->_Size = size;
 }
 
-template <class T> void CDS_List<T>::SetData(T *data) { this->_List = data; }
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::SetData(T *data) {
+  this->_List = data;
+}
 
-template <class T>
-void CDS_List<T>::SetElement(const size_t index, const T &elem) {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::SetElement(const size_t index,
+                                                const T &elem) {
   this->_List[index] = elem;
 }
 
-template <class T> void CDS_List<T>::Reallocate(const size_t newCap) {
-  T *newList = (T *)::operator new(newCap * sizeof(T));
-  // if new capacity is smaller than current capacity (downsizing) then take new
-  // capacity as upper limit, else take size.
-  size_t lim = ((this->GetCapacity() > newCap) ? newCap : this->GetSize());
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Reallocate(const size_t newCap) {
+  assertm(newCap >= this->GetSize(), "Capacity below the size of the list");
+  if constexpr (_Realloc) {
+    // realloc can grow in place, and glibc remaps large blocks instead of
+    // copying them.
+    if (!this->IsInline() && newCap > 0) {
+      void *newList = std::realloc(static_cast<void *>(this->_List),
+                                   newCap * sizeof(T));
+      if (!newList)
+        throw std::bad_alloc();
+      this->SetData(static_cast<T *>(newList));
+      this->SetCapacity(newCap);
+      return;
+    }
+  }
+  T *newList = this->Allocate(newCap);
+  this->Relocate(this->GetData(), this->GetSize(), newList);
+  this->Release();
+  this->SetData(newList);
+  this->SetCapacity(newCap);
+}
 
-  for (size_t i = 0; i < lim; i++) {
-    // move of elements into uninitialized memory (very weird!)
-    new (newList + i) T(std::move(this->GetElement(i)));
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Grow(const size_t needed) {
+  this->Reallocate(std::max(Growth::Next(this->GetCapacity()), needed));
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T *CDS_List<T, Allocator, Inline, Growth>::Allocate(const size_t count) {
+  if constexpr (_Realloc) {
+    void *data = std::malloc(count * sizeof(T));
+    if (!data)
+      throw std::bad_alloc();
+    return static_cast<T *>(data);
+  } else {
+    return _Traits::allocate(this->_Allocator, count);
   }
+}
 
-  for (int i = 0; i < this->GetSize(); i++) {
-    this->GetElement(i).~T();
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Relocate(T *from,
+                                                      const size_t count,
+                                                      T *to) {
+  if constexpr (CDS_TriviallyRelocatable<T>::value) {
+    if (count)
+      std::memcpy(static_cast<void *>(to), from, count * sizeof(T));
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      // move of elements into uninitialized memory of the new array
+      _Traits::construct(this->_Allocator, to + i, std::move(from[i]));
+      _Traits::destroy(this->_Allocator, from + i);
+    }
   }
+}
 
-  if (this->GetData())
-    ::operator delete(_List, this->GetCapacity() * sizeof(T));
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Release() {
+  if (this->GetData() && !this->IsInline()) {
+    if constexpr (_Realloc)
+      std::free(this->_List);
+    else
+      _Traits::deallocate(this->_Allocator, this->_List, this->GetCapacity());
+  }
+  this->SetData(this->_Buffer.GetData());
+  this->SetCapacity(Inline);
+}
 
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T *CDS_List<T, Allocator, Inline, Growth>::OpenGap(const size_t index,
+                                                 const size_t count) {
+  assertm(index <= this->GetSize(), "Index out of bounds");
+  size_t size = this->GetSize();
+  if (size + count <= this->GetCapacity()) {
+    T *data = this->GetData();
+    if constexpr (CDS_TriviallyRelocatable<T>::value) {
+      if (size > index)
+        std::memmove(static_cast<void *>(data + index + count), data + index,
+                     (size - index) * sizeof(T));
+    } else {
+      // Back to front, every target is uninitialized or already moved out.
+      for (size_t i = size; i-- > index;) {
+        this->Relocate(data + i, 1, data + i + count);
+      }
+    }
+    return data + index;
+  }
+  if (index == size) {
+    this->Grow(size + count);
+    return this->GetData() + index;
+  }
+  // One new array, the two halves go straight to their final place.
+  size_t newCap = std::max(Growth::Next(this->GetCapacity()), size + count);
+  T *newList = this->Allocate(newCap);
+  this->Relocate(this->GetData(), index, newList);
+  this->Relocate(this->GetData() + index, size - index,
+                 newList + index + count);
+  this->Release();
   this->SetData(newList);
   this->SetCapacity(newCap);
+  return newList + index;
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+template <class InputIt>
+void CDS_List<T, Allocator, Inline, Growth>::CopyRange(InputIt first,
+                                                       const size_t count,
+                                                       T *to) {
+  if constexpr (std::contiguous_iterator<InputIt> &&
+                std::is_same_v<std::iter_value_t<InputIt>, T> &&
+                std::is_trivially_copyable_v<T>) {
+    if (count)
+      std::memcpy(static_cast<void *>(to), std::to_address(first),
+                  count * sizeof(T));
+  } else {
+    for (size_t i = 0; i < count; i++, ++first) {
+      _Traits::construct(this->_Allocator, to + i, *first);
+    }
+  }
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+bool CDS_List<T, Allocator, Inline, Growth>::Contains(const T *pointer) const {
+  std::less<const T *> less;
+  return !less(pointer, this->GetData()) &&
+         less(pointer, this->GetData() + this->GetSize());
+}
+
+// Reserve
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Reserve(const size_t capacity) {
+  if (capacity > this->GetCapacity())
+    this->Reallocate(capacity);
+}
+
+// ShrinkToFit
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::ShrinkToFit() {
+  if (this->IsInline() || this->GetSize() == this->GetCapacity())
+    return;
+  if (this->GetSize() > Inline) {
+    this->Reallocate(this->GetSize());
+    return;
+  }
+  // Few enough elements to move back into the inline buffer, or none left
+  // at all without one.
+  T *data = this->GetData();
+  size_t capacity = this->GetCapacity();
+  this->SetData(this->_Buffer.GetData());
+  this->Relocate(data, this->GetSize(), this->GetData());
+  std::swap(data, this->_List);
+  this->SetCapacity(capacity);
+  this->Release();
 }
 
 // Fill
-template <class T> void CDS_List<T>::Fill(const T &elem) {
-  for (int i = 0; i < _Size; i++) {
-    this->SetElement(i, elem);
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Fill(const T &elem) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    _Simd::_Fill(this->GetData(), this->GetSize(), elem);
+  } else {
+    for (size_t i = 0; i < this->GetSize(); i++) {
+      this->SetElement(i, elem);
+    }
   }
 }
 
+// Numeric Operations
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Add(std::span<const T> other)
+  requires std::is_arithmetic_v<T>
+{
+  assertm(other.size() == this->GetSize(), "Sizes do not match");
+  _Simd::_Add(this->GetData(), other.data(), this->GetData(),
+              this->GetSize());
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Sub(std::span<const T> other)
+  requires std::is_arithmetic_v<T>
+{
+  assertm(other.size() == this->GetSize(), "Sizes do not match");
+  _Simd::_Sub(this->GetData(), other.data(), this->GetData(),
+              this->GetSize());
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Mul(std::span<const T> other)
+  requires std::is_arithmetic_v<T>
+{
+  assertm(other.size() == this->GetSize(), "Sizes do not match");
+  _Simd::_Mul(this->GetData(), other.data(), this->GetData(),
+              this->GetSize());
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Fma(std::span<const T> lhs,
+                                                 std::span<const T> rhs)
+  requires std::is_arithmetic_v<T>
+{
+  assertm(lhs.size() == this->GetSize() && rhs.size() == this->GetSize(),
+          "Sizes do not match");
+  _Simd::_Fma(lhs.data(), rhs.data(), this->GetData(), this->GetData(),
+              this->GetSize());
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::AssignScaled(
+    std::span<const T> source, const T &alpha)
+  requires std::is_arithmetic_v<T>
+{
+  // A source inside this list is never longer than it, so reserving does
+  // not move it.
+  this->Reserve(source.size());
+  _Simd::_Scale(source.data(), alpha, this->GetData(), source.size());
+  this->SetSize(source.size());
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T CDS_List<T, Allocator, Inline, Growth>::Dot(std::span<const T> other) const
+  requires std::is_arithmetic_v<T>
+{
+  assertm(other.size() == this->GetSize(), "Sizes do not match");
+  return _Simd::_Dot(this->GetData(), other.data(), this->GetSize());
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T CDS_List<T, Allocator, Inline, Growth>::Sum() const
+  requires std::is_arithmetic_v<T>
+{
+  return _Simd::_Sum(this->GetData(), this->GetSize());
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T CDS_List<T, Allocator, Inline, Growth>::Min() const
+  requires std::is_arithmetic_v<T>
+{
+  return _Simd::_Min(this->GetData(), this->GetSize());
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T CDS_List<T, Allocator, Inline, Growth>::Max() const
+  requires std::is_arithmetic_v<T>
+{
+  return _Simd::_Max(this->GetData(), this->GetSize());
+}
+
 // Swap
-template <class T>
-void CDS_List<T>::Swap(const size_t &lhs, const size_t &rhs) {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Swap(const size_t &lhs,
+                                          const size_t &rhs) {
   T temp = std::move(this->GetElement(lhs)); // Move element at lhs to temp
   this->SetElement(lhs, std::move(this->GetElement(rhs))); // Move rhs to lhs
   this->SetElement(rhs, std::move(temp)); // Move temp (original lhs) to rhs
 }
 
 // Append
-template <class T> const T &CDS_List<T>::Append(const T &elem) {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+const T &CDS_List<T, Allocator, Inline, Growth>::Append(const T &elem) {
   if (this->GetSize() >= this->GetCapacity()) {
-    this->Reallocate(this->GetCapacity() * 2);
+    // Growing frees the array elem may live in.
+    if (this->Contains(&elem))
+      return this->Append(T(elem));
+    this->Grow(this->GetSize() + 1);
   }
-  this->SetElement(this->GetSize(), elem);
+  _Traits::construct(this->_Allocator, this->GetData() + this->GetSize(), elem);
   this->SetSize(this->GetSize() + 1);
 
   return this->GetElement(this->GetSize() - 1);
 }
 
 // Append (Temporary elem)
-template <class T> const T &CDS_List<T>::Append(T &&elem) {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+const T &CDS_List<T, Allocator, Inline, Growth>::Append(T &&elem) {
   if (this->GetSize() >= this->GetCapacity()) {
-    this->Reallocate(this->GetCapacity() * 2);
+    // Growing frees the array elem may live in.
+    if (this->Contains(&elem))
+      return this->Append(T(std::move(elem)));
+    this->Grow(this->GetSize() + 1);
   }
-  new (this->GetData() + this->GetSize()) T(std::move(elem));
+  _Traits::construct(this->_Allocator, this->GetData() + this->GetSize(),
+                     std::move(elem));
   this->SetSize(this->GetSize() + 1);
 
   return this->GetElement(this->GetSize() - 1);
 }
 
 // Emplace
-template <class T>
+template <class T, class Allocator, std::size_t Inline, class Growth>
 template <class... Args>
-T &CDS_List<T>::Emplace(Args &&...args) {
+T &CDS_List<T, Allocator, Inline, Growth>::Emplace(Args &&...args) {
   if (this->GetSize() >= this->GetCapacity()) {
-    this->Reallocate(this->GetCapacity() * 2);
+    // Growing frees the array the arguments may refer to, so the element is
+    // built before it.
+    T elem(std::forward<Args>(args)...);
+    this->Grow(this->GetSize() + 1);
+    _Traits::construct(this->_Allocator, this->GetData() + this->GetSize(),
+                       std::move(elem));
+    this->SetSize(this->GetSize() + 1);
+    return this->GetElement(this->GetSize() - 1);
   }
-  new (&this->GetElement(this->GetSize())) T(std::forward<Args>(args)...);
+  _Traits::construct(this->_Allocator, this->GetData() + this->GetSize(),
+                     std::forward<Args>(args)...);
   this->SetSize(this->GetSize() + 1);
 
   return this->GetElement(this->GetSize() - 1);
 }
 
 // Pop
-template <class T> T CDS_List<T>::Pop() {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T CDS_List<T, Allocator, Inline, Growth>::Pop() {
   assertm(this->GetSize() > 0, "List is empty");
   T outElem = std::move(GetElement(this->GetSize() - 1));
+  _Traits::destroy(this->_Allocator, this->GetData() + this->GetSize() - 1);
   this->SetSize(this->GetSize() - 1);
 
   return outElem;
 }
 
 // Clear
-template <class T> void CDS_List<T>::Clear() {
-  for (int i = 0; i < this->GetSize(); i++) {
-    this->GetElement(i).~T();
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Clear() {
+  for (size_t i = 0; i < this->GetSize(); i++) {
+    _Traits::destroy(this->_Allocator, this->GetData() + i);
   }
   this->SetSize(0);
 }
 
+// AppendRange
+template <class T, class Allocator, std::size_t Inline, class Growth>
+template <class InputIt>
+void CDS_List<T, Allocator, Inline, Growth>::AppendRange(InputIt first,
+                                                         InputIt last) {
+  if constexpr (std::forward_iterator<InputIt>) {
+    size_t count = std::distance(first, last);
+    if (this->GetSize() + count > this->GetCapacity())
+      this->Grow(this->GetSize() + count);
+    this->CopyRange(first, count, this->GetData() + this->GetSize());
+    this->SetSize(this->GetSize() + count);
+  } else {
+    for (; first != last; ++first) {
+      this->Emplace(*first);
+    }
+  }
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::AppendRange(
+    std::span<const T> elems) {
+  this->AppendRange(elems.begin(), elems.end());
+}
+
 // Insert
-template <class T> void CDS_List<T>::Insert(const size_t index, const T &elem) {
-  std::logic_error("Function not yet implemented!");
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Insert(const size_t index,
+                                                    const T &elem) {
+  // Moving the elements may move or free elem.
+  if (this->Contains(&elem)) {
+    this->Insert(index, T(elem));
+    return;
+  }
+  _Traits::construct(this->_Allocator, this->OpenGap(index, 1), elem);
+  this->SetSize(this->GetSize() + 1);
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Insert(const size_t index,
+                                                    T &&elem) {
+  _Traits::construct(this->_Allocator, this->OpenGap(index, 1),
+                     std::move(elem));
+  this->SetSize(this->GetSize() + 1);
+}
+
+// InsertRange
+template <class T, class Allocator, std::size_t Inline, class Growth>
+template <class InputIt>
+void CDS_List<T, Allocator, Inline, Growth>::InsertRange(const size_t index,
+                                                         InputIt first,
+                                                         InputIt last) {
+  if constexpr (std::forward_iterator<InputIt>) {
+    size_t count = std::distance(first, last);
+    this->CopyRange(first, count, this->OpenGap(index, count));
+    this->SetSize(this->GetSize() + count);
+  } else {
+    // Single pass ranges have no size up front, append and rotate instead.
+    assertm(index <= this->GetSize(), "Index out of bounds");
+    size_t size = this->GetSize();
+    this->AppendRange(first, last);
+    std::rotate(this->GetData() + index, this->GetData() + size,
+                this->GetData() + this->GetSize());
+  }
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::InsertRange(
+    const size_t index, std::span<const T> elems) {
+  this->InsertRange(index, elems.begin(), elems.end());
 }
 
 // Remove
-template <class T> void CDS_List<T>::Remove(const size_t index) {
-  std::logic_error("Function not yet implemented!");
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::Remove(const size_t index) {
+  this->RemoveRange(index, 1);
+}
+
+template <class T, class Allocator, std::size_t Inline, class Growth>
+void CDS_List<T, Allocator, Inline, Growth>::RemoveRange(const size_t index,
+                                                         const size_t count) {
+  assertm(index + count <= this->GetSize(), "Range out of bounds");
+  T *data = this->GetData();
+  for (size_t i = index; i < index + count; i++) {
+    _Traits::destroy(this->_Allocator, data + i);
+  }
+  size_t tail = this->GetSize() - index - count;
+  if constexpr (CDS_TriviallyRelocatable<T>::value) {
+    if (tail)
+      std::memmove(static_cast<void *>(data + index), data + index + count,
+                   tail * sizeof(T));
+  } else {
+    this->Relocate(data + index + count, tail, data + index);
+  }
+  this->SetSize(this->GetSize() - count);
+}
+
+// RemoveIf
+template <class T, class Allocator, std::size_t Inline, class Growth>
+template <class Predicate>
+size_t CDS_List<T, Allocator, Inline, Growth>::RemoveIf(Predicate pred) {
+  T *data = this->GetData();
+  size_t kept = 0;
+  for (size_t i = 0; i < this->GetSize(); i++) {
+    if (pred(std::as_const(data[i]))) {
+      _Traits::destroy(this->_Allocator, data + i);
+    } else {
+      if (kept != i)
+        this->Relocate(data + i, 1, data + kept);
+      kept++;
+    }
+  }
+  size_t removed = this->GetSize() - kept;
+  this->SetSize(kept);
+  return removed;
 }
 
 // Operator Overloads
-template <class T> T &CDS_List<T>::operator[](const size_t index) {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+T &CDS_List<T, Allocator, Inline, Growth>::operator[](const size_t index) {
   return this->GetElement(index);
 }
 
-template <class T> const T &CDS_List<T>::operator[](const size_t index) const {
+template <class T, class Allocator, std::size_t Inline, class Growth>
+const T &CDS_List<T, Allocator, Inline, Growth>::operator[](
+    const size_t index) const {
   return this->GetElement(index);
 }
 
-template <class U>
-std::ostream &operator<<(std::ostream &stream, const CDS_List<U> &array) {
+template <class U, class A, std::size_t M, class G>
+std::ostream &operator<<(std::ostream &stream,
+                         const CDS_List<U, A, M, G> &array) {
   stream << "[";
   for (size_t i = 0; i < array.GetSize(); ++i) {
     stream << array.GetElement(i);
@@ -174,62 +630,39 @@ std::ostream &operator<<(std::ostream &stream, const CDS_List<U> &array) {
   return stream;
 }
 
-// Iterator Constructor
-template <class T>
-CDS_List<T>::iterator::iterator(pointer inPointer) : _pointer(inPointer) {}
-
-// Iterator Overloads
-template <class T>
-typename CDS_List<T>::iterator::reference
-CDS_List<T>::iterator::operator*() const {
-  return *this->_pointer;
-}
-
-template <class T>
-typename CDS_List<T>::iterator::pointer CDS_List<T>::iterator::operator->() {
-  return this->_pointer;
-}
-
-template <class T>
-typename CDS_List<T>::iterator &CDS_List<T>::iterator::operator++() {
-  ++_pointer;
-  return *this;
-}
-
-template <class T>
-typename CDS_List<T>::iterator CDS_List<T>::iterator::operator++(int) {
-  iterator temp = *this;
-  ++_pointer;
-  return temp;
-}
-
-template <class T>
-typename CDS_List<T>::iterator &CDS_List<T>::iterator::operator--() {
-  --_pointer;
-  return *this;
+// Iterators
+template <class T, class Allocator, std::size_t Inline, class Growth>
+typename CDS_List<T, Allocator, Inline, Growth>::iterator
+CDS_List<T, Allocator, Inline, Growth>::begin() {
+  return iterator(this->GetData());
 }
 
-template <class T>
-typename CDS_List<T>::iterator CDS_List<T>::iterator::operator--(int) {
-  iterator temp = *this;
-  --_pointer;
-  return temp;
+template <class T, class Allocator, std::size_t Inline, class Growth>
+typename CDS_List<T, Allocator, Inline, Growth>::const_iterator
+CDS_List<T, Allocator, Inline, Growth>::begin() const {
+  return const_iterator(this->GetData());
 }
 
-template <class T>
-bool CDS_List<T>::iterator::operator==(const CDS_List<T>::iterator &other) const {
-  return this->_pointer == other._pointer;
+template <class T, class Allocator, std::size_t Inline, class Growth>
+typename CDS_List<T, Allocator, Inline, Growth>::const_iterator
+CDS_List<T, Allocator, Inline, Growth>::cbegin() const {
+  return const_iterator(this->GetData());
 }
 
-template <class T>
-bool CDS_List<T>::iterator::operator!=(const CDS_List<T>::iterator &other) const {
-  return this->_pointer != other._pointer;
+template <class T, class Allocator, std::size_t Inline, class Growth>
+typename CDS_List<T, Allocator, Inline, Growth>::iterator
+CDS_List<T, Allocator, Inline, Growth>::end() {
+  return iterator(this->GetData() + this->GetSize());
 }
 
-template <class T> typename CDS_List<T>::iterator CDS_List<T>::end() {
-  return iterator(this->GetData() + this->GetSize());
+template <class T, class Allocator, std::size_t Inline, class Growth>
+typename CDS_List<T, Allocator, Inline, Growth>::const_iterator
+CDS_List<T, Allocator, Inline, Growth>::end() const {
+  return const_iterator(this->GetData() + this->GetSize());
 }
 
-template <class T> typename CDS_List<T>::iterator CDS_List<T>::begin() {
-  return iterator(this->GetData());
+template <class T, class Allocator, std::size_t Inline, class Growth>
+typename CDS_List<T, Allocator, Inline, Growth>::const_iterator
+CDS_List<T, Allocator, Inline, Growth>::cend() const {
+  return const_iterator(this->GetData() + this->GetSize());
 }
@@ -1 +1,857 @@
+#pragma once
+#include "CDS_Matrix.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <type_traits>
+#include <utility>
 
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+namespace _Init {
+
+/**
+ * @brief Edge length of the square tiles used by the blocked transpose.
+ */
+constexpr const int _TRANSPOSE_TILE = 32;
+
+/**
+ * @brief Number of elements per tile of the parallel element-wise loops.
+ */
+constexpr const int _PARALLEL_TILE = 16384;
+} // namespace _Init
+
+// Memory
+template <typename T> T *CDS_Matrix<T>::_Allocate(std::size_t count) {
+  if (count == 0)
+    return nullptr;
+  T *data = static_cast<T *>(::operator new(
+      count * sizeof(T), std::align_val_t(CDS_Matrix<T>::Alignment)));
+  std::uninitialized_value_construct_n(data, count);
+  return data;
+}
+
+template <typename T>
+void CDS_Matrix<T>::_Release(T *data, std::size_t count) {
+  if (!data)
+    return;
+  std::destroy_n(data, count);
+  ::operator delete(data, count * sizeof(T),
+                    std::align_val_t(CDS_Matrix<T>::Alignment));
+}
+
+template <typename T> std::size_t CDS_Matrix<T>::_Count() const {
+  return static_cast<std::size_t>(this->_Rows) * this->_Cols;
+}
+
+template <typename T>
+std::size_t CDS_Matrix<T>::_Index(int row, int col) const {
+  if (this->_Layout == Layout::RowMajor)
+    return static_cast<std::size_t>(row) * this->_Cols + col;
+  return static_cast<std::size_t>(col) * this->_Rows + row;
+}
+
+// Constructors
+template <typename T>
+CDS_Matrix<T>::CDS_Matrix(std::initializer_list<T> elements)
+    : _Rows(0), _Cols(0), _Layout(Layout::RowMajor) {
+  int count = static_cast<int>(elements.size());
+  int side = static_cast<int>(std::lround(std::sqrt(count)));
+  if (side * side == count) {
+    this->_Rows = side;
+    this->_Cols = side;
+  } else {
+    this->_Rows = count;
+    this->_Cols = 1;
+  }
+  this->_Data = _Allocate(this->_Count());
+  std::copy(elements.begin(), elements.end(), this->_Data);
+}
+
+template <typename T>
+CDS_Matrix<T>::CDS_Matrix(int rows, int cols, Layout layout)
+    : _Rows(rows), _Cols(cols), _Layout(layout) {
+  assertm(rows >= 0 && cols >= 0, "Matrix dimensions must be non-negative");
+  this->_Data = _Allocate(this->_Count());
+}
+
+template <typename T>
+template <class U>
+CDS_Matrix<T>::CDS_Matrix(const CDS_MatrixView<U> &view, Layout layout)
+    : _Rows(std::get<0>(view.GetShape())), _Cols(std::get<1>(view.GetShape())),
+      _Layout(layout) {
+  this->_Data = _Allocate(this->_Count());
+  for (int i = 0; i < this->_Rows; i++) {
+    for (int j = 0; j < this->_Cols; j++) {
+      this->_Data[this->_Index(i, j)] = view[{i, j}];
+    }
+  }
+}
+
+template <typename T>
+template <_Expr::Expression E>
+CDS_Matrix<T>::CDS_Matrix(const E &expr)
+    : _Rows(expr.Rows()), _Cols(expr.Cols()), _Layout(expr.GetLayout()) {
+  this->_Data = _Allocate(this->_Count());
+  this->_Assign(expr);
+}
+
+template <typename T>
+CDS_Matrix<T>::CDS_Matrix(const CDS_Matrix<T> &other)
+    : _Rows(other._Rows), _Cols(other._Cols), _Layout(other._Layout) {
+  this->_SetFactors(other._Factors.load());
+  this->_Data = _Allocate(this->_Count());
+  std::copy(other._Data, other._Data + other._Count(), this->_Data);
+}
+
+template <typename T>
+CDS_Matrix<T>::CDS_Matrix(CDS_Matrix<T> &&other) noexcept
+    : _Data(std::exchange(other._Data, nullptr)),
+      _Rows(std::exchange(other._Rows, 0)),
+      _Cols(std::exchange(other._Cols, 0)), _Layout(other._Layout) {
+  this->_SetFactors(other._Factors.exchange(nullptr));
+}
+
+template <typename T>
+CDS_Matrix<T> &CDS_Matrix<T>::operator=(const CDS_Matrix<T> &other) {
+  if (this == &other)
+    return *this;
+  if (this->_Count() != other._Count()) {
+    _Release(this->_Data, this->_Count());
+    this->_Data = _Allocate(other._Count());
+  }
+  this->_Rows = other._Rows;
+  this->_Cols = other._Cols;
+  this->_Layout = other._Layout;
+  this->_SetFactors(other._Factors.load());
+  std::copy(other._Data, other._Data + other._Count(), this->_Data);
+  return *this;
+}
+
+template <typename T>
+CDS_Matrix<T> &CDS_Matrix<T>::operator=(CDS_Matrix<T> &&other) noexcept {
+  if (this == &other)
+    return *this;
+  _Release(this->_Data, this->_Count());
+  this->_Data = std::exchange(other._Data, nullptr);
+  this->_Rows = std::exchange(other._Rows, 0);
+  this->_Cols = std::exchange(other._Cols, 0);
+  this->_Layout = other._Layout;
+  this->_SetFactors(other._Factors.exchange(nullptr));
+  return *this;
+}
+
+template <typename T>
+template <_Expr::Expression E>
+CDS_Matrix<T> &CDS_Matrix<T>::operator=(const E &expr) {
+  this->_Invalidate();
+  if (this->_Rows != expr.Rows() || this->_Cols != expr.Cols()) {
+    if (expr.Aliases(this->_Data)) {
+      // Cannot happen for well-formed expressions, the operands all have
+      // the shape of the result. Kept so a reallocation never pulls the
+      // buffer out from under the expression.
+      *this = CDS_Matrix<T>(expr);
+      return *this;
+    }
+    _Release(this->_Data, this->_Count());
+    this->_Rows = expr.Rows();
+    this->_Cols = expr.Cols();
+    this->_Data = _Allocate(this->_Count());
+  }
+  this->_Assign(expr);
+  return *this;
+}
+
+// Destructor
+template <typename T> CDS_Matrix<T>::~CDS_Matrix() {
+  _Release(this->_Data, this->_Count());
+}
+
+// Special Matrices
+template <typename T> CDS_Matrix<T> CDS_Matrix<T>::Identity(int rows, int cols) {
+  CDS_Matrix<T> out(rows, cols);
+  for (int i = 0; i < std::min(rows, cols); i++) {
+    out._Data[out._Index(i, i)] = T(1);
+  }
+  return out;
+}
+
+template <typename T> CDS_Matrix<T> CDS_Matrix<T>::Null(int rows, int cols) {
+  return CDS_Matrix<T>(rows, cols);
+}
+
+template <typename T> CDS_Matrix<T> CDS_Matrix<T>::Rotation(int dimension) {
+  assertm(dimension >= 2, "Rotation needs at least two dimensions");
+  return CDS_Matrix<T>::Identity(dimension, dimension);
+}
+
+template <typename T> void CDS_Matrix<T>::SetDegree(float degree) {
+  this->_Invalidate();
+  assertm(this->IsSquare() && this->_Rows >= 2,
+          "Rotation matrix must be square with at least two dimensions");
+  double radians = degree * std::numbers::pi / 180.0;
+  T c = static_cast<T>(std::cos(radians));
+  T s = static_cast<T>(std::sin(radians));
+
+  *this = CDS_Matrix<T>::Identity(this->_Rows, this->_Cols);
+  this->_Data[this->_Index(0, 0)] = c;
+  this->_Data[this->_Index(0, 1)] = -s;
+  this->_Data[this->_Index(1, 0)] = s;
+  this->_Data[this->_Index(1, 1)] = c;
+}
+
+// Arithmetic
+template <typename T>
+CDS_Matrix<T> CDS_Matrix<T>::operator*(const CDS_Matrix<T> &other) const {
+  assertm(this->IsMultipliable(other), "Matrix shapes do not match");
+  CDS_Matrix<T> out(this->_Rows, other._Cols, this->_Layout);
+  _Gemm::ParallelGemm<T>(T(1), this->View(), other.View(), T(0),
+                         out.View());
+  return out;
+}
+
+template <typename T>
+template <class E>
+void CDS_Matrix<T>::_Assign(const E &expr) {
+  CDS_ThreadPool &pool = CDS_ThreadPool::Instance();
+  if (expr.IsUniform(this->_Layout)) {
+    // All operands share the storage order of the result, so the whole
+    // expression is one linear loop over the buffers. Tiles are bands of
+    // whole rows (or columns) of the storage.
+    bool rowMajor = this->_Layout == Layout::RowMajor;
+    int major = rowMajor ? this->_Rows : this->_Cols;
+    int minor = rowMajor ? this->_Cols : this->_Rows;
+    int band = std::max(1, _Init::_PARALLEL_TILE / std::max(minor, 1));
+    pool.ParallelFor2D(
+        major, minor, band, minor, this->_Count(),
+        [&](int majorBegin, int majorEnd, int, int) {
+          std::size_t begin = static_cast<std::size_t>(majorBegin) * minor;
+          std::size_t end = static_cast<std::size_t>(majorEnd) * minor;
+          T *out = this->_Data;
+          for (std::size_t k = begin; k < end; k++) {
+            out[k] = expr.Linear(k);
+          }
+        });
+    return;
+  }
+
+  const int tile = _Init::_TRANSPOSE_TILE * 2;
+  pool.ParallelFor2D(
+      this->_Rows, this->_Cols, tile, tile, this->_Count(),
+      [&](int rowBegin, int rowEnd, int colBegin, int colEnd) {
+        for (int i = rowBegin; i < rowEnd; i++) {
+          for (int j = colBegin; j < colEnd; j++) {
+            this->_Data[this->_Index(i, j)] = expr.At(i, j);
+          }
+        }
+      });
+}
+
+template <typename T>
+std::vector<T> CDS_Matrix<T>::operator*(const std::vector<T> &vector) const {
+  assertm(static_cast<int>(vector.size()) == this->_Cols,
+          "Vector size does not match the number of columns");
+  std::vector<T> out(this->_Rows, T(0));
+  int band = std::max(1, _Init::_PARALLEL_TILE / std::max(this->_Cols, 1));
+
+  // Bands of rows, every band owns its slice of the output so no reduction
+  // across threads is needed for either layout.
+  CDS_ThreadPool::Instance().ParallelFor2D(
+      this->_Rows, 1, band, 1, this->_Count(),
+      [&](int rowBegin, int rowEnd, int, int) {
+        if (this->_Layout == Layout::RowMajor) {
+          for (int i = rowBegin; i < rowEnd; i++) {
+            const T *row =
+                this->_Data + static_cast<std::size_t>(i) * this->_Cols;
+            T sum = T(0);
+            for (int j = 0; j < this->_Cols; j++) {
+              sum += row[j] * vector[j];
+            }
+            out[i] = sum;
+          }
+          return;
+        }
+        for (int j = 0; j < this->_Cols; j++) {
+          const T *col =
+              this->_Data + static_cast<std::size_t>(j) * this->_Rows;
+          for (int i = rowBegin; i < rowEnd; i++) {
+            out[i] += col[i] * vector[j];
+          }
+        }
+      });
+  return out;
+}
+
+// Shape Manipulation
+template <typename T> void CDS_Matrix<T>::Reshape(int newRows, int newCols) {
+  this->_Invalidate();
+  assertm(newRows >= 0 && newCols >= 0,
+          "Matrix dimensions must be non-negative");
+  std::size_t newCount = static_cast<std::size_t>(newRows) * newCols;
+  std::size_t kept = std::min(newCount, this->_Count());
+
+  if (this->_Layout == Layout::RowMajor) {
+    if (newCount != this->_Count()) {
+      T *data = _Allocate(newCount);
+      std::move(this->_Data, this->_Data + kept, data);
+      _Release(this->_Data, this->_Count());
+      this->_Data = data;
+    }
+    this->_Rows = newRows;
+    this->_Cols = newCols;
+    return;
+  }
+
+  T *data = _Allocate(newCount);
+  for (std::size_t k = 0; k < kept; k++) {
+    int row = static_cast<int>(k / this->_Cols);
+    int col = static_cast<int>(k % this->_Cols);
+    int newRow = static_cast<int>(k / newCols);
+    int newCol = static_cast<int>(k % newCols);
+    data[static_cast<std::size_t>(newCol) * newRows + newRow] =
+        std::move(this->_Data[this->_Index(row, col)]);
+  }
+  _Release(this->_Data, this->_Count());
+  this->_Data = data;
+  this->_Rows = newRows;
+  this->_Cols = newCols;
+}
+
+template <typename T> void CDS_Matrix<T>::SetLayout(Layout layout) {
+  if (this->_Layout == layout)
+    return;
+  // The values do not change, so the factorizations stay valid.
+  CDS_Matrix<T> out(std::as_const(*this).View(), layout);
+  out._SetFactors(this->_Factors.load());
+  *this = std::move(out);
+}
+
+template <typename T>
+void CDS_Matrix<T>::SetColumn(int colIndex, const std::vector<T> &values) {
+  this->_Invalidate();
+  assertm(colIndex >= 0 && colIndex < this->_Cols,
+          "Column index out of bounds");
+  assertm(static_cast<int>(values.size()) == this->_Rows,
+          "Column size does not match the number of rows");
+  for (int i = 0; i < this->_Rows; i++) {
+    this->_Data[this->_Index(i, colIndex)] = values[i];
+  }
+}
+
+template <typename T>
+void CDS_Matrix<T>::SetRow(int rowIndex, const std::vector<T> &values) {
+  this->_Invalidate();
+  assertm(rowIndex >= 0 && rowIndex < this->_Rows, "Row index out of bounds");
+  assertm(static_cast<int>(values.size()) == this->_Cols,
+          "Row size does not match the number of columns");
+  for (int j = 0; j < this->_Cols; j++) {
+    this->_Data[this->_Index(rowIndex, j)] = values[j];
+  }
+}
+
+// Views
+template <typename T> CDS_MatrixView<T> CDS_Matrix<T>::View() {
+  this->_Invalidate();
+  return CDS_MatrixView<T>(this->_Data, this->_Rows, this->_Cols,
+                           this->GetRowStride(), this->GetColumnStride());
+}
+
+template <typename T> CDS_MatrixView<const T> CDS_Matrix<T>::View() const {
+  return CDS_MatrixView<const T>(this->_Data, this->_Rows, this->_Cols,
+                                 this->GetRowStride(),
+                                 this->GetColumnStride());
+}
+
+template <typename T>
+CDS_MatrixView<T>
+CDS_Matrix<T>::ExcludeColumns(std::initializer_list<int> colIndices) {
+  return this->View().ExcludeColumns(colIndices);
+}
+
+template <typename T>
+CDS_MatrixView<const T>
+CDS_Matrix<T>::ExcludeColumns(std::initializer_list<int> colIndices) const {
+  return this->View().ExcludeColumns(colIndices);
+}
+
+template <typename T>
+CDS_MatrixView<T>
+CDS_Matrix<T>::ExcludeRows(std::initializer_list<int> rowIndices) {
+  return this->View().ExcludeRows(rowIndices);
+}
+
+template <typename T>
+CDS_MatrixView<const T>
+CDS_Matrix<T>::ExcludeRows(std::initializer_list<int> rowIndices) const {
+  return this->View().ExcludeRows(rowIndices);
+}
+
+template <typename T> CDS_VectorView<T> CDS_Matrix<T>::GetDiagonal() {
+  return this->View().GetDiagonal();
+}
+
+template <typename T>
+CDS_VectorView<const T> CDS_Matrix<T>::GetDiagonal() const {
+  return this->View().GetDiagonal();
+}
+
+template <typename T> CDS_VectorView<T> CDS_Matrix<T>::GetColumn(int colIndex) {
+  return this->View().GetColumn(colIndex);
+}
+
+template <typename T>
+CDS_VectorView<const T> CDS_Matrix<T>::GetColumn(int colIndex) const {
+  return this->View().GetColumn(colIndex);
+}
+
+template <typename T> CDS_VectorView<T> CDS_Matrix<T>::GetRow(int rowIndex) {
+  return this->View().GetRow(rowIndex);
+}
+
+template <typename T>
+CDS_VectorView<const T> CDS_Matrix<T>::GetRow(int rowIndex) const {
+  return this->View().GetRow(rowIndex);
+}
+
+// Getters
+template <typename T> std::tuple<int, int> CDS_Matrix<T>::GetShape() const {
+  return {this->_Rows, this->_Cols};
+}
+
+template <typename T> T *CDS_Matrix<T>::GetData() {
+  this->_Invalidate();
+  return this->_Data;
+}
+
+template <typename T> const T *CDS_Matrix<T>::GetData() const {
+  return this->_Data;
+}
+
+template <typename T>
+typename CDS_Matrix<T>::Layout CDS_Matrix<T>::GetLayout() const {
+  return this->_Layout;
+}
+
+template <typename T> std::ptrdiff_t CDS_Matrix<T>::GetRowStride() const {
+  return this->_Layout == Layout::RowMajor ? this->_Cols : 1;
+}
+
+template <typename T> std::ptrdiff_t CDS_Matrix<T>::GetColumnStride() const {
+  return this->_Layout == Layout::RowMajor ? 1 : this->_Rows;
+}
+
+// Element-wise Modifiers
+template <typename T> void CDS_Matrix<T>::operator++(int) {
+  this->_Invalidate();
+  for (std::size_t k = 0; k < this->_Count(); k++) {
+    this->_Data[k]++;
+  }
+}
+
+template <typename T> void CDS_Matrix<T>::operator--(int) {
+  this->_Invalidate();
+  for (std::size_t k = 0; k < this->_Count(); k++) {
+    this->_Data[k]--;
+  }
+}
+
+template <typename T> void CDS_Matrix<T>::Fill(T value) {
+  this->_Invalidate();
+  std::fill(this->_Data, this->_Data + this->_Count(), value);
+}
+
+// Transformations
+template <typename T> void CDS_Matrix<T>::Transpose() {
+  this->_Invalidate();
+  CDS_ThreadPool &pool = CDS_ThreadPool::Instance();
+  const int tile = _Init::_TRANSPOSE_TILE;
+
+  if (this->IsSquare()) {
+    // Tiles above the diagonal swap with their mirror image, tiles on the
+    // diagonal swap within themselves, tiles below have nothing to do.
+    pool.ParallelFor2D(
+        this->_Rows, this->_Cols, tile, tile, this->_Count(),
+        [&](int rowBegin, int rowEnd, int colBegin, int colEnd) {
+          if (rowBegin > colBegin)
+            return;
+          for (int i = rowBegin; i < rowEnd; i++) {
+            for (int j = std::max(colBegin, i + 1); j < colEnd; j++) {
+              std::swap(this->_Data[this->_Index(i, j)],
+                        this->_Data[this->_Index(j, i)]);
+            }
+          }
+        });
+    return;
+  }
+
+  // Tiled copy, so that both the reads and the writes stay within a few
+  // cache lines per tile.
+  CDS_Matrix<T> out(this->_Cols, this->_Rows, this->_Layout);
+  pool.ParallelFor2D(
+      this->_Rows, this->_Cols, tile, tile, this->_Count(),
+      [&](int rowBegin, int rowEnd, int colBegin, int colEnd) {
+        for (int i = rowBegin; i < rowEnd; i++) {
+          for (int j = colBegin; j < colEnd; j++) {
+            out._Data[out._Index(j, i)] = this->_Data[this->_Index(i, j)];
+          }
+        }
+      });
+  *this = std::move(out);
+}
+
+template <typename T> void CDS_Matrix<T>::Conjugate() {
+  this->_Invalidate();
+  if constexpr (!std::is_arithmetic_v<T>) {
+    for (std::size_t k = 0; k < this->_Count(); k++) {
+      this->_Data[k] = std::conj(this->_Data[k]);
+    }
+  }
+}
+
+template <typename T> void CDS_Matrix<T>::ConjugateTranspose() {
+  this->Transpose();
+  this->Conjugate();
+}
+
+template <typename T> T CDS_Matrix<T>::Trace() const {
+  assertm(this->IsSquare(), "Trace is only defined for square matrices");
+  T sum = T(0);
+  for (int i = 0; i < this->_Rows; i++) {
+    sum += this->_Data[this->_Index(i, i)];
+  }
+  return sum;
+}
+
+// Operator Overloads
+template <typename T> CDS_VectorView<T> CDS_Matrix<T>::operator[](int rowIndex) {
+  return this->GetRow(rowIndex);
+}
+
+template <typename T>
+CDS_VectorView<const T> CDS_Matrix<T>::operator[](int rowIndex) const {
+  return this->GetRow(rowIndex);
+}
+
+template <typename T>
+T &CDS_Matrix<T>::operator[](std::pair<int, int> indices) {
+  this->_Invalidate();
+  assertm(indices.first >= 0 && indices.first < this->_Rows,
+          "Row index out of bounds");
+  assertm(indices.second >= 0 && indices.second < this->_Cols,
+          "Column index out of bounds");
+  return this->_Data[this->_Index(indices.first, indices.second)];
+}
+
+template <typename T>
+const T &CDS_Matrix<T>::operator[](std::pair<int, int> indices) const {
+  assertm(indices.first >= 0 && indices.first < this->_Rows,
+          "Row index out of bounds");
+  assertm(indices.second >= 0 && indices.second < this->_Cols,
+          "Column index out of bounds");
+  return this->_Data[this->_Index(indices.first, indices.second)];
+}
+
+// Is-Member Functions
+template <typename T> bool CDS_Matrix<T>::IsSquare() const {
+  return this->_Rows == this->_Cols;
+}
+
+template <typename T> bool CDS_Matrix<T>::IsNormal() const {
+  if (!this->IsSquare())
+    return false;
+  int n = this->_Rows;
+  CDS_Matrix<T> lhs(n, n), rhs(n, n);
+  _Gemm::Gemm<T>(T(1), this->View(), this->View().Transposed(), T(0),
+                 lhs.View());
+  _Gemm::Gemm<T>(T(1), this->View().Transposed(), this->View(), T(0),
+                 rhs.View());
+
+  // Both products round differently, so floating point input is compared
+  // relative to the largest entry.
+  T scale = T(0);
+  for (std::size_t k = 0; k < lhs._Count(); k++) {
+    scale = std::max(scale, std::abs(lhs._Data[k]));
+  }
+  T tolerance = T(0);
+  if constexpr (std::is_floating_point_v<T>)
+    tolerance = scale * n * 8 * std::numeric_limits<T>::epsilon();
+  for (std::size_t k = 0; k < lhs._Count(); k++) {
+    if (std::abs(lhs._Data[k] - rhs._Data[k]) > tolerance)
+      return false;
+  }
+  return true;
+}
+
+template <typename T> bool CDS_Matrix<T>::IsSymmetric() const {
+  if (!this->IsSquare())
+    return false;
+  for (int i = 0; i < this->_Rows; i++) {
+    for (int j = i + 1; j < this->_Cols; j++) {
+      if (this->_Data[this->_Index(i, j)] != this->_Data[this->_Index(j, i)])
+        return false;
+    }
+  }
+  return true;
+}
+
+template <typename T> bool CDS_Matrix<T>::IsDiagonal() const {
+  for (int i = 0; i < this->_Rows; i++) {
+    for (int j = 0; j < this->_Cols; j++) {
+      if (i != j && this->_Data[this->_Index(i, j)] != T(0))
+        return false;
+    }
+  }
+  return true;
+}
+
+template <typename T> bool CDS_Matrix<T>::IsUpperTriangular() const {
+  for (int i = 0; i < this->_Rows; i++) {
+    for (int j = 0; j < std::min(i, this->_Cols); j++) {
+      if (this->_Data[this->_Index(i, j)] != T(0))
+        return false;
+    }
+  }
+  return true;
+}
+
+template <typename T> bool CDS_Matrix<T>::IsLowerTriangular() const {
+  for (int i = 0; i < this->_Rows; i++) {
+    for (int j = i + 1; j < this->_Cols; j++) {
+      if (this->_Data[this->_Index(i, j)] != T(0))
+        return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool CDS_Matrix<T>::IsAddable(const CDS_Matrix<T> &other) const {
+  return this->_Rows == other._Rows && this->_Cols == other._Cols;
+}
+
+template <typename T>
+bool CDS_Matrix<T>::IsMultipliable(const CDS_Matrix<T> &other) const {
+  return this->_Cols == other._Rows;
+}
+
+// Factorizations
+template <typename T> T CDS_Matrix<T>::Determinant() const {
+  assertm(this->IsSquare(), "Determinant is only defined for square matrices");
+  _Scalar det = _Factor::LuDeterminant(*this->_GetLU());
+  if constexpr (std::is_integral_v<T>) {
+    return static_cast<T>(std::llround(det));
+  } else {
+    return det;
+  }
+}
+
+template <typename T> void CDS_Matrix<T>::Inverse() {
+  assertm(this->IsSquare(), "Inverse is only defined for square matrices");
+  std::shared_ptr<const _Factor::LU<_Scalar>> lu = this->_GetLU();
+  assertm(!lu->Singular, "Matrix is singular");
+  *this = _FromColumnMajor(_Factor::LuInverse(*lu), this->_Rows, this->_Cols,
+                           this->_Layout);
+}
+
+template <typename T> bool CDS_Matrix<T>::IsInvertible() const {
+  return this->IsSquare() && !this->_GetLU()->Singular;
+}
+
+template <typename T> int CDS_Matrix<T>::Rank() const {
+  std::shared_ptr<_Cache> cache = this->_GetCache();
+  std::lock_guard<std::mutex> lock(cache->Mutex);
+  if (cache->Rank < 0) {
+    cache->Rank =
+        _Factor::PivotedRank(this->_ColumnMajor(), this->_Rows, this->_Cols);
+  }
+  return cache->Rank;
+}
+
+template <typename T> int CDS_Matrix<T>::Nullity() const {
+  return this->_Cols - this->Rank();
+}
+
+template <typename T>
+std::pair<CDS_Matrix<T>, CDS_Matrix<T>>
+CDS_Matrix<T>::Decompose(Order order) const {
+  static_assert(!std::is_integral_v<T>,
+                "Decompose needs floating-point or complex elements");
+  const int m = this->_Rows;
+  const int n = this->_Cols;
+
+  if (order == Order::QR) {
+    std::shared_ptr<const _Factor::QR<_Scalar>> qr = this->_GetQR();
+    return {_FromColumnMajor(_Factor::QrFormQ(*qr), m, m, this->_Layout),
+            _FromColumnMajor(_Factor::QrFormR(*qr), m, n, this->_Layout)};
+  }
+
+  // With P the exchange matrix, (P * A)^H = Q' * R' gives
+  // A = (P * R'^H * P) * (P * Q'^H), an upper triangular times a unitary
+  // factor.
+  std::vector<_Scalar> flipped(static_cast<std::size_t>(n) * m);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      flipped[j + static_cast<std::size_t>(i) * n] = _Factor::_Conj(
+          static_cast<_Scalar>(this->_Data[this->_Index(m - 1 - i, j)]));
+    }
+  }
+  _Factor::QR<_Scalar> qr = _Factor::QrFactor(std::move(flipped), n, m);
+  std::vector<_Scalar> q = _Factor::QrFormQ(qr);
+  std::vector<_Scalar> r = _Factor::QrFormR(qr);
+
+  CDS_Matrix<T> outR(m, n, this->_Layout);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      outR._Data[outR._Index(i, j)] = _Factor::_Conj(
+          r[(n - 1 - j) + static_cast<std::size_t>(m - 1 - i) * n]);
+    }
+  }
+  CDS_Matrix<T> outQ(n, n, this->_Layout);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      outQ._Data[outQ._Index(i, j)] =
+          _Factor::_Conj(q[j + static_cast<std::size_t>(n - 1 - i) * n]);
+    }
+  }
+  return {std::move(outR), std::move(outQ)};
+}
+
+template <typename T>
+CDS_Result<std::vector<typename CDS_Matrix<T>::Complex>>
+CDS_Matrix<T>::Eigenvals() const {
+  auto solved = this->_GetSpectrum(false);
+  if (solved.IsError())
+    return CDS_Result<std::vector<Complex>>::Failure(solved.ErrorMessage);
+  return CDS_Result<std::vector<Complex>>::Success(solved.Unpack()->Values);
+}
+
+template <typename T>
+CDS_Result<CDS_Matrix<typename CDS_Matrix<T>::Complex>>
+CDS_Matrix<T>::Eigenvecs() const {
+  auto solved = this->_GetSpectrum(true);
+  if (solved.IsError())
+    return CDS_Result<CDS_Matrix<Complex>>::Failure(solved.ErrorMessage);
+  const auto &spectrum = solved.Unpack();
+  CDS_Matrix<Complex> out(this->_Rows, this->_Cols,
+                          CDS_Matrix<Complex>::Layout::ColMajor);
+  std::copy(spectrum->Vectors.begin(), spectrum->Vectors.end(),
+            out.GetData());
+  if (this->_Layout == Layout::RowMajor)
+    out.SetLayout(CDS_Matrix<Complex>::Layout::RowMajor);
+  return CDS_Result<CDS_Matrix<Complex>>::Success(out);
+}
+
+// Factorization Cache
+template <typename T>
+std::shared_ptr<typename CDS_Matrix<T>::_Cache>
+CDS_Matrix<T>::_GetCache() const {
+  std::shared_ptr<_Cache> cache = this->_Factors.load();
+  if (cache)
+    return cache;
+  std::shared_ptr<_Cache> fresh = std::make_shared<_Cache>();
+  // Raised before the cache is published, so whoever sees the cache also
+  // sees the flag.
+  this->_HasFactors.store(true, std::memory_order_relaxed);
+  // On failure another thread installed its cache first and cache holds it.
+  if (this->_Factors.compare_exchange_strong(cache, fresh))
+    return fresh;
+  return cache;
+}
+
+template <typename T>
+void CDS_Matrix<T>::_SetFactors(std::shared_ptr<_Cache> factors) {
+  this->_HasFactors.store(factors != nullptr, std::memory_order_relaxed);
+  this->_Factors.store(std::move(factors));
+}
+
+template <typename T> void CDS_Matrix<T>::_Invalidate() {
+  // A matrix being modified has no concurrent readers, so a relaxed load of
+  // the flag is enough and the atomic pointer is left alone when empty.
+  if (this->_HasFactors.load(std::memory_order_relaxed))
+    this->_SetFactors(nullptr);
+}
+
+template <typename T>
+std::shared_ptr<const _Factor::LU<typename CDS_Matrix<T>::_Scalar>>
+CDS_Matrix<T>::_GetLU() const {
+  std::shared_ptr<_Cache> cache = this->_GetCache();
+  std::lock_guard<std::mutex> lock(cache->Mutex);
+  if (!cache->Lu) {
+    cache->Lu = std::make_shared<const _Factor::LU<_Scalar>>(
+        _Factor::LuFactor(this->_ColumnMajor(), this->_Rows));
+  }
+  return cache->Lu;
+}
+
+template <typename T>
+std::shared_ptr<const _Factor::QR<typename CDS_Matrix<T>::_Scalar>>
+CDS_Matrix<T>::_GetQR() const {
+  std::shared_ptr<_Cache> cache = this->_GetCache();
+  std::lock_guard<std::mutex> lock(cache->Mutex);
+  if (!cache->Qr) {
+    cache->Qr = std::make_shared<const _Factor::QR<_Scalar>>(
+        _Factor::QrFactor(this->_ColumnMajor(), this->_Rows, this->_Cols));
+  }
+  return cache->Qr;
+}
+
+template <typename T>
+CDS_Result<std::shared_ptr<const _Factor::Spectrum<
+    _Factor::Real<typename CDS_Matrix<T>::_Scalar>>>>
+CDS_Matrix<T>::_GetSpectrum(bool vectors) const {
+  using Spectrum = _Factor::Spectrum<_Factor::Real<_Scalar>>;
+  using Result = CDS_Result<std::shared_ptr<const Spectrum>>;
+  static_assert(std::is_arithmetic_v<T>,
+                "Eigen decomposition needs real elements");
+  assertm(this->IsSquare(), "Eigenvalues need a square matrix");
+  std::shared_ptr<_Cache> cache = this->_GetCache();
+  std::lock_guard<std::mutex> lock(cache->Mutex);
+  if (!cache->Eigen || (vectors && cache->Eigen->Vectors.empty() &&
+                        this->_Rows > 0)) {
+    std::vector<_Scalar> data = this->_ColumnMajor();
+    CDS_Result<Spectrum> solved =
+        this->IsSymmetric()
+            ? _Factor::SymmetricEigen(std::move(data), this->_Rows, vectors)
+            : _Factor::GeneralEigen(std::move(data), this->_Rows, vectors);
+    // A failure is not cached, the matrix is not expected to be asked again.
+    if (solved.IsError())
+      return Result::Failure(solved.ErrorMessage);
+    cache->Eigen = std::make_shared<const Spectrum>(std::move(solved.Unpack()));
+  }
+  return Result::Success(cache->Eigen);
+}
+
+template <typename T>
+std::vector<typename CDS_Matrix<T>::_Scalar>
+CDS_Matrix<T>::_ColumnMajor() const {
+  std::vector<_Scalar> out(this->_Count());
+  for (int j = 0; j < this->_Cols; j++) {
+    for (int i = 0; i < this->_Rows; i++) {
+      out[static_cast<std::size_t>(j) * this->_Rows + i] =
+          static_cast<_Scalar>(this->_Data[this->_Index(i, j)]);
+    }
+  }
+  return out;
+}
+
+template <typename T>
+CDS_Matrix<T> CDS_Matrix<T>::_FromColumnMajor(const std::vector<_Scalar> &data,
+                                              int rows, int cols,
+                                              Layout layout) {
+  CDS_Matrix<T> out(rows, cols, layout);
+  for (int j = 0; j < cols; j++) {
+    for (int i = 0; i < rows; i++) {
+      const _Scalar &value = data[static_cast<std::size_t>(j) * rows + i];
+      if constexpr (std::is_integral_v<T>) {
+        out._Data[out._Index(i, j)] = static_cast<T>(std::llround(value));
+      } else {
+        out._Data[out._Index(i, j)] = value;
+      }
+    }
+  }
+  return out;
+}
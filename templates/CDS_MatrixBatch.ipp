@@ -0,0 +1,433 @@
+#pragma once
+#include "CDS_MatrixBatch.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+namespace _Batch {
+
+// The lane loops of the elimination read and write planes of one scratch
+// buffer, the restrict qualifiers let them vectorize without alias checks.
+
+template <class S>
+void _Update(S *__restrict target, const S *__restrict source,
+             const S *__restrict factor) {
+  for (int b = 0; b < _LANES; b++) {
+    target[b] -= factor[b] * source[b];
+  }
+}
+
+template <class S>
+void _Exchange(S *__restrict top, S *__restrict row,
+               const int *__restrict pivot, int i) {
+  for (int b = 0; b < _LANES; b++) {
+    bool swap = pivot[b] == i;
+    S upper = top[b];
+    top[b] = swap ? row[b] : upper;
+    row[b] = swap ? upper : row[b];
+  }
+}
+
+template <class S>
+void _Eliminate(S *work, int n, int width, bool full, S *det) {
+  using R = _Factor::Real<S>;
+  auto plane = [&](int i, int j) {
+    return work + (static_cast<std::size_t>(i) * width + j) * _LANES;
+  };
+  int pivot[_LANES];
+  R best[_LANES];
+  S scale[_LANES];
+  S factor[_LANES];
+  for (int b = 0; b < _LANES; b++) {
+    det[b] = S(1);
+  }
+
+  for (int k = 0; k < n; k++) {
+    // Pivot search, branch-free so it vectorizes across the matrices.
+    S *diag = plane(k, k);
+    for (int b = 0; b < _LANES; b++) {
+      pivot[b] = k;
+      best[b] = std::abs(diag[b]);
+    }
+    for (int i = k + 1; i < n; i++) {
+      const S *col = plane(i, k);
+      for (int b = 0; b < _LANES; b++) {
+        R value = std::abs(col[b]);
+        bool larger = value > best[b];
+        best[b] = larger ? value : best[b];
+        pivot[b] = larger ? i : pivot[b];
+      }
+    }
+    // Every matrix swaps row k with its own pivot row. Blending row k with
+    // each candidate row under a mask keeps the swap vectorized, at the same
+    // cost as eliminating that row.
+    for (int i = k + 1; i < n; i++) {
+      for (int j = k; j < width; j++) {
+        _Exchange(plane(k, j), plane(i, j), pivot, i);
+      }
+    }
+    for (int b = 0; b < _LANES; b++) {
+      det[b] = pivot[b] == k ? det[b] : -det[b];
+    }
+    // A zero pivot makes the determinant zero. Inverses of such matrices are
+    // left to run into infinities, determinants must not turn into NaN.
+    for (int b = 0; b < _LANES; b++) {
+      det[b] *= diag[b];
+      scale[b] = full || diag[b] != S(0) ? S(1) / diag[b] : S(0);
+    }
+
+    if (full) {
+      for (int j = k; j < width; j++) {
+        S *row = plane(k, j);
+        for (int b = 0; b < _LANES; b++) {
+          row[b] *= scale[b];
+        }
+      }
+    }
+    for (int i = full ? 0 : k + 1; i < n; i++) {
+      if (i == k)
+        continue;
+      const S *col = plane(i, k);
+      for (int b = 0; b < _LANES; b++) {
+        factor[b] = full ? col[b] : col[b] * scale[b];
+      }
+      for (int j = full ? k : k + 1; j < width; j++) {
+        _Update(plane(i, j), plane(k, j), factor);
+      }
+    }
+  }
+}
+
+} // namespace _Batch
+
+// Memory
+template <typename T> T *CDS_MatrixBatch<T>::_Allocate(std::size_t count) {
+  if (count == 0)
+    return nullptr;
+  T *data = static_cast<T *>(::operator new(
+      count * sizeof(T), std::align_val_t(CDS_MatrixBatch<T>::Alignment)));
+  std::uninitialized_value_construct_n(data, count);
+  return data;
+}
+
+template <typename T>
+void CDS_MatrixBatch<T>::_Release(T *data, std::size_t count) {
+  if (!data)
+    return;
+  std::destroy_n(data, count);
+  ::operator delete(data, count * sizeof(T),
+                    std::align_val_t(CDS_MatrixBatch<T>::Alignment));
+}
+
+template <typename T> std::size_t CDS_MatrixBatch<T>::_Size() const {
+  return static_cast<std::size_t>(this->_Rows) * this->_Cols * this->_Stride;
+}
+
+template <typename T> T *CDS_MatrixBatch<T>::_Plane(int row, int col) const {
+  return this->_Data +
+         (static_cast<std::size_t>(row) * this->_Cols + col) * this->_Stride;
+}
+
+// Constructors
+template <typename T>
+CDS_MatrixBatch<T>::CDS_MatrixBatch(int count, int rows, int cols)
+    : _Count(count), _Rows(rows), _Cols(cols) {
+  assertm(count >= 0 && rows >= 0 && cols >= 0,
+          "Batch dimensions must be non-negative");
+  // Whole groups of lanes, so the kernels never need a remainder loop, and
+  // whole cache lines, so every plane starts aligned.
+  std::size_t line = Alignment % sizeof(T) == 0 ? Alignment / sizeof(T) : 1;
+  std::size_t multiple = std::max<std::size_t>(_Batch::_LANES, line);
+  this->_Stride = (static_cast<std::size_t>(count) + multiple - 1) / multiple *
+                  multiple;
+  this->_Data = _Allocate(this->_Size());
+}
+
+template <typename T>
+CDS_MatrixBatch<T>::CDS_MatrixBatch(const std::vector<CDS_Matrix<T>> &matrices)
+    : CDS_MatrixBatch(static_cast<int>(matrices.size()),
+                      matrices.empty() ? 0 : std::get<0>(matrices[0].GetShape()),
+                      matrices.empty() ? 0
+                                       : std::get<1>(matrices[0].GetShape())) {
+  for (int index = 0; index < this->_Count; index++) {
+    this->Set(index, matrices[index]);
+  }
+}
+
+template <typename T>
+CDS_MatrixBatch<T>::CDS_MatrixBatch(const CDS_MatrixBatch<T> &other)
+    : _Count(other._Count), _Rows(other._Rows), _Cols(other._Cols),
+      _Stride(other._Stride) {
+  this->_Data = _Allocate(this->_Size());
+  std::copy(other._Data, other._Data + other._Size(), this->_Data);
+}
+
+template <typename T>
+CDS_MatrixBatch<T>::CDS_MatrixBatch(CDS_MatrixBatch<T> &&other) noexcept
+    : _Data(std::exchange(other._Data, nullptr)), _Count(other._Count),
+      _Rows(other._Rows), _Cols(other._Cols), _Stride(other._Stride) {
+  other._Count = other._Rows = other._Cols = 0;
+  other._Stride = 0;
+}
+
+template <typename T>
+CDS_MatrixBatch<T> &
+CDS_MatrixBatch<T>::operator=(const CDS_MatrixBatch<T> &other) {
+  if (this == &other)
+    return *this;
+  if (this->_Size() != other._Size()) {
+    _Release(this->_Data, this->_Size());
+    this->_Data = _Allocate(other._Size());
+  }
+  this->_Count = other._Count;
+  this->_Rows = other._Rows;
+  this->_Cols = other._Cols;
+  this->_Stride = other._Stride;
+  std::copy(other._Data, other._Data + other._Size(), this->_Data);
+  return *this;
+}
+
+template <typename T>
+CDS_MatrixBatch<T> &
+CDS_MatrixBatch<T>::operator=(CDS_MatrixBatch<T> &&other) noexcept {
+  if (this == &other)
+    return *this;
+  _Release(this->_Data, this->_Size());
+  this->_Data = std::exchange(other._Data, nullptr);
+  this->_Count = std::exchange(other._Count, 0);
+  this->_Rows = std::exchange(other._Rows, 0);
+  this->_Cols = std::exchange(other._Cols, 0);
+  this->_Stride = std::exchange(other._Stride, 0);
+  return *this;
+}
+
+template <typename T> CDS_MatrixBatch<T>::~CDS_MatrixBatch() {
+  _Release(this->_Data, this->_Size());
+}
+
+// Access
+template <typename T> int CDS_MatrixBatch<T>::GetCount() const {
+  return this->_Count;
+}
+
+template <typename T>
+std::tuple<int, int> CDS_MatrixBatch<T>::GetShape() const {
+  return {this->_Rows, this->_Cols};
+}
+
+template <typename T> std::ptrdiff_t CDS_MatrixBatch<T>::GetStride() const {
+  return static_cast<std::ptrdiff_t>(this->_Stride);
+}
+
+template <typename T> T *CDS_MatrixBatch<T>::GetData() { return this->_Data; }
+
+template <typename T> const T *CDS_MatrixBatch<T>::GetData() const {
+  return this->_Data;
+}
+
+template <typename T>
+CDS_MatrixView<T> CDS_MatrixBatch<T>::operator[](int index) {
+  assertm(index >= 0 && index < this->_Count, "Index out of range");
+  std::ptrdiff_t stride = this->GetStride();
+  return CDS_MatrixView<T>(this->_Data + index, this->_Rows, this->_Cols,
+                           stride * this->_Cols, stride);
+}
+
+template <typename T>
+CDS_MatrixView<const T> CDS_MatrixBatch<T>::operator[](int index) const {
+  assertm(index >= 0 && index < this->_Count, "Index out of range");
+  std::ptrdiff_t stride = this->GetStride();
+  return CDS_MatrixView<const T>(this->_Data + index, this->_Rows,
+                                 this->_Cols, stride * this->_Cols, stride);
+}
+
+template <typename T>
+CDS_VectorView<T> CDS_MatrixBatch<T>::GetElement(int row, int col) {
+  assertm(row >= 0 && row < this->_Rows && col >= 0 && col < this->_Cols,
+          "Index out of range");
+  return CDS_VectorView<T>(this->_Plane(row, col), this->_Count, 1);
+}
+
+template <typename T>
+CDS_VectorView<const T> CDS_MatrixBatch<T>::GetElement(int row,
+                                                       int col) const {
+  assertm(row >= 0 && row < this->_Rows && col >= 0 && col < this->_Cols,
+          "Index out of range");
+  return CDS_VectorView<const T>(this->_Plane(row, col), this->_Count, 1);
+}
+
+template <typename T> CDS_Matrix<T> CDS_MatrixBatch<T>::Get(int index) const {
+  return CDS_Matrix<T>((*this)[index]);
+}
+
+template <typename T>
+void CDS_MatrixBatch<T>::Set(int index, const CDS_Matrix<T> &matrix) {
+  assertm(index >= 0 && index < this->_Count, "Index out of range");
+  assertm(matrix.GetShape() == this->GetShape(),
+          "Matrix shape does not match the batch");
+  for (int i = 0; i < this->_Rows; i++) {
+    for (int j = 0; j < this->_Cols; j++) {
+      this->_Plane(i, j)[index] = matrix[{i, j}];
+    }
+  }
+}
+
+// Batched operations
+template <typename T>
+template <class F>
+void CDS_MatrixBatch<T>::_ForTasks(std::size_t work, F &&body) const {
+  std::size_t tasks =
+      (static_cast<std::size_t>(this->_Count) + _Batch::_TASK - 1) /
+      _Batch::_TASK;
+  CDS_ThreadPool::Instance().ParallelFor(tasks, work, [&](std::size_t task) {
+    int begin = static_cast<int>(task) * _Batch::_TASK;
+    body(begin, std::min(this->_Count, begin + _Batch::_TASK));
+  });
+}
+
+template <typename T>
+CDS_MatrixBatch<T>
+CDS_MatrixBatch<T>::operator*(const CDS_MatrixBatch<T> &other) const {
+  assertm(this->IsMultipliable(other),
+          "Batch dimensions do not allow multiplication");
+  CDS_MatrixBatch<T> out(this->_Count, this->_Rows, other._Cols);
+  std::size_t work = this->_Size() * other._Cols;
+
+  // Tasks start on lane boundaries and planes are padded to whole groups,
+  // so every group runs all _LANES lanes.
+  this->_ForTasks(work, [&](int begin, int end) {
+    T sum[_Batch::_LANES];
+    for (int b0 = begin; b0 < end; b0 += _Batch::_LANES) {
+      for (int i = 0; i < this->_Rows; i++) {
+        for (int j = 0; j < other._Cols; j++) {
+          std::fill(sum, sum + _Batch::_LANES, T(0));
+          for (int k = 0; k < this->_Cols; k++) {
+            const T *a = this->_Plane(i, k) + b0;
+            const T *b = other._Plane(k, j) + b0;
+            for (int lane = 0; lane < _Batch::_LANES; lane++) {
+              sum[lane] += a[lane] * b[lane];
+            }
+          }
+          std::copy(sum, sum + _Batch::_LANES, out._Plane(i, j) + b0);
+        }
+      }
+    }
+  });
+  return out;
+}
+
+template <typename T> void CDS_MatrixBatch<T>::Transpose() {
+  if (this->IsSquare()) {
+    for (int i = 0; i < this->_Rows; i++) {
+      for (int j = i + 1; j < this->_Cols; j++) {
+        std::swap_ranges(this->_Plane(i, j), this->_Plane(i, j) + this->_Stride,
+                         this->_Plane(j, i));
+      }
+    }
+    return;
+  }
+  // Transposing moves whole planes, no element changes its plane offset.
+  CDS_MatrixBatch<T> out(this->_Count, this->_Cols, this->_Rows);
+  for (int i = 0; i < this->_Rows; i++) {
+    for (int j = 0; j < this->_Cols; j++) {
+      std::copy(this->_Plane(i, j), this->_Plane(i, j) + this->_Stride,
+                out._Plane(j, i));
+    }
+  }
+  *this = std::move(out);
+}
+
+template <typename T> void CDS_MatrixBatch<T>::Inverse() {
+  assertm(this->IsSquare(), "Inverse is only defined for square matrices");
+  int n = this->_Rows;
+  std::size_t work = this->_Size() * n;
+
+  this->_ForTasks(work, [&](int begin, int end) {
+    // [A | I] per matrix, reduced to [I | A^-1].
+    std::vector<_Scalar> scratch(static_cast<std::size_t>(2) * n * n *
+                                 _Batch::_LANES);
+    _Scalar det[_Batch::_LANES];
+    auto plane = [&](int i, int j) {
+      return scratch.data() +
+             (static_cast<std::size_t>(i) * 2 * n + j) * _Batch::_LANES;
+    };
+    for (int b0 = begin; b0 < end; b0 += _Batch::_LANES) {
+      int lanes = std::min(_Batch::_LANES, end - b0);
+      for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+          const T *source = this->_Plane(i, j) + b0;
+          _Scalar *left = plane(i, j);
+          _Scalar *right = plane(i, n + j);
+          // Unused lanes hold the identity so they stay finite.
+          for (int b = 0; b < _Batch::_LANES; b++) {
+            left[b] = b < lanes ? static_cast<_Scalar>(source[b])
+                                : _Scalar(i == j);
+            right[b] = _Scalar(i == j);
+          }
+        }
+      }
+      _Batch::_Eliminate(scratch.data(), n, 2 * n, true, det);
+      for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+          const _Scalar *result = plane(i, n + j);
+          T *target = this->_Plane(i, j) + b0;
+          for (int b = 0; b < lanes; b++) {
+            target[b] = static_cast<T>(result[b]);
+          }
+        }
+      }
+    }
+  });
+}
+
+template <typename T> std::vector<T> CDS_MatrixBatch<T>::Determinant() const {
+  assertm(this->IsSquare(), "Determinant is only defined for square matrices");
+  int n = this->_Rows;
+  std::vector<T> out(this->_Count);
+  std::size_t work = this->_Size() * n;
+
+  this->_ForTasks(work, [&](int begin, int end) {
+    std::vector<_Scalar> scratch(static_cast<std::size_t>(n) * n *
+                                 _Batch::_LANES);
+    _Scalar det[_Batch::_LANES];
+    for (int b0 = begin; b0 < end; b0 += _Batch::_LANES) {
+      int lanes = std::min(_Batch::_LANES, end - b0);
+      for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+          const T *source = this->_Plane(i, j) + b0;
+          _Scalar *target =
+              scratch.data() +
+              (static_cast<std::size_t>(i) * n + j) * _Batch::_LANES;
+          for (int b = 0; b < _Batch::_LANES; b++) {
+            target[b] = static_cast<_Scalar>(source[b]);
+          }
+        }
+      }
+      _Batch::_Eliminate(scratch.data(), n, n, false, det);
+      for (int b = 0; b < lanes; b++) {
+        if constexpr (std::is_integral_v<T>) {
+          out[b0 + b] = static_cast<T>(std::llround(det[b]));
+        } else {
+          out[b0 + b] = det[b];
+        }
+      }
+    }
+  });
+  return out;
+}
+
+// Definition of is-Member functions
+template <typename T> bool CDS_MatrixBatch<T>::IsSquare() const {
+  return this->_Rows == this->_Cols;
+}
+
+template <typename T>
+bool CDS_MatrixBatch<T>::IsMultipliable(const CDS_MatrixBatch<T> &other) const {
+  return this->_Count == other._Count && this->_Cols == other._Rows;
+}
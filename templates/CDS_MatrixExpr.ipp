@@ -0,0 +1,193 @@
+#pragma once
+#include "CDS_MatrixExpr.hpp"
+#include <cassert>
+#include <tuple>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+namespace _Expr {
+
+// Matrix Reference
+template <class T>
+_MatrixRef<T>::_MatrixRef(const CDS_Matrix<T> &matrix) : _Matrix(&matrix) {}
+
+template <class T> int _MatrixRef<T>::Rows() const {
+  return std::get<0>(this->_Matrix->GetShape());
+}
+
+template <class T> int _MatrixRef<T>::Cols() const {
+  return std::get<1>(this->_Matrix->GetShape());
+}
+
+template <class T>
+typename CDS_Matrix<T>::Layout _MatrixRef<T>::GetLayout() const {
+  return this->_Matrix->GetLayout();
+}
+
+template <class T> T _MatrixRef<T>::At(int row, int col) const {
+  return this->_Matrix->GetData()[row * this->_Matrix->GetRowStride() +
+                                  col * this->_Matrix->GetColumnStride()];
+}
+
+template <class T> T _MatrixRef<T>::Linear(std::size_t index) const {
+  return this->_Matrix->GetData()[index];
+}
+
+template <class T>
+bool _MatrixRef<T>::IsUniform(typename CDS_Matrix<T>::Layout layout) const {
+  return this->_Matrix->GetLayout() == layout;
+}
+
+template <class T> bool _MatrixRef<T>::Aliases(const T *data) const {
+  return data != nullptr && this->_Matrix->GetData() == data;
+}
+
+// Owned Matrix
+template <class T>
+_MatrixOwn<T>::_MatrixOwn(CDS_Matrix<T> &&matrix)
+    : _Matrix(std::move(matrix)) {}
+
+template <class T> int _MatrixOwn<T>::Rows() const {
+  return std::get<0>(this->_Matrix.GetShape());
+}
+
+template <class T> int _MatrixOwn<T>::Cols() const {
+  return std::get<1>(this->_Matrix.GetShape());
+}
+
+template <class T>
+typename CDS_Matrix<T>::Layout _MatrixOwn<T>::GetLayout() const {
+  return this->_Matrix.GetLayout();
+}
+
+template <class T> T _MatrixOwn<T>::At(int row, int col) const {
+  return this->_Matrix.GetData()[row * this->_Matrix.GetRowStride() +
+                                 col * this->_Matrix.GetColumnStride()];
+}
+
+template <class T> T _MatrixOwn<T>::Linear(std::size_t index) const {
+  return this->_Matrix.GetData()[index];
+}
+
+template <class T>
+bool _MatrixOwn<T>::IsUniform(typename CDS_Matrix<T>::Layout layout) const {
+  return this->_Matrix.GetLayout() == layout;
+}
+
+template <class T> bool _MatrixOwn<T>::Aliases(const T *) const {
+  return false;
+}
+
+// Binary Node
+template <class L, class R, class Op>
+_Binary<L, R, Op>::_Binary(L lhs, R rhs)
+    : _Lhs(std::move(lhs)), _Rhs(std::move(rhs)) {
+  assertm(this->_Lhs.Rows() == this->_Rhs.Rows() &&
+              this->_Lhs.Cols() == this->_Rhs.Cols(),
+          "Matrix shapes do not match");
+}
+
+template <class L, class R, class Op> int _Binary<L, R, Op>::Rows() const {
+  return this->_Lhs.Rows();
+}
+
+template <class L, class R, class Op> int _Binary<L, R, Op>::Cols() const {
+  return this->_Lhs.Cols();
+}
+
+template <class L, class R, class Op>
+typename CDS_Matrix<typename _Binary<L, R, Op>::value_type>::Layout
+_Binary<L, R, Op>::GetLayout() const {
+  return this->_Lhs.GetLayout();
+}
+
+template <class L, class R, class Op>
+typename _Binary<L, R, Op>::value_type _Binary<L, R, Op>::At(int row,
+                                                             int col) const {
+  return Op()(this->_Lhs.At(row, col), this->_Rhs.At(row, col));
+}
+
+template <class L, class R, class Op>
+typename _Binary<L, R, Op>::value_type
+_Binary<L, R, Op>::Linear(std::size_t index) const {
+  return Op()(this->_Lhs.Linear(index), this->_Rhs.Linear(index));
+}
+
+template <class L, class R, class Op>
+bool _Binary<L, R, Op>::IsUniform(
+    typename CDS_Matrix<value_type>::Layout layout) const {
+  return this->_Lhs.IsUniform(layout) && this->_Rhs.IsUniform(layout);
+}
+
+template <class L, class R, class Op>
+bool _Binary<L, R, Op>::Aliases(const value_type *data) const {
+  return this->_Lhs.Aliases(data) || this->_Rhs.Aliases(data);
+}
+
+// Scaled Node
+template <class E>
+_Scaled<E>::_Scaled(value_type scalar, E expr)
+    : _Scalar(scalar), _Expr(std::move(expr)) {}
+
+template <class E> int _Scaled<E>::Rows() const { return this->_Expr.Rows(); }
+
+template <class E> int _Scaled<E>::Cols() const { return this->_Expr.Cols(); }
+
+template <class E>
+typename CDS_Matrix<typename _Scaled<E>::value_type>::Layout
+_Scaled<E>::GetLayout() const {
+  return this->_Expr.GetLayout();
+}
+
+template <class E>
+typename _Scaled<E>::value_type _Scaled<E>::At(int row, int col) const {
+  return this->_Scalar * this->_Expr.At(row, col);
+}
+
+template <class E>
+typename _Scaled<E>::value_type
+_Scaled<E>::Linear(std::size_t index) const {
+  return this->_Scalar * this->_Expr.Linear(index);
+}
+
+template <class E>
+bool _Scaled<E>::IsUniform(
+    typename CDS_Matrix<value_type>::Layout layout) const {
+  return this->_Expr.IsUniform(layout);
+}
+
+template <class E> bool _Scaled<E>::Aliases(const value_type *data) const {
+  return this->_Expr.Aliases(data);
+}
+
+// Storing Operands
+template <class X> typename _Stored<X>::type _Store(X &&operand) {
+  return typename _Stored<X>::type(std::forward<X>(operand));
+}
+
+} // namespace _Expr
+
+// Operators
+template <_Expr::Operand L, _Expr::Operand R>
+auto operator+(L &&lhs, R &&rhs) {
+  using Lhs = typename _Expr::_Stored<L>::type;
+  using Rhs = typename _Expr::_Stored<R>::type;
+  return _Expr::_Binary<Lhs, Rhs, _Expr::_Plus>(
+      _Expr::_Store(std::forward<L>(lhs)), _Expr::_Store(std::forward<R>(rhs)));
+}
+
+template <_Expr::Operand L, _Expr::Operand R>
+auto operator-(L &&lhs, R &&rhs) {
+  using Lhs = typename _Expr::_Stored<L>::type;
+  using Rhs = typename _Expr::_Stored<R>::type;
+  return _Expr::_Binary<Lhs, Rhs, _Expr::_Minus>(
+      _Expr::_Store(std::forward<L>(lhs)), _Expr::_Store(std::forward<R>(rhs)));
+}
+
+template <_Expr::Operand E>
+auto operator*(typename _Expr::_Stored<E>::type::value_type scalar,
+               E &&operand) {
+  using Stored = typename _Expr::_Stored<E>::type;
+  return _Expr::_Scaled<Stored>(scalar,
+                                _Expr::_Store(std::forward<E>(operand)));
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include "CDS_MatrixFile.hpp"
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+namespace _File {
+
+template <class T> constexpr DType DTypeOf() {
+  if constexpr (std::is_same_v<T, std::int8_t>)
+    return DType::Int8;
+  else if constexpr (std::is_same_v<T, std::uint8_t>)
+    return DType::UInt8;
+  else if constexpr (std::is_same_v<T, std::int16_t>)
+    return DType::Int16;
+  else if constexpr (std::is_same_v<T, std::uint16_t>)
+    return DType::UInt16;
+  else if constexpr (std::is_same_v<T, std::int32_t>)
+    return DType::Int32;
+  else if constexpr (std::is_same_v<T, std::uint32_t>)
+    return DType::UInt32;
+  else if constexpr (std::is_same_v<T, std::int64_t>)
+    return DType::Int64;
+  else if constexpr (std::is_same_v<T, std::uint64_t>)
+    return DType::UInt64;
+  else if constexpr (std::is_same_v<T, float>)
+    return DType::Float32;
+  else if constexpr (std::is_same_v<T, double>)
+    return DType::Float64;
+  else if constexpr (std::is_same_v<T, std::complex<float>>)
+    return DType::Complex64;
+  else if constexpr (std::is_same_v<T, std::complex<double>>)
+    return DType::Complex128;
+  else
+    return DType::Other;
+}
+
+} // namespace _File
+
+// CDS_MappedMatrix
+template <typename T>
+CDS_Result<CDS_MappedMatrix<T>>
+CDS_MappedMatrix<T>::Open(const std::string &path) {
+  CDS_Result<std::shared_ptr<const _File::Mapping>> mapping =
+      _File::MapFile(path);
+  if (mapping.IsError())
+    return CDS_Result<CDS_MappedMatrix<T>>::Failure(mapping.ErrorMessage);
+
+  CDS_Result<_File::Header> header =
+      _File::ReadHeader(*mapping.Unpack(), _File::DTypeOf<T>(), sizeof(T));
+  if (header.IsError())
+    return CDS_Result<CDS_MappedMatrix<T>>::Failure(header.ErrorMessage);
+  if (header.Unpack().Alignment % alignof(T) != 0)
+    return CDS_Result<CDS_MappedMatrix<T>>::Failure(
+        "The element data is misaligned for the element type");
+
+  return CDS_Result<CDS_MappedMatrix<T>>::Success(
+      CDS_MappedMatrix<T>(mapping.Unpack(), header.Unpack()));
+}
+
+template <typename T>
+CDS_MappedMatrix<T>::CDS_MappedMatrix(
+    std::shared_ptr<const _File::Mapping> mapping, const _File::Header &header)
+    : _Mapping(std::move(mapping)), _Rows(static_cast<int>(header.Rows)),
+      _Cols(static_cast<int>(header.Cols)),
+      _Layout(header.Layout == 0 ? Layout::RowMajor : Layout::ColMajor) {
+  this->_Data = reinterpret_cast<const T *>(
+      static_cast<const char *>(this->_Mapping->Address) + header.DataOffset);
+}
+
+template <typename T>
+CDS_MatrixView<const T> CDS_MappedMatrix<T>::View() const {
+  bool rowMajor = this->_Layout == Layout::RowMajor;
+  return CDS_MatrixView<const T>(this->_Data, this->_Rows, this->_Cols,
+                                 rowMajor ? this->_Cols : 1,
+                                 rowMajor ? 1 : this->_Rows);
+}
+
+template <typename T> const T *CDS_MappedMatrix<T>::GetData() const {
+  return this->_Data;
+}
+
+template <typename T>
+typename CDS_MappedMatrix<T>::Layout CDS_MappedMatrix<T>::GetLayout() const {
+  return this->_Layout;
+}
+
+template <typename T>
+std::tuple<int, int> CDS_MappedMatrix<T>::GetShape() const {
+  return {this->_Rows, this->_Cols};
+}
+
+// CDS_MatrixWriter
+template <typename T>
+CDS_MatrixWriter<T>::CDS_MatrixWriter(const std::string &path, int rows,
+                                      int cols, Layout layout)
+    : _Count(static_cast<std::size_t>(rows) * cols) {
+  assertm(rows >= 0 && cols >= 0, "Matrix dimensions must be non-negative");
+  this->_Stream = std::fopen(path.c_str(), "wb");
+  if (!this->_Stream) {
+    this->_Error = "Cannot create " + path + ": " + std::strerror(errno);
+    return;
+  }
+  _File::Header header =
+      _File::MakeHeader(_File::DTypeOf<T>(), sizeof(T), rows, cols,
+                        layout == Layout::ColMajor);
+  char padding[CDS_Matrix<T>::Alignment] = {};
+  if (std::fwrite(&header, sizeof(header), 1, this->_Stream) != 1 ||
+      std::fwrite(padding, 1, header.DataOffset - sizeof(header),
+                  this->_Stream) != header.DataOffset - sizeof(header)) {
+    this->_Error = "Cannot write the header of " + path;
+  }
+}
+
+template <typename T> CDS_MatrixWriter<T>::~CDS_MatrixWriter() {
+  if (this->_Stream)
+    std::fclose(this->_Stream);
+}
+
+template <typename T>
+CDS_Result<std::size_t> CDS_MatrixWriter<T>::Write(const T *elements,
+                                                   std::size_t count) {
+  if (!this->_Error.empty())
+    return CDS_Result<std::size_t>::Failure(this->_Error);
+  if (!this->_Stream)
+    return CDS_Result<std::size_t>::Failure("The writer is closed");
+  if (count > this->_Count - this->_Written)
+    return CDS_Result<std::size_t>::Failure(
+        "More elements than the matrix holds");
+  if (std::fwrite(elements, sizeof(T), count, this->_Stream) != count) {
+    this->_Error = std::string("Cannot write elements: ") + std::strerror(errno);
+    return CDS_Result<std::size_t>::Failure(this->_Error);
+  }
+  this->_Written += count;
+  return CDS_Result<std::size_t>::Success(this->_Written);
+}
+
+template <typename T> CDS_Result<std::size_t> CDS_MatrixWriter<T>::Close() {
+  if (!this->_Stream)
+    return CDS_Result<std::size_t>::Failure(
+        this->_Error.empty() ? "The writer is closed" : this->_Error);
+  bool closed = std::fclose(this->_Stream) == 0;
+  this->_Stream = nullptr;
+  if (!this->_Error.empty())
+    return CDS_Result<std::size_t>::Failure(this->_Error);
+  if (!closed)
+    return CDS_Result<std::size_t>::Failure(
+        std::string("Cannot close the file: ") + std::strerror(errno));
+  if (this->_Written != this->_Count)
+    return CDS_Result<std::size_t>::Failure(
+        "Fewer elements were written than the matrix holds");
+  return CDS_Result<std::size_t>::Success(this->_Written);
+}
+
+template <typename T>
+CDS_Result<std::size_t> CDS_MatrixWriter<T>::Save(const std::string &path,
+                                                  const CDS_Matrix<T> &matrix) {
+  auto [rows, cols] = matrix.GetShape();
+  CDS_MatrixWriter<T> writer(path, rows, cols, matrix.GetLayout());
+  CDS_Result<std::size_t> written = writer.Write(
+      matrix.GetData(), static_cast<std::size_t>(rows) * cols);
+  if (written.IsError())
+    return written;
+  return writer.Close();
+}
@@ -0,0 +1,222 @@
+#pragma once
+#include "CDS_MatrixView.hpp"
+#include <algorithm>
+#include <cassert>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+// Vector View Constructors
+template <class T>
+CDS_VectorView<T>::CDS_VectorView(T *data, int size, std::ptrdiff_t stride)
+    : _Data(data), _Size(size), _Stride(stride), _Offsets(nullptr) {}
+
+template <class T>
+CDS_VectorView<T>::CDS_VectorView(T *data, Offsets offsets)
+    : _Data(data), _Size(static_cast<int>(offsets->size())), _Stride(0),
+      _Offsets(std::move(offsets)) {}
+
+template <class T>
+CDS_VectorView<T>::operator CDS_VectorView<const T>() const {
+  if (this->_Offsets)
+    return CDS_VectorView<const T>(this->_Data, this->_Offsets);
+  return CDS_VectorView<const T>(this->_Data, this->_Size, this->_Stride);
+}
+
+// Vector View Getters
+template <class T> int CDS_VectorView<T>::GetSize() const {
+  return this->_Size;
+}
+
+template <class T> std::ptrdiff_t CDS_VectorView<T>::GetStride() const {
+  return this->_Stride;
+}
+
+template <class T> T *CDS_VectorView<T>::GetData() const { return this->_Data; }
+
+template <class T> bool CDS_VectorView<T>::IsStrided() const {
+  return !this->_Offsets;
+}
+
+template <class T> T &CDS_VectorView<T>::operator[](int index) const {
+  assertm(index >= 0 && index < this->_Size, "Index out of bounds");
+  if (this->_Offsets)
+    return this->_Data[(*this->_Offsets)[index]];
+  return this->_Data[index * this->_Stride];
+}
+
+template <class T>
+std::vector<typename CDS_VectorView<T>::value_type>
+CDS_VectorView<T>::ToVector() const {
+  std::vector<value_type> out(this->_Size);
+  for (int i = 0; i < this->_Size; i++) {
+    out[i] = (*this)[i];
+  }
+  return out;
+}
+
+template <class T>
+CDS_VectorView<T>::operator std::vector<value_type>() const {
+  return this->ToVector();
+}
+
+// Matrix View Constructors
+template <class T>
+CDS_MatrixView<T>::CDS_MatrixView(T *data, int rows, int cols,
+                                  std::ptrdiff_t rowStride,
+                                  std::ptrdiff_t colStride)
+    : _Data(data), _Rows(rows), _Cols(cols), _RowStride(rowStride),
+      _ColStride(colStride), _RowOffsets(nullptr), _ColOffsets(nullptr) {}
+
+template <class T>
+CDS_MatrixView<T>::operator CDS_MatrixView<const T>() const {
+  CDS_MatrixView<const T> view(this->_Data, this->_Rows, this->_Cols,
+                               this->_RowStride, this->_ColStride);
+  view._RowOffsets = this->_RowOffsets;
+  view._ColOffsets = this->_ColOffsets;
+  return view;
+}
+
+// Matrix View Getters
+template <class T> std::tuple<int, int> CDS_MatrixView<T>::GetShape() const {
+  return {this->_Rows, this->_Cols};
+}
+
+template <class T> T *CDS_MatrixView<T>::GetData() const { return this->_Data; }
+
+template <class T> std::ptrdiff_t CDS_MatrixView<T>::GetRowStride() const {
+  return this->_RowStride;
+}
+
+template <class T> std::ptrdiff_t CDS_MatrixView<T>::GetColumnStride() const {
+  return this->_ColStride;
+}
+
+template <class T> bool CDS_MatrixView<T>::IsStrided() const {
+  return !this->_RowOffsets && !this->_ColOffsets;
+}
+
+template <class T>
+std::ptrdiff_t CDS_MatrixView<T>::RowOffset(int rowIndex) const {
+  if (this->_RowOffsets)
+    return (*this->_RowOffsets)[rowIndex];
+  return rowIndex * this->_RowStride;
+}
+
+template <class T>
+std::ptrdiff_t CDS_MatrixView<T>::ColumnOffset(int colIndex) const {
+  if (this->_ColOffsets)
+    return (*this->_ColOffsets)[colIndex];
+  return colIndex * this->_ColStride;
+}
+
+template <class T>
+T &CDS_MatrixView<T>::operator[](std::pair<int, int> indices) const {
+  assertm(indices.first >= 0 && indices.first < this->_Rows,
+          "Row index out of bounds");
+  assertm(indices.second >= 0 && indices.second < this->_Cols,
+          "Column index out of bounds");
+  return this->_Data[this->RowOffset(indices.first) +
+                     this->ColumnOffset(indices.second)];
+}
+
+// Sub-views
+template <class T>
+CDS_VectorView<T> CDS_MatrixView<T>::GetRow(int rowIndex) const {
+  assertm(rowIndex >= 0 && rowIndex < this->_Rows, "Row index out of bounds");
+  T *base = this->_Data + this->RowOffset(rowIndex);
+  if (this->_ColOffsets)
+    return CDS_VectorView<T>(base, this->_ColOffsets);
+  return CDS_VectorView<T>(base, this->_Cols, this->_ColStride);
+}
+
+template <class T>
+CDS_VectorView<T> CDS_MatrixView<T>::GetColumn(int colIndex) const {
+  assertm(colIndex >= 0 && colIndex < this->_Cols,
+          "Column index out of bounds");
+  T *base = this->_Data + this->ColumnOffset(colIndex);
+  if (this->_RowOffsets)
+    return CDS_VectorView<T>(base, this->_RowOffsets);
+  return CDS_VectorView<T>(base, this->_Rows, this->_RowStride);
+}
+
+template <class T> CDS_VectorView<T> CDS_MatrixView<T>::GetDiagonal() const {
+  int size = std::min(this->_Rows, this->_Cols);
+  if (this->IsStrided())
+    return CDS_VectorView<T>(this->_Data, size,
+                             this->_RowStride + this->_ColStride);
+
+  auto offsets = std::make_shared<std::vector<std::ptrdiff_t>>(size);
+  for (int i = 0; i < size; i++) {
+    (*offsets)[i] = this->RowOffset(i) + this->ColumnOffset(i);
+  }
+  return CDS_VectorView<T>(this->_Data, std::move(offsets));
+}
+
+template <class T>
+template <class F>
+typename CDS_MatrixView<T>::Offsets
+CDS_MatrixView<T>::_Exclude(int count, std::initializer_list<int> excluded,
+                            F offsetOf) {
+  auto offsets = std::make_shared<std::vector<std::ptrdiff_t>>();
+  offsets->reserve(count);
+  for (int i = 0; i < count; i++) {
+    if (std::find(excluded.begin(), excluded.end(), i) == excluded.end())
+      offsets->push_back(offsetOf(i));
+  }
+  return offsets;
+}
+
+template <class T>
+CDS_MatrixView<T>
+CDS_MatrixView<T>::ExcludeColumns(std::initializer_list<int> colIndices) const {
+  CDS_MatrixView<T> view = *this;
+  view._ColOffsets = _Exclude(this->_Cols, colIndices,
+                              [this](int j) { return this->ColumnOffset(j); });
+  view._Cols = static_cast<int>(view._ColOffsets->size());
+  return view;
+}
+
+template <class T>
+CDS_MatrixView<T>
+CDS_MatrixView<T>::ExcludeRows(std::initializer_list<int> rowIndices) const {
+  CDS_MatrixView<T> view = *this;
+  view._RowOffsets = _Exclude(this->_Rows, rowIndices,
+                              [this](int i) { return this->RowOffset(i); });
+  view._Rows = static_cast<int>(view._RowOffsets->size());
+  return view;
+}
+
+template <class T>
+CDS_MatrixView<T> CDS_MatrixView<T>::Block(int row, int col, int rows,
+                                           int cols) const {
+  assertm(row >= 0 && rows >= 0 && row + rows <= this->_Rows,
+          "Block rows out of bounds");
+  assertm(col >= 0 && cols >= 0 && col + cols <= this->_Cols,
+          "Block columns out of bounds");
+  CDS_MatrixView<T> view = *this;
+  view._Rows = rows;
+  view._Cols = cols;
+  if (this->_RowOffsets) {
+    view._RowOffsets = std::make_shared<std::vector<std::ptrdiff_t>>(
+        this->_RowOffsets->begin() + row,
+        this->_RowOffsets->begin() + row + rows);
+  } else {
+    view._Data += row * this->_RowStride;
+  }
+  if (this->_ColOffsets) {
+    view._ColOffsets = std::make_shared<std::vector<std::ptrdiff_t>>(
+        this->_ColOffsets->begin() + col,
+        this->_ColOffsets->begin() + col + cols);
+  } else {
+    view._Data += col * this->_ColStride;
+  }
+  return view;
+}
+
+template <class T> CDS_MatrixView<T> CDS_MatrixView<T>::Transposed() const {
+  CDS_MatrixView<T> view = *this;
+  std::swap(view._Rows, view._Cols);
+  std::swap(view._RowStride, view._ColStride);
+  std::swap(view._RowOffsets, view._ColOffsets);
+  return view;
+}
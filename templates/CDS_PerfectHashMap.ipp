@@ -0,0 +1,238 @@
+#pragma once
+#include "CDS_PerfectHashMap.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+// Hash arithmetic
+inline std::uint64_t _PerfectHash::_Reduce(std::uint64_t hash,
+                                           std::uint64_t range) {
+  // The high half of hash * range, which is below range.
+  _StringHash::_Multiply(hash, range);
+  return range;
+}
+
+inline std::uint64_t _PerfectHash::_Slot(std::uint64_t hash,
+                                         std::uint32_t seed,
+                                         std::uint64_t count) {
+  return _Reduce(_StringHash::_Fold(hash ^ _StringHash::_SECRET[2],
+                                    seed ^ _StringHash::_SECRET[3]),
+                 count);
+}
+
+// CDS_PerfectHashMap
+template <class K, class V>
+CDS_Result<CDS_PerfectHashMap<K, V>>
+CDS_PerfectHashMap<K, V>::Build(std::span<const K> keys,
+                                std::span<const V> values,
+                                std::uint64_t seed) {
+  using Result = CDS_Result<CDS_PerfectHashMap<K, V>>;
+  assertm(keys.size() == values.size(), "Every key needs one value");
+  std::size_t count = keys.size();
+
+  // Equal hashes are either a key given twice, or a collision that no
+  // bucket seed can separate and that another hash seed most likely will.
+  std::vector<std::uint64_t> hashes(count);
+  std::vector<std::uint64_t> slots(count);
+  std::vector<std::uint32_t> seeds((count + _PerfectHash::_BUCKET_SIZE - 1) /
+                                   _PerfectHash::_BUCKET_SIZE);
+  std::vector<std::size_t> order(count);
+  bool found = false;
+  for (std::size_t attempt = 0; attempt < 8 && !found; attempt++, seed++) {
+    for (std::size_t i = 0; i < count; i++) {
+      std::string_view bytes = Bytes(keys[i]);
+      hashes[i] = CDS_HashBytes(bytes.data(), bytes.size(), seed);
+    }
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+      return hashes[a] < hashes[b];
+    });
+    bool collides = false;
+    for (std::size_t i = 1; i < count; i++) {
+      if (hashes[order[i - 1]] != hashes[order[i]])
+        continue;
+      if (Bytes(keys[order[i - 1]]) == Bytes(keys[order[i]]))
+        return Result::Failure("The key already exists");
+      collides = true;
+    }
+    found = !collides && _PerfectHash::_Displace(hashes, seeds, slots);
+  }
+  if (!found)
+    return Result::Failure("No perfect hash was found for the keys");
+
+  _PerfectHash::_Header header = {};
+  std::memcpy(header.Magic, _PerfectHash::_MAGIC, sizeof(header.Magic));
+  header.Version = _PerfectHash::_VERSION;
+  header.ByteOrder = _PerfectHash::_ORDER_MARK;
+  header.KeySize = _Strings ? 0 : sizeof(K);
+  header.ValueSize = sizeof(V);
+  header.Count = count;
+  header.Buckets = seeds.size();
+  header.Seed = seed - 1;
+  for (std::size_t i = 0; i < count; i++) {
+    header.KeyBytes += Bytes(keys[i]).size();
+  }
+
+  // The padding between sections is zeroed, so equal maps save equal files.
+  _PerfectHash::_Sections sections = _PerfectHash::_Locate(header);
+  std::shared_ptr<std::byte> storage(
+      static_cast<std::byte *>(::operator new(
+          sections.End, std::align_val_t(_PerfectHash::_ALIGNMENT))),
+      [](std::byte *image) {
+        ::operator delete(image, std::align_val_t(_PerfectHash::_ALIGNMENT));
+      });
+  std::byte *image = storage.get();
+  std::memset(image, 0, sections.End);
+  std::memcpy(image, &header, sizeof(header));
+  if (!seeds.empty())
+    std::memcpy(image + sections.Seeds, seeds.data(),
+                seeds.size() * sizeof(std::uint32_t));
+
+  // Lay the keys out in slot order, string keys one after the other.
+  for (std::size_t i = 0; i < count; i++) {
+    order[slots[i]] = i;
+  }
+  std::uint64_t offset = 0;
+  for (std::size_t slot = 0; slot < count; slot++) {
+    std::string_view bytes = Bytes(keys[order[slot]]);
+    std::memcpy(image + sections.Values + slot * sizeof(V),
+                &values[order[slot]], sizeof(V));
+    if constexpr (_Strings)
+      std::memcpy(image + sections.Offsets + slot * sizeof(std::uint64_t),
+                  &offset, sizeof(offset));
+    if (!bytes.empty())
+      std::memcpy(image + sections.Keys + offset, bytes.data(), bytes.size());
+    offset += bytes.size();
+  }
+  if constexpr (_Strings)
+    std::memcpy(image + sections.Offsets + count * sizeof(std::uint64_t),
+                &offset, sizeof(offset));
+
+  return Result::Success(CDS_PerfectHashMap<K, V>(storage, image));
+}
+
+template <class K, class V>
+CDS_Result<CDS_PerfectHashMap<K, V>>
+CDS_PerfectHashMap<K, V>::Open(const std::string &path) {
+  using Result = CDS_Result<CDS_PerfectHashMap<K, V>>;
+  CDS_Result<std::shared_ptr<const _File::Mapping>> mapping =
+      _File::MapFile(path);
+  if (mapping.IsError())
+    return Result::Failure(mapping.ErrorMessage);
+
+  const _File::Mapping &file = *mapping.Unpack();
+  CDS_Result<_PerfectHash::_Header> header = _PerfectHash::_Check(
+      file.Address, file.Length, _Strings ? 0 : sizeof(K), sizeof(V));
+  if (header.IsError())
+    return Result::Failure(header.ErrorMessage);
+  return Result::Success(CDS_PerfectHashMap<K, V>(
+      mapping.Unpack(), static_cast<const std::byte *>(file.Address)));
+}
+
+template <class K, class V>
+CDS_Result<std::size_t>
+CDS_PerfectHashMap<K, V>::Save(const std::string &path) const {
+  std::FILE *stream = std::fopen(path.c_str(), "wb");
+  if (!stream)
+    return CDS_Result<std::size_t>::Failure("Cannot create " + path + ": " +
+                                            std::strerror(errno));
+  std::size_t length = this->GetBytes();
+  bool written = std::fwrite(this->_Image, 1, length, stream) == length;
+  bool closed = std::fclose(stream) == 0;
+  if (!written || !closed)
+    return CDS_Result<std::size_t>::Failure("Cannot write " + path);
+  return CDS_Result<std::size_t>::Success(length);
+}
+
+// Getters
+template <class K, class V>
+std::size_t CDS_PerfectHashMap<K, V>::GetSize() const {
+  return static_cast<std::size_t>(this->_Info.Count);
+}
+
+template <class K, class V>
+std::size_t CDS_PerfectHashMap<K, V>::GetBytes() const {
+  return _PerfectHash::_Locate(this->_Info).End;
+}
+
+template <class K, class V>
+CDS_Result<V> CDS_PerfectHashMap<K, V>::Get(key_view key) const {
+  const V *value = this->Find(key);
+  if (!value)
+    return CDS_Result<V>::Failure("The key does not exist");
+  return CDS_Result<V>::Success(*value);
+}
+
+template <class K, class V>
+const V *CDS_PerfectHashMap<K, V>::Find(key_view key) const {
+  if (!this->_Info.Count)
+    return nullptr;
+  std::string_view bytes = Bytes(key);
+  std::uint64_t hash =
+      CDS_HashBytes(bytes.data(), bytes.size(), this->_Info.Seed);
+  std::uint32_t seed =
+      this->_Seeds[_PerfectHash::_Reduce(hash, this->_Info.Buckets)];
+  std::size_t slot = _PerfectHash::_Slot(hash, seed, this->_Info.Count);
+  if (this->KeyAt(slot) != bytes)
+    return nullptr;
+  return &this->_Values[slot];
+}
+
+template <class K, class V>
+bool CDS_PerfectHashMap<K, V>::Contains(key_view key) const {
+  return this->Find(key) != nullptr;
+}
+
+template <class K, class V>
+template <class Function>
+void CDS_PerfectHashMap<K, V>::ForEach(Function function) const {
+  for (std::size_t slot = 0; slot < this->_Info.Count; slot++) {
+    std::string_view bytes = this->KeyAt(slot);
+    if constexpr (_Strings) {
+      function(bytes, this->_Values[slot]);
+    } else {
+      K key;
+      std::memcpy(&key, bytes.data(), sizeof(K));
+      function(const_cast<const K &>(key), this->_Values[slot]);
+    }
+  }
+}
+
+// Private
+template <class K, class V>
+CDS_PerfectHashMap<K, V>::CDS_PerfectHashMap(
+    std::shared_ptr<const void> storage, const std::byte *image)
+    : _Storage(std::move(storage)), _Image(image) {
+  std::memcpy(&this->_Info, image, sizeof(this->_Info));
+  _PerfectHash::_Sections sections = _PerfectHash::_Locate(this->_Info);
+  this->_Seeds =
+      reinterpret_cast<const std::uint32_t *>(image + sections.Seeds);
+  this->_Values = reinterpret_cast<const V *>(image + sections.Values);
+  this->_Offsets =
+      reinterpret_cast<const std::uint64_t *>(image + sections.Offsets);
+  this->_Keys = reinterpret_cast<const char *>(image + sections.Keys);
+}
+
+template <class K, class V>
+std::string_view CDS_PerfectHashMap<K, V>::Bytes(key_view key) {
+  if constexpr (_Strings)
+    return key;
+  else
+    return {reinterpret_cast<const char *>(&key), sizeof(K)};
+}
+
+template <class K, class V>
+std::string_view CDS_PerfectHashMap<K, V>::KeyAt(std::size_t slot) const {
+  if constexpr (_Strings)
+    return {this->_Keys + this->_Offsets[slot],
+            this->_Offsets[slot + 1] - this->_Offsets[slot]};
+  else
+    return {this->_Keys + slot * sizeof(K), sizeof(K)};
+}
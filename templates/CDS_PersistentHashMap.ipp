@@ -0,0 +1,462 @@
+#pragma once
+#include "CDS_PersistentHashMap.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+inline std::size_t _Persistent::_ControlBytes(std::size_t capacity) {
+  return (capacity + _CLONES + _ALIGNMENT - 1) / _ALIGNMENT * _ALIGNMENT;
+}
+
+// Constructors
+template <class K, class V>
+CDS_Result<CDS_PersistentHashMap<K, V>>
+CDS_PersistentHashMap<K, V>::Open(const std::string &path,
+                                  float maxLoadFactor) {
+  using Result = CDS_Result<CDS_PersistentHashMap<K, V>>;
+  assertm(maxLoadFactor > 0 && maxLoadFactor < 1,
+          "The load factor must be between 0 and 1");
+  CDS_Result<std::unique_ptr<_File::SharedMapping>> opened =
+      _File::OpenShared(path);
+  if (opened.IsError())
+    return Result::Failure(opened.ErrorMessage);
+  std::unique_ptr<_File::SharedMapping> mapping = std::move(opened.Unpack());
+
+  _Persistent::_Header header = {};
+  if (!mapping->Temporary.empty()) {
+    CDS_Result<std::size_t> resized =
+        _File::Resize(*mapping, _Persistent::_DATA);
+    if (resized.IsError())
+      return Result::Failure(resized.ErrorMessage);
+    std::memcpy(header.Magic, _Persistent::_MAGIC, sizeof(header.Magic));
+    header.Version = _Persistent::_VERSION;
+    header.ByteOrder = _Persistent::_ORDER_MARK;
+    header.KeySize = _Strings ? 0 : sizeof(K);
+    header.ValueSize = sizeof(V);
+    header.Generation = 1;
+    header.End = _Persistent::_DATA;
+    CDS_Result<std::uint64_t> committed =
+        _Persistent::_Commit(*mapping, header);
+    if (committed.IsError())
+      return Result::Failure(committed.ErrorMessage);
+    CDS_Result<std::string> published = _File::Publish(*mapping, path);
+    if (published.IsError())
+      return Result::Failure(published.ErrorMessage);
+  } else if (mapping->Length < _Persistent::_DATA) {
+    return Result::Failure(
+        "The file is too short to be a persistent hash map");
+  } else {
+    CDS_Result<_Persistent::_Header> loaded = _Persistent::_Load(
+        *mapping, _Strings ? 0 : sizeof(K), sizeof(V), sizeof(_Slot));
+    if (loaded.IsError())
+      return Result::Failure(loaded.ErrorMessage);
+    header = loaded.Unpack();
+  }
+  return Result{CDS_PersistentHashMap(std::move(mapping), header,
+                                      maxLoadFactor),
+                std::nullopt};
+}
+
+template <class K, class V>
+CDS_PersistentHashMap<K, V> &
+CDS_PersistentHashMap<K, V>::operator=(CDS_PersistentHashMap &&other) noexcept {
+  if (this != &other) {
+    if (this->_Mapping)
+      this->Flush();
+    this->_Mapping = std::move(other._Mapping);
+    this->_State = other._State;
+    this->_Last = other._Last;
+    this->_MaxLoadFactor = other._MaxLoadFactor;
+  }
+  return *this;
+}
+
+template <class K, class V>
+CDS_PersistentHashMap<K, V>::~CDS_PersistentHashMap() {
+  if (this->_Mapping)
+    this->Flush();
+}
+
+// Getters
+template <class K, class V>
+std::size_t CDS_PersistentHashMap<K, V>::GetSize() const {
+  return static_cast<std::size_t>(this->_State.Size);
+}
+
+template <class K, class V>
+std::size_t CDS_PersistentHashMap<K, V>::GetCapacity() const {
+  return static_cast<std::size_t>(this->_State.Capacity);
+}
+
+template <class K, class V>
+std::uint64_t CDS_PersistentHashMap<K, V>::GetGeneration() const {
+  return this->_Last.Generation;
+}
+
+template <class K, class V>
+CDS_Result<V> CDS_PersistentHashMap<K, V>::Get(key_view key) const {
+  const V *value = this->Find(key);
+  if (!value)
+    return CDS_Result<V>::Failure("The key does not exist");
+  return CDS_Result<V>::Success(*value);
+}
+
+template <class K, class V>
+const V *CDS_PersistentHashMap<K, V>::Find(key_view key) const {
+  std::string_view bytes = Bytes(key);
+  std::size_t index =
+      this->Lookup(bytes, CDS_HashBytes(bytes.data(), bytes.size()));
+  if (index == this->_State.Capacity)
+    return nullptr;
+  return &this->Slots()[index].Value;
+}
+
+template <class K, class V>
+bool CDS_PersistentHashMap<K, V>::Contains(key_view key) const {
+  return this->Find(key) != nullptr;
+}
+
+// Modifiers
+template <class K, class V>
+CDS_Result<const V *> CDS_PersistentHashMap<K, V>::Insert(key_view key,
+                                                          const V &value) {
+  std::string_view bytes = Bytes(key);
+  std::uint64_t hash = CDS_HashBytes(bytes.data(), bytes.size());
+  if (this->Lookup(bytes, hash) != this->_State.Capacity)
+    return CDS_Result<const V *>::Failure("The key already exists");
+  CDS_Result<std::size_t> index = this->Place(bytes, hash, value);
+  if (index.IsError())
+    return CDS_Result<const V *>::Failure(index.ErrorMessage);
+  return CDS_Result<const V *>::Success(&this->Slots()[index.Unpack()].Value);
+}
+
+template <class K, class V>
+CDS_Result<const V *> CDS_PersistentHashMap<K, V>::Set(key_view key,
+                                                       const V &value) {
+  std::string_view bytes = Bytes(key);
+  std::uint64_t hash = CDS_HashBytes(bytes.data(), bytes.size());
+  std::size_t index = this->Lookup(bytes, hash);
+  if (index == this->_State.Capacity) {
+    CDS_Result<std::size_t> placed = this->Place(bytes, hash, value);
+    if (placed.IsError())
+      return CDS_Result<const V *>::Failure(placed.ErrorMessage);
+    index = placed.Unpack();
+  } else {
+    CDS_Result<std::uint64_t> detached = this->Detach();
+    if (detached.IsError())
+      return CDS_Result<const V *>::Failure(detached.ErrorMessage);
+    this->Slots()[index].Value = value;
+  }
+  return CDS_Result<const V *>::Success(&this->Slots()[index].Value);
+}
+
+template <class K, class V>
+CDS_Result<V> CDS_PersistentHashMap<K, V>::Delete(key_view key) {
+  std::string_view bytes = Bytes(key);
+  std::size_t index =
+      this->Lookup(bytes, CDS_HashBytes(bytes.data(), bytes.size()));
+  if (index == this->_State.Capacity)
+    return CDS_Result<V>::Failure("The key does not exist");
+  CDS_Result<std::uint64_t> detached = this->Detach();
+  if (detached.IsError())
+    return CDS_Result<V>::Failure(detached.ErrorMessage);
+
+  // With linear probing, no key lies past an empty slot on its probe
+  // sequence, so a slot followed by one can become empty again.
+  V value = this->Slots()[index].Value;
+  std::size_t next = (index + 1) & (this->_State.Capacity - 1);
+  if (this->Control()[next] == _Hash::_EMPTY) {
+    this->SetControl(index, _Hash::_EMPTY);
+  } else {
+    this->SetControl(index, _Hash::_DELETED);
+    this->_State.Deleted++;
+  }
+  this->_State.Size--;
+  return CDS_Result<V>::Success(value);
+}
+
+template <class K, class V> void CDS_PersistentHashMap<K, V>::Clear() {
+  if (this->_State.Capacity && this->_State.Table != this->_Last.Table) {
+    this->_State.Spare = this->_State.Table;
+    this->_State.SpareCapacity = this->_State.Capacity;
+  }
+  this->_State.Table = 0;
+  this->_State.Capacity = 0;
+  this->_State.Size = 0;
+  this->_State.Deleted = 0;
+}
+
+template <class K, class V>
+CDS_Result<std::size_t>
+CDS_PersistentHashMap<K, V>::Reserve(std::size_t count) {
+  std::size_t capacity = this->CapacityFor(count);
+  if (capacity > this->_State.Capacity) {
+    CDS_Result<std::uint64_t> rehashed = this->Rehash(capacity);
+    if (rehashed.IsError())
+      return CDS_Result<std::size_t>::Failure(rehashed.ErrorMessage);
+  }
+  return CDS_Result<std::size_t>::Success(this->GetCapacity());
+}
+
+template <class K, class V>
+CDS_Result<std::uint64_t> CDS_PersistentHashMap<K, V>::Flush() {
+  // Once this commits, the table of the last Flush is free.
+  _Persistent::_Header next = this->_State;
+  next.Generation = this->_Last.Generation + 1;
+  if (this->_Last.Capacity && this->_Last.Table != next.Table &&
+      (!next.Spare || this->_Last.Capacity == next.Capacity)) {
+    next.Spare = this->_Last.Table;
+    next.SpareCapacity = this->_Last.Capacity;
+  }
+  CDS_Result<std::uint64_t> committed =
+      _Persistent::_Commit(*this->_Mapping, next);
+  if (committed.IsError())
+    return committed;
+  this->_State = next;
+  this->_Last = next;
+  return committed;
+}
+
+template <class K, class V>
+template <class Function>
+void CDS_PersistentHashMap<K, V>::ForEach(Function function) const {
+  const std::int8_t *control = this->Control();
+  const _Slot *slots = this->Slots();
+  for (std::size_t i = 0; i < this->_State.Capacity; i++) {
+    if (control[i] < 0)
+      continue;
+    if constexpr (_Strings)
+      function(this->KeyOf(slots[i]), slots[i].Value);
+    else
+      function(slots[i].Key, slots[i].Value);
+  }
+}
+
+// Private
+template <class K, class V>
+CDS_PersistentHashMap<K, V>::CDS_PersistentHashMap(
+    std::unique_ptr<_File::SharedMapping> mapping,
+    const _Persistent::_Header &header, float maxLoadFactor)
+    : _Mapping(std::move(mapping)), _State(header), _Last(header),
+      _MaxLoadFactor(maxLoadFactor) {}
+
+template <class K, class V>
+std::int8_t *CDS_PersistentHashMap<K, V>::Control() const {
+  return reinterpret_cast<std::int8_t *>(
+      static_cast<char *>(this->_Mapping->Address) + this->_State.Table);
+}
+
+template <class K, class V>
+typename CDS_PersistentHashMap<K, V>::_Slot *
+CDS_PersistentHashMap<K, V>::Slots() const {
+  return reinterpret_cast<_Slot *>(
+      static_cast<char *>(this->_Mapping->Address) + this->_State.Table +
+      _Persistent::_ControlBytes(this->_State.Capacity));
+}
+
+template <class K, class V>
+std::string_view CDS_PersistentHashMap<K, V>::Bytes(key_view key) {
+  if constexpr (_Strings)
+    return key;
+  else
+    return {reinterpret_cast<const char *>(&key), sizeof(K)};
+}
+
+template <class K, class V>
+std::string_view CDS_PersistentHashMap<K, V>::KeyOf(const _Slot &slot) const {
+  if constexpr (_Strings)
+    return {static_cast<const char *>(this->_Mapping->Address) +
+                slot.Key.Offset,
+            slot.Key.Length};
+  else
+    return {reinterpret_cast<const char *>(&slot.Key), sizeof(K)};
+}
+
+template <class K, class V>
+std::size_t CDS_PersistentHashMap<K, V>::Lookup(std::string_view bytes,
+                                                std::uint64_t hash) const {
+  std::size_t capacity = this->_State.Capacity;
+  if (!capacity)
+    return 0;
+  // The probe walks the slots in order, a group at a time. A key never lies
+  // past the first empty slot after its start, so the group holding one is
+  // the last; matches beyond it fail the key comparison.
+  const std::int8_t *control = this->Control();
+  const _Slot *slots = this->Slots();
+  std::size_t mask = capacity - 1;
+  std::int8_t tag = _Hash::_H2(hash);
+  std::size_t position = _Hash::_H1(hash) & mask;
+  for (std::size_t scanned = 0; scanned < capacity;
+       scanned += _Hash::_GROUP) {
+    _Hash::_Group group(control + position);
+    for (_Hash::_Mask match = group.Match(tag); match; match.Next()) {
+      std::size_t index = (position + match.Lowest()) & mask;
+      if (this->KeyOf(slots[index]) == bytes)
+        return index;
+    }
+    if (group.MatchEmpty())
+      return capacity;
+    position = (position + _Hash::_GROUP) & mask;
+  }
+  return capacity;
+}
+
+template <class K, class V>
+CDS_Result<std::size_t>
+CDS_PersistentHashMap<K, V>::Place(std::string_view bytes, std::uint64_t hash,
+                                   const V &value) {
+  // A growing table is written to a new area anyway, so only a table that
+  // keeps its size is detached from the committed one.
+  std::size_t capacity = this->_State.Capacity;
+  std::size_t budget = std::size_t(capacity * this->_MaxLoadFactor);
+  CDS_Result<std::uint64_t> table =
+      this->_State.Size + this->_State.Deleted + 1 <= budget
+          ? this->Detach()
+      : capacity && (this->_State.Size + 1) * 2 <= budget
+          ? this->Rehash(capacity)
+          : this->Rehash(this->CapacityFor(this->_State.Size + 1));
+  if (table.IsError())
+    return CDS_Result<std::size_t>::Failure(table.ErrorMessage);
+
+  _Slot slot;
+  if constexpr (_Strings) {
+    CDS_Result<std::uint64_t> offset = this->Allocate(bytes.size(), 1);
+    if (offset.IsError())
+      return CDS_Result<std::size_t>::Failure(offset.ErrorMessage);
+    if (!bytes.empty())
+      std::memcpy(static_cast<char *>(this->_Mapping->Address) +
+                      offset.Unpack(),
+                  bytes.data(), bytes.size());
+    slot.Key = {offset.Unpack(), bytes.size()};
+  } else {
+    std::memcpy(&slot.Key, bytes.data(), sizeof(K));
+  }
+  slot.Value = value;
+
+  std::size_t index = this->Probe(hash);
+  if (this->Control()[index] == _Hash::_DELETED)
+    this->_State.Deleted--;
+  std::memcpy(&this->Slots()[index], &slot, sizeof(_Slot));
+  this->SetControl(index, _Hash::_H2(hash));
+  this->_State.Size++;
+  return CDS_Result<std::size_t>::Success(index);
+}
+
+template <class K, class V>
+CDS_Result<std::uint64_t> CDS_PersistentHashMap<K, V>::Detach() {
+  if (!this->_State.Capacity || this->_State.Table != this->_Last.Table)
+    return CDS_Result<std::uint64_t>::Success(this->_State.Table);
+  std::size_t capacity = this->_State.Capacity;
+  CDS_Result<std::uint64_t> area = this->TableArea(capacity);
+  if (area.IsError())
+    return area;
+  char *base = static_cast<char *>(this->_Mapping->Address);
+  std::memcpy(base + area.Unpack(), base + this->_State.Table,
+              _Persistent::_ControlBytes(capacity) + capacity * sizeof(_Slot));
+  this->_State.Table = area.Unpack();
+  return area;
+}
+
+template <class K, class V>
+CDS_Result<std::uint64_t>
+CDS_PersistentHashMap<K, V>::Rehash(std::size_t capacity) {
+  CDS_Result<std::uint64_t> area = this->TableArea(capacity);
+  if (area.IsError())
+    return area;
+
+  // The area may have moved the mapping, the old table is found afresh.
+  const std::int8_t *oldControl = this->Control();
+  const _Slot *oldSlots = this->Slots();
+  std::uint64_t oldTable = this->_State.Table;
+  std::size_t oldCapacity = this->_State.Capacity;
+  this->_State.Table = area.Unpack();
+  this->_State.Capacity = capacity;
+  this->_State.Deleted = 0;
+  std::fill_n(this->Control(), capacity + _Persistent::_CLONES,
+              _Hash::_EMPTY);
+  _Slot *slots = this->Slots();
+  for (std::size_t i = 0; i < oldCapacity; i++) {
+    if (oldControl[i] < 0)
+      continue;
+    std::string_view bytes = this->KeyOf(oldSlots[i]);
+    std::uint64_t hash = CDS_HashBytes(bytes.data(), bytes.size());
+    std::size_t index = this->Probe(hash);
+    std::memcpy(&slots[index], &oldSlots[i], sizeof(_Slot));
+    this->SetControl(index, _Hash::_H2(hash));
+  }
+
+  // A table no Flush committed is free again.
+  if (oldCapacity && oldTable != this->_Last.Table) {
+    this->_State.Spare = oldTable;
+    this->_State.SpareCapacity = oldCapacity;
+  }
+  return area;
+}
+
+template <class K, class V>
+CDS_Result<std::uint64_t>
+CDS_PersistentHashMap<K, V>::TableArea(std::size_t capacity) {
+  if (this->_State.Spare && this->_State.SpareCapacity == capacity) {
+    std::uint64_t spare = this->_State.Spare;
+    this->_State.Spare = 0;
+    this->_State.SpareCapacity = 0;
+    return CDS_Result<std::uint64_t>::Success(spare);
+  }
+  return this->Allocate(_Persistent::_ControlBytes(capacity) +
+                            capacity * sizeof(_Slot),
+                        _Persistent::_ALIGNMENT);
+}
+
+template <class K, class V>
+CDS_Result<std::uint64_t>
+CDS_PersistentHashMap<K, V>::Allocate(std::size_t bytes,
+                                      std::size_t alignment) {
+  std::uint64_t offset =
+      (this->_State.End + alignment - 1) / alignment * alignment;
+  std::uint64_t end = offset + bytes;
+  if (end > this->_Mapping->Length) {
+    // The file grows geometrically, in whole header-sized pages.
+    std::size_t length = std::max<std::size_t>(end, this->_Mapping->Length * 2);
+    length = (length + _Persistent::_DATA - 1) / _Persistent::_DATA *
+             _Persistent::_DATA;
+    CDS_Result<std::size_t> resized = _File::Resize(*this->_Mapping, length);
+    if (resized.IsError())
+      return CDS_Result<std::uint64_t>::Failure(resized.ErrorMessage);
+  }
+  this->_State.End = end;
+  return CDS_Result<std::uint64_t>::Success(offset);
+}
+
+template <class K, class V>
+std::size_t CDS_PersistentHashMap<K, V>::Probe(std::uint64_t hash) const {
+  std::size_t mask = this->_State.Capacity - 1;
+  std::size_t position = _Hash::_H1(hash) & mask;
+  const std::int8_t *control = this->Control();
+  for (;;) {
+    _Hash::_Mask free = _Hash::_Group(control + position).MatchFree();
+    if (free)
+      return (position + free.Lowest()) & mask;
+    position = (position + _Hash::_GROUP) & mask;
+  }
+}
+
+template <class K, class V>
+void CDS_PersistentHashMap<K, V>::SetControl(std::size_t index,
+                                             std::int8_t control) {
+  std::int8_t *bytes = this->Control();
+  bytes[index] = control;
+  if (index < _Persistent::_CLONES)
+    bytes[this->_State.Capacity + index] = control;
+}
+
+template <class K, class V>
+std::size_t CDS_PersistentHashMap<K, V>::CapacityFor(std::size_t count) const {
+  std::size_t capacity = _Persistent::_MIN_CAPACITY;
+  while (count > std::size_t(capacity * this->_MaxLoadFactor)) {
+    capacity *= 2;
+  }
+  return capacity;
+}
@@ -1,7 +1,5 @@
 #pragma once
-#include "CDS_SimpleHashMap.hpp"
-#include <array>
-#include <memory>
+#include "CDS_Result.hpp"
 #include <optional>
 #include <string>
 
@@ -0,0 +1,237 @@
+#pragma once
+#include "CDS_SegmentedList.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <iterator>
+#include <span>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+// Segment arithmetic
+constexpr _Segment::_Position _Segment::_Locate(std::size_t index) {
+  // Shifted by the first capacity, the segment is the position of the top
+  // bit and the offset the bits below it.
+  std::size_t shifted = index + (std::size_t(1) << _FIRST_SHIFT);
+  std::size_t segment = std::bit_width(shifted) - 1 - _FIRST_SHIFT;
+  return {segment, shifted - (std::size_t(1) << (segment + _FIRST_SHIFT))};
+}
+
+constexpr std::size_t _Segment::_Capacity(std::size_t segment) {
+  return std::size_t(1) << (segment + _FIRST_SHIFT);
+}
+
+constexpr std::size_t _Segment::_First(std::size_t segment) {
+  return _Capacity(segment) - _Capacity(0);
+}
+
+// Constructors
+template <class T, class Allocator>
+CDS_SegmentedList<T, Allocator>::CDS_SegmentedList()
+    : CDS_SegmentedList(Allocator()) {}
+
+template <class T, class Allocator>
+CDS_SegmentedList<T, Allocator>::CDS_SegmentedList(const Allocator &allocator)
+    : _Allocator(allocator) {}
+
+template <class T, class Allocator>
+CDS_SegmentedList<T, Allocator>::CDS_SegmentedList(
+    const CDS_SegmentedList &other)
+    : _Allocator(_Traits::select_on_container_copy_construction(
+          other._Allocator)) {
+  for (std::size_t i = 0; i < other.GetSize(); i++) {
+    this->Append(other.GetElement(i));
+  }
+}
+
+template <class T, class Allocator>
+CDS_SegmentedList<T, Allocator>::CDS_SegmentedList(
+    CDS_SegmentedList &&other) noexcept
+    : _Allocator(std::move(other._Allocator)) {
+  this->Swap(other);
+}
+
+template <class T, class Allocator>
+CDS_SegmentedList<T, Allocator> &
+CDS_SegmentedList<T, Allocator>::operator=(CDS_SegmentedList other) noexcept {
+  this->Swap(other);
+  return *this;
+}
+
+// Destructor
+template <class T, class Allocator>
+CDS_SegmentedList<T, Allocator>::~CDS_SegmentedList() {
+  this->Clear();
+  for (std::size_t segment = 0; segment < _Segment::_COUNT; segment++) {
+    if (this->_Segments[segment])
+      _Traits::deallocate(this->_Allocator, this->_Segments[segment],
+                          _Segment::_Capacity(segment));
+  }
+}
+
+// Getters
+template <class T, class Allocator>
+Allocator CDS_SegmentedList<T, Allocator>::GetAllocator() const {
+  return this->_Allocator;
+}
+
+template <class T, class Allocator>
+std::size_t CDS_SegmentedList<T, Allocator>::GetSize() const {
+  return this->_Size;
+}
+
+template <class T, class Allocator>
+std::size_t CDS_SegmentedList<T, Allocator>::GetCapacity() const {
+  std::size_t capacity = 0;
+  for (std::size_t segment = 0; segment < _Segment::_COUNT; segment++) {
+    if (this->_Segments[segment])
+      capacity += _Segment::_Capacity(segment);
+  }
+  return capacity;
+}
+
+template <class T, class Allocator>
+T &CDS_SegmentedList<T, Allocator>::GetElement(const std::size_t index) const {
+  assertm(index < this->GetSize(), "Index out of bounds");
+  _Segment::_Position position = _Segment::_Locate(index);
+  return this->_Segments[position.Segment][position.Offset];
+}
+
+// Append
+template <class T, class Allocator>
+const T &CDS_SegmentedList<T, Allocator>::Append(const T &elem) {
+  // Nothing moves when a segment is added, elem stays valid even if it is
+  // an element of this list.
+  T *slot = this->Slot();
+  _Traits::construct(this->_Allocator, slot, elem);
+  this->_Size++;
+  return *slot;
+}
+
+template <class T, class Allocator>
+const T &CDS_SegmentedList<T, Allocator>::Append(T &&elem) {
+  T *slot = this->Slot();
+  _Traits::construct(this->_Allocator, slot, std::move(elem));
+  this->_Size++;
+  return *slot;
+}
+
+// Emplace
+template <class T, class Allocator>
+template <class... Args>
+T &CDS_SegmentedList<T, Allocator>::Emplace(Args &&...args) {
+  T *slot = this->Slot();
+  _Traits::construct(this->_Allocator, slot, std::forward<Args>(args)...);
+  this->_Size++;
+  return *slot;
+}
+
+// Pop
+template <class T, class Allocator>
+T CDS_SegmentedList<T, Allocator>::Pop() {
+  assertm(this->GetSize() > 0, "List is empty");
+  T *last = &this->GetElement(this->GetSize() - 1);
+  T outElem = std::move(*last);
+  _Traits::destroy(this->_Allocator, last);
+  this->_Size--;
+
+  return outElem;
+}
+
+// Clear
+template <class T, class Allocator>
+void CDS_SegmentedList<T, Allocator>::Clear() {
+  std::size_t size = this->GetSize();
+  for (std::size_t segment = 0; _Segment::_First(segment) < size;
+       segment++) {
+    std::size_t count = std::min(_Segment::_Capacity(segment),
+                                 size - _Segment::_First(segment));
+    for (std::size_t i = 0; i < count; i++) {
+      _Traits::destroy(this->_Allocator, this->_Segments[segment] + i);
+    }
+  }
+  this->_Size = 0;
+}
+
+// Flatten
+template <class T, class Allocator>
+CDS_List<T, Allocator> CDS_SegmentedList<T, Allocator>::Flatten() const & {
+  return this->template Gather<false>();
+}
+
+template <class T, class Allocator>
+CDS_List<T, Allocator> CDS_SegmentedList<T, Allocator>::Flatten() && {
+  CDS_List<T, Allocator> list = this->template Gather<true>();
+  this->Clear();
+  return list;
+}
+
+// Swap
+template <class T, class Allocator>
+void CDS_SegmentedList<T, Allocator>::Swap(CDS_SegmentedList &other) noexcept {
+  // The segments belong to the allocator, they always travel together.
+  using std::swap;
+  swap(this->_Allocator, other._Allocator);
+  swap(this->_Size, other._Size);
+  swap(this->_Segments, other._Segments);
+}
+
+// Operator Overloads
+template <class T, class Allocator>
+T &CDS_SegmentedList<T, Allocator>::operator[](const std::size_t index) {
+  return this->GetElement(index);
+}
+
+template <class T, class Allocator>
+const T &
+CDS_SegmentedList<T, Allocator>::operator[](const std::size_t index) const {
+  return this->GetElement(index);
+}
+
+template <class U, class A>
+std::ostream &operator<<(std::ostream &stream,
+                         const CDS_SegmentedList<U, A> &array) {
+  stream << "[";
+  for (size_t i = 0; i < array.GetSize(); ++i) {
+    stream << array.GetElement(i);
+    if (i != array.GetSize() - 1) {
+      stream << ", ";
+    }
+  }
+  stream << "]";
+  return stream;
+}
+
+// Private
+template <class T, class Allocator>
+T *CDS_SegmentedList<T, Allocator>::Slot() {
+  _Segment::_Position position = _Segment::_Locate(this->GetSize());
+  assertm(position.Segment < _Segment::_COUNT, "List is full");
+  T *&data = this->_Segments[position.Segment];
+  if (!data)
+    data = _Traits::allocate(this->_Allocator,
+                             _Segment::_Capacity(position.Segment));
+  return data + position.Offset;
+}
+
+template <class T, class Allocator>
+template <bool Move>
+CDS_List<T, Allocator> CDS_SegmentedList<T, Allocator>::Gather() const {
+  CDS_List<T, Allocator> list(this->_Allocator);
+  list.Reserve(this->GetSize());
+  std::size_t size = this->GetSize();
+  for (std::size_t segment = 0; _Segment::_First(segment) < size;
+       segment++) {
+    T *data = this->_Segments[segment];
+    std::size_t count = std::min(_Segment::_Capacity(segment),
+                                 size - _Segment::_First(segment));
+    if constexpr (Move && !std::is_trivially_copyable_v<T>) {
+      list.AppendRange(std::make_move_iterator(data),
+                       std::make_move_iterator(data + count));
+    } else {
+      list.AppendRange(std::span<const T>(data, count));
+    }
+  }
+  return list;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "CDS_Simd.hpp"
+#include <algorithm>
+#include <cassert>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+template <class T>
+constexpr void _Simd::_Fill(T *out, std::size_t count, T value) {
+  for (std::size_t i = 0; i < count; i++) {
+    out[i] = value;
+  }
+}
+
+template <class T>
+constexpr void _Simd::_Add(const T *lhs, const T *rhs, T *out,
+                           std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    out[i] = lhs[i] + rhs[i];
+  }
+}
+
+template <class T>
+constexpr void _Simd::_Sub(const T *lhs, const T *rhs, T *out,
+                           std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    out[i] = lhs[i] - rhs[i];
+  }
+}
+
+template <class T>
+constexpr void _Simd::_Mul(const T *lhs, const T *rhs, T *out,
+                           std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    out[i] = lhs[i] * rhs[i];
+  }
+}
+
+template <class T>
+constexpr void _Simd::_Fma(const T *lhs, const T *rhs, const T *addend,
+                           T *out, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    out[i] = lhs[i] * rhs[i] + addend[i];
+  }
+}
+
+template <class T>
+constexpr void _Simd::_Scale(const T *in, T alpha, T *out,
+                             std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    out[i] = alpha * in[i];
+  }
+}
+
+template <class T>
+constexpr T _Simd::_Dot(const T *lhs, const T *rhs,
+                        std::size_t count) {
+  T sum = T(0);
+  for (std::size_t i = 0; i < count; i++) {
+    sum += lhs[i] * rhs[i];
+  }
+  return sum;
+}
+
+template <class T> constexpr T _Simd::_Sum(const T *in, std::size_t count) {
+  T sum = T(0);
+  for (std::size_t i = 0; i < count; i++) {
+    sum += in[i];
+  }
+  return sum;
+}
+
+template <class T> constexpr T _Simd::_Min(const T *in, std::size_t count) {
+  assertm(count > 0, "Minimum of no elements");
+  T out = in[0];
+  for (std::size_t i = 1; i < count; i++) {
+    out = std::min(out, in[i]);
+  }
+  return out;
+}
+
+template <class T> constexpr T _Simd::_Max(const T *in, std::size_t count) {
+  assertm(count > 0, "Maximum of no elements");
+  T out = in[0];
+  for (std::size_t i = 1; i < count; i++) {
+    out = std::max(out, in[i]);
+  }
+  return out;
+}
@@ -0,0 +1,399 @@
+#pragma once
+#include "CDS_SparseMatrix.hpp"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+namespace _Sparse {
+
+template <class T>
+_Compressed<T> _Swap(const _Compressed<T> &in, int minor) {
+  int major = static_cast<int>(in.Offsets.size()) - 1;
+  std::size_t count = in.Indices.size();
+  _Compressed<T> out;
+  out.Offsets.assign(minor + 1, 0);
+  out.Indices.resize(count);
+  out.Values.resize(count);
+
+  for (std::size_t p = 0; p < count; p++) {
+    out.Offsets[in.Indices[p] + 1]++;
+  }
+  for (int k = 0; k < minor; k++) {
+    out.Offsets[k + 1] += out.Offsets[k];
+  }
+  // Visiting the input in major order leaves every output line sorted.
+  std::vector<std::size_t> next(out.Offsets.begin(), out.Offsets.end() - 1);
+  for (int k = 0; k < major; k++) {
+    for (std::size_t p = in.Offsets[k]; p < in.Offsets[k + 1]; p++) {
+      std::size_t q = next[in.Indices[p]]++;
+      out.Indices[q] = k;
+      out.Values[q] = in.Values[p];
+    }
+  }
+  return out;
+}
+
+} // namespace _Sparse
+
+// Constructors
+template <typename T>
+CDS_SparseMatrix<T>::CDS_SparseMatrix(int rows, int cols, Format format)
+    : _Rows(rows), _Cols(cols), _Format(format) {
+  assertm(rows >= 0 && cols >= 0, "Matrix dimensions must be non-negative");
+  this->_Storage.Offsets.assign(this->_Major() + 1, 0);
+}
+
+template <typename T>
+CDS_SparseMatrix<T>::CDS_SparseMatrix(int rows, int cols,
+                                      const std::vector<Triplet> &triplets,
+                                      Format format)
+    : CDS_SparseMatrix(rows, cols, format) {
+  bool csr = format == Format::CSR;
+  std::vector<std::size_t> &offsets = this->_Storage.Offsets;
+  for (const Triplet &t : triplets) {
+    assertm(t.Row >= 0 && t.Row < rows && t.Col >= 0 && t.Col < cols,
+            "Triplet index out of range");
+    offsets[(csr ? t.Row : t.Col) + 1]++;
+  }
+  for (int k = 0; k < this->_Major(); k++) {
+    offsets[k + 1] += offsets[k];
+  }
+
+  // Bucket by major line, then sort each line and merge repeated positions.
+  std::vector<std::pair<int, T>> entries(triplets.size());
+  std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+  for (const Triplet &t : triplets) {
+    entries[next[csr ? t.Row : t.Col]++] = {csr ? t.Col : t.Row, t.Value};
+  }
+
+  this->_Storage.Indices.reserve(entries.size());
+  this->_Storage.Values.reserve(entries.size());
+  std::size_t begin = 0;
+  for (int k = 0; k < this->_Major(); k++) {
+    std::size_t end = offsets[k + 1];
+    std::sort(entries.begin() + begin, entries.begin() + end,
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    offsets[k] = this->_Storage.Indices.size();
+    for (std::size_t p = begin; p < end;) {
+      int index = entries[p].first;
+      T sum = T(0);
+      for (; p < end && entries[p].first == index; p++) {
+        sum += entries[p].second;
+      }
+      if (sum != T(0)) {
+        this->_Storage.Indices.push_back(index);
+        this->_Storage.Values.push_back(sum);
+      }
+    }
+    begin = end;
+  }
+  offsets[this->_Major()] = this->_Storage.Indices.size();
+}
+
+template <typename T>
+CDS_SparseMatrix<T>::CDS_SparseMatrix(const CDS_Matrix<T> &dense,
+                                      Format format)
+    : CDS_SparseMatrix(std::get<0>(dense.GetShape()),
+                       std::get<1>(dense.GetShape()), format) {
+  bool csr = format == Format::CSR;
+  for (int k = 0; k < this->_Major(); k++) {
+    for (int m = 0; m < this->_Minor(); m++) {
+      const T &value = csr ? dense[{k, m}] : dense[{m, k}];
+      if (value != T(0)) {
+        this->_Storage.Indices.push_back(m);
+        this->_Storage.Values.push_back(value);
+      }
+    }
+    this->_Storage.Offsets[k + 1] = this->_Storage.Indices.size();
+  }
+}
+
+template <typename T>
+CDS_Matrix<T>
+CDS_SparseMatrix<T>::ToDense(typename CDS_Matrix<T>::Layout layout) const {
+  CDS_Matrix<T> out(this->_Rows, this->_Cols, layout);
+  bool csr = this->_Format == Format::CSR;
+  for (int k = 0; k < this->_Major(); k++) {
+    for (std::size_t p = this->_Storage.Offsets[k];
+         p < this->_Storage.Offsets[k + 1]; p++) {
+      int m = this->_Storage.Indices[p];
+      out[csr ? std::pair{k, m} : std::pair{m, k}] = this->_Storage.Values[p];
+    }
+  }
+  return out;
+}
+
+// Products
+template <typename T>
+std::vector<T>
+CDS_SparseMatrix<T>::operator*(const std::vector<T> &vector) const {
+  assertm(static_cast<int>(vector.size()) == this->_Cols,
+          "Vector size does not match the number of columns");
+  const std::vector<std::size_t> &offsets = this->_Storage.Offsets;
+  const std::vector<int> &indices = this->_Storage.Indices;
+  const std::vector<T> &values = this->_Storage.Values;
+  std::vector<T> out(this->_Rows, T(0));
+  std::vector<int> bands = this->_Bands();
+  std::size_t count = bands.size() - 1;
+
+  if (this->_Format == Format::CSR) {
+    // Every band of rows owns its slice of the output.
+    CDS_ThreadPool::Instance().ParallelFor(
+        count, this->NonZeros(), [&](std::size_t b) {
+          for (int i = bands[b]; i < bands[b + 1]; i++) {
+            T sum = T(0);
+            for (std::size_t p = offsets[i]; p < offsets[i + 1]; p++) {
+              sum += values[p] * vector[indices[p]];
+            }
+            out[i] = sum;
+          }
+        });
+    return out;
+  }
+
+  // Columns scatter into the whole output, so below the cutoff they go
+  // straight into it.
+  CDS_ThreadPool &pool = CDS_ThreadPool::Instance();
+  if (pool.IsSerial(this->NonZeros())) {
+    for (int j = 0; j < this->_Cols; j++) {
+      T x = vector[j];
+      for (std::size_t p = offsets[j]; p < offsets[j + 1]; p++) {
+        out[indices[p]] += values[p] * x;
+      }
+    }
+    return out;
+  }
+
+  // Every thread takes a run of bands and accumulates into an output of its
+  // own, the first into out, the others are summed afterwards.
+  std::size_t threads = std::min(pool.GetThreadCount(), count);
+  std::vector<T> partial((threads - 1) * this->_Rows, T(0));
+  pool.ParallelFor(threads, this->NonZeros(), [&](std::size_t t) {
+    T *target = t == 0 ? out.data() : partial.data() + (t - 1) * this->_Rows;
+    for (int j = bands[t * count / threads];
+         j < bands[(t + 1) * count / threads]; j++) {
+      T x = vector[j];
+      for (std::size_t p = offsets[j]; p < offsets[j + 1]; p++) {
+        target[indices[p]] += values[p] * x;
+      }
+    }
+  });
+  for (std::size_t t = 1; t < threads; t++) {
+    const T *source = partial.data() + (t - 1) * this->_Rows;
+    for (int i = 0; i < this->_Rows; i++) {
+      out[i] += source[i];
+    }
+  }
+  return out;
+}
+
+template <typename T>
+CDS_Matrix<T>
+CDS_SparseMatrix<T>::operator*(const CDS_Matrix<T> &other) const {
+  using Layout = typename CDS_Matrix<T>::Layout;
+  assertm(this->IsMultipliable(other),
+          "Matrix dimensions do not allow multiplication");
+  const std::vector<std::size_t> &offsets = this->_Storage.Offsets;
+  const std::vector<int> &indices = this->_Storage.Indices;
+  const std::vector<T> &values = this->_Storage.Values;
+  int cols = std::get<1>(other.GetShape());
+  std::size_t work = this->NonZeros() * static_cast<std::size_t>(cols);
+  bool csr = this->_Format == Format::CSR;
+  Layout layout = csr ? Layout::RowMajor : Layout::ColMajor;
+
+  // Both kernels stream contiguous rows (CSR) or columns (CSC) of the dense
+  // operand, reorder a copy if it is stored the other way.
+  CDS_Matrix<T> reordered(0, 0);
+  const CDS_Matrix<T> *dense = &other;
+  if (other.GetLayout() != layout) {
+    reordered = other;
+    reordered.SetLayout(layout);
+    dense = &reordered;
+  }
+  const T *b = dense->GetData();
+  CDS_Matrix<T> out(this->_Rows, cols, layout);
+  T *c = out.GetData();
+
+  if (csr) {
+    // C(i, :) += A(i, k) * B(k, :), bands of rows own their rows of C.
+    std::vector<int> bands = this->_Bands();
+    CDS_ThreadPool::Instance().ParallelFor(
+        bands.size() - 1, work, [&](std::size_t band) {
+          for (int i = bands[band]; i < bands[band + 1]; i++) {
+            T *row = c + static_cast<std::size_t>(i) * cols;
+            for (std::size_t p = offsets[i]; p < offsets[i + 1]; p++) {
+              T a = values[p];
+              const T *source = b + static_cast<std::size_t>(indices[p]) * cols;
+              for (int j = 0; j < cols; j++) {
+                row[j] += a * source[j];
+              }
+            }
+          }
+        });
+    return out;
+  }
+
+  // C(:, j) += A(:, k) * B(k, j), tiles of columns own their columns of C.
+  int tile = static_cast<int>(std::max<std::size_t>(
+      1, _Sparse::_BAND_NONZEROS / std::max<std::size_t>(this->NonZeros(), 1)));
+  CDS_ThreadPool::Instance().ParallelFor2D(
+      1, cols, 1, tile, work, [&](int, int, int colBegin, int colEnd) {
+        for (int j = colBegin; j < colEnd; j++) {
+          T *target = c + static_cast<std::size_t>(j) * this->_Rows;
+          const T *source = b + static_cast<std::size_t>(j) * this->_Cols;
+          for (int k = 0; k < this->_Cols; k++) {
+            T x = source[k];
+            if (x == T(0))
+              continue;
+            for (std::size_t p = offsets[k]; p < offsets[k + 1]; p++) {
+              target[indices[p]] += values[p] * x;
+            }
+          }
+        }
+      });
+  return out;
+}
+
+// Storage
+template <typename T> void CDS_SparseMatrix<T>::SetFormat(Format format) {
+  if (format == this->_Format)
+    return;
+  this->_Storage = _Sparse::_Swap(this->_Storage, this->_Minor());
+  this->_Format = format;
+}
+
+template <typename T>
+typename CDS_SparseMatrix<T>::Format CDS_SparseMatrix<T>::GetFormat() const {
+  return this->_Format;
+}
+
+template <typename T>
+std::tuple<int, int> CDS_SparseMatrix<T>::GetShape() const {
+  return {this->_Rows, this->_Cols};
+}
+
+template <typename T> std::size_t CDS_SparseMatrix<T>::NonZeros() const {
+  return this->_Storage.Values.size();
+}
+
+template <typename T>
+const std::vector<std::size_t> &CDS_SparseMatrix<T>::GetOffsets() const {
+  return this->_Storage.Offsets;
+}
+
+template <typename T>
+const std::vector<int> &CDS_SparseMatrix<T>::GetIndices() const {
+  return this->_Storage.Indices;
+}
+
+template <typename T>
+const std::vector<T> &CDS_SparseMatrix<T>::GetValues() const {
+  return this->_Storage.Values;
+}
+
+template <typename T> void CDS_SparseMatrix<T>::Transpose() {
+  // The compressed lines of A are the compressed lines of A^T in the other
+  // format, converting them back keeps the format.
+  this->_Storage = _Sparse::_Swap(this->_Storage, this->_Minor());
+  std::swap(this->_Rows, this->_Cols);
+}
+
+template <typename T>
+T CDS_SparseMatrix<T>::operator[](std::pair<int, int> indices) const {
+  auto [row, col] = indices;
+  assertm(row >= 0 && row < this->_Rows && col >= 0 && col < this->_Cols,
+          "Index out of range");
+  bool csr = this->_Format == Format::CSR;
+  int major = csr ? row : col;
+  int minor = csr ? col : row;
+  auto begin = this->_Storage.Indices.begin() + this->_Storage.Offsets[major];
+  auto end = this->_Storage.Indices.begin() + this->_Storage.Offsets[major + 1];
+  auto found = std::lower_bound(begin, end, minor);
+  if (found == end || *found != minor)
+    return T(0);
+  return this->_Storage.Values[found - this->_Storage.Indices.begin()];
+}
+
+// Definition of is-Member functions
+template <typename T> bool CDS_SparseMatrix<T>::IsSquare() const {
+  return this->_Rows == this->_Cols;
+}
+
+template <typename T> bool CDS_SparseMatrix<T>::IsSymmetric() const {
+  if (!this->IsSquare())
+    return false;
+  // Storage is canonical, so A == A^T exactly when the arrays match.
+  _Sparse::_Compressed<T> transposed =
+      _Sparse::_Swap(this->_Storage, this->_Minor());
+  return transposed.Offsets == this->_Storage.Offsets &&
+         transposed.Indices == this->_Storage.Indices &&
+         transposed.Values == this->_Storage.Values;
+}
+
+template <typename T> bool CDS_SparseMatrix<T>::IsDiagonal() const {
+  return this->_IsZeroBeyondDiagonal(true) &&
+         this->_IsZeroBeyondDiagonal(false);
+}
+
+template <typename T> bool CDS_SparseMatrix<T>::IsUpperTriangular() const {
+  return this->_IsZeroBeyondDiagonal(true);
+}
+
+template <typename T> bool CDS_SparseMatrix<T>::IsLowerTriangular() const {
+  return this->_IsZeroBeyondDiagonal(false);
+}
+
+template <typename T>
+bool CDS_SparseMatrix<T>::IsAddable(const CDS_SparseMatrix<T> &other) const {
+  return this->_Rows == other._Rows && this->_Cols == other._Cols;
+}
+
+template <typename T>
+bool CDS_SparseMatrix<T>::IsMultipliable(const CDS_Matrix<T> &other) const {
+  return this->_Cols == std::get<0>(other.GetShape());
+}
+
+// Private helpers
+template <typename T> int CDS_SparseMatrix<T>::_Major() const {
+  return this->_Format == Format::CSR ? this->_Rows : this->_Cols;
+}
+
+template <typename T> int CDS_SparseMatrix<T>::_Minor() const {
+  return this->_Format == Format::CSR ? this->_Cols : this->_Rows;
+}
+
+template <typename T> std::vector<int> CDS_SparseMatrix<T>::_Bands() const {
+  const std::vector<std::size_t> &offsets = this->_Storage.Offsets;
+  std::size_t nonZeros = this->NonZeros();
+  std::size_t count = std::clamp<std::size_t>(
+      (nonZeros + _Sparse::_BAND_NONZEROS - 1) / _Sparse::_BAND_NONZEROS, 1,
+      std::max(this->_Major(), 1));
+  std::vector<int> bands(count + 1, 0);
+  for (std::size_t b = 1; b < count; b++) {
+    std::size_t target = b * nonZeros / count;
+    // Last line starting at or before the target, bands stay monotonic
+    // because the targets are.
+    bands[b] = static_cast<int>(
+        std::upper_bound(offsets.begin(), offsets.end() - 1, target) -
+        offsets.begin() - 1);
+  }
+  bands[count] = this->_Major();
+  return bands;
+}
+
+template <typename T>
+bool CDS_SparseMatrix<T>::_IsZeroBeyondDiagonal(bool below) const {
+  bool csr = this->_Format == Format::CSR;
+  for (int k = 0; k < this->_Major(); k++) {
+    for (std::size_t p = this->_Storage.Offsets[k];
+         p < this->_Storage.Offsets[k + 1]; p++) {
+      int row = csr ? k : this->_Storage.Indices[p];
+      int col = csr ? this->_Storage.Indices[p] : k;
+      if (below ? row > col : row < col)
+        return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,425 @@
+#pragma once
+#include "CDS_StaticMatrix.hpp"
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+#define assertm(exp, msg) assert(((void)msg, exp))
+
+namespace _Static {
+
+template <class F, int... I>
+constexpr void _Unroll(F &body, std::integer_sequence<int, I...>) {
+  (body(I), ...);
+}
+
+template <int N, class F> constexpr void _For(F &&body) {
+  if constexpr (N <= _UNROLL) {
+    _Unroll(body, std::make_integer_sequence<int, N>{});
+  } else {
+    for (int i = 0; i < N; i++) {
+      body(i);
+    }
+  }
+}
+
+template <class T> constexpr T _Abs(const T &value) {
+  return value < T(0) ? -value : value;
+}
+
+} // namespace _Static
+
+// Constructors
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C>::CDS_StaticMatrix() : _Arr() {}
+
+template <class T, int R, int C>
+template <class... U>
+  requires(sizeof...(U) == R * C && sizeof...(U) > 1 &&
+           (std::is_convertible_v<U, T> && ...))
+constexpr CDS_StaticMatrix<T, R, C>::CDS_StaticMatrix(U... elems) : _Arr() {
+  std::size_t index = 0;
+  ((this->_Arr[index++] = static_cast<T>(elems)), ...);
+}
+
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C>::CDS_StaticMatrix(
+    const CDS_Arr<T, R * C> &elems)
+    : _Arr(elems) {}
+
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C> CDS_StaticMatrix<T, R, C>::Identity()
+  requires(R == C)
+{
+  CDS_StaticMatrix<T, R, C> out;
+  _Static::_For<R>([&](int i) { out._Arr[i * C + i] = T(1); });
+  return out;
+}
+
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C> CDS_StaticMatrix<T, R, C>::Null() {
+  return CDS_StaticMatrix<T, R, C>();
+}
+
+template <class T, int R, int C>
+CDS_StaticMatrix<T, R, C> CDS_StaticMatrix<T, R, C>::Rotation(float degree)
+  requires(R == C && R >= 2)
+{
+  double radians = degree * std::numbers::pi / 180.0;
+  T c = static_cast<T>(std::cos(radians));
+  T s = static_cast<T>(std::sin(radians));
+
+  CDS_StaticMatrix<T, R, C> out = CDS_StaticMatrix<T, R, C>::Identity();
+  out._Arr[0] = c;
+  out._Arr[1] = -s;
+  out._Arr[C] = s;
+  out._Arr[C + 1] = c;
+  return out;
+}
+
+// Arithmetic
+template <class T, int R, int C>
+template <int K>
+constexpr CDS_StaticMatrix<T, R, K>
+CDS_StaticMatrix<T, R, C>::operator*(
+    const CDS_StaticMatrix<T, C, K> &other) const {
+  CDS_StaticMatrix<T, R, K> out;
+  const T *b = other.GetData();
+  T *c = out.GetData();
+  _Static::_For<R * K>([&](int index) {
+    int row = index / K;
+    int col = index % K;
+    T sum = T();
+    _Static::_For<C>(
+        [&](int k) { sum += this->_Arr[row * C + k] * b[k * K + col]; });
+    c[index] = sum;
+  });
+  return out;
+}
+
+template <class T, int R, int C>
+constexpr CDS_Arr<T, R>
+CDS_StaticMatrix<T, R, C>::operator*(const CDS_Arr<T, C> &vector) const {
+  CDS_Arr<T, R> out;
+  _Static::_For<R>([&](int row) {
+    T sum = T();
+    _Static::_For<C>(
+        [&](int k) { sum += this->_Arr[row * C + k] * vector[k]; });
+    out[row] = sum;
+  });
+  return out;
+}
+
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C> CDS_StaticMatrix<T, R, C>::operator+(
+    const CDS_StaticMatrix<T, R, C> &other) const {
+  CDS_StaticMatrix<T, R, C> out;
+  _Static::_For<R * C>(
+      [&](int i) { out._Arr[i] = this->_Arr[i] + other._Arr[i]; });
+  return out;
+}
+
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C> CDS_StaticMatrix<T, R, C>::operator-(
+    const CDS_StaticMatrix<T, R, C> &other) const {
+  CDS_StaticMatrix<T, R, C> out;
+  _Static::_For<R * C>(
+      [&](int i) { out._Arr[i] = this->_Arr[i] - other._Arr[i]; });
+  return out;
+}
+
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C>
+operator*(const T &scalar, const CDS_StaticMatrix<T, R, C> &matrix) {
+  CDS_StaticMatrix<T, R, C> out;
+  T *data = out.GetData();
+  const T *in = matrix.GetData();
+  _Static::_For<R * C>([&](int i) { data[i] = scalar * in[i]; });
+  return out;
+}
+
+template <class T, int R, int C>
+constexpr bool CDS_StaticMatrix<T, R, C>::operator==(
+    const CDS_StaticMatrix<T, R, C> &other) const {
+  for (int i = 0; i < R * C; i++) {
+    if (this->_Arr[i] != other._Arr[i])
+      return false;
+  }
+  return true;
+}
+
+// Element Access
+template <class T, int R, int C>
+constexpr T &CDS_StaticMatrix<T, R, C>::operator[](std::pair<int, int> index) {
+  assertm(index.first >= 0 && index.first < R && index.second >= 0 &&
+              index.second < C,
+          "Index out of range");
+  return this->_Arr[index.first * C + index.second];
+}
+
+template <class T, int R, int C>
+constexpr const T &
+CDS_StaticMatrix<T, R, C>::operator[](std::pair<int, int> index) const {
+  assertm(index.first >= 0 && index.first < R && index.second >= 0 &&
+              index.second < C,
+          "Index out of range");
+  return this->_Arr[index.first * C + index.second];
+}
+
+// Getters
+template <class T, int R, int C>
+constexpr std::tuple<int, int> CDS_StaticMatrix<T, R, C>::GetShape() const {
+  return std::make_tuple(R, C);
+}
+
+template <class T, int R, int C>
+constexpr T *CDS_StaticMatrix<T, R, C>::GetData() {
+  return this->_Arr.GetData();
+}
+
+template <class T, int R, int C>
+constexpr const T *CDS_StaticMatrix<T, R, C>::GetData() const {
+  return this->_Arr.GetData();
+}
+
+template <class T, int R, int C>
+CDS_MatrixView<T> CDS_StaticMatrix<T, R, C>::View() {
+  return CDS_MatrixView<T>(this->_Arr.GetData(), R, C, C, 1);
+}
+
+template <class T, int R, int C>
+CDS_MatrixView<const T> CDS_StaticMatrix<T, R, C>::View() const {
+  return CDS_MatrixView<const T>(this->_Arr.GetData(), R, C, C, 1);
+}
+
+// Matrix Operations
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, C, R>
+CDS_StaticMatrix<T, R, C>::Transposed() const {
+  CDS_StaticMatrix<T, C, R> out;
+  T *data = out.GetData();
+  _Static::_For<R * C>([&](int index) {
+    int row = index / C;
+    int col = index % C;
+    data[col * R + row] = this->_Arr[index];
+  });
+  return out;
+}
+
+template <class T, int R, int C>
+constexpr void CDS_StaticMatrix<T, R, C>::Transpose()
+  requires(R == C)
+{
+  *this = this->Transposed();
+}
+
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C> CDS_StaticMatrix<T, R, C>::Inverted() const
+  requires(R == C)
+{
+  const CDS_Arr<T, R * C> &a = this->_Arr;
+  CDS_StaticMatrix<T, R, C> out;
+  CDS_Arr<T, R * C> &b = out._Arr;
+
+  if constexpr (R == 1) {
+    assertm(a[0] != T(0), "Matrix is singular");
+    b[0] = T(1) / a[0];
+  } else if constexpr (R == 2) {
+    T det = a[0] * a[3] - a[1] * a[2];
+    assertm(det != T(0), "Matrix is singular");
+    b[0] = a[3] / det;
+    b[1] = -a[1] / det;
+    b[2] = -a[2] / det;
+    b[3] = a[0] / det;
+  } else if constexpr (R == 3) {
+    b[0] = a[4] * a[8] - a[5] * a[7];
+    b[1] = a[2] * a[7] - a[1] * a[8];
+    b[2] = a[1] * a[5] - a[2] * a[4];
+    b[3] = a[5] * a[6] - a[3] * a[8];
+    b[4] = a[0] * a[8] - a[2] * a[6];
+    b[5] = a[2] * a[3] - a[0] * a[5];
+    b[6] = a[3] * a[7] - a[4] * a[6];
+    b[7] = a[1] * a[6] - a[0] * a[7];
+    b[8] = a[0] * a[4] - a[1] * a[3];
+    T det = a[0] * b[0] + a[1] * b[3] + a[2] * b[6];
+    assertm(det != T(0), "Matrix is singular");
+    _Static::_For<9>([&](int i) { b[i] /= det; });
+  } else if constexpr (R == 4) {
+    // 2x2 minors of the top (s) and bottom (c) row pairs, the adjugate is
+    // assembled from their products.
+    T s0 = a[0] * a[5] - a[4] * a[1];
+    T s1 = a[0] * a[6] - a[4] * a[2];
+    T s2 = a[0] * a[7] - a[4] * a[3];
+    T s3 = a[1] * a[6] - a[5] * a[2];
+    T s4 = a[1] * a[7] - a[5] * a[3];
+    T s5 = a[2] * a[7] - a[6] * a[3];
+    T c5 = a[10] * a[15] - a[14] * a[11];
+    T c4 = a[9] * a[15] - a[13] * a[11];
+    T c3 = a[9] * a[14] - a[13] * a[10];
+    T c2 = a[8] * a[15] - a[12] * a[11];
+    T c1 = a[8] * a[14] - a[12] * a[10];
+    T c0 = a[8] * a[13] - a[12] * a[9];
+    T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    assertm(det != T(0), "Matrix is singular");
+
+    b[0] = a[5] * c5 - a[6] * c4 + a[7] * c3;
+    b[1] = -a[1] * c5 + a[2] * c4 - a[3] * c3;
+    b[2] = a[13] * s5 - a[14] * s4 + a[15] * s3;
+    b[3] = -a[9] * s5 + a[10] * s4 - a[11] * s3;
+    b[4] = -a[4] * c5 + a[6] * c2 - a[7] * c1;
+    b[5] = a[0] * c5 - a[2] * c2 + a[3] * c1;
+    b[6] = -a[12] * s5 + a[14] * s2 - a[15] * s1;
+    b[7] = a[8] * s5 - a[10] * s2 + a[11] * s1;
+    b[8] = a[4] * c4 - a[5] * c2 + a[7] * c0;
+    b[9] = -a[0] * c4 + a[1] * c2 - a[3] * c0;
+    b[10] = a[12] * s4 - a[13] * s2 + a[15] * s0;
+    b[11] = -a[8] * s4 + a[9] * s2 - a[11] * s0;
+    b[12] = -a[4] * c3 + a[5] * c1 - a[6] * c0;
+    b[13] = a[0] * c3 - a[1] * c1 + a[2] * c0;
+    b[14] = -a[12] * s3 + a[13] * s1 - a[14] * s0;
+    b[15] = a[8] * s3 - a[9] * s1 + a[10] * s0;
+    _Static::_For<16>([&](int i) { b[i] /= det; });
+  } else {
+    out = this->_GaussJordanInverse();
+  }
+  return out;
+}
+
+template <class T, int R, int C>
+constexpr void CDS_StaticMatrix<T, R, C>::Inverse()
+  requires(R == C)
+{
+  *this = this->Inverted();
+}
+
+template <class T, int R, int C>
+constexpr CDS_StaticMatrix<T, R, C>
+CDS_StaticMatrix<T, R, C>::_GaussJordanInverse() const {
+  CDS_Arr<T, R * C> a = this->_Arr;
+  CDS_StaticMatrix<T, R, C> out = CDS_StaticMatrix<T, R, C>::Identity();
+  CDS_Arr<T, R * C> &b = out._Arr;
+
+  for (int col = 0; col < C; col++) {
+    int pivot = col;
+    for (int row = col + 1; row < R; row++) {
+      if (_Static::_Abs(a[row * C + col]) > _Static::_Abs(a[pivot * C + col]))
+        pivot = row;
+    }
+    assertm(a[pivot * C + col] != T(0), "Matrix is singular");
+    if (pivot != col) {
+      for (int k = 0; k < C; k++) {
+        a.Swap(pivot * C + k, col * C + k);
+        b.Swap(pivot * C + k, col * C + k);
+      }
+    }
+
+    T scale = T(1) / a[col * C + col];
+    for (int k = 0; k < C; k++) {
+      a[col * C + k] *= scale;
+      b[col * C + k] *= scale;
+    }
+    for (int row = 0; row < R; row++) {
+      T factor = a[row * C + col];
+      if (row == col || factor == T(0))
+        continue;
+      for (int k = 0; k < C; k++) {
+        a[row * C + k] -= factor * a[col * C + k];
+        b[row * C + k] -= factor * b[col * C + k];
+      }
+    }
+  }
+  return out;
+}
+
+template <class T, int R, int C>
+constexpr T CDS_StaticMatrix<T, R, C>::Determinant() const
+  requires(R == C)
+{
+  const CDS_Arr<T, R * C> &a = this->_Arr;
+
+  if constexpr (R == 1) {
+    return a[0];
+  } else if constexpr (R == 2) {
+    return a[0] * a[3] - a[1] * a[2];
+  } else if constexpr (R == 3) {
+    return a[0] * (a[4] * a[8] - a[5] * a[7]) -
+           a[1] * (a[3] * a[8] - a[5] * a[6]) +
+           a[2] * (a[3] * a[7] - a[4] * a[6]);
+  } else if constexpr (R == 4) {
+    T s0 = a[0] * a[5] - a[4] * a[1];
+    T s1 = a[0] * a[6] - a[4] * a[2];
+    T s2 = a[0] * a[7] - a[4] * a[3];
+    T s3 = a[1] * a[6] - a[5] * a[2];
+    T s4 = a[1] * a[7] - a[5] * a[3];
+    T s5 = a[2] * a[7] - a[6] * a[3];
+    T c5 = a[10] * a[15] - a[14] * a[11];
+    T c4 = a[9] * a[15] - a[13] * a[11];
+    T c3 = a[9] * a[14] - a[13] * a[10];
+    T c2 = a[8] * a[15] - a[12] * a[11];
+    T c1 = a[8] * a[14] - a[12] * a[10];
+    T c0 = a[8] * a[13] - a[12] * a[9];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  } else if constexpr (std::is_integral_v<T>) {
+    // Bareiss elimination, every division is exact.
+    CDS_Arr<T, R * C> m = a;
+    T sign = T(1);
+    T previous = T(1);
+    for (int k = 0; k < R - 1; k++) {
+      if (m[k * C + k] == T(0)) {
+        int swap = k + 1;
+        while (swap < R && m[swap * C + k] == T(0))
+          swap++;
+        if (swap == R)
+          return T(0);
+        for (int j = 0; j < C; j++) {
+          m.Swap(k * C + j, swap * C + j);
+        }
+        sign = -sign;
+      }
+      for (int i = k + 1; i < R; i++) {
+        for (int j = k + 1; j < C; j++) {
+          m[i * C + j] = (m[i * C + j] * m[k * C + k] -
+                          m[i * C + k] * m[k * C + j]) /
+                         previous;
+        }
+      }
+      previous = m[k * C + k];
+    }
+    return sign * m[(R - 1) * C + (R - 1)];
+  } else {
+    CDS_Arr<T, R * C> m = a;
+    T det = T(1);
+    for (int k = 0; k < R; k++) {
+      int pivot = k;
+      for (int i = k + 1; i < R; i++) {
+        if (_Static::_Abs(m[i * C + k]) > _Static::_Abs(m[pivot * C + k]))
+          pivot = i;
+      }
+      if (m[pivot * C + k] == T(0))
+        return T(0);
+      if (pivot != k) {
+        for (int j = 0; j < C; j++) {
+          m.Swap(k * C + j, pivot * C + j);
+        }
+        det = -det;
+      }
+      det *= m[k * C + k];
+      for (int i = k + 1; i < R; i++) {
+        T factor = m[i * C + k] / m[k * C + k];
+        for (int j = k + 1; j < C; j++) {
+          m[i * C + j] -= factor * m[k * C + j];
+        }
+      }
+    }
+    return det;
+  }
+}
+
+template <class T, int R, int C>
+constexpr T CDS_StaticMatrix<T, R, C>::Trace() const
+  requires(R == C)
+{
+  T sum = T();
+  _Static::_For<R>([&](int i) { sum += this->_Arr[i * C + i]; });
+  return sum;
+}
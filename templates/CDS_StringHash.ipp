@@ -0,0 +1,135 @@
+#pragma once
+#include "CDS_StringHash.hpp"
+#include <cstring>
+
+namespace _StringHash {
+
+/**
+ * @brief Odd constants with balanced bits, mixed into every step.
+ */
+constexpr std::uint64_t _SECRET[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL,
+    0x4d5a2da51de1aa47ULL};
+
+/**
+ * @brief Replace two words by the low and high half of their product.
+ */
+inline void _Multiply(std::uint64_t &a, std::uint64_t &b) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  a = static_cast<std::uint64_t>(product);
+  b = static_cast<std::uint64_t>(product >> 64);
+#else
+  std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+  std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+  std::uint64_t high = aHigh * bHigh, middle0 = aHigh * bLow;
+  std::uint64_t middle1 = aLow * bHigh, low = aLow * bLow;
+  std::uint64_t carry = (low >> 32) + static_cast<std::uint32_t>(middle0) +
+                        static_cast<std::uint32_t>(middle1);
+  a = (carry << 32) | static_cast<std::uint32_t>(low);
+  b = high + (middle0 >> 32) + (middle1 >> 32) + (carry >> 32);
+#endif
+}
+
+/**
+ * @brief Fold the 128-bit product of two words into one word.
+ */
+inline std::uint64_t _Fold(std::uint64_t a, std::uint64_t b) {
+  _Multiply(a, b);
+  return a ^ b;
+}
+
+inline std::uint64_t _Read8(const std::uint8_t *bytes) {
+  std::uint64_t word;
+  std::memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+inline std::uint64_t _Read4(const std::uint8_t *bytes) {
+  std::uint32_t word;
+  std::memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+/**
+ * @brief Read 1 to 3 bytes as the first, middle and last one.
+ */
+inline std::uint64_t _Read3(const std::uint8_t *bytes, std::size_t length) {
+  return (std::uint64_t(bytes[0]) << 16) |
+         (std::uint64_t(bytes[length >> 1]) << 8) | bytes[length - 1];
+}
+
+} // namespace _StringHash
+
+inline std::uint64_t CDS_HashBytes(const void *data, std::size_t length,
+                                   std::uint64_t seed) {
+  using namespace _StringHash;
+  const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+  seed ^= _Fold(seed ^ _SECRET[0], _SECRET[1]);
+  std::uint64_t a, b;
+  if (length <= 16) {
+    // Short keys are read as at most four overlapping words, no loop.
+    if (length >= 4) {
+      std::size_t shift = (length >> 3) << 2;
+      a = (_Read4(bytes) << 32) | _Read4(bytes + shift);
+      b = (_Read4(bytes + length - 4) << 32) |
+          _Read4(bytes + length - 4 - shift);
+    } else if (length > 0) {
+      a = _Read3(bytes, length);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    std::size_t left = length;
+    if (left >= 48) {
+      // Three independent lanes keep the multipliers busy on long keys.
+      std::uint64_t seed1 = seed, seed2 = seed;
+      do {
+        seed = _Fold(_Read8(bytes) ^ _SECRET[1], _Read8(bytes + 8) ^ seed);
+        seed1 =
+            _Fold(_Read8(bytes + 16) ^ _SECRET[2], _Read8(bytes + 24) ^ seed1);
+        seed2 =
+            _Fold(_Read8(bytes + 32) ^ _SECRET[3], _Read8(bytes + 40) ^ seed2);
+        bytes += 48;
+        left -= 48;
+      } while (left >= 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (left > 16) {
+      seed = _Fold(_Read8(bytes) ^ _SECRET[1], _Read8(bytes + 8) ^ seed);
+      bytes += 16;
+      left -= 16;
+    }
+    a = _Read8(bytes + left - 16);
+    b = _Read8(bytes + left - 8);
+  }
+  a ^= _SECRET[1];
+  b ^= seed;
+  _Multiply(a, b);
+  return _Fold(a ^ _SECRET[0] ^ length, b ^ _SECRET[1]);
+}
+
+// CDS_StringHash
+inline std::size_t CDS_StringHash::operator()(std::string_view key) const {
+  return static_cast<std::size_t>(CDS_HashBytes(key.data(), key.size()));
+}
+
+inline std::size_t
+CDS_StringHash::operator()(std::span<const std::byte> key) const {
+  return static_cast<std::size_t>(CDS_HashBytes(key.data(), key.size()));
+}
+
+// CDS_StringEqual
+inline bool CDS_StringEqual::operator()(std::string_view key,
+                                        std::string_view other) const {
+  return key == other;
+}
+
+inline bool
+CDS_StringEqual::operator()(std::string_view key,
+                            std::span<const std::byte> other) const {
+  return key.size() == other.size() &&
+         (other.empty() ||
+          std::memcmp(key.data(), other.data(), key.size()) == 0);
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include "CDS_StringMap.hpp"
+#include <cstring>
+#include <utility>
+
+template <class V>
+CDS_StringMap<V>::CDS_StringMap(float maxLoadFactor) : _Map(maxLoadFactor) {}
+
+template <class V>
+CDS_StringMap<V>::CDS_StringMap(const CDS_StringMap &other)
+    : _Map(other._Map.GetMaxLoadFactor()) {
+  // The copied views would point into the other arena, so the keys are
+  // interned again.
+  this->_Map.Reserve(other.GetSize());
+  other._Map.ForEach([this](std::string_view key, const V &value) {
+    this->_Map.Insert(this->Intern(key), value);
+  });
+}
+
+template <class V>
+CDS_StringMap<V> &CDS_StringMap<V>::operator=(CDS_StringMap other) noexcept {
+  this->Swap(other);
+  return *this;
+}
+
+// Getters
+template <class V> std::size_t CDS_StringMap<V>::GetSize() const {
+  return this->_Map.GetSize();
+}
+
+template <class V> std::size_t CDS_StringMap<V>::GetCapacity() const {
+  return this->_Map.GetCapacity();
+}
+
+template <class V> std::size_t CDS_StringMap<V>::GetKeyBytes() const {
+  return this->_Keys ? this->_Keys->GetUsed() : 0;
+}
+
+template <class V>
+CDS_Result<V> CDS_StringMap<V>::Get(std::string_view key) const {
+  return this->_Map.Get(key);
+}
+
+template <class V>
+CDS_Result<V> CDS_StringMap<V>::Get(std::span<const std::byte> key) const {
+  return this->_Map.Get(key);
+}
+
+template <class V> V *CDS_StringMap<V>::Find(std::string_view key) {
+  return this->_Map.Find(key);
+}
+
+template <class V>
+const V *CDS_StringMap<V>::Find(std::string_view key) const {
+  return this->_Map.Find(key);
+}
+
+template <class V> V *CDS_StringMap<V>::Find(std::span<const std::byte> key) {
+  return this->_Map.Find(key);
+}
+
+template <class V>
+const V *CDS_StringMap<V>::Find(std::span<const std::byte> key) const {
+  return this->_Map.Find(key);
+}
+
+template <class V> bool CDS_StringMap<V>::Contains(std::string_view key) const {
+  return this->_Map.Contains(key);
+}
+
+template <class V>
+bool CDS_StringMap<V>::Contains(std::span<const std::byte> key) const {
+  return this->_Map.Contains(key);
+}
+
+// Modifiers
+template <class V>
+CDS_Result<V *> CDS_StringMap<V>::Insert(std::string_view key, V value) {
+  // The key is copied into the arena before the map hashes it, so the map
+  // hashes it only once. If it exists, the copy is the latest allocation of
+  // the arena and is handed straight back.
+  std::string_view interned = this->Intern(key);
+  CDS_Result<V *> inserted = this->_Map.Insert(interned, std::move(value));
+  if (inserted.IsError() && !interned.empty())
+    this->_Keys->Deallocate(const_cast<char *>(interned.data()),
+                            interned.size(), 1);
+  return inserted;
+}
+
+template <class V> V &CDS_StringMap<V>::Set(std::string_view key, V value) {
+  if (V *existing = this->_Map.Find(key)) {
+    *existing = std::move(value);
+    return *existing;
+  }
+  return *this->_Map.Insert(this->Intern(key), std::move(value)).Unpack();
+}
+
+template <class V>
+CDS_Result<V> CDS_StringMap<V>::Delete(std::string_view key) {
+  return this->_Map.Delete(key);
+}
+
+template <class V>
+CDS_Result<V> CDS_StringMap<V>::Delete(std::span<const std::byte> key) {
+  return this->_Map.Delete(key);
+}
+
+template <class V> void CDS_StringMap<V>::Clear() {
+  this->_Map.Clear();
+  if (this->_Keys)
+    this->_Keys->Reset();
+}
+
+template <class V> void CDS_StringMap<V>::Reserve(std::size_t count) {
+  this->_Map.Reserve(count);
+}
+
+template <class V>
+template <class Function>
+void CDS_StringMap<V>::ForEach(Function function) {
+  this->_Map.ForEach(function);
+}
+
+template <class V>
+template <class Function>
+void CDS_StringMap<V>::ForEach(Function function) const {
+  this->_Map.ForEach(function);
+}
+
+template <class V> void CDS_StringMap<V>::Swap(CDS_StringMap &other) noexcept {
+  this->_Map.Swap(other._Map);
+  this->_Keys.swap(other._Keys);
+}
+
+// Operator Overloads
+template <class V> V &CDS_StringMap<V>::operator[](std::string_view key) {
+  if (V *existing = this->_Map.Find(key))
+    return *existing;
+  return *this->_Map.Insert(this->Intern(key), V()).Unpack();
+}
+
+// Private
+template <class V>
+std::string_view CDS_StringMap<V>::Intern(std::string_view key) {
+  if (key.empty())
+    return {};
+  if (!this->_Keys)
+    this->_Keys = std::make_unique<CDS_Arena>(4096);
+  char *copy = static_cast<char *>(this->_Keys->Allocate(key.size(), 1));
+  std::memcpy(copy, key.data(), key.size());
+  return {copy, key.size()};
+}
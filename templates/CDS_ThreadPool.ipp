@@ -0,0 +1,48 @@
+#pragma once
+#include "CDS_ThreadPool.hpp"
+#include <algorithm>
+#include <type_traits>
+
+// Parallel Loops
+template <class F>
+void CDS_ThreadPool::ParallelFor(std::size_t count, std::size_t work,
+                                 F &&body) {
+  if (count == 0)
+    return;
+  if (count == 1 || this->IsSerial(work)) {
+    for (std::size_t i = 0; i < count; i++) {
+      body(i);
+    }
+    return;
+  }
+
+  using Body = std::remove_reference_t<F>;
+  this->_Dispatch(
+      count,
+      [](void *context, std::size_t index) {
+        (*static_cast<Body *>(context))(index);
+      },
+      const_cast<void *>(static_cast<const void *>(&body)));
+}
+
+template <class F>
+void CDS_ThreadPool::ParallelFor2D(int rows, int cols, int tileRows,
+                                   int tileCols, std::size_t work, F &&body) {
+  if (rows <= 0 || cols <= 0)
+    return;
+  if (this->IsSerial(work)) {
+    body(0, rows, 0, cols);
+    return;
+  }
+
+  tileRows = std::clamp(tileRows, 1, rows);
+  tileCols = std::clamp(tileCols, 1, cols);
+  std::size_t tilesDown = (rows + tileRows - 1) / tileRows;
+  std::size_t tilesAcross = (cols + tileCols - 1) / tileCols;
+  this->ParallelFor(tilesDown * tilesAcross, work, [&](std::size_t tile) {
+    int row = static_cast<int>(tile / tilesAcross) * tileRows;
+    int col = static_cast<int>(tile % tilesAcross) * tileCols;
+    body(row, std::min(row + tileRows, rows), col,
+         std::min(col + tileCols, cols));
+  });
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "CDS_Allocator.hpp"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+
+static bool IsAligned(const void* pointer, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+TEST(CDS_AllocatorTest, ArenaBumpsAndResets) {
+    CDS_Arena arena(1024);
+    char* a = static_cast<char*>(arena.Allocate(10, 1));
+    char* b = static_cast<char*>(arena.Allocate(8, 8));
+    EXPECT_EQ(a + 16, b);
+    EXPECT_TRUE(IsAligned(arena.Allocate(1, 64), 64));
+    EXPECT_GE(arena.GetUsed(), 19u);
+
+    // Requests larger than a block get a block of their own.
+    void* large = arena.Allocate(5000, 16);
+    EXPECT_TRUE(IsAligned(large, 16));
+    std::size_t capacity = arena.GetCapacity();
+    EXPECT_GE(capacity, 6024u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetUsed(), 0u);
+    EXPECT_EQ(arena.Allocate(10, 1), a);
+    EXPECT_EQ(arena.GetCapacity(), capacity);
+}
+
+TEST(CDS_AllocatorTest, ArenaRollsBackLatestAllocation) {
+    CDS_Arena arena;
+    void* first = arena.Allocate(64);
+    void* second = arena.Allocate(32);
+    arena.Deallocate(first, 64);
+    EXPECT_NE(arena.Allocate(16), first);
+    arena.Reset();
+    first = arena.Allocate(64);
+    arena.Deallocate(first, 64);
+    EXPECT_EQ(arena.Allocate(128), first);
+    (void)second;
+}
+
+TEST(CDS_AllocatorTest, PoolReusesChunksPerSizeClass) {
+    CDS_Pool pool;
+    void* a = pool.Allocate(24);
+    void* b = pool.Allocate(30);
+    EXPECT_NE(a, b);
+    EXPECT_TRUE(IsAligned(a, 32));
+    pool.Deallocate(a, 24);
+    EXPECT_EQ(pool.Allocate(32), a);
+
+    void* aligned = pool.Allocate(8, 64);
+    EXPECT_TRUE(IsAligned(aligned, 64));
+    pool.Deallocate(aligned, 8, 64);
+
+    // Beyond the largest class the pool forwards to the heap.
+    void* large = pool.Allocate(100000, 128);
+    EXPECT_TRUE(IsAligned(large, 128));
+    pool.Deallocate(large, 100000, 128);
+
+    std::set<void*> distinct;
+    for (int i = 0; i < 5000; ++i) {
+        distinct.insert(pool.Allocate(48));
+    }
+    EXPECT_EQ(distinct.size(), 5000u);
+}
+
+TEST(CDS_AllocatorTest, WorksWithStandardContainers) {
+    CDS_Pool pool;
+    using Entry = std::pair<const int, int>;
+    std::map<int, int, std::less<int>, CDS_PoolAllocator<Entry>> map{
+        CDS_PoolAllocator<Entry>(pool)};
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = i * i;
+    }
+    EXPECT_EQ(map[31], 961);
+
+    CDS_Arena arena;
+    {
+        std::vector<int, CDS_ArenaAllocator<int>> vector{
+            CDS_ArenaAllocator<int>(arena)};
+        for (int i = 0; i < 1000; ++i) {
+            vector.push_back(i);
+        }
+        EXPECT_EQ(vector[999], 999);
+    }
+    CDS_ArenaAllocator<int> ints(arena);
+    CDS_ArenaAllocator<double> doubles(ints);
+    EXPECT_TRUE(ints == doubles);
+    CDS_Arena other;
+    EXPECT_FALSE(ints == CDS_ArenaAllocator<int>(other));
+}
@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
-#include "CDS_Arr.h"
+#include "CDS_Arr.hpp"
+
+#include <algorithm>
+#include <span>
+#include <sstream>
+#include <string>
+
+// Size of the arrays of the typed tests
+constexpr int N = 5;
 
 // Test fixture for CDS_Arr class
-template <typename T, int N>
+template <typename T>
 class CDS_ArrTest : public ::testing::Test {
 protected:
     CDS_Arr<T, N> arr;
@@ -12,7 +20,7 @@ using MyTypes = ::testing::Types<int, float, double>;
 TYPED_TEST_SUITE(CDS_ArrTest, MyTypes);
 
 TYPED_TEST(CDS_ArrTest, GetSizeTest) {
-    EXPECT_EQ(this->arr.GetSize(), N);
+    EXPECT_EQ(this->arr.GetSize(), static_cast<size_t>(N));
 }
 
 TYPED_TEST(CDS_ArrTest, GetDataTest) {
@@ -62,9 +70,72 @@ TYPED_TEST(CDS_ArrTest, StreamOutputTest) {
     this->arr.Fill(value);
     std::stringstream ss;
     ss << this->arr;
-    std::string expectedOutput;
+    std::stringstream element;
+    element << value;
+    std::string expectedOutput = "[";
     for (int i = 0; i < N; ++i) {
-        expectedOutput += std::to_string(value) + " ";
+        expectedOutput += element.str() + (i + 1 < N ? ", " : "]");
     }
     EXPECT_EQ(ss.str(), expectedOutput);
 }
+
+static_assert(std::contiguous_iterator<CDS_Arr<int, 4>::iterator>);
+static_assert(std::contiguous_iterator<CDS_Arr<int, 4>::const_iterator>);
+static_assert(std::ranges::contiguous_range<CDS_Arr<int, 4>>);
+static_assert(std::ranges::contiguous_range<const CDS_Arr<int, 4>>);
+
+TEST(CDS_ArrRangeTest, ContiguousRange) {
+    CDS_Arr<int, 5> arr;
+    for (int i = 0; i < 5; ++i) {
+        arr[i] = 5 - i;
+    }
+    std::ranges::sort(arr);
+    EXPECT_EQ(*(arr.cend() - 1), 5);
+    EXPECT_EQ(arr.end() - arr.begin(), 5);
+
+    // Spans alias the array, they do not copy it.
+    std::span<int> span = arr;
+    EXPECT_EQ(span.data(), arr.GetData());
+    span[0] = 10;
+    EXPECT_EQ(arr[0], 10);
+
+    const CDS_Arr<int, 5>& constant = arr;
+    std::span<const int> view = constant;
+    EXPECT_EQ(view.size(), 5u);
+    EXPECT_EQ(view.data(), constant.GetData());
+    EXPECT_EQ(view[1], 2);
+}
+
+namespace {
+
+constexpr CDS_Arr<int, 8> SQUARES =
+    CDS_Arr<int, 8>::Generate([](size_t i) { return int(i * i); });
+
+constexpr CDS_Arr<int, 6> SortedDescending() {
+    CDS_Arr<int, 6> arr{3, 1, 4, 1, 5, 9};
+    arr.Sort(std::greater<>());
+    arr.Swap(0, 5);
+    return arr;
+}
+
+} // namespace
+
+TEST(CDS_ArrConstexprTest, CompileTimeTables) {
+    static_assert(SQUARES[7] == 49);
+    static_assert(SQUARES.Find(25) == 5);
+    static_assert(SQUARES.Find(3) == 8);
+    static_assert(SQUARES.LowerBound(10) == 4);
+    static_assert(SQUARES.Sum() == 140);
+
+    constexpr auto halves =
+        SQUARES.Transform([](int x) { return x / 2.0; });
+    static_assert(std::is_same_v<decltype(halves), const CDS_Arr<double, 8>>);
+    static_assert(halves[3] == 4.5);
+
+    constexpr CDS_Arr<int, 6> sorted = SortedDescending();
+    static_assert(sorted[0] == 1 && sorted[1] == 5 && sorted[5] == 9);
+
+    constexpr CDS_Arr<int, 4> partial{7, 8};
+    static_assert(partial[1] == 8 && partial[3] == 0);
+    EXPECT_EQ(SQUARES.LowerBound(50), 8u);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "CDS_ConcurrentHashMap.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Value whose halves must always agree, a torn read shows up as a
+ * mismatch.
+ */
+struct Pair {
+    std::uint64_t First;
+    std::uint64_t Second;
+};
+
+} // namespace
+
+TEST(CDS_ConcurrentHashMapTest, SingleThreaded) {
+    CDS_ConcurrentHashMap<int, int> map(5);
+    EXPECT_EQ(map.GetShardCount(), 8u);
+    static_assert(CDS_ConcurrentHashMap<int, int>::LockFreeReads);
+    static_assert(!CDS_ConcurrentHashMap<int, std::string>::LockFreeReads);
+
+    EXPECT_TRUE(map.Get(1).IsError());
+    ASSERT_TRUE(map.Insert(1, 10).IsSucces());
+    EXPECT_TRUE(map.Insert(1, 11).IsError());
+    EXPECT_EQ(map.Get(1).Unpack(), 10);
+    map.Set(1, 12);
+    EXPECT_TRUE(map.Update(1, [](int& value) { value++; }));
+    EXPECT_FALSE(map.Update(2, [](int& value) { value++; }));
+    EXPECT_EQ(map.Get(1).Unpack(), 13);
+
+    for (int i = 2; i < 10000; ++i) {
+        map.Set(i, i * 10);
+    }
+    EXPECT_EQ(map.GetSize(), 9999u);
+    for (int i = 2; i < 10000; i += 2) {
+        EXPECT_EQ(map.Delete(i).Unpack(), i * 10);
+    }
+    EXPECT_TRUE(map.Delete(2).IsError());
+    EXPECT_EQ(map.GetSize(), 5000u);
+    EXPECT_FALSE(map.Contains(4));
+    EXPECT_TRUE(map.Contains(5));
+
+    long long sum = 0;
+    map.ForEach([&](const int& key, int& value) { sum += value - key * 10; });
+    EXPECT_EQ(sum, 3);
+
+    map.Clear();
+    EXPECT_EQ(map.GetSize(), 0u);
+    EXPECT_FALSE(map.Contains(5));
+}
+
+TEST(CDS_ConcurrentHashMapTest, LockFreeReadersSeeWholeValues) {
+    constexpr int writers = 4;
+    constexpr std::uint64_t keys = 4096;
+    CDS_ConcurrentHashMap<std::uint64_t, Pair> map(16);
+    std::atomic<bool> done{false};
+    std::atomic<long> torn{0};
+    std::atomic<long> hits{0};
+    std::atomic<int> ready{0};
+    for (std::uint64_t key = 0; key < keys; ++key) {
+        map.Set(key, Pair{key, key});
+    }
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t] {
+            std::uint64_t key = t;
+            ready++;
+            while (!done.load()) {
+                key = (key * 2654435761u + 1) % keys;
+                CDS_Result<Pair> found = map.Get(key);
+                if (found.IsSucces()) {
+                    Pair pair = found.Unpack();
+                    if (pair.First != pair.Second || pair.First % keys != key)
+                        torn++;
+                    hits++;
+                }
+            }
+        });
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < writers; ++t) {
+        workers.emplace_back([&, t] {
+            while (ready.load() < 4) {
+                std::this_thread::yield();
+            }
+            for (std::uint64_t round = 1; round < 40; ++round) {
+                for (std::uint64_t key = t; key < keys; key += writers) {
+                    std::uint64_t value = key + round * keys;
+                    if ((key + round) % 3 == 0)
+                        map.Delete(key);
+                    else
+                        map.Set(key, Pair{value, value});
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_GT(hits.load(), 0);
+
+    std::size_t expected = 0;
+    for (std::uint64_t key = 0; key < keys; ++key) {
+        bool present = (key + 39) % 3 != 0;
+        expected += present;
+        EXPECT_EQ(map.Contains(key), present);
+    }
+    EXPECT_EQ(map.GetSize(), expected);
+}
+
+TEST(CDS_ConcurrentHashMapTest, ConcurrentUpdatesOfLockedTypes) {
+    CDS_ConcurrentHashMap<std::string, std::string> map;
+    CDS_ConcurrentHashMap<int, long> counters;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 8; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < 2000; ++i) {
+                std::string key = std::to_string(t) + ":" + std::to_string(i);
+                EXPECT_TRUE(map.Insert(key, key + key).IsSucces());
+                EXPECT_EQ(map.Get(key).Unpack(), key + key);
+                counters.Insert(i % 16, 0);
+                counters.Update(i % 16, [](long& value) { value++; });
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(map.GetSize(), 16000u);
+    EXPECT_EQ(map.Get("7:1999").Unpack(), "7:19997:1999");
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(counters.Get(i).Unpack(), 1000);
+    }
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "CDS_ConcurrentList.hpp"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(CDS_ConcurrentListTest, SegmentArithmetic) {
+    EXPECT_EQ(_Segment::_Locate(0).Segment, 0u);
+    EXPECT_EQ(_Segment::_Locate(63).Offset, 63u);
+    EXPECT_EQ(_Segment::_Locate(64).Segment, 1u);
+    EXPECT_EQ(_Segment::_Locate(64).Offset, 0u);
+    EXPECT_EQ(_Segment::_Locate(191).Segment, 1u);
+    EXPECT_EQ(_Segment::_Locate(192).Segment, 2u);
+    EXPECT_EQ(_Segment::_Capacity(2), 256u);
+}
+
+TEST(CDS_ConcurrentListTest, ManyProducers) {
+    constexpr int threads = 8;
+    constexpr int perThread = 50000;
+    CDS_ConcurrentList<int> list;
+    std::vector<const int*> firsts(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            firsts[t] = &list.Append(t * perThread);
+            for (int i = 1; i < perThread; ++i) {
+                list.Emplace(t * perThread + i);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    ASSERT_EQ(list.GetSize(), size_t(threads) * perThread);
+    // Elements never move while the list grows.
+    for (int t = 0; t < threads; ++t) {
+        EXPECT_EQ(*firsts[t], t * perThread);
+    }
+
+    CDS_List<int> frozen = list.Freeze();
+    EXPECT_EQ(list.GetSize(), 0u);
+    ASSERT_EQ(frozen.GetSize(), size_t(threads) * perThread);
+    std::ranges::sort(frozen);
+    for (int i = 0; i < threads * perThread; ++i) {
+        ASSERT_EQ(frozen[i], i);
+    }
+}
+
+TEST(CDS_ConcurrentListTest, FreezesNonTrivialElements) {
+    CDS_ConcurrentList<std::string> list;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < 1000; ++i) {
+                list.Append(std::string(20, char('a' + t)));
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(list[3999].size(), 20u);
+
+    CDS_List<std::string> frozen = list.Freeze();
+    EXPECT_EQ(frozen.GetSize(), 4000u);
+    EXPECT_EQ(std::ranges::count(frozen, std::string(20, 'c')), 1000);
+
+    list.Append("reused");
+    EXPECT_EQ(list.GetSize(), 1u);
+    EXPECT_EQ(list[0], "reused");
+}
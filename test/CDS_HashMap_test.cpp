@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "CDS_HashMap.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+TEST(CDS_HashMapTest, InsertGetDelete) {
+    CDS_HashMap<std::string, int> map;
+    EXPECT_EQ(map.GetCapacity(), 0u);
+    EXPECT_TRUE(map.Get("missing").IsError());
+
+    CDS_Result<int*> inserted = map.Insert("one", 1);
+    ASSERT_TRUE(inserted.IsSucces());
+    EXPECT_EQ(*inserted.Unpack(), 1);
+    EXPECT_TRUE(map.Insert("one", 2).IsError());
+    EXPECT_EQ(map.Get("one").Unpack(), 1);
+
+    map.Set("one", 3);
+    map["two"] += 2;
+    EXPECT_EQ(map.GetSize(), 2u);
+    EXPECT_EQ(*map.Find("one"), 3);
+    EXPECT_EQ(map.Get("two").Unpack(), 2);
+
+    CDS_Result<int> removed = map.Delete("one");
+    ASSERT_TRUE(removed.IsSucces());
+    EXPECT_EQ(removed.Unpack(), 3);
+    EXPECT_TRUE(map.Delete("one").IsError());
+    EXPECT_FALSE(map.Contains("one"));
+    EXPECT_EQ(map.GetSize(), 1u);
+}
+
+TEST(CDS_HashMapTest, GrowsPastLoadFactor) {
+    CDS_HashMap<int, int> map(0.5f);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(map.Insert(i * 16, i).IsSucces());
+    }
+    EXPECT_EQ(map.GetSize(), 10000u);
+    EXPECT_LE(map.GetSize(), map.GetCapacity() / 2);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_NE(map.Find(i * 16), nullptr);
+        EXPECT_EQ(*map.Find(i * 16), i);
+        EXPECT_FALSE(map.Contains(i * 16 + 1));
+    }
+
+    map.SetMaxLoadFactor(0.25f);
+    EXPECT_LE(map.GetSize(), map.GetCapacity() / 4);
+    EXPECT_EQ(map.Get(160).Unpack(), 10);
+
+    CDS_HashMap<int, int> reserved;
+    reserved.Reserve(1000);
+    std::size_t capacity = reserved.GetCapacity();
+    for (int i = 0; i < 1000; ++i) {
+        reserved[i] = i;
+    }
+    EXPECT_EQ(reserved.GetCapacity(), capacity);
+}
+
+TEST(CDS_HashMapTest, ChurnMatchesUnorderedMap) {
+    CDS_HashMap<unsigned, unsigned> map;
+    std::unordered_map<unsigned, unsigned> reference;
+    unsigned state = 1;
+    for (int i = 0; i < 200000; ++i) {
+        state = state * 1103515245u + 12345u;
+        unsigned key = (state >> 8) % 4096;
+        if (state & 1) {
+            map.Set(key, state);
+            reference[key] = state;
+        } else {
+            EXPECT_EQ(map.Delete(key).IsSucces(), reference.erase(key) == 1);
+        }
+    }
+    EXPECT_EQ(map.GetSize(), reference.size());
+    // Deleted slots are reclaimed, the table does not grow with the churn.
+    EXPECT_LE(map.GetCapacity(), 8192u);
+    std::size_t visited = 0;
+    map.ForEach([&](const unsigned& key, unsigned& value) {
+        EXPECT_EQ(reference.at(key), value);
+        ++visited;
+    });
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST(CDS_HashMapTest, CopyMoveAndOwnership) {
+    CDS_HashMap<int, std::shared_ptr<int>> map;
+    auto shared = std::make_shared<int>(7);
+    for (int i = 0; i < 100; ++i) {
+        map.Set(i, shared);
+    }
+    EXPECT_EQ(shared.use_count(), 101);
+
+    CDS_HashMap<int, std::shared_ptr<int>> copy = map;
+    EXPECT_EQ(shared.use_count(), 201);
+    EXPECT_EQ(*copy.Get(42).Unpack(), 7);
+
+    CDS_HashMap<int, std::shared_ptr<int>> moved = std::move(map);
+    EXPECT_EQ(map.GetSize(), 0u);
+    EXPECT_EQ(moved.GetSize(), 100u);
+
+    copy.Clear();
+    EXPECT_EQ(shared.use_count(), 101);
+    EXPECT_FALSE(copy.Contains(1));
+    copy = moved;
+    EXPECT_EQ(shared.use_count(), 201);
+    moved.Delete(5);
+    EXPECT_EQ(shared.use_count(), 200);
+}
+
+TEST(CDS_HashMapTest, CustomHash) {
+    struct Constant {
+        std::size_t operator()(int) const { return 0; }
+    };
+    CDS_HashMap<int, int, Constant> map;
+    for (int i = 0; i < 100; ++i) {
+        map[i] = -i;
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(map.Get(i).Unpack(), -i);
+    }
+    EXPECT_TRUE(map.Delete(50).IsSucces());
+    EXPECT_EQ(map.Get(99).Unpack(), -99);
+}
+
+TEST(CDS_HashMapTest, GroupMatch) {
+    std::int8_t control[_Hash::_GROUP];
+    for (std::size_t i = 0; i < _Hash::_GROUP; ++i) {
+        control[i] = static_cast<std::int8_t>(i % 3 == 0 ? 5 : i % 3 == 1
+                                                       ? _Hash::_EMPTY
+                                                       : _Hash::_DELETED);
+    }
+    _Hash::_Group group(control);
+
+    std::size_t matched = 0;
+    for (_Hash::_Mask match = group.Match(5); match; match.Next()) {
+        EXPECT_EQ(match.Lowest() % 3, 0u);
+        ++matched;
+    }
+    EXPECT_EQ(matched, (_Hash::_GROUP + 2) / 3);
+    EXPECT_FALSE(group.Match(6));
+
+    _Hash::_Mask empty = group.MatchEmpty();
+    EXPECT_EQ(empty.Lowest(), 1u);
+    EXPECT_EQ(empty.TrailingZeros(), 1u);
+    EXPECT_EQ(empty.LeadingZeros(), (_Hash::_GROUP - 2) % 3);
+
+    _Hash::_Mask free = group.MatchFree();
+    std::size_t freeCount = 0;
+    for (; free; free.Next()) {
+        EXPECT_NE(free.Lowest() % 3, 0u);
+        ++freeCount;
+    }
+    EXPECT_EQ(freeCount, _Hash::_GROUP - matched);
+}
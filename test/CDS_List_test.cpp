@@ -0,0 +1,308 @@
+#include <gtest/gtest.h>
+#include "CDS_Allocator.hpp"
+#include "CDS_List.hpp"
+
+#include <algorithm>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Record {
+    int Id;
+    double Value;
+};
+
+struct Owner {
+    std::unique_ptr<int> Pointer;
+};
+
+template <> struct CDS_TriviallyRelocatable<Owner> : std::true_type {};
+
+TEST(CDS_ListTest, AppendEmplaceAndPop) {
+    CDS_List<std::string> list;
+    std::string first = "first";
+    list.Append(first);
+    list.Append(std::string("second"));
+    list.Emplace(3, 'x');
+    EXPECT_EQ(list.GetSize(), 3u);
+    EXPECT_EQ(list[0], "first");
+    EXPECT_EQ(list[1], "second");
+    EXPECT_EQ(list[2], "xxx");
+    EXPECT_EQ(list.Pop(), "xxx");
+    EXPECT_EQ(list.GetSize(), 2u);
+}
+
+TEST(CDS_ListTest, DrawsFromArena) {
+    CDS_Arena arena;
+    {
+        CDS_List<std::string, CDS_ArenaAllocator<std::string>> list{
+            CDS_ArenaAllocator<std::string>(arena)};
+        for (int i = 0; i < 100; ++i) {
+            list.Append(std::to_string(i));
+        }
+        EXPECT_EQ(list[57], "57");
+        EXPECT_GT(arena.GetUsed(), 0u);
+        EXPECT_TRUE(list.GetAllocator() == CDS_ArenaAllocator<int>(arena));
+    }
+    arena.Reset();
+    EXPECT_EQ(arena.GetUsed(), 0u);
+}
+
+TEST(CDS_ListTest, DrawsFromPool) {
+    CDS_Pool pool;
+    for (int round = 0; round < 3; ++round) {
+        CDS_List<int, CDS_PoolAllocator<int>> list{
+            CDS_PoolAllocator<int>(pool)};
+        for (int i = 0; i < 500; ++i) {
+            list.Append(i);
+        }
+        int sum = 0;
+        for (int value : list) {
+            sum += value;
+        }
+        EXPECT_EQ(sum, 124750);
+    }
+}
+
+TEST(CDS_ListTest, SmallListStaysInlineUntilFull) {
+    CDS_Arena arena;
+    CDS_SmallList<std::string, 4, CDS_ArenaAllocator<std::string>> list{
+        CDS_ArenaAllocator<std::string>(arena)};
+    EXPECT_TRUE(list.IsInline());
+    EXPECT_EQ(list.GetCapacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        list.Emplace(10, char('a' + i));
+    }
+    EXPECT_TRUE(list.IsInline());
+    EXPECT_EQ(arena.GetUsed(), 0u);
+
+    list.Append("spilled");
+    EXPECT_FALSE(list.IsInline());
+    EXPECT_GT(arena.GetUsed(), 0u);
+    EXPECT_EQ(list.GetSize(), 5u);
+    EXPECT_EQ(list[0], "aaaaaaaaaa");
+    EXPECT_EQ(list[3], "dddddddddd");
+    EXPECT_EQ(list.Pop(), "spilled");
+
+    std::string joined;
+    for (const std::string& value : list) {
+        joined += value[0];
+    }
+    EXPECT_EQ(joined, "abcd");
+}
+
+TEST(CDS_ListTest, CopiesAndMoves) {
+    CDS_SmallList<std::string, 2> small;
+    small.Append("one");
+    CDS_SmallList<std::string, 2> copy(small);
+    EXPECT_EQ(copy[0], "one");
+    CDS_SmallList<std::string, 2> moved(std::move(small));
+    EXPECT_TRUE(moved.IsInline());
+    EXPECT_EQ(moved[0], "one");
+    EXPECT_EQ(small.GetSize(), 0u);
+
+    for (int i = 0; i < 10; ++i) {
+        moved.Append(std::to_string(i));
+    }
+    const std::string* data = moved.GetData();
+    CDS_SmallList<std::string, 2> stolen(std::move(moved));
+    EXPECT_EQ(stolen.GetData(), data);
+    EXPECT_EQ(stolen.GetSize(), 11u);
+    EXPECT_TRUE(moved.IsInline());
+    moved.Append("again");
+    EXPECT_EQ(moved[0], "again");
+
+    copy = stolen;
+    EXPECT_EQ(copy.GetSize(), 11u);
+    EXPECT_EQ(copy[10], "9");
+    stolen = std::move(moved);
+    EXPECT_EQ(stolen.GetSize(), 1u);
+    EXPECT_EQ(stolen[0], "again");
+
+    CDS_List<int> heap;
+    heap.Append(7);
+    CDS_List<int> taken(std::move(heap));
+    EXPECT_EQ(taken[0], 7);
+    heap.Append(8);
+    EXPECT_EQ(heap[0], 8);
+}
+
+TEST(CDS_ListTest, ReserveAndShrinkToFit) {
+    CDS_List<Record> list;
+    EXPECT_EQ(list.GetCapacity(), 0u);
+    list.Reserve(1000);
+    EXPECT_EQ(list.GetCapacity(), 1000u);
+    const Record* data = list.GetData();
+    for (int i = 0; i < 1000; ++i) {
+        list.Append({i, i * 0.5});
+    }
+    EXPECT_EQ(list.GetData(), data);
+    for (int i = 0; i < 100000; ++i) {
+        list.Append({i, 0.0});
+    }
+    EXPECT_EQ(list[999].Value, 499.5);
+    EXPECT_EQ(list[100999].Id, 99999);
+    while (list.GetSize() > 10) {
+        list.Pop();
+    }
+    list.ShrinkToFit();
+    EXPECT_EQ(list.GetCapacity(), 10u);
+    EXPECT_EQ(list[9].Id, 9);
+
+    CDS_SmallList<std::string, 4> small;
+    for (int i = 0; i < 6; ++i) {
+        small.Append(std::to_string(i));
+    }
+    small.Pop();
+    small.Pop();
+    small.ShrinkToFit();
+    EXPECT_TRUE(small.IsInline());
+    EXPECT_EQ(small[3], "3");
+}
+
+TEST(CDS_ListTest, GrowthPolicy) {
+    using Growth = CDS_ListGrowth<3, 2, 16>;
+    EXPECT_EQ(Growth::Next(0), 16u);
+    EXPECT_EQ(Growth::Next(16), 24u);
+    EXPECT_EQ(CDS_ListGrowth<>::Next(0), 4u);
+    EXPECT_EQ(CDS_ListGrowth<>::Next(1), 4u);
+    EXPECT_EQ(CDS_ListGrowth<>::Next(8), 16u);
+
+    CDS_List<int, std::allocator<int>, 0, Growth> list;
+    list.Append(1);
+    EXPECT_EQ(list.GetCapacity(), 16u);
+    for (int i = 1; i < 17; ++i) {
+        list.Append(i);
+    }
+    EXPECT_EQ(list.GetCapacity(), 24u);
+}
+
+TEST(CDS_ListTest, RelocatesOwningElements) {
+    CDS_List<Owner> list;
+    for (int i = 0; i < 100; ++i) {
+        list.Append(Owner{std::make_unique<int>(i)});
+    }
+    EXPECT_EQ(*list[42].Pointer, 42);
+    list.ShrinkToFit();
+    CDS_List<Owner> moved;
+    moved = std::move(list);
+    EXPECT_EQ(*moved[99].Pointer, 99);
+}
+
+template <class List>
+static std::string Join(const List& list) {
+    std::ostringstream stream;
+    stream << list;
+    return stream.str();
+}
+
+TEST(CDS_ListTest, AppendAndInsertRanges) {
+    CDS_List<int> list;
+    std::vector<int> values{1, 2, 3, 4, 5};
+    list.AppendRange(values);
+    EXPECT_EQ(list.GetCapacity(), 5u);
+    list.InsertRange(2, values.begin(), values.begin() + 2);
+    EXPECT_EQ(Join(list), "[1, 2, 1, 2, 3, 4, 5]");
+    list.Reserve(20);
+    list.InsertRange(0, std::span<const int>(values).last(3));
+    EXPECT_EQ(Join(list), "[3, 4, 5, 1, 2, 1, 2, 3, 4, 5]");
+    list.Insert(10, 9);
+    list.Insert(1, list[0]);
+    EXPECT_EQ(Join(list), "[3, 3, 4, 5, 1, 2, 1, 2, 3, 4, 5, 9]");
+
+    std::istringstream stream("7 8");
+    list.InsertRange(1, std::istream_iterator<int>(stream),
+                     std::istream_iterator<int>());
+    EXPECT_EQ(list[1], 7);
+    EXPECT_EQ(list[2], 8);
+    EXPECT_EQ(list[3], 3);
+
+    CDS_SmallList<std::string, 2> strings;
+    std::list<std::string> words{"b", "c", "d"};
+    strings.Append("a");
+    strings.Append("e");
+    strings.InsertRange(1, words.begin(), words.end());
+    strings.Insert(0, strings[4]);
+    EXPECT_EQ(Join(strings), "[e, a, b, c, d, e]");
+    strings.Insert(6, std::string("f"));
+    strings.Append(strings[0]);
+    EXPECT_EQ(Join(strings), "[e, a, b, c, d, e, f, e]");
+}
+
+TEST(CDS_ListTest, AppendsItsOwnElementsWhileGrowing) {
+    CDS_List<std::string> list;
+    list.Append(std::string(40, 'a'));
+    for (int i = 0; i < 20; ++i) {
+        list.Emplace(list[0]);
+        list.Emplace(list[0].begin(), list[0].end());
+        list.Append(std::move(list[list.GetSize() - 1]));
+    }
+    EXPECT_EQ(list.GetSize(), 61u);
+    EXPECT_EQ(list[0], std::string(40, 'a'));
+    EXPECT_EQ(list[58], std::string(40, 'a'));
+    EXPECT_EQ(list[60], std::string(40, 'a'));
+}
+
+TEST(CDS_ListTest, RemoveRangesAndRemoveIf) {
+    CDS_List<std::string> strings;
+    for (int i = 0; i < 10; ++i) {
+        strings.Append(std::to_string(i));
+    }
+    strings.Remove(0);
+    strings.RemoveRange(2, 3);
+    EXPECT_EQ(Join(strings), "[1, 2, 6, 7, 8, 9]");
+    size_t removed = strings.RemoveIf(
+        [](const std::string& value) { return std::stoi(value) % 2 == 0; });
+    EXPECT_EQ(removed, 3u);
+    EXPECT_EQ(Join(strings), "[1, 7, 9]");
+    strings.RemoveRange(0, 3);
+    EXPECT_EQ(strings.GetSize(), 0u);
+
+    CDS_List<int> ints;
+    for (int i = 0; i < 1000; ++i) {
+        ints.Append(i);
+    }
+    EXPECT_EQ(ints.RemoveIf([](int value) { return value % 3 != 0; }), 666u);
+    EXPECT_EQ(ints.GetSize(), 334u);
+    EXPECT_EQ(ints[333], 999);
+    ints.RemoveRange(1, 332);
+    EXPECT_EQ(Join(ints), "[0, 999]");
+}
+
+static_assert(std::contiguous_iterator<CDS_List<int>::iterator>);
+static_assert(std::contiguous_iterator<CDS_List<int>::const_iterator>);
+static_assert(std::ranges::contiguous_range<CDS_List<int>>);
+static_assert(std::ranges::contiguous_range<const CDS_SmallList<int, 4>>);
+
+TEST(CDS_ListTest, ContiguousRange) {
+    CDS_List<int> list;
+    for (int i = 0; i < 100; ++i) {
+        list.Append((i * 37) % 100);
+    }
+    std::span<int> span = list;
+    EXPECT_EQ(span.data(), list.GetData());
+    EXPECT_EQ(span.size(), 100u);
+
+    std::ranges::sort(list);
+    EXPECT_TRUE(std::is_sorted(list.cbegin(), list.cend()));
+    EXPECT_EQ(list.end() - list.begin(), 100);
+    EXPECT_EQ(list.begin()[42], 42);
+
+    const CDS_List<int>& constant = list;
+    std::span<const int> view = constant;
+    EXPECT_EQ(std::accumulate(view.begin(), view.end(), 0), 4950);
+    CDS_List<int>::const_iterator it = list.begin();
+    EXPECT_TRUE(it == constant.begin());
+    EXPECT_TRUE(it < constant.end());
+
+    auto even = list | std::views::filter([](int v) { return v % 2 == 0; });
+    EXPECT_EQ(std::ranges::distance(even), 50);
+
+    std::vector<int> copy(100);
+    std::copy(list.begin(), list.end(), copy.begin());
+    EXPECT_EQ(copy[99], 99);
+}
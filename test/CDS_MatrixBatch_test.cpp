@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "CDS_MatrixBatch.hpp"
+#include "CDS_TestUtil.hpp"
+
+#include <cstdint>
+
+TEST(CDS_MatrixBatchTest, StorageAndAccess) {
+    std::vector<CDS_Matrix<float>> list = RandomList<float>(37, 3, 2, 1);
+    CDS_MatrixBatch<float> batch(list);
+    EXPECT_EQ(batch.GetCount(), 37);
+    EXPECT_EQ(batch.GetShape(), std::make_tuple(3, 2));
+    EXPECT_EQ(batch.GetStride() % 16, 0);
+    auto address = reinterpret_cast<std::uintptr_t>(batch.GetElement(2, 1).GetData());
+    EXPECT_EQ(address % CDS_MatrixBatch<float>::Alignment, 0u);
+
+    for (int b = 0; b < 37; ++b) {
+        CDS_MatrixView<const float> view = std::as_const(batch)[b];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                EXPECT_EQ((view[{i, j}]), (list[b][{i, j}]));
+                EXPECT_EQ(batch.GetElement(i, j)[b], (list[b][{i, j}]));
+            }
+        }
+    }
+
+    batch[5][{1, 1}] = 100;
+    EXPECT_EQ((batch.Get(5)[{1, 1}]), 100);
+    batch.Set(6, list[0]);
+    EXPECT_EQ((batch.Get(6)[{2, 0}]), (list[0][{2, 0}]));
+}
+
+TEST(CDS_MatrixBatchTest, ProductAndTranspose) {
+    // Not a multiple of the task size, so the last task is partial.
+    int count = 1500;
+    std::vector<CDS_Matrix<int>> left = RandomList<int>(count, 4, 3, 2);
+    std::vector<CDS_Matrix<int>> right = RandomList<int>(count, 3, 5, 3);
+    CDS_MatrixBatch<int> a(left);
+    CDS_MatrixBatch<int> b(right);
+    ASSERT_TRUE(a.IsMultipliable(b));
+    ASSERT_FALSE(a.IsMultipliable(a));
+
+    CDS_ThreadPool& pool = CDS_ThreadPool::Instance();
+    std::size_t threads = pool.GetThreadCount();
+    std::size_t cutoff = pool.GetSerialCutoff();
+    pool.SetThreadCount(4);
+    pool.SetSerialCutoff(0);
+    CDS_MatrixBatch<int> product = a * b;
+    pool.SetThreadCount(threads);
+    pool.SetSerialCutoff(cutoff);
+
+    EXPECT_EQ(product.GetShape(), std::make_tuple(4, 5));
+    for (int index = 0; index < count; index += 97) {
+        CDS_Matrix<int> expected = left[index] * right[index];
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 5; ++j) {
+                EXPECT_EQ((product[index][{i, j}]), (expected[{i, j}]));
+            }
+        }
+    }
+
+    a.Transpose();
+    EXPECT_EQ(a.GetShape(), std::make_tuple(3, 4));
+    CDS_MatrixBatch<int> square(RandomList<int>(40, 3, 3, 4));
+    CDS_MatrixBatch<int> original = square;
+    square.Transpose();
+    for (int index = 0; index < 40; ++index) {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                EXPECT_EQ((a[index][{i, j}]), (left[index][{j, i}]));
+            }
+            for (int j = 0; j < 3; ++j) {
+                EXPECT_EQ((square[index][{i, j}]), (original[index][{j, i}]));
+            }
+        }
+    }
+}
+
+TEST(CDS_MatrixBatchTest, DeterminantAndInverse) {
+    for (int n : {1, 2, 4, 8}) {
+        std::vector<CDS_Matrix<double>> list = RandomList<double>(70, n, n, n);
+        // A singular matrix in the middle of a lane group.
+        list[33] = CDS_Matrix<double>(n, n);
+        CDS_MatrixBatch<double> batch(list);
+
+        std::vector<double> det = batch.Determinant();
+        ASSERT_EQ(det.size(), 70u);
+        for (int index = 0; index < 70; ++index) {
+            EXPECT_NEAR(det[index], list[index].Determinant(),
+                        1e-9 * std::max(1.0, std::abs(det[index])));
+        }
+        EXPECT_EQ(det[33], 0.0);
+
+        batch.Inverse();
+        for (int index = 0; index < 70; ++index) {
+            if (index == 33 || list[index].Determinant() == 0) {
+                continue;
+            }
+            CDS_Matrix<double> identity = batch.Get(index) * list[index];
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    EXPECT_NEAR((identity[{i, j}]), i == j ? 1.0 : 0.0, 1e-9);
+                }
+            }
+        }
+    }
+
+    CDS_MatrixBatch<int> integer(RandomList<int>(10, 3, 3, 5));
+    std::vector<int> det = integer.Determinant();
+    for (int index = 0; index < 10; ++index) {
+        EXPECT_EQ(det[index], integer.Get(index).Determinant());
+    }
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "CDS_MatrixFile.hpp"
+#include "CDS_TestUtil.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+TEST(CDS_MatrixFileTest, SaveAndMapRoundTrip) {
+    using Layout = CDS_Matrix<double>::Layout;
+    ScratchFile file("cds_matrix_round_trip.bin");
+
+    for (Layout layout : {Layout::RowMajor, Layout::ColMajor}) {
+        CDS_Matrix<double> matrix = Sequence<double>(13, 7, layout);
+        CDS_Result<std::size_t> saved =
+            CDS_MatrixWriter<double>::Save(file.Path, matrix);
+        ASSERT_TRUE(saved.IsSucces()) << saved.ErrorMessage.value();
+        EXPECT_EQ(saved.Unpack(), 91u);
+
+        CDS_Result<CDS_MappedMatrix<double>> mapped =
+            CDS_MappedMatrix<double>::Open(file.Path);
+        ASSERT_TRUE(mapped.IsSucces()) << mapped.ErrorMessage.value();
+        CDS_MappedMatrix<double>& loaded = mapped.Unpack();
+        EXPECT_EQ(loaded.GetShape(), std::make_tuple(13, 7));
+        EXPECT_EQ(loaded.GetLayout(), layout);
+        auto address = reinterpret_cast<std::uintptr_t>(loaded.GetData());
+        EXPECT_EQ(address % CDS_Matrix<double>::Alignment, 0u);
+
+        CDS_MatrixView<const double> view = loaded.View();
+        for (int i = 0; i < 13; ++i) {
+            for (int j = 0; j < 7; ++j) {
+                EXPECT_EQ((view[{i, j}]), (matrix[{i, j}]));
+            }
+        }
+        CDS_Matrix<double> copy(view, layout);
+        EXPECT_EQ((copy[{12, 6}]), (matrix[{12, 6}]));
+    }
+}
+
+TEST(CDS_MatrixFileTest, StreamingWriter) {
+    ScratchFile file("cds_matrix_streaming.bin");
+    {
+        CDS_MatrixWriter<int> writer(file.Path, 100, 3);
+        for (int i = 0; i < 100; ++i) {
+            int row[3] = {i, -i, i * i};
+            ASSERT_TRUE(writer.Write(row, 3).IsSucces());
+        }
+        int extra = 0;
+        EXPECT_TRUE(writer.Write(&extra, 1).IsError());
+        ASSERT_TRUE(writer.Close().IsSucces());
+    }
+
+    CDS_Result<CDS_MappedMatrix<int>> mapped =
+        CDS_MappedMatrix<int>::Open(file.Path);
+    ASSERT_TRUE(mapped.IsSucces());
+    CDS_MatrixView<const int> view = mapped.Unpack().View();
+    EXPECT_EQ((view[{99, 0}]), 99);
+    EXPECT_EQ((view[{99, 1}]), -99);
+    EXPECT_EQ((view[{7, 2}]), 49);
+
+    CDS_MatrixWriter<int> incomplete(file.Path, 2, 2);
+    int values[3] = {1, 2, 3};
+    ASSERT_TRUE(incomplete.Write(values, 3).IsSucces());
+    EXPECT_TRUE(incomplete.Close().IsError());
+}
+
+TEST(CDS_MatrixFileTest, RejectsMismatchedFiles) {
+    ScratchFile file("cds_matrix_rejects.bin");
+    EXPECT_TRUE(CDS_MappedMatrix<float>::Open(file.Path).IsError());
+
+    CDS_Matrix<float> matrix =
+        Sequence<float>(4, 4, CDS_Matrix<float>::Layout::RowMajor);
+    ASSERT_TRUE(CDS_MatrixWriter<float>::Save(file.Path, matrix).IsSucces());
+    EXPECT_TRUE(CDS_MappedMatrix<float>::Open(file.Path).IsSucces());
+    EXPECT_TRUE(CDS_MappedMatrix<double>::Open(file.Path).IsError());
+    EXPECT_TRUE(CDS_MappedMatrix<int>::Open(file.Path).IsError());
+
+    std::filesystem::resize_file(file.Path, 64 + 15 * sizeof(float));
+    CDS_Result<CDS_MappedMatrix<float>> truncated =
+        CDS_MappedMatrix<float>::Open(file.Path);
+    ASSERT_TRUE(truncated.IsError());
+    EXPECT_EQ(truncated.ErrorMessage.value(), "The file is truncated");
+
+    std::FILE* text = std::fopen(file.Path.c_str(), "w");
+    for (int i = 0; i < 16; ++i) {
+        std::fprintf(text, "%d.0 %d.5\n", i, i);
+    }
+    std::fclose(text);
+    EXPECT_TRUE(CDS_MappedMatrix<float>::Open(file.Path).IsError());
+}
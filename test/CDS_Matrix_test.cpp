@@ -0,0 +1,511 @@
+#include <gtest/gtest.h>
+#include "CDS_Matrix.hpp"
+#include "CDS_Simd.hpp"
+#include "CDS_TestUtil.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+TEST(CDS_MatrixTest, StorageIsAligned) {
+    CDS_Matrix<float> matrix(5, 7);
+    auto address = reinterpret_cast<std::uintptr_t>(matrix.GetData());
+    EXPECT_EQ(address % CDS_Matrix<float>::Alignment, 0u);
+}
+
+TEST(CDS_MatrixTest, InitializerListShape) {
+    CDS_Matrix<float> square{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(square.GetShape(), std::make_tuple(3, 3));
+    EXPECT_EQ((square[{1, 2}]), 6);
+
+    CDS_Matrix<float> column{1, 2, 3};
+    EXPECT_EQ(column.GetShape(), std::make_tuple(3, 1));
+}
+
+TEST(CDS_MatrixTest, LayoutsAgreeOnElements) {
+    CDS_Matrix<double> rowMajor{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    CDS_Matrix<double> colMajor = rowMajor;
+    colMajor.SetLayout(CDS_Matrix<double>::Layout::ColMajor);
+    EXPECT_EQ(colMajor.GetColumnStride(), 3);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_EQ((rowMajor[{i, j}]), (colMajor[{i, j}]));
+        }
+    }
+    CDS_Matrix<double> sum = rowMajor + colMajor;
+    EXPECT_EQ((sum[{2, 0}]), 14);
+}
+
+TEST(CDS_MatrixTest, ViewsAliasStorage) {
+    CDS_Matrix<int> matrix(3, 3);
+    matrix.GetRow(1)[2] = 5;
+    matrix.GetColumn(0)[2] = 7;
+    matrix.GetDiagonal()[0] = 9;
+    EXPECT_EQ((matrix[{1, 2}]), 5);
+    EXPECT_EQ((matrix[{2, 0}]), 7);
+    EXPECT_EQ((matrix[{0, 0}]), 9);
+    EXPECT_EQ(matrix.GetColumn(0).GetStride(), 3);
+}
+
+TEST(CDS_MatrixTest, ExcludeRowsAndColumns) {
+    CDS_Matrix<int> matrix{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    CDS_MatrixView<int> view = matrix.ExcludeColumns({1}).ExcludeRows({0});
+    EXPECT_EQ(view.GetShape(), std::make_tuple(2, 2));
+    EXPECT_EQ((view[{0, 0}]), 4);
+    EXPECT_EQ((view[{1, 1}]), 9);
+    EXPECT_EQ(view.GetRow(1).ToVector(), (std::vector<int>{7, 9}));
+
+    CDS_Matrix<int> copy = view;
+    EXPECT_EQ((copy[{0, 1}]), 6);
+}
+
+TEST(CDS_MatrixTest, TransposeKeepsLayout) {
+    CDS_Matrix<int> matrix(2, 3);
+    matrix.SetRow(0, {1, 2, 3});
+    matrix.SetRow(1, {4, 5, 6});
+    matrix.Transpose();
+    EXPECT_EQ(matrix.GetShape(), std::make_tuple(3, 2));
+    EXPECT_EQ(matrix.GetLayout(), CDS_Matrix<int>::Layout::RowMajor);
+    EXPECT_EQ(matrix.GetColumn(1).ToVector(), (std::vector<int>{4, 5, 6}));
+}
+
+TEST(CDS_MatrixTest, ReshapeKeepsRowMajorOrder) {
+    CDS_Matrix<int> matrix(2, 2, CDS_Matrix<int>::Layout::ColMajor);
+    matrix.SetRow(0, {1, 2});
+    matrix.SetRow(1, {3, 4});
+    matrix.Reshape(1, 5);
+    EXPECT_EQ(matrix.GetRow(0).ToVector(), (std::vector<int>{1, 2, 3, 4, 0}));
+}
+
+template <class T>
+static CDS_Matrix<T> NaiveProduct(const CDS_Matrix<T>& a, const CDS_Matrix<T>& b) {
+    auto [m, k] = a.GetShape();
+    int n = std::get<1>(b.GetShape());
+    CDS_Matrix<T> out(m, n);
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            T sum = T(0);
+            for (int p = 0; p < k; ++p) {
+                sum += a[{i, p}] * b[{p, j}];
+            }
+            out[{i, j}] = sum;
+        }
+    }
+    return out;
+}
+
+TEST(CDS_MatrixTest, MultiplyMatchesNaiveProduct) {
+    using Layout = CDS_Matrix<double>::Layout;
+    for (Layout layout : {Layout::RowMajor, Layout::ColMajor}) {
+        CDS_Matrix<double> a = Sequence<double>(67, 301, layout);
+        CDS_Matrix<double> b = Sequence<double>(301, 45, Layout::RowMajor);
+        CDS_Matrix<double> product = a * b;
+        CDS_Matrix<double> expected = NaiveProduct(a, b);
+        for (int i = 0; i < 67; ++i) {
+            for (int j = 0; j < 45; ++j) {
+                EXPECT_DOUBLE_EQ((product[{i, j}]), (expected[{i, j}]));
+            }
+        }
+    }
+}
+
+TEST(CDS_MatrixTest, MultiplyIntegers) {
+    CDS_Matrix<int> a = Sequence<int>(40, 50, CDS_Matrix<int>::Layout::RowMajor);
+    CDS_Matrix<int> b = Sequence<int>(50, 30, CDS_Matrix<int>::Layout::ColMajor);
+    CDS_Matrix<int> product = a * b;
+    CDS_Matrix<int> expected = NaiveProduct(a, b);
+    for (int i = 0; i < 40; ++i) {
+        for (int j = 0; j < 30; ++j) {
+            EXPECT_EQ((product[{i, j}]), (expected[{i, j}]));
+        }
+    }
+}
+
+TEST(CDS_MatrixTest, GemmOnViews) {
+    CDS_Matrix<float> a = Sequence<float>(60, 70, CDS_Matrix<float>::Layout::RowMajor);
+    CDS_Matrix<float> c(70, 70);
+    c.Fill(1.0f);
+    _Gemm::Gemm<float>(2.0f, a.View().Transposed(), a.View(), 1.0f, c.View());
+
+    CDS_Matrix<float> at = a;
+    at.Transpose();
+    CDS_Matrix<float> expected = NaiveProduct(at, a);
+    for (int i = 0; i < 70; ++i) {
+        for (int j = 0; j < 70; ++j) {
+            EXPECT_FLOAT_EQ((c[{i, j}]), (2.0f * expected[{i, j}] + 1.0f));
+        }
+    }
+}
+
+TEST(CDS_MatrixTest, IsNormal) {
+    CDS_Matrix<double> symmetric{2, 1, 1, 3};
+    CDS_Matrix<double> shear{1, 1, 0, 1};
+    EXPECT_TRUE(symmetric.IsNormal());
+    EXPECT_FALSE(shear.IsNormal());
+}
+
+TEST(CDS_MatrixTest, ParallelMatchesSerial) {
+    using Layout = CDS_Matrix<double>::Layout;
+    CDS_ThreadPool& pool = CDS_ThreadPool::Instance();
+    std::size_t threads = pool.GetThreadCount();
+    std::size_t cutoff = pool.GetSerialCutoff();
+
+    CDS_Matrix<double> a = Sequence<double>(150, 170, Layout::RowMajor);
+    CDS_Matrix<double> b = Sequence<double>(170, 130, Layout::ColMajor);
+    CDS_Matrix<double> c = Sequence<double>(150, 170, Layout::ColMajor);
+    std::vector<double> v(170, 0.5);
+
+    pool.SetThreadCount(1);
+    CDS_Matrix<double> product = a * b;
+    CDS_Matrix<double> sum = a + c;
+    CDS_Matrix<double> scaled = 3 * a;
+    std::vector<double> mapped = a * v;
+    CDS_Matrix<double> transposed = a;
+    transposed.Transpose();
+
+    pool.SetThreadCount(4);
+    pool.SetSerialCutoff(0);
+    CDS_Matrix<double> parallelTransposed = a;
+    parallelTransposed.Transpose();
+    CDS_Matrix<double> square = Sequence<double>(100, 100, Layout::RowMajor);
+    CDS_Matrix<double> squareTransposed = square;
+    squareTransposed.Transpose();
+    CDS_Matrix<double> parallelProduct = a * b;
+    CDS_Matrix<double> parallelSum = a + c;
+    CDS_Matrix<double> parallelScaled = 3 * a;
+    EXPECT_EQ(a * v, mapped);
+    EXPECT_EQ(c * v, (CDS_Matrix<double>(c.View(), Layout::RowMajor) * v));
+    for (int i = 0; i < 150; ++i) {
+        for (int j = 0; j < 130; ++j) {
+            EXPECT_EQ((product[{i, j}]), (parallelProduct[{i, j}]));
+        }
+        for (int j = 0; j < 170; ++j) {
+            EXPECT_EQ((sum[{i, j}]), (parallelSum[{i, j}]));
+            EXPECT_EQ((scaled[{i, j}]), (parallelScaled[{i, j}]));
+            EXPECT_EQ((transposed[{j, i}]), (parallelTransposed[{j, i}]));
+        }
+    }
+    for (int i = 0; i < 100; ++i) {
+        for (int j = 0; j < 100; ++j) {
+            EXPECT_EQ((square[{i, j}]), (squareTransposed[{j, i}]));
+        }
+    }
+
+    pool.SetThreadCount(threads);
+    pool.SetSerialCutoff(cutoff);
+}
+
+TEST(CDS_MatrixTest, ParallelForRethrows) {
+    CDS_ThreadPool& pool = CDS_ThreadPool::Instance();
+    std::size_t threads = pool.GetThreadCount();
+    std::size_t cutoff = pool.GetSerialCutoff();
+    pool.SetThreadCount(4);
+    pool.SetSerialCutoff(0);
+
+    // Thrown on workers and on the helping caller, from nested loops too.
+    for (int round = 0; round < 20; ++round) {
+        std::atomic<int> ran{0};
+        EXPECT_THROW(pool.ParallelFor(64, 64,
+                                      [&](std::size_t i) {
+                                          ran++;
+                                          if (i % 7 == 3)
+                                              throw std::runtime_error("body");
+                                      }),
+                     std::runtime_error);
+        EXPECT_GE(ran.load(), 1);
+        EXPECT_THROW(pool.ParallelFor(8, 8,
+                                      [&](std::size_t) {
+                                          pool.ParallelFor(
+                                              8, 8, [](std::size_t j) {
+                                                  if (j == 5)
+                                                      throw std::logic_error(
+                                                          "nested");
+                                              });
+                                      }),
+                     std::logic_error);
+    }
+
+    // The pool still works afterwards.
+    std::vector<int> done(100, 0);
+    pool.ParallelFor(100, 100, [&](std::size_t i) { done[i] = 1; });
+    EXPECT_EQ(std::count(done.begin(), done.end(), 1), 100);
+
+    pool.SetThreadCount(threads);
+    pool.SetSerialCutoff(cutoff);
+}
+
+TEST(CDS_MatrixTest, ExpressionsFuseIntoOneResult) {
+    using Layout = CDS_Matrix<double>::Layout;
+    CDS_Matrix<double> a = Sequence<double>(20, 30, Layout::RowMajor);
+    CDS_Matrix<double> b = Sequence<double>(20, 30, Layout::ColMajor);
+    CDS_Matrix<double> c = Sequence<double>(20, 30, Layout::RowMajor);
+
+    auto expr = a + b - 4 * c;
+    EXPECT_EQ(expr.Rows(), 20);
+    CDS_Matrix<double> result = expr;
+    for (int i = 0; i < 20; ++i) {
+        for (int j = 0; j < 30; ++j) {
+            EXPECT_EQ((result[{i, j}]),
+                      (a[{i, j}] + b[{i, j}] - 4 * c[{i, j}]));
+        }
+    }
+}
+
+TEST(CDS_MatrixTest, AliasedAssignmentIsInPlace) {
+    using Layout = CDS_Matrix<float>::Layout;
+    CDS_Matrix<float> a = Sequence<float>(16, 16, Layout::RowMajor);
+    CDS_Matrix<float> b = Sequence<float>(16, 16, Layout::ColMajor);
+    CDS_Matrix<float> expected = a + 2 * b;
+    const float* buffer = a.GetData();
+
+    a = a + 2 * b;
+    EXPECT_EQ(a.GetData(), buffer);
+    for (int i = 0; i < 16; ++i) {
+        for (int j = 0; j < 16; ++j) {
+            EXPECT_EQ((a[{i, j}]), (expected[{i, j}]));
+        }
+    }
+}
+
+TEST(CDS_MatrixTest, ExpressionsWithTemporaries) {
+    CDS_Matrix<int> a{1, 2, 3, 4};
+    CDS_Matrix<int> b{5, 6, 7, 8};
+    auto expr = a * b + a;
+    CDS_Matrix<int> result(1, 1);
+    result = expr;
+    EXPECT_EQ(result.GetShape(), std::make_tuple(2, 2));
+    EXPECT_EQ((result[{0, 0}]), 20);
+    EXPECT_EQ((result[{1, 1}]), 54);
+}
+
+template <class T>
+static double MaxDifference(const CDS_Matrix<T>& a, const CDS_Matrix<T>& b) {
+    auto [rows, cols] = a.GetShape();
+    EXPECT_EQ(a.GetShape(), b.GetShape());
+    double diff = 0;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            diff = std::max(diff, double(std::abs(a[{i, j}] - b[{i, j}])));
+        }
+    }
+    return diff;
+}
+
+TEST(CDS_MatrixTest, GemmAtEveryLevel) {
+    _Simd::_Level saved = _Simd::_GetLevel();
+    CDS_Matrix<float> a = Sequence<float>(130, 90);
+    CDS_Matrix<float> b =
+        Sequence<float>(90, 75, CDS_Matrix<float>::Layout::ColMajor);
+    CDS_Matrix<double> c = Sequence<double>(75, 130);
+    CDS_Matrix<double> d = Sequence<double>(130, 61);
+    CDS_Matrix<float> expectedFloat = NaiveProduct(a, b);
+    CDS_Matrix<double> expectedDouble = NaiveProduct(c, d);
+    for (int level = 0; level <= int(_Simd::_GetSupported()); ++level) {
+        _Simd::_SetLevel(_Simd::_Level(level));
+        SCOPED_TRACE(level);
+        EXPECT_EQ(MaxDifference<float>(a * b, expectedFloat), 0.0);
+        EXPECT_EQ(MaxDifference<double>(c * d, expectedDouble), 0.0);
+    }
+    _Simd::_SetLevel(saved);
+}
+
+TEST(CDS_MatrixTest, DeterminantAndInverse) {
+    CDS_Matrix<double> small{2, -1, 0, -1, 2, -1, 0, -1, 2};
+    EXPECT_NEAR(small.Determinant(), 4.0, 1e-12);
+
+    CDS_Matrix<int> integer{0, 2, 1, 3, 1, 4, 5, 6, 2};
+    EXPECT_EQ(integer.Determinant(), 41);
+
+    // Crosses several panels of the blocked LU.
+    using Layout = CDS_Matrix<double>::Layout;
+    for (Layout layout : {Layout::RowMajor, Layout::ColMajor}) {
+        CDS_Matrix<double> a = Random<double>(203, 203, 11, layout);
+        const CDS_Matrix<double>& view = a;
+        double det = view.Determinant();
+        CDS_Matrix<double> inverse = a;
+        inverse.Inverse();
+        EXPECT_NEAR(det * inverse.Determinant(), 1.0, 1e-8);
+        EXPECT_LT(MaxDifference<double>(a * inverse,
+                                        CDS_Matrix<double>::Identity(203, 203)),
+                  1e-10);
+    }
+}
+
+TEST(CDS_MatrixTest, FactorizationCacheFollowsModifications) {
+    CDS_Matrix<double> a{1, 2, 3, 4};
+    EXPECT_NEAR(a.Determinant(), -2.0, 1e-12);
+    CDS_Matrix<double> copy = a;
+    a[{0, 0}] = 3;
+    EXPECT_NEAR(a.Determinant(), 6.0, 1e-12);
+    EXPECT_NEAR(copy.Determinant(), -2.0, 1e-12);
+    a.SetLayout(CDS_Matrix<double>::Layout::ColMajor);
+    EXPECT_NEAR(a.Determinant(), 6.0, 1e-12);
+    a.Fill(1);
+    EXPECT_FALSE(a.IsInvertible());
+    EXPECT_TRUE(copy.IsInvertible());
+
+    // A copy shares the factors and still drops them when it changes.
+    CDS_Matrix<double> moved = std::move(copy);
+    moved[{1, 1}] = 0;
+    EXPECT_NEAR(moved.Determinant(), -6.0, 1e-12);
+}
+
+TEST(CDS_MatrixTest, RankAndNullity) {
+    CDS_Matrix<double> left = Random<double>(120, 30, 3);
+    CDS_Matrix<double> right = Random<double>(30, 90, 4);
+    CDS_Matrix<double> product = left * right;
+    EXPECT_EQ(product.Rank(), 30);
+    EXPECT_EQ(product.Nullity(), 60);
+    EXPECT_EQ(left.Rank(), 30);
+
+    CDS_Matrix<int> integer{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(integer.Rank(), 2);
+    EXPECT_EQ(CDS_Matrix<float>(4, 3).Rank(), 0);
+}
+
+template <class T>
+static void ExpectUnitary(const CDS_Matrix<T>& q, double tolerance) {
+    CDS_Matrix<T> adjoint = q;
+    adjoint.ConjugateTranspose();
+    auto [rows, cols] = q.GetShape();
+    EXPECT_LT(MaxDifference<T>(adjoint * q, CDS_Matrix<T>::Identity(cols, cols)),
+              tolerance);
+}
+
+TEST(CDS_MatrixTest, QRDecomposition) {
+    using Order = CDS_Matrix<double>::Order;
+    for (auto [rows, cols] : {std::pair{150, 100}, std::pair{90, 140}}) {
+        CDS_Matrix<double> a = Random<double>(rows, cols, rows + cols);
+        auto [q, r] = a.Decompose(Order::QR);
+        EXPECT_EQ(q.GetShape(), std::make_tuple(rows, rows));
+        EXPECT_TRUE(r.IsUpperTriangular());
+        ExpectUnitary(q, 1e-12);
+        EXPECT_LT(MaxDifference<double>(q * r, a), 1e-12);
+    }
+}
+
+TEST(CDS_MatrixTest, RQDecomposition) {
+    using Order = CDS_Matrix<double>::Order;
+    for (auto [rows, cols] : {std::pair{70, 70}, std::pair{40, 75}}) {
+        CDS_Matrix<double> a = Random<double>(rows, cols, rows * cols);
+        auto [r, q] = a.Decompose(Order::RQ);
+        EXPECT_EQ(q.GetShape(), std::make_tuple(cols, cols));
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < i + cols - rows; ++j) {
+                EXPECT_EQ((r[{i, j}]), 0.0);
+            }
+        }
+        ExpectUnitary(q, 1e-12);
+        EXPECT_LT(MaxDifference<double>(r * q, a), 1e-12);
+    }
+}
+
+TEST(CDS_MatrixTest, ComplexDecomposition) {
+    using Complex = std::complex<double>;
+    using Order = CDS_Matrix<Complex>::Order;
+    CDS_Matrix<Complex> a = Random<Complex>(80, 70, 5);
+    auto [q, r] = a.Decompose(Order::QR);
+    ExpectUnitary(q, 1e-12);
+    EXPECT_LT(MaxDifference<Complex>(q * r, a), 1e-12);
+
+    CDS_Matrix<Complex> square = Random<Complex>(70, 70, 6);
+    auto [r2, q2] = square.Decompose(Order::RQ);
+    ExpectUnitary(q2, 1e-12);
+    EXPECT_LT(MaxDifference<Complex>(r2 * q2, square), 1e-12);
+    CDS_Matrix<Complex> inverse = square;
+    inverse.Inverse();
+    EXPECT_LT(MaxDifference<Complex>(square * inverse,
+                                     CDS_Matrix<Complex>::Identity(70, 70)),
+              1e-10);
+}
+
+template <class T>
+static double EigenResidual(const CDS_Matrix<T>& a) {
+    using Complex = typename CDS_Matrix<T>::Complex;
+    auto [n, cols] = a.GetShape();
+    std::vector<Complex> values = a.Eigenvals().Unpack();
+    CDS_Matrix<Complex> vectors = a.Eigenvecs().Unpack();
+    double residual = 0;
+    for (int j = 0; j < n; ++j) {
+        double norm = 0;
+        for (int i = 0; i < n; ++i) {
+            Complex sum = 0;
+            for (int k = 0; k < n; ++k) {
+                sum += Complex(a[{i, k}]) * vectors[{k, j}];
+            }
+            residual = std::max<double>(
+                residual, std::abs(sum - values[j] * vectors[{i, j}]));
+            norm += std::norm(vectors[{i, j}]);
+        }
+        EXPECT_NEAR(norm, 1.0,
+                    100 * std::numeric_limits<
+                              typename Complex::value_type>::epsilon());
+    }
+    return residual;
+}
+
+TEST(CDS_MatrixTest, SymmetricEigenvalues) {
+    // Large enough for the blocked tridiagonal reduction.
+    CDS_Matrix<double> half = Random<double>(300, 300, 9);
+    CDS_Matrix<double> a = half + CDS_Matrix<double>([&] {
+        CDS_Matrix<double> transposed = half;
+        transposed.Transpose();
+        return transposed;
+    }());
+    ASSERT_TRUE(a.IsSymmetric());
+
+    std::vector<CDS_Matrix<double>::Complex> values = a.Eigenvals().Unpack();
+    for (int i = 1; i < 300; ++i) {
+        EXPECT_EQ(values[i].imag(), 0.0);
+        EXPECT_LE(values[i - 1].real(), values[i].real());
+    }
+    double trace = 0;
+    for (auto value : values) {
+        trace += value.real();
+    }
+    EXPECT_NEAR(trace, a.Trace(), 1e-9);
+    EXPECT_LT(EigenResidual(a), 1e-11);
+
+    CDS_Matrix<int> integer{2, 1, 1, 2};
+    std::vector<CDS_Matrix<int>::Complex> pair = integer.Eigenvals().Unpack();
+    EXPECT_NEAR(pair[0].real(), 1.0, 1e-14);
+    EXPECT_NEAR(pair[1].real(), 3.0, 1e-14);
+}
+
+TEST(CDS_MatrixTest, GeneralEigenvalues) {
+    CDS_Matrix<double> rotation{0, -1, 1, 0};
+    std::vector<CDS_Matrix<double>::Complex> values =
+        rotation.Eigenvals().Unpack();
+    EXPECT_NEAR(values[0].imag(), 1.0, 1e-14);
+    EXPECT_NEAR(values[1].imag(), -1.0, 1e-14);
+    EXPECT_LT(EigenResidual(rotation), 1e-14);
+
+    for (int n : {1, 2, 7, 90}) {
+        CDS_Matrix<double> a = Random<double>(n, n, n);
+        EXPECT_LT(EigenResidual(a), 1e-10) << n;
+    }
+    CDS_Matrix<float> single = Random<float>(40, 40, 2);
+    EXPECT_LT(EigenResidual(single), 1e-4);
+}
+
+TEST(CDS_MatrixTest, EigenvaluesOfNonFiniteMatrices) {
+    CDS_Matrix<double> general = Random<double>(30, 30, 5);
+    general[{3, 7}] = std::numeric_limits<double>::quiet_NaN();
+    CDS_Result<std::vector<CDS_Matrix<double>::Complex>> values =
+        general.Eigenvals();
+    ASSERT_TRUE(values.IsError());
+    EXPECT_EQ(values.ErrorMessage.value(),
+              "The matrix has non-finite elements");
+
+    CDS_Matrix<double> symmetric = CDS_Matrix<double>::Identity(20, 20);
+    symmetric[{4, 4}] = std::numeric_limits<double>::infinity();
+    EXPECT_TRUE(symmetric.Eigenvecs().IsError());
+
+    // The failure is not cached.
+    symmetric[{4, 4}] = 2;
+    EXPECT_EQ(symmetric.Eigenvals().Unpack().back().real(), 2.0);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "CDS_PerfectHashMap.hpp"
+#include "CDS_TestUtil.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+TEST(CDS_PerfectHashMapTest, StringKeys) {
+    std::vector<std::string> keys;
+    std::vector<int> values;
+    for (int i = 0; i < 5000; ++i) {
+        keys.push_back("word-" + std::to_string(i * 31));
+        values.push_back(i);
+    }
+    keys.push_back("");
+    values.push_back(-1);
+
+    CDS_Result<CDS_PerfectHashMap<std::string, int>> built =
+        CDS_PerfectHashMap<std::string, int>::Build(keys, values);
+    ASSERT_TRUE(built.IsSucces()) << built.ErrorMessage.value();
+    CDS_PerfectHashMap<std::string, int>& map = built.Unpack();
+    EXPECT_EQ(map.GetSize(), keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_NE(map.Find(keys[i]), nullptr) << keys[i];
+        EXPECT_EQ(*map.Find(keys[i]), values[i]);
+    }
+    EXPECT_EQ(map.Get("word-31").Unpack(), 1);
+    EXPECT_TRUE(map.Get("word-32").IsError());
+    EXPECT_FALSE(map.Contains("word-"));
+
+    std::size_t visited = 0;
+    map.ForEach([&](std::string_view key, int value) {
+        EXPECT_EQ(map.Get(key).Unpack(), value);
+        visited++;
+    });
+    EXPECT_EQ(visited, keys.size());
+}
+
+TEST(CDS_PerfectHashMapTest, FixedSizeKeys) {
+    std::vector<std::uint64_t> keys;
+    std::vector<double> values;
+    for (std::uint64_t i = 0; i < 100000; ++i) {
+        keys.push_back(i * 0x9E3779B97F4A7C15ULL);
+        values.push_back(double(i) / 2);
+    }
+    CDS_Result<CDS_PerfectHashMap<std::uint64_t, double>> built =
+        CDS_PerfectHashMap<std::uint64_t, double>::Build(keys, values);
+    ASSERT_TRUE(built.IsSucces()) << built.ErrorMessage.value();
+    CDS_PerfectHashMap<std::uint64_t, double>& map = built.Unpack();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(map.Get(keys[i]).Unpack(), values[i]);
+    }
+    EXPECT_FALSE(map.Contains(1));
+    // Seeds, values and keys, with no empty slots.
+    EXPECT_LT(map.GetBytes(), keys.size() * (8 + 8 + 2));
+}
+
+TEST(CDS_PerfectHashMapTest, EmptyAndDuplicateKeys) {
+    CDS_Result<CDS_PerfectHashMap<std::string_view, int>> empty =
+        CDS_PerfectHashMap<std::string_view, int>::Build({}, {});
+    ASSERT_TRUE(empty.IsSucces());
+    EXPECT_EQ(empty.Unpack().GetSize(), 0u);
+    EXPECT_FALSE(empty.Unpack().Contains("anything"));
+
+    std::vector<std::string_view> keys = {"a", "b", "a"};
+    std::vector<int> values = {1, 2, 3};
+    CDS_Result<CDS_PerfectHashMap<std::string_view, int>> duplicate =
+        CDS_PerfectHashMap<std::string_view, int>::Build(keys, values);
+    ASSERT_TRUE(duplicate.IsError());
+    EXPECT_EQ(duplicate.ErrorMessage.value(), "The key already exists");
+}
+
+TEST(CDS_PerfectHashMapTest, SaveAndMapRoundTrip) {
+    ScratchFile file("cds_perfect_hash_round_trip.bin");
+    std::vector<std::string> keys = {"alpha", "beta", "gamma", "delta",
+                                     "epsilon", "zeta", "eta"};
+    std::vector<std::int32_t> values = {1, 2, 3, 4, 5, 6, 7};
+    CDS_PerfectHashMap<std::string, std::int32_t> built =
+        CDS_PerfectHashMap<std::string, std::int32_t>::Build(keys, values)
+            .Unpack();
+    CDS_Result<std::size_t> saved = built.Save(file.Path);
+    ASSERT_TRUE(saved.IsSucces()) << saved.ErrorMessage.value();
+    EXPECT_EQ(saved.Unpack(), built.GetBytes());
+
+    CDS_Result<CDS_PerfectHashMap<std::string, std::int32_t>> mapped =
+        CDS_PerfectHashMap<std::string, std::int32_t>::Open(file.Path);
+    ASSERT_TRUE(mapped.IsSucces()) << mapped.ErrorMessage.value();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(mapped.Unpack().Get(keys[i]).Unpack(), values[i]);
+    }
+    EXPECT_FALSE(mapped.Unpack().Contains("theta"));
+
+    CDS_Result<CDS_PerfectHashMap<std::string, std::int64_t>> wrongType =
+        CDS_PerfectHashMap<std::string, std::int64_t>::Open(file.Path);
+    ASSERT_TRUE(wrongType.IsError());
+    EXPECT_EQ(wrongType.ErrorMessage.value(),
+              "The file holds other key or value types");
+
+    std::filesystem::resize_file(file.Path, built.GetBytes() - 1);
+    CDS_Result<CDS_PerfectHashMap<std::string, std::int32_t>> truncated =
+        CDS_PerfectHashMap<std::string, std::int32_t>::Open(file.Path);
+    ASSERT_TRUE(truncated.IsError());
+    EXPECT_EQ(truncated.ErrorMessage.value(), "The file is truncated");
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "CDS_PersistentHashMap.hpp"
+#include "CDS_TestUtil.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using StringMap = CDS_PersistentHashMap<std::string, std::int64_t>;
+
+TEST(CDS_PersistentHashMapTest, ReopensWhatWasFlushed) {
+    ScratchFile file("cds_persistent_hash_reopen.bin");
+    {
+        CDS_Result<StringMap> opened = StringMap::Open(file.Path);
+        ASSERT_TRUE(opened.IsSucces()) << opened.ErrorMessage.value();
+        StringMap& map = opened.Unpack();
+        EXPECT_EQ(map.GetSize(), 0u);
+        EXPECT_EQ(map.GetGeneration(), 1u);
+        for (std::int64_t i = 0; i < 5000; ++i) {
+            ASSERT_TRUE(
+                map.Insert("key-" + std::to_string(i), i * i).IsSucces());
+        }
+        EXPECT_TRUE(map.Insert("key-7", 0).IsError());
+        EXPECT_TRUE(map.Insert("", -1).IsSucces());
+        EXPECT_EQ(map.Delete("key-10").Unpack(), 100);
+        EXPECT_EQ(*map.Set("key-11", 11).Unpack(), 11);
+        EXPECT_EQ(map.GetSize(), 5000u);
+        EXPECT_EQ(map.Flush().Unpack(), 2u);
+    }
+
+    CDS_Result<StringMap> reopened = StringMap::Open(file.Path);
+    ASSERT_TRUE(reopened.IsSucces()) << reopened.ErrorMessage.value();
+    StringMap& map = reopened.Unpack();
+    EXPECT_EQ(map.GetSize(), 5000u);
+    EXPECT_EQ(map.GetGeneration(), 3u);
+    EXPECT_EQ(map.Get("key-4999").Unpack(), 4999 * 4999);
+    EXPECT_EQ(map.Get("key-11").Unpack(), 11);
+    EXPECT_EQ(map.Get("").Unpack(), -1);
+    EXPECT_FALSE(map.Contains("key-10"));
+    EXPECT_EQ(map.Find("key-5000"), nullptr);
+
+    std::size_t visited = 0;
+    map.ForEach([&](std::string_view key, std::int64_t value) {
+        EXPECT_EQ(map.Get(key).Unpack(), value);
+        visited++;
+    });
+    EXPECT_EQ(visited, map.GetSize());
+}
+
+TEST(CDS_PersistentHashMapTest, CrashKeepsTheLastFlush) {
+    ScratchFile file("cds_persistent_hash_crash.bin");
+    ScratchFile crashed("cds_persistent_hash_crashed.bin");
+    CDS_Result<StringMap> opened = StringMap::Open(file.Path);
+    ASSERT_TRUE(opened.IsSucces()) << opened.ErrorMessage.value();
+    StringMap& map = opened.Unpack();
+    for (std::int64_t i = 0; i < 100; ++i) {
+        map.Set("before-" + std::to_string(i), i);
+    }
+    ASSERT_TRUE(map.Flush().IsSucces());
+
+    // Change everything, then copy the file as a crash would leave it.
+    for (std::int64_t i = 0; i < 100; ++i) {
+        map.Set("before-" + std::to_string(i), -i);
+        map.Delete("before-" + std::to_string(i + 100));
+    }
+    map.Delete("before-0");
+    for (std::int64_t i = 0; i < 1000; ++i) {
+        map.Set("after-" + std::to_string(i), i);
+    }
+    std::filesystem::copy_file(file.Path, crashed.Path);
+
+    CDS_Result<StringMap> recovered = StringMap::Open(crashed.Path);
+    ASSERT_TRUE(recovered.IsSucces()) << recovered.ErrorMessage.value();
+    EXPECT_EQ(recovered.Unpack().GetSize(), 100u);
+    EXPECT_EQ(recovered.Unpack().GetGeneration(), map.GetGeneration());
+    for (std::int64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(
+            recovered.Unpack().Get("before-" + std::to_string(i)).Unpack(), i);
+    }
+    EXPECT_FALSE(recovered.Unpack().Contains("after-0"));
+}
+
+TEST(CDS_PersistentHashMapTest, TornHeaderFallsBack) {
+    ScratchFile file("cds_persistent_hash_torn.bin");
+    ScratchFile torn("cds_persistent_hash_torn_copy.bin");
+    StringMap map = std::move(StringMap::Open(file.Path).Unpack());
+    map.Set("kept", 1);
+    map.Flush();
+    map.Set("lost", 2);
+    std::uint64_t generation = map.Flush().Unpack();
+    std::filesystem::copy_file(file.Path, torn.Path);
+
+    // Break the copy of the header the last Flush wrote.
+    std::fstream stream(torn.Path,
+                        std::ios::in | std::ios::out | std::ios::binary);
+    stream.seekp(std::streamoff(generation % 2 * _Persistent::_COPY_STRIDE +
+                                40));
+    stream.put('\x7F');
+    stream.close();
+
+    CDS_Result<StringMap> reopened = StringMap::Open(torn.Path);
+    ASSERT_TRUE(reopened.IsSucces()) << reopened.ErrorMessage.value();
+    EXPECT_EQ(reopened.Unpack().GetGeneration(), generation - 1);
+    EXPECT_EQ(reopened.Unpack().Get("kept").Unpack(), 1);
+    EXPECT_FALSE(reopened.Unpack().Contains("lost"));
+}
+
+TEST(CDS_PersistentHashMapTest, FixedSizeKeys) {
+    ScratchFile file("cds_persistent_hash_fixed.bin");
+    using Map = CDS_PersistentHashMap<std::uint64_t, double>;
+    {
+        Map map = std::move(Map::Open(file.Path).Unpack());
+        EXPECT_EQ(map.Reserve(1000).Unpack(), 2048u);
+        for (std::uint64_t i = 0; i < 100000; ++i) {
+            ASSERT_TRUE(map.Insert(i * 0x9E3779B97F4A7C15ULL, double(i))
+                            .IsSucces());
+        }
+        for (std::uint64_t i = 0; i < 100000; i += 2) {
+            ASSERT_TRUE(map.Delete(i * 0x9E3779B97F4A7C15ULL).IsSucces());
+        }
+        EXPECT_EQ(map.GetSize(), 50000u);
+    }
+
+    Map map = std::move(Map::Open(file.Path).Unpack());
+    EXPECT_EQ(map.GetSize(), 50000u);
+    for (std::uint64_t i = 0; i < 100000; ++i) {
+        const double* value = map.Find(i * 0x9E3779B97F4A7C15ULL);
+        if (i % 2 == 0) {
+            ASSERT_EQ(value, nullptr);
+        } else {
+            ASSERT_NE(value, nullptr);
+            ASSERT_EQ(*value, double(i));
+        }
+    }
+
+    map.Clear();
+    EXPECT_EQ(map.GetSize(), 0u);
+    EXPECT_FALSE(map.Contains(0x9E3779B97F4A7C15ULL));
+    map.Set(42, 0.5);
+    EXPECT_EQ(map.Get(42).Unpack(), 0.5);
+}
+
+TEST(CDS_PersistentHashMapTest, RejectsOtherFiles) {
+    ScratchFile file("cds_persistent_hash_reject.bin");
+    StringMap::Open(file.Path).Unpack().Set("key", 1);
+
+    CDS_Result<CDS_PersistentHashMap<std::string, std::int32_t>> wrongType =
+        CDS_PersistentHashMap<std::string, std::int32_t>::Open(file.Path);
+    ASSERT_TRUE(wrongType.IsError());
+    EXPECT_EQ(wrongType.ErrorMessage.value(),
+              "The file holds other key or value types");
+
+    std::filesystem::resize_file(file.Path, 100);
+    CDS_Result<StringMap> truncated = StringMap::Open(file.Path);
+    ASSERT_TRUE(truncated.IsError());
+    EXPECT_EQ(truncated.ErrorMessage.value(),
+              "The file is too short to be a persistent hash map");
+
+    std::ofstream(file.Path, std::ios::binary) << std::string(8192, 'x');
+    CDS_Result<StringMap> foreign = StringMap::Open(file.Path);
+    ASSERT_TRUE(foreign.IsError());
+    EXPECT_EQ(foreign.ErrorMessage.value(), "Not a persistent hash map file");
+}
+
+TEST(CDS_PersistentHashMapTest, CreatesAtomicallyAndLocks) {
+    ScratchFile file("cds_persistent_hash_lock.bin");
+    {
+        CDS_Result<StringMap> first = StringMap::Open(file.Path);
+        ASSERT_TRUE(first.IsSucces()) << first.ErrorMessage.value();
+        CDS_Result<StringMap> second = StringMap::Open(file.Path);
+        ASSERT_TRUE(second.IsError());
+        EXPECT_EQ(second.ErrorMessage.value(),
+                  file.Path + " is open in another process");
+        first.Unpack().Set("key", 1);
+    }
+    CDS_Result<StringMap> reopened = StringMap::Open(file.Path);
+    ASSERT_TRUE(reopened.IsSucces()) << reopened.ErrorMessage.value();
+    EXPECT_EQ(reopened.Unpack().Get("key").Unpack(), 1);
+
+    // Creating left no temporary file next to the map.
+    std::string prefix =
+        std::filesystem::path(file.Path).filename().string() + ".";
+    for (const auto& entry : std::filesystem::directory_iterator(
+             std::filesystem::path(file.Path).parent_path())) {
+        EXPECT_NE(entry.path().filename().string().rfind(prefix, 0), 0u)
+            << entry.path();
+    }
+
+    // An existing empty file is not taken for a new map.
+    ScratchFile empty("cds_persistent_hash_empty.bin");
+    std::ofstream(empty.Path, std::ios::binary).close();
+    CDS_Result<StringMap> opened = StringMap::Open(empty.Path);
+    ASSERT_TRUE(opened.IsError());
+    EXPECT_EQ(opened.ErrorMessage.value(),
+              "The file is too short to be a persistent hash map");
+}
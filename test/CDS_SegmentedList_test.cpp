@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "CDS_Allocator.hpp"
+#include "CDS_SegmentedList.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST(CDS_SegmentedListTest, StableAddresses) {
+    CDS_SegmentedList<int> list;
+    EXPECT_EQ(list.GetCapacity(), 0u);
+    std::vector<const int*> addresses;
+    for (int i = 0; i < 100000; ++i) {
+        addresses.push_back(&list.Append(i));
+    }
+    EXPECT_EQ(list.GetSize(), 100000u);
+    for (int i = 0; i < 100000; i += 997) {
+        EXPECT_EQ(addresses[i], &list[i]);
+        EXPECT_EQ(*addresses[i], i);
+    }
+    EXPECT_GE(list.GetCapacity(), 100000u);
+    EXPECT_LT(list.GetCapacity(), 200000u);
+
+    std::size_t capacity = list.GetCapacity();
+    for (int i = 0; i < 50000; ++i) {
+        list.Pop();
+    }
+    list.Append(-1);
+    EXPECT_EQ(list[50000], -1);
+    EXPECT_EQ(list.GetCapacity(), capacity);
+}
+
+TEST(CDS_SegmentedListTest, NonTrivialElements) {
+    CDS_SegmentedList<std::string> list;
+    list.Append("first");
+    for (int i = 0; i < 200; ++i) {
+        list.Append(list[0]);
+    }
+    list.Emplace(3, 'z');
+    EXPECT_EQ(list.GetSize(), 202u);
+    EXPECT_EQ(list[200], "first");
+    EXPECT_EQ(list.Pop(), "zzz");
+
+    CDS_SegmentedList<std::string> copy(list);
+    EXPECT_EQ(copy[150], "first");
+    CDS_SegmentedList<std::string> moved(std::move(copy));
+    EXPECT_EQ(moved.GetSize(), 201u);
+    EXPECT_EQ(copy.GetSize(), 0u);
+    copy = moved;
+    moved = std::move(list);
+    EXPECT_EQ(copy.GetSize(), 201u);
+    EXPECT_EQ(moved.GetSize(), 201u);
+
+    CDS_SegmentedList<std::string> small;
+    small.Append("a");
+    small.Append("b");
+    std::ostringstream stream;
+    stream << small;
+    EXPECT_EQ(stream.str(), "[a, b]");
+}
+
+TEST(CDS_SegmentedListTest, Flatten) {
+    CDS_SegmentedList<double> numbers;
+    for (int i = 0; i < 1000; ++i) {
+        numbers.Append(i * 0.5);
+    }
+    CDS_List<double> flat = numbers.Flatten();
+    EXPECT_EQ(flat.GetSize(), 1000u);
+    EXPECT_EQ(flat[999], 499.5);
+    EXPECT_EQ(numbers.GetSize(), 1000u);
+
+    CDS_Pool pool;
+    CDS_SegmentedList<std::string, CDS_PoolAllocator<std::string>> strings{
+        CDS_PoolAllocator<std::string>(pool)};
+    for (int i = 0; i < 300; ++i) {
+        strings.Append(std::to_string(i));
+    }
+    CDS_List<std::string, CDS_PoolAllocator<std::string>> moved =
+        std::move(strings).Flatten();
+    EXPECT_EQ(moved.GetSize(), 300u);
+    EXPECT_EQ(moved[299], "299");
+    EXPECT_EQ(strings.GetSize(), 0u);
+}
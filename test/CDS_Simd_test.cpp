@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "CDS_Arr.hpp"
+#include "CDS_List.hpp"
+#include "CDS_Simd.hpp"
+#include "CDS_TestUtil.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Runs a test body once for every instruction set the CPU supports.
+template <class F>
+static void ForEachLevel(F&& body) {
+    _Simd::_Level saved = _Simd::_GetLevel();
+    for (int level = 0; level <= int(_Simd::_GetSupported()); ++level) {
+        _Simd::_SetLevel(_Simd::_Level(level));
+        SCOPED_TRACE(level);
+        body();
+    }
+    _Simd::_SetLevel(saved);
+}
+
+template <class T>
+static void CheckKernels() {
+    ForEachLevel([] {
+        for (std::size_t count : {0, 1, 3, 7, 15, 16, 17, 63, 64, 65, 1001}) {
+            SCOPED_TRACE(count);
+            // Offset by one element so no level sees aligned data.
+            std::vector<T> a = RandomVector<T>(count + 1, 1);
+            std::vector<T> b = RandomVector<T>(count + 1, 2);
+            std::vector<T> c = RandomVector<T>(count + 1, 3);
+            const T* x = a.data() + 1;
+            const T* y = b.data() + 1;
+            const T* z = c.data() + 1;
+            std::vector<T> got(count + 1), want(count + 1);
+
+            _Simd::_Add(x, y, got.data() + 1, count);
+            _Simd::_Add<T>(x, y, want.data() + 1, count);
+            EXPECT_EQ(got, want);
+            _Simd::_Sub(x, y, got.data() + 1, count);
+            _Simd::_Sub<T>(x, y, want.data() + 1, count);
+            EXPECT_EQ(got, want);
+            _Simd::_Mul(x, y, got.data() + 1, count);
+            _Simd::_Mul<T>(x, y, want.data() + 1, count);
+            EXPECT_EQ(got, want);
+            _Simd::_Scale(x, T(2.5), got.data() + 1, count);
+            _Simd::_Scale<T>(x, T(2.5), want.data() + 1, count);
+            EXPECT_EQ(got, want);
+            _Simd::_Fill(got.data() + 1, count, T(4));
+            _Simd::_Fill<T>(want.data() + 1, count, T(4));
+            EXPECT_EQ(got, want);
+
+            _Simd::_Fma(x, y, z, got.data() + 1, count);
+            _Simd::_Fma<T>(x, y, z, want.data() + 1, count);
+            for (std::size_t i = 0; i <= count; ++i) {
+                EXPECT_NEAR(got[i], want[i], 4 * std::numeric_limits<T>::epsilon());
+            }
+
+            T tolerance = T(count + 1) * std::numeric_limits<T>::epsilon();
+            EXPECT_NEAR(_Simd::_Dot(x, y, count), _Simd::_Dot<T>(x, y, count),
+                        tolerance);
+            EXPECT_NEAR(_Simd::_Sum(x, count), _Simd::_Sum<T>(x, count),
+                        tolerance);
+            if (count > 0) {
+                EXPECT_EQ(_Simd::_Min(x, count), _Simd::_Min<T>(x, count));
+                EXPECT_EQ(_Simd::_Max(x, count), _Simd::_Max<T>(x, count));
+            }
+        }
+    });
+}
+
+TEST(CDS_SimdTest, FloatKernelsMatchScalar) { CheckKernels<float>(); }
+
+TEST(CDS_SimdTest, DoubleKernelsMatchScalar) { CheckKernels<double>(); }
+
+TEST(CDS_SimdTest, SetLevelClampsToSupported) {
+    _Simd::_Level saved = _Simd::_GetLevel();
+    _Simd::_SetLevel(_Simd::_Level::AVX512);
+    EXPECT_LE(_Simd::_GetLevel(), _Simd::_GetSupported());
+    _Simd::_SetLevel(_Simd::_Level::Scalar);
+    EXPECT_EQ(_Simd::_GetLevel(), _Simd::_Level::Scalar);
+    _Simd::_SetLevel(saved);
+}
+
+TEST(CDS_SimdTest, ListOperations) {
+    CDS_List<float> a, b;
+    for (int i = 0; i < 100; ++i) {
+        a.Append(float(i));
+        b.Append(2.0f);
+    }
+    a.Add(b);
+    EXPECT_EQ(a[10], 12.0f);
+    a.Sub(b);
+    a.Mul(b);
+    EXPECT_EQ(a[10], 20.0f);
+    a.Fma(b, b);
+    EXPECT_EQ(a[10], 24.0f);
+    EXPECT_EQ(a.Sum(), 2.0f * 4950 + 400);
+    EXPECT_EQ(a.Dot(b), 2.0f * a.Sum());
+    EXPECT_EQ(a.Min(), 4.0f);
+    EXPECT_EQ(a.Max(), 202.0f);
+
+    CDS_List<float> scaled;
+    scaled.AssignScaled(a, 0.5f);
+    EXPECT_EQ(scaled.GetSize(), 100u);
+    EXPECT_EQ(scaled[99], 101.0f);
+    scaled.AssignScaled(scaled, 2.0f);
+    EXPECT_EQ(scaled[99], 202.0f);
+    scaled.Fill(1.5f);
+    EXPECT_EQ(scaled.Sum(), 150.0f);
+
+    CDS_List<int> ints;
+    for (int i = 1; i <= 10; ++i) {
+        ints.Append(i);
+    }
+    EXPECT_EQ(ints.Sum(), 55);
+    EXPECT_EQ(ints.Dot(ints), 385);
+    EXPECT_EQ(ints.Max(), 10);
+    ints.Fill(3);
+    EXPECT_EQ(ints.Sum(), 30);
+}
+
+TEST(CDS_SimdTest, ArrOperations) {
+    CDS_Arr<double, 40> a, b;
+    a.Fill(1.0);
+    for (int i = 0; i < 40; ++i) {
+        b[i] = i;
+    }
+    a.Add(b);
+    EXPECT_EQ(a.Sum(), 40 + 780);
+    a.AssignScaled(b, -1.0);
+    EXPECT_EQ(a.Min(), -39.0);
+    EXPECT_EQ(a.Max(), 0.0);
+    EXPECT_EQ(b.Dot(b), 20540.0);
+
+    constexpr int sum = [] {
+        CDS_Arr<int, 4> arr;
+        arr.Fill(2);
+        arr.Mul(arr);
+        return arr.Sum();
+    }();
+    EXPECT_EQ(sum, 16);
+}
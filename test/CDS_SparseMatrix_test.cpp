@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "CDS_SparseMatrix.hpp"
+#include "CDS_TestUtil.hpp"
+
+template <class T>
+static void ExpectEqual(const CDS_Matrix<T>& a, const CDS_Matrix<T>& b) {
+    ASSERT_EQ(a.GetShape(), b.GetShape());
+    auto [rows, cols] = a.GetShape();
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            EXPECT_EQ((a[{i, j}]), (b[{i, j}])) << i << ", " << j;
+        }
+    }
+}
+
+TEST(CDS_SparseMatrixTest, FromTriplets) {
+    using Sparse = CDS_SparseMatrix<int>;
+    std::vector<Sparse::Triplet> triplets{
+        {2, 1, 4}, {0, 0, 1}, {2, 1, 3}, {1, 2, 5}, {0, 2, 2}, {1, 0, 0}};
+
+    for (auto format : {Sparse::Format::CSR, Sparse::Format::CSC}) {
+        Sparse matrix(3, 3, triplets, format);
+        EXPECT_EQ(matrix.NonZeros(), 4u);
+        EXPECT_EQ((matrix[{2, 1}]), 7);
+        EXPECT_EQ((matrix[{0, 2}]), 2);
+        EXPECT_EQ((matrix[{1, 0}]), 0);
+        EXPECT_EQ((matrix[{1, 1}]), 0);
+    }
+
+    Sparse csr(3, 3, triplets);
+    EXPECT_EQ(csr.GetOffsets(), (std::vector<std::size_t>{0, 2, 3, 4}));
+    EXPECT_EQ(csr.GetIndices(), (std::vector<int>{0, 2, 2, 1}));
+    EXPECT_EQ(csr.GetValues(), (std::vector<int>{1, 2, 5, 7}));
+
+    // Repeated positions that cancel are not stored.
+    Sparse cancelled(2, 2, {{0, 1, 3}, {0, 1, -3}});
+    EXPECT_EQ(cancelled.NonZeros(), 0u);
+}
+
+TEST(CDS_SparseMatrixTest, DenseRoundTripAndFormat) {
+    CDS_Matrix<double> dense = RandomIntegers<double>(37, 23, 1, 0.2);
+    CDS_SparseMatrix<double> csr(dense);
+    CDS_SparseMatrix<double> csc(dense, CDS_SparseMatrix<double>::Format::CSC);
+    ExpectEqual(csr.ToDense(), dense);
+    ExpectEqual(csc.ToDense(CDS_Matrix<double>::Layout::ColMajor), dense);
+
+    csr.SetFormat(CDS_SparseMatrix<double>::Format::CSC);
+    EXPECT_EQ(csr.GetOffsets(), csc.GetOffsets());
+    EXPECT_EQ(csr.GetIndices(), csc.GetIndices());
+    EXPECT_EQ(csr.GetValues(), csc.GetValues());
+}
+
+TEST(CDS_SparseMatrixTest, Transpose) {
+    CDS_Matrix<int> dense = RandomIntegers<int>(9, 14, 2, 0.3);
+    CDS_SparseMatrix<int> sparse(dense);
+    sparse.Transpose();
+    dense.Transpose();
+    EXPECT_EQ(sparse.GetShape(), std::make_tuple(14, 9));
+    EXPECT_EQ(sparse.GetFormat(), CDS_SparseMatrix<int>::Format::CSR);
+    ExpectEqual(sparse.ToDense(), dense);
+}
+
+TEST(CDS_SparseMatrixTest, Predicates) {
+    CDS_Matrix<int> dense{1, 2, 0, 2, 3, 4, 0, 4, 5};
+    CDS_SparseMatrix<int> symmetric(dense);
+    EXPECT_TRUE(symmetric.IsSquare());
+    EXPECT_TRUE(symmetric.IsSymmetric());
+    EXPECT_FALSE(symmetric.IsDiagonal());
+
+    CDS_SparseMatrix<int> upper(3, 3, {{0, 0, 1}, {0, 2, 6}, {1, 1, 2}},
+                                CDS_SparseMatrix<int>::Format::CSC);
+    EXPECT_TRUE(upper.IsUpperTriangular());
+    EXPECT_FALSE(upper.IsLowerTriangular());
+    EXPECT_FALSE(upper.IsSymmetric());
+
+    CDS_SparseMatrix<int> diagonal(3, 3, {{0, 0, 1}, {2, 2, 3}});
+    EXPECT_TRUE(diagonal.IsDiagonal());
+    EXPECT_TRUE(diagonal.IsAddable(upper));
+    EXPECT_TRUE(diagonal.IsMultipliable(CDS_Matrix<int>(3, 5)));
+    EXPECT_FALSE(diagonal.IsMultipliable(CDS_Matrix<int>(2, 5)));
+    EXPECT_FALSE(CDS_SparseMatrix<int>(2, 3).IsSquare());
+}
+
+TEST(CDS_SparseMatrixTest, VectorProduct) {
+    // Enough non-zeros to be split into several bands.
+    CDS_Matrix<double> dense = RandomIntegers<double>(700, 500, 3, 0.15);
+    std::vector<double> vector(500);
+    for (int j = 0; j < 500; ++j) {
+        vector[j] = 0.5 * j - 100;
+    }
+    std::vector<double> expected = dense * vector;
+
+    CDS_ThreadPool& pool = CDS_ThreadPool::Instance();
+    std::size_t threads = pool.GetThreadCount();
+    std::size_t cutoff = pool.GetSerialCutoff();
+    pool.SetSerialCutoff(0);
+    // One thread runs serially, three split the four bands unevenly.
+    for (std::size_t count : {1, 3, 4}) {
+        pool.SetThreadCount(count);
+        for (auto format : {CDS_SparseMatrix<double>::Format::CSR,
+                            CDS_SparseMatrix<double>::Format::CSC}) {
+            CDS_SparseMatrix<double> sparse(dense, format);
+            std::vector<double> actual = sparse * vector;
+            ASSERT_EQ(actual.size(), expected.size());
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                EXPECT_NEAR(actual[i], expected[i], 1e-9) << count;
+            }
+        }
+    }
+    pool.SetThreadCount(threads);
+    pool.SetSerialCutoff(cutoff);
+}
+
+TEST(CDS_SparseMatrixTest, MatrixProduct) {
+    CDS_Matrix<int> dense = RandomIntegers<int>(60, 45, 4, 0.1);
+    CDS_Matrix<int> other = RandomIntegers<int>(45, 30, 5, 0.8);
+    CDS_Matrix<int> expected = dense * other;
+
+    CDS_SparseMatrix<int> csr(dense);
+    CDS_SparseMatrix<int> csc(dense, CDS_SparseMatrix<int>::Format::CSC);
+    CDS_Matrix<int> rowMajor = csr * other;
+    CDS_Matrix<int> colMajor = csc * other;
+    EXPECT_EQ(rowMajor.GetLayout(), CDS_Matrix<int>::Layout::RowMajor);
+    EXPECT_EQ(colMajor.GetLayout(), CDS_Matrix<int>::Layout::ColMajor);
+    ExpectEqual(rowMajor, expected);
+    ExpectEqual(colMajor, expected);
+
+    other.SetLayout(CDS_Matrix<int>::Layout::ColMajor);
+    ExpectEqual(csr * other, expected);
+
+    CDS_ThreadPool& pool = CDS_ThreadPool::Instance();
+    std::size_t threads = pool.GetThreadCount();
+    std::size_t cutoff = pool.GetSerialCutoff();
+    pool.SetThreadCount(4);
+    pool.SetSerialCutoff(0);
+    ExpectEqual(csr * other, expected);
+    ExpectEqual(csc * other, expected);
+    pool.SetThreadCount(threads);
+    pool.SetSerialCutoff(cutoff);
+}
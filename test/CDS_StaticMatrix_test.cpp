@@ -0,0 +1,116 @@
+#include "CDS_Matrix.hpp"
+#include "CDS_StaticMatrix.hpp"
+#include "CDS_TestUtil.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+// Evaluated entirely by the compiler.
+constexpr CDS_Matrix3<int> kA(2, 1, 0, 1, 1, 0, 0, 0, 1);
+constexpr CDS_Matrix3<int> kB(1, 2, 3, 4, 5, 6, 7, 8, 9);
+static_assert(kA.Determinant() == 1);
+static_assert((kA * kB)[{0, 2}] == 12);
+static_assert(kA.Transposed()[{0, 1}] == 1);
+static_assert(CDS_Matrix3<int>::Identity() * kA == kA);
+static_assert(kA.Inverted() * kA == CDS_Matrix3<int>::Identity());
+static_assert(CDS_StaticMatrix<int, 5, 5>::Identity().Determinant() == 1);
+
+// Random matrix made invertible by a dominant diagonal.
+template <int N> CDS_StaticMatrix<double, N, N> Invertible(unsigned seed) {
+  CDS_Matrix<double> random = Random<double>(N, N, seed);
+  CDS_StaticMatrix<double, N, N> out;
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      out[{i, j}] = random[{i, j}] + (i == j ? N : 0);
+    }
+  }
+  return out;
+}
+
+template <int N> void ExpectInverse(unsigned seed) {
+  CDS_StaticMatrix<double, N, N> a = Invertible<N>(seed);
+  CDS_StaticMatrix<double, N, N> product = a * a.Inverted();
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      EXPECT_NEAR((product[{i, j}]), (i == j ? 1.0 : 0.0), 1e-12);
+    }
+  }
+}
+
+} // namespace
+
+TEST(CDS_StaticMatrixTest, ConstructionAndAccess) {
+  CDS_StaticMatrix<float, 2, 3> m(1, 2, 3, 4, 5, 6);
+  EXPECT_EQ(m.GetShape(), std::make_tuple(2, 3));
+  EXPECT_EQ((m[{1, 0}]), 4.0f);
+  EXPECT_EQ((CDS_StaticMatrix<float, 2, 3>()),
+            (CDS_StaticMatrix<float, 2, 3>::Null()));
+  EXPECT_EQ(sizeof(m), sizeof(CDS_Arr<float, 6>));
+}
+
+TEST(CDS_StaticMatrixTest, MultiplyMatchesDynamicMatrix) {
+  CDS_StaticMatrix<double, 2, 3> a(1, 2, 3, 4, 5, 6);
+  CDS_StaticMatrix<double, 3, 2> b(7, 8, 9, 10, 11, 12);
+  CDS_StaticMatrix<double, 2, 2> product = a * b;
+
+  CDS_Matrix<double> expected =
+      CDS_Matrix<double>(a.View()) * CDS_Matrix<double>(b.View());
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 2; j++) {
+      EXPECT_EQ((product[{i, j}]), (expected[{i, j}]));
+    }
+  }
+
+  CDS_Arr<double, 3> v;
+  v[0] = 1;
+  v[1] = 0;
+  v[2] = -1;
+  CDS_Arr<double, 2> av = a * v;
+  EXPECT_EQ(av[0], -2.0);
+  EXPECT_EQ(av[1], -2.0);
+}
+
+TEST(CDS_StaticMatrixTest, ArithmeticAndTranspose) {
+  CDS_Matrix2<int> a(1, 2, 3, 4);
+  CDS_Matrix2<int> b(4, 3, 2, 1);
+  EXPECT_EQ(a + b, (CDS_Matrix2<int>(5, 5, 5, 5)));
+  EXPECT_EQ(a - b, (CDS_Matrix2<int>(-3, -1, 1, 3)));
+  EXPECT_EQ(2 * a, (CDS_Matrix2<int>(2, 4, 6, 8)));
+  EXPECT_EQ(a.Trace(), 5);
+  a.Transpose();
+  EXPECT_EQ(a, (CDS_Matrix2<int>(1, 3, 2, 4)));
+}
+
+TEST(CDS_StaticMatrixTest, Rotation) {
+  CDS_Matrix3<double> r = CDS_Matrix3<double>::Rotation(90.0f);
+  CDS_Arr<double, 3> x;
+  x[0] = 1;
+  CDS_Arr<double, 3> y = r * x;
+  EXPECT_NEAR(y[0], 0.0, 1e-12);
+  EXPECT_NEAR(y[1], 1.0, 1e-12);
+  EXPECT_NEAR(y[2], 0.0, 1e-12);
+  EXPECT_NEAR(r.Determinant(), 1.0, 1e-12);
+}
+
+TEST(CDS_StaticMatrixTest, DeterminantAndInverse) {
+  ExpectInverse<2>(7);
+  ExpectInverse<3>(8);
+  ExpectInverse<4>(9);
+  ExpectInverse<6>(10);
+
+  // Closed-form and eliminated determinants agree on a scaled identity.
+  CDS_Matrix4<double> four = 2.0 * CDS_Matrix4<double>::Identity();
+  CDS_StaticMatrix<double, 5, 5> five =
+      2.0 * CDS_StaticMatrix<double, 5, 5>::Identity();
+  EXPECT_DOUBLE_EQ(four.Determinant(), 16.0);
+  EXPECT_DOUBLE_EQ(five.Determinant(), 32.0);
+
+  CDS_StaticMatrix<int, 5, 5> singular;
+  singular[{0, 0}] = 1;
+  EXPECT_EQ(singular.Determinant(), 0);
+
+  CDS_Matrix4<double> a = Invertible<4>(11);
+  CDS_Matrix4<double> inverse = a;
+  inverse.Inverse();
+  EXPECT_NEAR(a.Determinant() * inverse.Determinant(), 1.0, 1e-12);
+}
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include "CDS_HashMap.hpp"
+#include "CDS_StringHash.hpp"
+#include "CDS_StringMap.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::size_t allocations = 0;
+
+std::span<const std::byte> Bytes(std::string_view text) {
+    return std::as_bytes(std::span(text.data(), text.size()));
+}
+
+} // namespace
+
+// Every replaceable form is replaced, so whatever form a container uses is
+// counted and freed by the matching function. The nothrow forms call these.
+// They are kept out of line, otherwise GCC sees the malloc and free behind
+// inlined new and delete pairs and reports them as mismatched.
+[[gnu::noinline]] void* operator new(std::size_t size) {
+    allocations++;
+    if (void* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+[[gnu::noinline]] void* operator new(std::size_t size,
+                                     std::align_val_t alignment) {
+    allocations++;
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded =
+        (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    if (void* pointer = std::aligned_alloc(align, rounded))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new[](std::size_t size,
+                                       std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer,
+                                         std::size_t) noexcept {
+    std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer,
+                                       std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer,
+                                         std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, std::size_t,
+                                       std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer, std::size_t,
+                                         std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+TEST(CDS_StringHashTest, SameHashForEveryKeyForm) {
+    CDS_StringHash hash;
+    for (std::size_t length = 0; length < 200; ++length) {
+        std::string key(length, 'a');
+        for (std::size_t i = 0; i < length; ++i) {
+            key[i] = static_cast<char>('a' + (i * 7 + length) % 26);
+        }
+        std::size_t expected = hash(key);
+        EXPECT_EQ(hash(std::string_view(key)), expected);
+        EXPECT_EQ(hash(key.c_str()), expected);
+        EXPECT_EQ(hash(Bytes(key)), expected);
+    }
+}
+
+TEST(CDS_StringHashTest, SpreadsSimilarKeys) {
+    // Keys differing in one byte, at every length the hash reads
+    // differently, must not collide.
+    std::vector<std::uint64_t> hashes;
+    for (std::size_t length = 1; length < 100; ++length) {
+        std::string key(length, 'x');
+        for (std::size_t i = 0; i < length; ++i) {
+            key[i] = 'y';
+            hashes.push_back(CDS_HashBytes(key.data(), key.size()));
+            key[i] = 'x';
+        }
+    }
+    std::sort(hashes.begin(), hashes.end());
+    EXPECT_EQ(std::adjacent_find(hashes.begin(), hashes.end()),
+              hashes.end());
+    EXPECT_NE(CDS_HashBytes("key", 3, 1), CDS_HashBytes("key", 3, 2));
+}
+
+TEST(CDS_StringHashTest, TransparentHashMapLookup) {
+    CDS_HashMap<std::string, int, CDS_StringHash, CDS_StringEqual> map;
+    map.Set("alpha", 1);
+    map.Set(std::string(40, 'b'), 2);
+
+    std::string_view view = "alpha";
+    std::size_t before = allocations;
+    EXPECT_EQ(map.Get(view).Unpack(), 1);
+    EXPECT_TRUE(map.Contains("alpha"));
+    EXPECT_EQ(*map.Find(Bytes(std::string_view("alpha"))), 1);
+    EXPECT_FALSE(map.Contains(std::string_view("alph")));
+    EXPECT_EQ(allocations, before);
+
+    EXPECT_EQ(map.Delete(view).Unpack(), 1);
+    EXPECT_FALSE(map.Contains(view));
+    EXPECT_EQ(map.GetSize(), 1u);
+}
+
+TEST(CDS_StringMapTest, InsertGetDelete) {
+    CDS_StringMap<int> map;
+    EXPECT_TRUE(map.Get("missing").IsError());
+
+    CDS_Result<int*> inserted = map.Insert("one", 1);
+    ASSERT_TRUE(inserted.IsSucces());
+    EXPECT_EQ(*inserted.Unpack(), 1);
+    std::size_t keyBytes = map.GetKeyBytes();
+    EXPECT_TRUE(map.Insert("one", 2).IsError());
+    EXPECT_EQ(map.GetKeyBytes(), keyBytes);
+    EXPECT_EQ(map.Get("one").Unpack(), 1);
+
+    map.Set("one", 3);
+    map["two"] += 2;
+    map[""] = 7;
+    EXPECT_EQ(map.GetSize(), 3u);
+    EXPECT_EQ(*map.Find(Bytes("one")), 3);
+    EXPECT_EQ(map.Get("").Unpack(), 7);
+
+    EXPECT_EQ(map.Delete(Bytes("one")).Unpack(), 3);
+    EXPECT_TRUE(map.Delete("one").IsError());
+    EXPECT_FALSE(map.Contains("one"));
+    EXPECT_EQ(map.GetSize(), 2u);
+
+    map.Clear();
+    EXPECT_EQ(map.GetSize(), 0u);
+    EXPECT_EQ(map.GetKeyBytes(), 0u);
+}
+
+TEST(CDS_StringMapTest, OwnsItsKeys) {
+    CDS_StringMap<int> map;
+    std::string buffer = "token";
+    map.Insert(buffer, 1);
+    buffer.assign("other");
+    EXPECT_EQ(map.Get("token").Unpack(), 1);
+    EXPECT_FALSE(map.Contains("other"));
+
+    CDS_StringMap<int> copy = map;
+    map.Clear();
+    map.Set("token", 2);
+    EXPECT_EQ(copy.Get("token").Unpack(), 1);
+
+    CDS_StringMap<int> moved = std::move(copy);
+    EXPECT_EQ(moved.Get("token").Unpack(), 1);
+    std::vector<std::string> keys;
+    moved.ForEach([&](std::string_view key, int) { keys.emplace_back(key); });
+    EXPECT_EQ(keys, std::vector<std::string>{"token"});
+}
+
+TEST(CDS_StringMapTest, SteadyStateDoesNotAllocate) {
+    CDS_StringMap<int> map;
+    std::vector<std::string> tokens;
+    for (int i = 0; i < 1000; ++i) {
+        tokens.push_back("token-" + std::to_string(i));
+    }
+    map.Reserve(2 * tokens.size());
+    for (const std::string& token : tokens) {
+        map.Set(token, 0);
+    }
+
+    std::size_t before = allocations;
+    for (int round = 0; round < 10; ++round) {
+        for (const std::string& token : tokens) {
+            map[token]++;
+            map.Set(std::string_view(token), map.Get(token).Unpack());
+            ASSERT_TRUE(map.Contains(Bytes(token)));
+        }
+    }
+    EXPECT_EQ(allocations, before);
+    EXPECT_EQ(map.Get("token-999").Unpack(), 10);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+// Helpers shared by the tests.
+
+#include "CDS_Matrix.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Path of a scratch file in the temporary directory, removed when the test
+// starts, in case an earlier run left it behind, and when it ends.
+struct ScratchFile {
+    std::string Path;
+
+    explicit ScratchFile(const std::string& name)
+        : Path((std::filesystem::temp_directory_path() / name).string()) {
+        std::remove(this->Path.c_str());
+    }
+
+    ~ScratchFile() { std::remove(this->Path.c_str()); }
+};
+
+// Matrix of small integers without a simple pattern, so its products are
+// exact in every element type.
+template <class T>
+CDS_Matrix<T> Sequence(int rows, int cols,
+                       typename CDS_Matrix<T>::Layout layout =
+                           CDS_Matrix<T>::Layout::RowMajor) {
+    CDS_Matrix<T> out(rows, cols, layout);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            out[{i, j}] = T((i * 7 + j * 3) % 11) - T(5);
+        }
+    }
+    return out;
+}
+
+// Matrix with elements uniform in [-1, 1), complex ones in both parts.
+template <class T>
+CDS_Matrix<T> Random(int rows, int cols, unsigned seed,
+                     typename CDS_Matrix<T>::Layout layout =
+                         CDS_Matrix<T>::Layout::RowMajor) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    CDS_Matrix<T> out(rows, cols, layout);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                out[{i, j}] = static_cast<T>(dist(rng));
+            } else {
+                out[{i, j}] = T(dist(rng), dist(rng));
+            }
+        }
+    }
+    return out;
+}
+
+// Matrix of integers in [-9, 9], with roughly density * rows * cols
+// elements drawn and the rest zero.
+template <class T>
+CDS_Matrix<T> RandomIntegers(int rows, int cols, std::mt19937& engine,
+                             double density = 1.0) {
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<int> value(-9, 9);
+    CDS_Matrix<T> out(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            if (density >= 1.0 || coin(engine) < density) {
+                out[{i, j}] = T(value(engine));
+            }
+        }
+    }
+    return out;
+}
+
+template <class T>
+CDS_Matrix<T> RandomIntegers(int rows, int cols, unsigned seed,
+                             double density = 1.0) {
+    std::mt19937 engine(seed);
+    return RandomIntegers<T>(rows, cols, engine, density);
+}
+
+// Matrices of integers in [-9, 9], all drawn from one seed.
+template <class T>
+std::vector<CDS_Matrix<T>> RandomList(int count, int rows, int cols,
+                                      unsigned seed) {
+    std::mt19937 engine(seed);
+    std::vector<CDS_Matrix<T>> out;
+    for (int b = 0; b < count; ++b) {
+        out.push_back(RandomIntegers<T>(rows, cols, engine));
+    }
+    return out;
+}
+
+// Vector with elements uniform in [-1, 1).
+template <class T>
+std::vector<T> RandomVector(std::size_t count, unsigned seed) {
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<T> value(-1, 1);
+    std::vector<T> out(count);
+    for (T& x : out) {
+        x = value(engine);
+    }
+    return out;
+}